@@ -1,5 +1,7 @@
 #include "Asset.h"
 
+#include <algorithm>
+
 #include "FileSystem.h"
 
 TYPEINFO_INIT(Asset, NoBaseClass, 100)
@@ -14,6 +16,27 @@ Asset::Asset(const std::string& name, AssetScope scope) :
 
 }
 
+void Asset::AddDependency(Asset* asset)
+{
+    if(asset != this && std::find(mDependencies.begin(), mDependencies.end(), asset) == mDependencies.end())
+    {
+        mDependencies.push_back(asset);
+    }
+}
+
+void Asset::Reclaim(AssetScope scope)
+{
+    // Anything this asset depends on must be kept too, or the asset will be left with dangling pointers.
+    mScope = scope;
+    for(Asset* dependency : mDependencies)
+    {
+        if(dependency->GetScope() == AssetScope::Retained)
+        {
+            dependency->Reclaim(scope);
+        }
+    }
+}
+
 std::string Asset::GetNameNoExtension() const
 {
     return Path::RemoveExtension(mName);
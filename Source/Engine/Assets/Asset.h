@@ -7,9 +7,12 @@
 // Usually loaded from the disk, but could be created at runtime as well.
 //
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "MemoryTracker.h"
 #include "TypeInfo.h"
 
 // Assets can have an assigned scope, which helps to inform memory management.
@@ -17,10 +20,26 @@ enum class AssetScope
 {
     Global,     // An asset with Global scope is only unloaded from memory if explicitly requested.
     Scene,      // An asset with Scene scope is unloaded when the scene changes.
+    Retained,   // A Scene asset kept loaded through a scene change, because the next scene will likely use it. If it isn't used, it's unloaded.
 
     Manual      // An asset with manual scope is not tracked by the system, so the creator of the asset is responsible for its lifetime.
 };
 
+class IAssetArchive;
+
+// Identifies an asset's data inside of an asset archive, so it can be read in pieces on demand rather than all at once.
+struct AssetStreamInfo
+{
+    // The archive containing the asset. Null if the asset can't be streamed.
+    const IAssetArchive* archive = nullptr;
+
+    // Offset of the asset's data within the archive, and size of the data.
+    uint32_t offset = 0;
+    uint32_t size = 0;
+
+    bool IsValid() const { return archive != nullptr; }
+};
+
 // Holds raw asset data to be passed to an Asset::Load function.
 struct AssetData
 {
@@ -28,12 +47,22 @@ struct AssetData
     // A few assets want to keep the byte buffer in memory, while others just parse it and then want to delete it.
     std::unique_ptr<uint8_t> bytes = nullptr;
     uint32_t length = 0;
+
+    // If the asset is being streamed, bytes is null, and this can be used to read the asset's data instead.
+    AssetStreamInfo stream;
 };
 
 class Asset
 {
     TYPEINFO_BASE(Asset);
 public:
+    // Assets at least this big are streamed from their archive, rather than read into memory when loaded.
+    // By default, assets are never streamed. Asset types that support streaming can hide this with a smaller value.
+    static constexpr uint32_t kStreamingThreshold = UINT32_MAX;
+
+    // Memory allocated while loading an asset is tracked under this tag. Asset types can hide this with a more specific tag.
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Assets;
+
     virtual ~Asset() = default;
 
     void SetName(const std::string& name) { mName = name; }
@@ -43,6 +72,13 @@ public:
     void SetScope(AssetScope scope) { mScope = scope; }
     AssetScope GetScope() const { return mScope; }
 
+    // Other assets that were loaded while this asset was loading (e.g. a model's textures).
+    void AddDependency(Asset* asset);
+    const std::vector<Asset*>& GetDependencies() const { return mDependencies; }
+
+    // Called when a retained asset is used again. Moves it (and any retained assets it depends on) to the given scope.
+    void Reclaim(AssetScope scope);
+
 protected:
     // Asset's name, typically including an extension.
     std::string mName;
@@ -50,6 +86,10 @@ protected:
     // Asset's scope.
     AssetScope mScope = AssetScope::Global;
 
+    // Assets this asset loaded, and likely holds pointers to.
+    // If this asset is retained through a scene change and used again, these must be kept too.
+    std::vector<Asset*> mDependencies;
+
     // You should not be able to create an instance of this class - only subclasses are allowed.
     explicit Asset(const std::string& name, AssetScope scope);
 };
\ No newline at end of file
@@ -10,7 +10,8 @@
 #include <vector>
 
 #include "Asset.h"      // AssetScope
-#include "StringUtil.h" // string_map_ci
+#include "StringUtil.h"
+#include "Symbol.h"
 #include "TypeId.h"
 
 // Problem: we want to track all the asset caches that exist in a static list, but templatized classes can't be put in a list (for different types of T).
@@ -28,6 +29,7 @@ public:
     virtual ~IAssetCache() = default;
     virtual const std::string& GetId() = 0;
     virtual void UnloadAssets(AssetScope scope) = 0;
+    virtual void ChangeScope(AssetScope scope, AssetScope newScope) = 0;
 };
 
 template<typename T>
@@ -74,15 +76,20 @@ public:
 
     T* GetAsset(const std::string& name)
     {
+        // If the name was never interned, it can't be in the cache.
+        Symbol symbol = Symbol::Find(name);
+        if(symbol.IsEmpty()) { return nullptr; }
+
         std::lock_guard<std::mutex> lock(mAssetsMutex);
-        auto it = mAssets.find(name);
-        return it != mAssets.end() ? it->second : nullptr;
+        T** asset = mAssets.Find(symbol);
+        return asset != nullptr ? *asset : nullptr;
     }
 
     void SetAsset(const std::string& name, T* asset)
     {
+        Symbol symbol(name);
         std::lock_guard<std::mutex> lock(mAssetsMutex);
-        mAssets[name] = asset;
+        mAssets[symbol] = asset;
     }
 
     void UnloadAssets(AssetScope scope) override
@@ -95,35 +102,49 @@ public:
             {
                 delete entry.second;
             }
-            mAssets.clear();
+            mAssets.Clear();
         }
         else
         {
             // Otherwise, we are picking and choosing what we want to get rid of.
-            for(auto it = mAssets.begin(); it != mAssets.end();)
+            // Erasing moves entries around in the map, so gather up what to erase first.
+            std::vector<Symbol> toErase;
+            for(auto& entry : mAssets)
             {
-                if((*it).second->GetScope() == scope)
-                {
-                    delete (*it).second;
-                    it = mAssets.erase(it);
-                }
-                else
+                if(entry.second->GetScope() == scope)
                 {
-                    ++it;
+                    delete entry.second;
+                    toErase.push_back(entry.first);
                 }
             }
+            for(Symbol& symbol : toErase)
+            {
+                mAssets.Erase(symbol);
+            }
+        }
+    }
+
+    void ChangeScope(AssetScope scope, AssetScope newScope) override
+    {
+        std::lock_guard<std::mutex> lock(mAssetsMutex);
+        for(auto& entry : mAssets)
+        {
+            if(entry.second->GetScope() == scope)
+            {
+                entry.second->SetScope(newScope);
+            }
         }
     }
 
-    const std::string_map_ci<T*>& GetAssets() const { return mAssets; }
+    const SymbolMap<T*>& GetAssets() const { return mAssets; }
 
 private:
     // An identifier for this asset cache.
     // Useful when multiple caches store the same asset type, but for different purposes.
     std::string mId;
 
-    // The assets themselves, keyed by name.
-    std::string_map_ci<T*> mAssets;
+    // The assets themselves, keyed by (interned) name.
+    SymbolMap<T*> mAssets;
 
     // A mutex is required when modifying the cache, since we allow loading assets on any thread.
     // We don't want multiple threads modifying the cache at the same time.
@@ -10,6 +10,15 @@
 #include "ReportManager.h"
 #include "StringUtil.h"
 
+namespace
+{
+    // Assets currently being loaded on this thread. The last one is the innermost load.
+    thread_local std::vector<Asset*> tLoadingAssets;
+
+    // Prefetched asset data is evicted (oldest first) to stay under this size.
+    const uint32_t kMaxPrefetchBytes = 64 * 1024 * 1024;
+}
+
 AssetManager gAssetManager;
 
 void AssetManager::Shutdown()
@@ -119,6 +128,26 @@ bool AssetManager::LoadAssetArchive(const std::string& archiveName, int searchOr
     return true;
 }
 
+void AssetManager::ForEachArchivedAsset(const std::string& extension, const std::function<void(const std::string&, AssetData&)>& callback) const
+{
+    // Read the raw bytes of each archived asset with this extension, one at a time.
+    // Note that if an asset exists in several archives, the callback is called for each copy.
+    for(auto& entry : mArchives)
+    {
+        entry.archive->ForEachAsset([&entry, &extension, &callback](const std::string& assetName) {
+            if(StringUtil::EndsWithIgnoreCase(assetName, extension))
+            {
+                AssetData assetData;
+                assetData.bytes.reset(entry.archive->CreateAssetBuffer(assetName, assetData.length));
+                if(assetData.bytes != nullptr)
+                {
+                    callback(assetName, assetData);
+                }
+            }
+        });
+    }
+}
+
 void AssetManager::SetAssetExtractor(const std::string& extension, const std::function<bool(AssetExtractData&)>& extractorFunction)
 {
     if(extension.empty())
@@ -186,6 +215,19 @@ void AssetManager::UnloadAssets(AssetScope scope)
     }
 }
 
+void AssetManager::RetainAssets(AssetScope scope)
+{
+    // Loader threads may be reclaiming retained assets, so hold the cache mutex while changing scopes.
+    std::lock_guard<std::mutex> lock(IAssetCache::sAssetCachesMutex);
+    for(auto& entry : IAssetCache::sAssetCachesByType)
+    {
+        for(IAssetCache* assetCache : entry.second)
+        {
+            assetCache->ChangeScope(scope, AssetScope::Retained);
+        }
+    }
+}
+
 bool AssetManager::ExtractAsset(IAssetArchive* archive, const std::string& assetName,  const std::string& outputDirectory) const
 {
     // Must have an archive to extract from.
@@ -257,4 +299,204 @@ uint8_t* AssetManager::CreateAssetBuffer(const std::string& assetName, uint32_t&
 
     // Couldn't find this asset!
     return nullptr;
-}
\ No newline at end of file
+}
+
+bool AssetManager::GetAssetStreamInfo(const std::string& assetName, uint32_t minSize, AssetStreamInfo& outStreamInfo) const
+{
+    // Most asset types never stream, so don't bother searching for those.
+    if(minSize == UINT32_MAX) { return false; }
+
+    // Loose files take precedence over archived assets, and are always loaded fully.
+    if(!FindLooseFilePath(assetName).empty()) { return false; }
+
+    // Find the first archive containing this asset (same order as CreateAssetBuffer).
+    // If that archive can't stream it (or it's too small to be worth it), it'll be loaded normally.
+    for(auto& entry : mArchives)
+    {
+        AssetStreamInfo streamInfo;
+        if(entry.archive->GetAssetStreamInfo(assetName, streamInfo))
+        {
+            if(streamInfo.IsValid() && streamInfo.size >= minSize)
+            {
+                outStreamInfo = streamInfo;
+                return true;
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+void AssetManager::OnAssetRequested(Asset* asset, AssetScope scope)
+{
+    // If another asset is loading on this thread, it's requesting this asset as part of its own load.
+    // Manual assets aren't tracked, so their lifetimes are unknown - don't record those.
+    if(!tLoadingAssets.empty() && scope != AssetScope::Manual)
+    {
+        tLoadingAssets.back()->AddDependency(asset);
+    }
+
+    // A retained asset is being used again, so keep it (and what it depends on) at the requested scope.
+    // Assets can load on any thread, so the scope check and change happen under the cache mutex (as in RetainAssets).
+    std::lock_guard<std::mutex> lock(IAssetCache::sAssetCachesMutex);
+    if(asset->GetScope() == AssetScope::Retained)
+    {
+        asset->Reclaim(scope);
+    }
+}
+
+void AssetManager::PushLoadingAsset(Asset* asset)
+{
+    tLoadingAssets.push_back(asset);
+}
+
+void AssetManager::PopLoadingAsset()
+{
+    tLoadingAssets.pop_back();
+}
+
+void AssetManager::MarkPrefetchesEvictable()
+{
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    mEvictablePrefetchSequence = mPrefetchSequence;
+    mUnevictablePrefetchedBytes = 0;
+    mPrefetchRequestedNames.clear();
+}
+
+bool AssetManager::IsPrefetchCacheFull() const
+{
+    // Evictable data can always make room, so only the rest counts.
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    return mUnevictablePrefetchedBytes >= kMaxPrefetchBytes;
+}
+
+AssetPrefetchStats AssetManager::GetPrefetchStats() const
+{
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    AssetPrefetchStats stats = mPrefetchStats;
+    stats.cachedBytes = mPrefetchedBytes;
+    return stats;
+}
+
+bool AssetManager::PrefetchAssetData(const std::string& name, uint32_t streamingThreshold, const std::function<void(const AssetData&)>& onRead)
+{
+    // If already prefetched, there's nothing to read. But the caller may still want to see the data.
+    // The data may be taken by a load as soon as the lock is released, so the caller gets a copy.
+    {
+        AssetData copy;
+        {
+            std::lock_guard<std::mutex> lock(mPrefetchMutex);
+            auto it = mPrefetchedAssets.find(name);
+            if(it != mPrefetchedAssets.end())
+            {
+                mPrefetchRequestedNames.insert(name);
+
+                // It's wanted again, so it shouldn't be evicted anymore. Treat it as if it were just prefetched.
+                PrefetchedAsset& prefetchedAsset = it->second;
+                if(prefetchedAsset.sequence <= mEvictablePrefetchSequence)
+                {
+                    prefetchedAsset.sequence = ++mPrefetchSequence;
+                    mPrefetchOrder.emplace_back(name, prefetchedAsset.sequence);
+                    mUnevictablePrefetchedBytes += prefetchedAsset.assetData.length;
+                }
+                if(onRead != nullptr)
+                {
+                    copy.length = prefetchedAsset.assetData.length;
+                    copy.bytes.reset(new uint8_t[copy.length]);
+                    memcpy(copy.bytes.get(), prefetchedAsset.assetData.bytes.get(), copy.length);
+                }
+                else
+                {
+                    return true;
+                }
+            }
+        }
+        if(copy.bytes != nullptr)
+        {
+            onRead(copy);
+            return true;
+        }
+    }
+
+    // Streamed assets only read their data on demand, so prefetching wouldn't be used.
+    AssetStreamInfo streamInfo;
+    if(GetAssetStreamInfo(name, streamingThreshold, streamInfo)) { return false; }
+
+    // From here on, if this asset is loaded without using prefetched data, it's a miss.
+    {
+        std::lock_guard<std::mutex> lock(mPrefetchMutex);
+        mPrefetchRequestedNames.insert(name);
+    }
+
+    // Read the data. This is the slow part (reading and decompressing), so don't hold the lock for it.
+    MEMORY_TAG_SCOPED(MemoryTag::Assets);
+    PrefetchedAsset prefetchedAsset;
+    prefetchedAsset.assetData.bytes.reset(CreateAssetBuffer(name, prefetchedAsset.assetData.length));
+    if(prefetchedAsset.assetData.bytes == nullptr) { return false; }
+    if(onRead != nullptr)
+    {
+        onRead(prefetchedAsset.assetData);
+    }
+
+    // Too big to ever fit? Then it can't be prefetched.
+    uint32_t length = prefetchedAsset.assetData.length;
+    if(length > kMaxPrefetchBytes) { return false; }
+
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    if(mPrefetchedAssets.find(name) != mPrefetchedAssets.end()) { return true; }
+
+    // Make room by evicting the oldest prefetches.
+    // Prefetches that were already loaded are no longer in the map (or were prefetched again, with a newer sequence number), so those are just skipped.
+    while(!mPrefetchOrder.empty())
+    {
+        auto it = mPrefetchedAssets.find(mPrefetchOrder.front().first);
+        bool stale = it == mPrefetchedAssets.end() || it->second.sequence != mPrefetchOrder.front().second;
+        if(!stale)
+        {
+            if(mPrefetchedBytes + length <= kMaxPrefetchBytes) { break; }
+
+            // Prefetches are in sequence order, so if this one can't be evicted, neither can any after it.
+            // There's no room, so don't keep this data.
+            if(it->second.sequence > mEvictablePrefetchSequence) { return false; }
+            mPrefetchedBytes -= it->second.assetData.length;
+            mPrefetchedAssets.erase(it);
+            ++mPrefetchStats.evicted;
+        }
+        mPrefetchOrder.pop_front();
+    }
+
+    prefetchedAsset.sequence = ++mPrefetchSequence;
+    mPrefetchOrder.emplace_back(name, prefetchedAsset.sequence);
+    mPrefetchedAssets[name] = std::move(prefetchedAsset);
+    mPrefetchedBytes += length;
+    mUnevictablePrefetchedBytes += length;
+    ++mPrefetchStats.prefetched;
+    return true;
+}
+
+bool AssetManager::TakePrefetchedAsset(const std::string& name, AssetData& outAssetData)
+{
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    auto it = mPrefetchedAssets.find(name);
+    if(it == mPrefetchedAssets.end()) { return false; }
+
+    if(it->second.sequence > mEvictablePrefetchSequence)
+    {
+        mUnevictablePrefetchedBytes -= it->second.assetData.length;
+    }
+    outAssetData = std::move(it->second.assetData);
+    mPrefetchedBytes -= outAssetData.length;
+    mPrefetchedAssets.erase(it);
+    mPrefetchRequestedNames.erase(name);
+    ++mPrefetchStats.hits;
+    return true;
+}
+
+void AssetManager::OnAssetReadFromDisk(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    if(mPrefetchRequestedNames.erase(name) > 0)
+    {
+        ++mPrefetchStats.misses;
+    }
+}
@@ -22,10 +22,18 @@
 //    If only the name is provided, an "asset name resolver" can be provided that maps asset types and cache IDs to expected extensions.
 //    The system will then try to use the expected extensions to find and load the correct asset.
 //
-// 7) Asset unloading via scope: each asset stores a scope (Global, Scene, etc). Assets can be unloaded by scope at any time.
+// 7) Prefetching: an asset's data can be read ahead of time (on any thread), into a bounded prefetch cache.
+//    When the asset is loaded, its data comes from the prefetch cache rather than the disk or an archive.
+//
+// 8) Asset unloading via scope: each asset stores a scope (Global, Scene, etc). Assets can be unloaded by scope at any time.
+//    Assets can also be retained: they stay loaded, and go back to their old scope if requested again. Unloading retained scope gets rid of the rest.
 //
 #pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <initializer_list>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,6 +56,22 @@ struct AssetExtractData
     std::string outputPath;
 };
 
+// Counts for how well asset prefetching is working.
+struct AssetPrefetchStats
+{
+    // Assets that were loaded using prefetched data, and assets that prefetching was asked for but were loaded from disk/archive instead.
+    // Assets that prefetching was never asked for (e.g. UI or global assets) don't count as misses.
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+
+    // Assets that were prefetched, and how many of those were evicted without ever being loaded.
+    uint32_t prefetched = 0;
+    uint32_t evicted = 0;
+
+    // Bytes currently held in the prefetch cache.
+    uint32_t cachedBytes = 0;
+};
+
 class AssetManager
 {
 public:
@@ -65,6 +89,7 @@ public:
 
     // Asset Archives
     bool LoadAssetArchive(const std::string& archiveName, int searchOrder = 0);
+    void ForEachArchivedAsset(const std::string& extension, const std::function<void(const std::string&, AssetData&)>& callback) const;
 
     // Asset Extraction
     void SetAssetExtractor(const std::string& extension, const std::function<bool(AssetExtractData&)>& extractorFunction);
@@ -76,9 +101,26 @@ public:
     template<typename T> T* LoadAsset(const std::string& name, AssetScope scope = AssetScope::Global, const std::string& assetCacheId = "");
     template<typename T> T* LoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache);
     template<typename T> void TrackAsset(T* asset, AssetScope scope = AssetScope::Global, const std::string& assetCacheId = "");
-    template<typename T> const std::string_map_ci<T*>& GetAssets(const std::string& assetCacheId = "");
+    template<typename T> const SymbolMap<T*>& GetAssets(const std::string& assetCacheId = "");
     void UnloadAssets(AssetScope scope);
 
+    // Asset Prefetching
+    // Reads an asset's data into the prefetch cache, so a later LoadAsset doesn't have to read it. Safe to call from any thread.
+    // If provided, onRead is called with the asset's data before it goes in the cache (e.g. to find other assets it refers to).
+    // Returns false if the asset doesn't exist, is already loaded, or doesn't benefit from prefetching (e.g. it is streamed).
+    template<typename T> bool PrefetchAsset(const std::string& name, const std::function<void(const AssetData&)>& onRead = nullptr, const std::string& assetCacheId = "");
+
+    // Data prefetched so far may be evicted to make room for new prefetches (e.g. when predictions of what will be loaded change).
+    // Until then, prefetched data is kept, and the cache is full once it reaches its size limit.
+    // Assets asked for before this no longer count as misses when read from disk, unless they're asked for again.
+    void MarkPrefetchesEvictable();
+    bool IsPrefetchCacheFull() const;
+    AssetPrefetchStats GetPrefetchStats() const;
+
+    // Changes all assets at the given scope to Retained scope.
+    // A retained asset (and its dependencies) takes the requested scope again when next loaded, rather than being loaded from scratch.
+    void RetainAssets(AssetScope scope);
+
 private:
     // Search paths for loading assets from the disk. Used for loading loose files and asset archives.
     // Expected to be in priority order - an asset is loaded from the first place it is found.
@@ -103,7 +145,39 @@ private:
 
     bool ExtractAsset(IAssetArchive* archive, const std::string& assetName, const std::string& outputDirectory) const;
     uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const;
+    bool GetAssetStreamInfo(const std::string& assetName, uint32_t minSize, AssetStreamInfo& outStreamInfo) const;
     template<typename T> T* LoadAssetInternal(const std::string& name, AssetScope scope, AssetCache<T>* cache);
+
+    // Prefetched asset data, waiting to be loaded. Oldest prefetches are evicted first if the cache gets too big.
+    // Only prefetches made before the last MarkPrefetchesEvictable (sequence at or below the evictable sequence) are evicted.
+    struct PrefetchedAsset
+    {
+        AssetData assetData;
+        uint32_t sequence = 0;
+    };
+    std::string_map_ci<PrefetchedAsset> mPrefetchedAssets;
+    std::deque<std::pair<std::string, uint32_t>> mPrefetchOrder;
+    uint32_t mPrefetchSequence = 0;
+    uint32_t mPrefetchedBytes = 0;
+    uint32_t mEvictablePrefetchSequence = 0;
+    uint32_t mUnevictablePrefetchedBytes = 0;
+    AssetPrefetchStats mPrefetchStats;
+    mutable std::mutex mPrefetchMutex;
+
+    // Assets prefetching was asked for since the last MarkPrefetchesEvictable, that haven't been loaded yet.
+    // If one of these is read from disk when loaded, that's a prefetch miss.
+    std::string_set_ci mPrefetchRequestedNames;
+
+    bool PrefetchAssetData(const std::string& name, uint32_t streamingThreshold, const std::function<void(const AssetData&)>& onRead);
+    bool TakePrefetchedAsset(const std::string& name, AssetData& outAssetData);
+    void OnAssetReadFromDisk(const std::string& name);
+
+    // Called whenever LoadAsset returns an asset, whether it was just loaded or already in the cache.
+    void OnAssetRequested(Asset* asset, AssetScope scope);
+
+    // Tracks the assets being loaded on each thread, so assets loaded during another asset's load are recorded as its dependencies.
+    void PushLoadingAsset(Asset* asset);
+    void PopLoadingAsset();
 };
 
 extern AssetManager gAssetManager;
@@ -125,6 +199,36 @@ T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, const std:
     return LoadAsset(name, scope, assetCache);
 }
 
+template<typename T>
+bool AssetManager::PrefetchAsset(const std::string& name, const std::function<void(const AssetData&)>& onRead, const std::string& assetCacheId)
+{
+    if(name.empty()) { return false; }
+
+    // Same name resolution as LoadAsset: use the name as-is if it has an extension, otherwise try the type's extensions.
+    std::vector<std::string> names;
+    if(!mAssetNameResolver.HasValidExtension(name))
+    {
+        for(const std::string& extension : mAssetNameResolver.GetTypeExtensions<T>(assetCacheId))
+        {
+            names.push_back(name + extension);
+        }
+    }
+    names.push_back(name);
+
+    AssetCache<T>* cache = AssetCache<T>::Get(assetCacheId);
+    for(const std::string& candidate : names)
+    {
+        // No point prefetching an asset that's already loaded.
+        if(cache->GetAsset(candidate) != nullptr) { return false; }
+
+        if(PrefetchAssetData(candidate, T::kStreamingThreshold, onRead))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 template<typename T>
 T* AssetManager::LoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache)
 {
@@ -175,7 +279,7 @@ void AssetManager::TrackAsset(T* asset, AssetScope scope, const std::string& ass
 }
 
 template<typename T>
-const std::string_map_ci<T*>& AssetManager::GetAssets(const std::string& assetCacheId)
+const SymbolMap<T*>& AssetManager::GetAssets(const std::string& assetCacheId)
 {
     return AssetCache<T>::Get(assetCacheId)->GetAssets();
 }
@@ -195,14 +299,24 @@ inline T* AssetManager::LoadAssetInternal(const std::string& name, AssetScope sc
             {
                 cachedAsset->SetScope(AssetScope::Global);
             }
+            OnAssetRequested(cachedAsset, scope);
             return cachedAsset;
         }
     }
 
-    // Create buffer containing this asset's data. If this fails, the asset doesn't exist, so we can't load it.
+    // Attribute memory used by this asset (including its raw data) to the asset type's tag.
+    MEMORY_TAG_SCOPED(T::kMemoryTag);
+
+    // If this asset's data was prefetched, use that.
+    // Otherwise, if this asset type supports streaming and the asset is big enough, don't read its data now - the asset will read it on demand.
+    // Otherwise, create buffer containing this asset's data. If this fails, the asset doesn't exist, so we can't load it.
     AssetData assetData;
-    assetData.bytes.reset(CreateAssetBuffer(name, assetData.length));
-    if(assetData.bytes == nullptr) { return nullptr; }
+    if(!TakePrefetchedAsset(name, assetData) && !GetAssetStreamInfo(name, T::kStreamingThreshold, assetData.stream))
+    {
+        assetData.bytes.reset(CreateAssetBuffer(name, assetData.length));
+        if(assetData.bytes == nullptr) { return nullptr; }
+        OnAssetReadFromDisk(name);
+    }
     //printf("Loading asset %s\n", assetName.c_str());
 
     // Create asset from asset buffer.
@@ -216,6 +330,9 @@ inline T* AssetManager::LoadAssetInternal(const std::string& name, AssetScope sc
     }
 
     // Load the asset.
+    OnAssetRequested(asset, scope);
+    PushLoadingAsset(asset);
     asset->Load(assetData);
+    PopLoadingAsset();
     return asset;
 }
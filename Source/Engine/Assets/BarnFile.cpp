@@ -1,5 +1,6 @@
 #include "BarnFile.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -9,7 +10,15 @@
 
 #include "ReportManager.h"
 
-#define LOG_BARN(x, ...) gReportManager.Logf("BarnFileMgr", x, __VA_ARGS__)
+namespace
+{
+    ReportStream& GetBarnStream()
+    {
+        static ReportStream& barnStream = gReportManager.GetReportStream("BarnFileMgr");
+        return barnStream;
+    }
+}
+#define LOG_BARN(x, ...) gReportManager.Logf(GetBarnStream(), x, __VA_ARGS__)
 
 BarnFile::BarnFile(const std::string& filePath) :
     mName(filePath),
@@ -361,4 +370,36 @@ void BarnFile::ForEachAsset(const std::function<void(const std::string&)>& callb
             callback(entry.first);
         }
     }
+}
+
+bool BarnFile::GetAssetStreamInfo(const std::string& assetName, AssetStreamInfo& outStreamInfo) const
+{
+    // Pointers aren't actually in this barn, so treat them as not found.
+    auto it = mAssetMap.find(assetName);
+    if(it == mAssetMap.end() || it->second.IsPointer())
+    {
+        return false;
+    }
+
+    // Compressed assets must be decompressed all at once, so only uncompressed assets can be streamed.
+    const BarnAsset& asset = it->second;
+    if(asset.compressionType == CompressionType::None)
+    {
+        outStreamInfo.archive = this;
+        outStreamInfo.offset = mDataOffset + asset.offset;
+        outStreamInfo.size = asset.size;
+    }
+    return true;
+}
+
+uint32_t BarnFile::ReadAssetStream(const AssetStreamInfo& streamInfo, uint32_t position, uint8_t* buffer, uint32_t count) const
+{
+    // Don't read past the end of the asset.
+    if(position >= streamInfo.size) { return 0; }
+    count = std::min(count, streamInfo.size - position);
+
+    // Streams are usually read from a background thread (e.g. the audio system's), so this shares the reader mutex with asset loading.
+    std::lock_guard<std::mutex> lock(mReaderMutex);
+    mReader.Seek(streamInfo.offset + position);
+    return mReader.Read(buffer, count);
 }
\ No newline at end of file
@@ -55,6 +55,9 @@ public:
     uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const override;
     void ForEachAsset(const std::function<void(const std::string&)>& callback) const override;
 
+    bool GetAssetStreamInfo(const std::string& assetName, AssetStreamInfo& outStreamInfo) const override;
+    uint32_t ReadAssetStream(const AssetStreamInfo& streamInfo, uint32_t position, uint8_t* buffer, uint32_t count) const override;
+
 private:
     // Identifiers required to verify file type.
     const uint32_t kGameIdentifier = 0x21334B47; // GK3!
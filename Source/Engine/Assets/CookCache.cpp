@@ -0,0 +1,250 @@
+#include "CookCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "BinaryWriter.h"
+
+CookCache gCookCache;
+
+namespace
+{
+    // Header is an 8-byte identifier, the format version, and the entry count.
+    const char* kIdentifier = "GK3Cook";
+    const uint32_t kHeaderSize = 16;
+
+    // Each table entry is a key, a data offset (from the start of the file), and a data length.
+    const uint32_t kTableEntrySize = 16;
+
+    // 64-bit FNV-1a.
+    const uint64_t kHashOffsetBasis = 14695981039346656037ULL;
+    const uint64_t kHashPrime = 1099511628211ULL;
+
+    uint64_t HashByte(uint64_t hash, uint8_t byte)
+    {
+        return (hash ^ byte) * kHashPrime;
+    }
+
+    uint32_t ReadUInt(const uint8_t* data)
+    {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint64_t ReadULong(const uint8_t* data)
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}
+
+/*static*/ uint64_t CookCache::MakeKey(const std::string& name, const uint8_t* source, uint32_t sourceLength)
+{
+    // Asset names are case-insensitive, so hash the name lower-cased.
+    uint64_t hash = kHashOffsetBasis;
+    for(char c : name)
+    {
+        hash = HashByte(hash, static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(c))));
+    }
+
+    // Separate name from contents, so "AB" + "C" and "A" + "BC" don't collide.
+    hash = HashByte(hash, 0);
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        hash = HashByte(hash, static_cast<uint8_t>(sourceLength >> (i * 8)));
+    }
+    for(uint32_t i = 0; i < sourceLength; ++i)
+    {
+        hash = HashByte(hash, source[i]);
+    }
+    return hash;
+}
+
+void CookCache::Load(const std::string& filePath)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFilePath = filePath;
+    mFileData.clear();
+    mFileEntryCount = 0;
+    mFileEntryUsed.clear();
+    mUsedFileDataSize = 0;
+
+    // A missing file is fine - it'll be created on save.
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    if(!file.good()) { return; }
+    mFileData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    // Validate the header. If anything is off, throw out the whole file.
+    if(mFileData.size() < kHeaderSize ||
+       memcmp(mFileData.data(), kIdentifier, strlen(kIdentifier)) != 0 ||
+       ReadUInt(mFileData.data() + 8) != kFormatVersion)
+    {
+        mFileData.clear();
+        return;
+    }
+
+    // Validate the table, and every entry's data range.
+    uint32_t entryCount = ReadUInt(mFileData.data() + 12);
+    uint64_t tableEnd = kHeaderSize + static_cast<uint64_t>(entryCount) * kTableEntrySize;
+    if(tableEnd > mFileData.size())
+    {
+        mFileData.clear();
+        return;
+    }
+    for(uint32_t i = 0; i < entryCount; ++i)
+    {
+        const uint8_t* tableEntry = mFileData.data() + kHeaderSize + i * kTableEntrySize;
+        uint64_t dataEnd = static_cast<uint64_t>(ReadUInt(tableEntry + 8)) + ReadUInt(tableEntry + 12);
+        if(dataEnd > mFileData.size())
+        {
+            mFileData.clear();
+            return;
+        }
+    }
+    mFileEntryCount = entryCount;
+    mFileEntryUsed.resize(entryCount);
+}
+
+bool CookCache::Save()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(!IsEnabled() || mStoredEntries.Empty()) { return true; }
+
+    // Gather all entries - those loaded from the file, plus any added since - and sort them by key.
+    struct SaveEntry
+    {
+        uint64_t key = 0;
+        const uint8_t* data = nullptr;
+        uint32_t length = 0;
+    };
+    std::vector<SaveEntry> entries;
+    entries.reserve(mFileEntryCount + mStoredEntries.Size());
+    uint32_t dataSize = 0;
+    for(auto& entry : mStoredEntries)
+    {
+        entries.push_back({ entry.first, entry.second.data, entry.second.length });
+        dataSize += entry.second.length;
+    }
+
+    // File entries used this run come next. Unused ones only go in if there's room.
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        bool used = pass == 0;
+        for(uint32_t i = 0; i < mFileEntryCount; ++i)
+        {
+            if(mFileEntryUsed[i] != used) { continue; }
+
+            const uint8_t* tableEntry = mFileData.data() + kHeaderSize + i * kTableEntrySize;
+            uint64_t key = ReadULong(tableEntry);
+            uint32_t length = ReadUInt(tableEntry + 12);
+            if(!mStoredEntries.Contains(key) && (used || dataSize + static_cast<uint64_t>(length) <= kMaxDataSize))
+            {
+                entries.push_back({ key, mFileData.data() + ReadUInt(tableEntry + 8), length });
+                dataSize += length;
+            }
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const SaveEntry& a, const SaveEntry& b) { return a.key < b.key; });
+
+    // Write to a temp file and then swap it in, so a failed write doesn't leave a broken cache behind.
+    std::string tempFilePath = mFilePath + ".tmp";
+    {
+        BinaryWriter writer(tempFilePath.c_str());
+        if(!writer.CanWrite()) { return false; }
+
+        // Header.
+        writer.WriteString(kIdentifier, 8);
+        writer.WriteUInt(kFormatVersion);
+        writer.WriteUInt(static_cast<uint32_t>(entries.size()));
+
+        // Table.
+        uint32_t dataOffset = kHeaderSize + static_cast<uint32_t>(entries.size()) * kTableEntrySize;
+        for(SaveEntry& entry : entries)
+        {
+            writer.WriteULong(entry.key);
+            writer.WriteUInt(dataOffset);
+            writer.WriteUInt(entry.length);
+            dataOffset += entry.length;
+        }
+
+        // Data.
+        for(SaveEntry& entry : entries)
+        {
+            writer.Write(entry.data, entry.length);
+        }
+        if(!writer.CanWrite()) { return false; }
+    }
+    std::remove(mFilePath.c_str());
+    return std::rename(tempFilePath.c_str(), mFilePath.c_str()) == 0;
+}
+
+bool CookCache::Find(uint64_t key, const uint8_t*& outData, uint32_t& outLength)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(!IsEnabled()) { return false; }
+
+    const StoredEntry* storedEntry = mStoredEntries.Find(key);
+    if(storedEntry != nullptr)
+    {
+        outData = storedEntry->data;
+        outLength = storedEntry->length;
+        return true;
+    }
+    return FindInFile(key, outData, outLength);
+}
+
+void CookCache::Store(uint64_t key, const uint8_t* data, uint32_t length)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(!IsEnabled() || mStoredEntries.Contains(key)) { return; }
+
+    // Data used this run is always kept, so once that fills the cache, there's no room for more.
+    if(static_cast<uint64_t>(mUsedFileDataSize) + mStoredDataSize + length > kMaxDataSize) { return; }
+
+    mStoredData.emplace_back(data, data + length);
+    StoredEntry& entry = mStoredEntries[key];
+    entry.data = mStoredData.back().data();
+    entry.length = length;
+    mStoredDataSize += length;
+}
+
+bool CookCache::FindInFile(uint64_t key, const uint8_t*& outData, uint32_t& outLength)
+{
+    // The table is sorted by key, so binary search it.
+    uint32_t low = 0;
+    uint32_t high = mFileEntryCount;
+    while(low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        const uint8_t* tableEntry = mFileData.data() + kHeaderSize + mid * kTableEntrySize;
+        uint64_t midKey = ReadULong(tableEntry);
+        if(midKey == key)
+        {
+            outData = mFileData.data() + ReadUInt(tableEntry + 8);
+            outLength = ReadUInt(tableEntry + 12);
+
+            // Remember it was used, so it's kept the next time the cache is saved.
+            if(!mFileEntryUsed[mid])
+            {
+                mFileEntryUsed[mid] = true;
+                mUsedFileDataSize += outLength;
+            }
+            return true;
+        }
+        if(midKey < key)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,84 @@
+//
+// Clark Kromenaker
+//
+// An on-disk cache of "cooked" asset data.
+//
+// Some assets are slow to load from their original form - text-based Sheep, for example, must be run through the compiler every time.
+// The first time such an asset is loaded, its loader can store a compact binary form of the result in this cache.
+// On later runs, the loader finds the cooked data and skips the slow path entirely.
+//
+// Entries are keyed by a hash of the asset's name and source bytes. If an asset changes (e.g. a different Barn), it just misses the cache.
+// The cache file also has a format version. Bump it whenever any cooked format changes, and all old entries are thrown out.
+//
+// The cache's data is capped in size. When saving, entries used during this run are kept first. Unused entries only fill any space left over.
+// So, entries for assets that are gone (e.g. from an older Barn) eventually fall out of the cache.
+//
+// The cache file is laid out to be used directly from memory: a header, a table of entries sorted by key, and then each entry's bytes.
+// Entries loaded from the file are never copied or unpacked - lookups binary search the table and return pointers into the file data.
+//
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FlatMap.h"
+
+class CookCache
+{
+public:
+    // Bump this when any cooked data format changes.
+    static const uint32_t kFormatVersion = 1;
+
+    // Cooked data (not counting the header and table) is kept under this size.
+    static const uint32_t kMaxDataSize = 16 * 1024 * 1024;
+
+    // Generates a key from an asset's name (case-insensitive) and source bytes.
+    static uint64_t MakeKey(const std::string& name, const uint8_t* source, uint32_t sourceLength);
+
+    // Enables the cache, loading any existing entries from the given file.
+    // If the file is missing, or from a different format version, the cache starts empty.
+    void Load(const std::string& filePath);
+
+    // Writes the cache back to its file, if anything was added. Returns false if the write failed.
+    bool Save();
+
+    // The cache does nothing until it has been loaded.
+    bool IsEnabled() const { return !mFilePath.empty(); }
+
+    // Finds cooked data for a key. The data remains valid for the lifetime of the cache.
+    bool Find(uint64_t key, const uint8_t*& outData, uint32_t& outLength);
+
+    // Adds cooked data for a key. The data is copied. If the cache is full of data used this run, nothing is stored.
+    void Store(uint64_t key, const uint8_t* data, uint32_t length);
+
+private:
+    // The cache file to load from and save to.
+    std::string mFilePath;
+
+    // The contents of the cache file, as loaded.
+    std::vector<uint8_t> mFileData;
+    uint32_t mFileEntryCount = 0;
+
+    // Whether each entry in the file was used this run.
+    std::vector<bool> mFileEntryUsed;
+    uint32_t mUsedFileDataSize = 0;
+
+    // Entries added since the file was loaded. A deque, so stored data never moves.
+    struct StoredEntry
+    {
+        const uint8_t* data = nullptr;
+        uint32_t length = 0;
+    };
+    FlatMap<uint64_t, StoredEntry> mStoredEntries;
+    std::deque<std::vector<uint8_t>> mStoredData;
+    uint32_t mStoredDataSize = 0;
+
+    // Assets may be loaded on background threads.
+    std::mutex mMutex;
+
+    bool FindInFile(uint64_t key, const uint8_t*& outData, uint32_t& outLength);
+};
+
+extern CookCache gCookCache;
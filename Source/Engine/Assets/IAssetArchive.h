@@ -9,6 +9,8 @@
 #include <functional>
 #include <string>
 
+#include "Asset.h"
+
 class IAssetArchive
 {
 public:
@@ -16,4 +18,9 @@ public:
     virtual const std::string& GetName() const = 0;
     virtual uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize) const = 0;
     virtual void ForEachAsset(const std::function<void(const std::string&)>& callback) const = 0;
+
+    // Streaming: returns true if the archive contains the asset (must agree with CreateAssetBuffer).
+    // If the asset's data can be read in pieces (e.g. it isn't compressed), the stream info is filled in.
+    virtual bool GetAssetStreamInfo(const std::string& assetName, AssetStreamInfo& outStreamInfo) const = 0;
+    virtual uint32_t ReadAssetStream(const AssetStreamInfo& streamInfo, uint32_t position, uint8_t* buffer, uint32_t count) const = 0;
 };
\ No newline at end of file
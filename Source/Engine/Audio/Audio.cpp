@@ -4,6 +4,7 @@
 
 #include "AudioManager.h"
 #include "BinaryReader.h"
+#include "IAssetArchive.h"
 #include "ReportManager.h"
 
 TYPEINFO_INIT(Audio, Asset, GENERATE_TYPE_ID)
@@ -21,6 +22,20 @@ Audio::~Audio()
 
 void Audio::Load(AssetData& data)
 {
+    // If streaming, we don't have the data - only the info needed to read it later.
+    // The audio manager will read the data as it plays, but we still need the header to retrieve some info, like duration.
+    if(data.stream.IsValid())
+    {
+        mStreamInfo = data.stream;
+
+        // The header is at the start of the file, and is normally much smaller than this.
+        uint8_t header[kMaxHeaderSize];
+        uint32_t headerSize = mStreamInfo.archive->ReadAssetStream(mStreamInfo, 0, header, kMaxHeaderSize);
+        BinaryReader reader(header, headerSize);
+        ParseHeader(reader);
+        return;
+    }
+
     // Take ownership of the data buffer.
     mDataBuffer = data.bytes.release();
     mDataBufferLength = data.length;
@@ -28,7 +43,11 @@ void Audio::Load(AssetData& data)
     // The audio manager can read this data as-is (it's just WAV data).
     // But parsing it can be helpful to retrieve some info, like duration, for later use.
     BinaryReader reader(mDataBuffer, mDataBufferLength);
+    ParseHeader(reader);
+}
 
+void Audio::ParseHeader(BinaryReader& reader)
+{
     // First 4 bytes: chunk ID "RIFF".
     std::string identifier = reader.ReadString(4);
     if(identifier != "RIFF")
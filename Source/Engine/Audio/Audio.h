@@ -8,10 +8,17 @@
 
 #include <string>
 
+class BinaryReader;
+
 class Audio : public Asset
 {
     TYPEINFO_SUB(Audio, Asset);
 public:
+    // Big audio files (mainly music, ambient, and long VO) are streamed from their archive rather than loaded into memory.
+    // Smaller files are read when loaded (usually on the loading thread), so playing them doesn't have to read from the archive.
+    static constexpr uint32_t kStreamingThreshold = 256 * 1024;
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Audio;
+
     Audio(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~Audio() override;
 
@@ -20,16 +27,28 @@ public:
     uint8_t* GetDataBuffer() const { return mDataBuffer; }
     uint32_t GetDataBufferLength() const { return mDataBufferLength; }
 
+    // If streamable, there's no data buffer - data must be read from the stream as needed.
+    bool IsStreamable() const { return mStreamInfo.IsValid(); }
+    const AssetStreamInfo& GetStreamInfo() const { return mStreamInfo; }
+
     float GetDuration() const { return mDuration; }
 
 private:
     const unsigned short kFormatPCM = 0x0001;
+
+    // When streaming, how much of the file to read to parse the header.
+    static const uint32_t kMaxHeaderSize = 512;
     //const unsigned short kMp3Format = 0x0055;
 
     // Audio data buffer - the contents of WAV file in memory.
     uint8_t* mDataBuffer = nullptr;
     uint32_t mDataBufferLength = 0;
 
+    // If the audio is streamable, identifies where to read the audio data from.
+    AssetStreamInfo mStreamInfo;
+
     // The length of the audio file, calculated from taking (data size / samples per second).
     float mDuration = 0.0f;
+
+    void ParseHeader(BinaryReader& reader);
 };
\ No newline at end of file
@@ -9,12 +9,57 @@
 #include "Audio.h"
 #include "GEngine.h"
 #include "GMath.h"
+#include "IAssetArchive.h"
 #include "Profiler.h"
 #include "ReportManager.h"
 #include "SaveManager.h"
 
 AudioManager gAudioManager;
 
+namespace
+{
+    // Streaming audio is read from an asset archive using FMOD's custom file callbacks.
+    // FMOD calls these from its own threads, so all state needed to read is kept in the handle.
+    struct AudioStreamHandle
+    {
+        AssetStreamInfo streamInfo;
+        uint32_t position = 0;
+    };
+
+    FMOD_RESULT F_CALLBACK AudioStreamOpen(const char* name, unsigned int* fileSize, void** handle, void* userData)
+    {
+        // User data is the Audio's stream info. Copy it, since the Audio may be deleted before the stream is closed.
+        AudioStreamHandle* streamHandle = new AudioStreamHandle();
+        streamHandle->streamInfo = *static_cast<AssetStreamInfo*>(userData);
+        *fileSize = streamHandle->streamInfo.size;
+        *handle = streamHandle;
+        return FMOD_OK;
+    }
+
+    FMOD_RESULT F_CALLBACK AudioStreamClose(void* handle, void* userData)
+    {
+        delete static_cast<AudioStreamHandle*>(handle);
+        return FMOD_OK;
+    }
+
+    FMOD_RESULT F_CALLBACK AudioStreamRead(void* handle, void* buffer, unsigned int sizeBytes, unsigned int* bytesRead, void* userData)
+    {
+        AudioStreamHandle* streamHandle = static_cast<AudioStreamHandle*>(handle);
+        const AssetStreamInfo& streamInfo = streamHandle->streamInfo;
+        *bytesRead = streamInfo.archive->ReadAssetStream(streamInfo, streamHandle->position, static_cast<uint8_t*>(buffer), sizeBytes);
+        streamHandle->position += *bytesRead;
+
+        // FMOD expects to be told if we read less than requested due to hitting the end of the file.
+        return *bytesRead < sizeBytes ? FMOD_ERR_FILE_EOF : FMOD_OK;
+    }
+
+    FMOD_RESULT F_CALLBACK AudioStreamSeek(void* handle, unsigned int position, void* userData)
+    {
+        static_cast<AudioStreamHandle*>(handle)->position = position;
+        return FMOD_OK;
+    }
+}
+
 bool AudioManager::Initialize()
 {
     TIMER_SCOPED("AudioManager::Initialize");
@@ -55,6 +100,9 @@ bool AudioManager::Initialize()
         }
     }
 
+    // Streaming audio is read in chunks of this size. Bigger chunks mean fewer (but longer) reads from the asset archive.
+    mSystem->setStreamBufferSize(kStreamChunkSize, FMOD_TIMEUNIT_RAWBYTES);
+
     // Initialize the FMOD system.
     result = mSystem->init(32, FMOD_INIT_NORMAL, nullptr);
     if(result != FMOD_OK)
@@ -234,18 +282,8 @@ void AudioManager::Update(float deltaTime)
     // So, we can release any waiting FMOD::Sounds if no playing sound is using it.
     for(int i = mWaitingToRelease.size() - 1; i >= 0; --i)
     {
-        bool stillPlaying = false;
-        for(auto& playingSound : mPlayingSounds)
-        {
-            if(playingSound.sound == mWaitingToRelease[i])
-            {
-                stillPlaying = true;
-                break;
-            }
-        }
-
         // Not playing? Release it finally!
-        if(!stillPlaying)
+        if(!IsSoundPlaying(mWaitingToRelease[i]))
         {
             DestroySound(mWaitingToRelease[i]);
 
@@ -254,6 +292,12 @@ void AudioManager::Update(float deltaTime)
         }
     }
 
+    // If too much memory is used by cached SFX, release the least recently used ones.
+    if(mEvictableBytes > kMaxEvictableBytes)
+    {
+        EvictSounds();
+    }
+
     /*
     // For testing fade in/out behavior.
     if(gInputManager.IsKeyLeadingEdge(SDL_SCANCODE_M))
@@ -379,7 +423,7 @@ void AudioManager::Stop(Audio* audio)
         {
             for(auto& sound : mPlayingSounds)
             {
-                if(sound.sound == it->second)
+                if(sound.sound == it->second.sound)
                 {
                     // After stopping, sound is removed from playing sounds during next update loop.
                     Stop(sound);
@@ -441,29 +485,20 @@ void AudioManager::ReleaseAudioData(Audio* audio)
     auto it = mFmodAudioData.find(audio);
     if(it != mFmodAudioData.end())
     {
-        // See if the sound is still playing.
-        bool stillPlaying = false;
-        for(auto& playingSound : mPlayingSounds)
-        {
-            if(playingSound.sound == it->second)
-            {
-                stillPlaying = true;
-                break;
-            }
-        }
-
         // If still playing, add it to list of data to release AFTER done playing.
         // Otherwise, we can release it right now!
-        if(stillPlaying)
+        FMOD::Sound* sound = it->second.sound;
+        if(IsSoundPlaying(sound))
         {
-            mWaitingToRelease.push_back(it->second);
+            mWaitingToRelease.push_back(sound);
         }
         else
         {
-            DestroySound(it->second);
+            DestroySound(sound);
         }
 
         // Erase audio->sound mapping.
+        mEvictableBytes -= it->second.evictableBytes;
         mFmodAudioData.erase(it);
     }
 }
@@ -638,17 +673,16 @@ FMOD::Sound* AudioManager::CreateSound(Audio* audio, AudioType audioType, bool i
     auto it = mFmodAudioData.find(audio);
     if(it != mFmodAudioData.end())
     {
-        return it->second;
+        it->second.lastUsed = ++mSoundUseCounter;
+        return it->second.sound;
     }
 
-    // Need to pass FMOD the length of audio data.
     FMOD_CREATESOUNDEXINFO exinfo;
     memset(&exinfo, 0, sizeof(FMOD_CREATESOUNDEXINFO));
     exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
-    exinfo.length = audio->GetDataBufferLength();
 
     // Determine flags.
-    FMOD_MODE mode = FMOD_OPENMEMORY; // treat passed pointer as memory instead of a filename
+    FMOD_MODE mode = 0;
     if(is3D)
     {
         mode |= FMOD_3D | FMOD_3D_LINEARSQUAREROLLOFF;
@@ -656,22 +690,55 @@ FMOD::Sound* AudioManager::CreateSound(Audio* audio, AudioType audioType, bool i
     mode |= (isLooping ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
 
     // For music and ambient audio, stream it to avoid FPS drops when loading.
-    // To stream the audio, we need to make sure the streaming buffer is never deleted while we're using it.
-    // To achieve this, I'll just make a copy of the audio data.
-    uint8_t* audioBuffer = audio->GetDataBuffer();
-    if(audioType == AudioType::Ambient || audioType == AudioType::Music)
+    // Long VO (big enough that its data was left in the asset archive) is also streamed, so it's never fully in memory.
+    // SFX are never played as streams: a stream can only play once at a time, and SFX commonly overlap themselves.
+    bool createStream = audioType == AudioType::Ambient || audioType == AudioType::Music ||
+                        (audioType == AudioType::VO && audio->IsStreamable());
+    if(createStream)
     {
         mode |= FMOD_CREATESTREAM;
-        audioBuffer = new uint8_t[audio->GetDataBufferLength()];
-        memcpy(audioBuffer, audio->GetDataBuffer(), exinfo.length);
     }
 
-    // Create the sound using the audio data buffer.
+    const char* nameOrData = nullptr;
+    uint8_t* audioBuffer = nullptr;
+    if(audio->IsStreamable())
+    {
+        // Audio data is still in the asset archive. FMOD will read it using these callbacks.
+        // If streaming, it's read in chunks as it plays. Otherwise, it's all read now.
+        nameOrData = audio->GetName().c_str();
+        exinfo.fileuseropen = AudioStreamOpen;
+        exinfo.fileuserclose = AudioStreamClose;
+        exinfo.fileuserread = AudioStreamRead;
+        exinfo.fileuserseek = AudioStreamSeek;
+        exinfo.fileuserdata = const_cast<AssetStreamInfo*>(&audio->GetStreamInfo());
+    }
+    else
+    {
+        // Treat passed pointer as memory instead of a filename. Need to pass FMOD the length of audio data.
+        mode |= FMOD_OPENMEMORY;
+        exinfo.length = audio->GetDataBufferLength();
+
+        // To stream the audio, we need to make sure the streaming buffer is never deleted while we're using it.
+        // To achieve this, I'll just make a copy of the audio data.
+        audioBuffer = audio->GetDataBuffer();
+        if(createStream)
+        {
+            audioBuffer = new uint8_t[audio->GetDataBufferLength()];
+            memcpy(audioBuffer, audio->GetDataBuffer(), exinfo.length);
+        }
+        nameOrData = reinterpret_cast<char*>(audioBuffer);
+    }
+
+    // Create the sound.
     FMOD::Sound* sound = nullptr;
-    FMOD_RESULT result = mSystem->createSound(reinterpret_cast<char*>(audioBuffer), mode, &exinfo, &sound);
+    FMOD_RESULT result = mSystem->createSound(nameOrData, mode, &exinfo, &sound);
     if(result != FMOD_OK)
     {
         LOG_ERROR("Failed to create FMOD sound: %s", FMOD_ErrorString(result));
+        if(audioBuffer != audio->GetDataBuffer())
+        {
+            delete[] audioBuffer;
+        }
         return nullptr;
     }
 
@@ -682,7 +749,18 @@ FMOD::Sound* AudioManager::CreateSound(Audio* audio, AudioType audioType, bool i
     }
 
     // Cache sound for reuse if this Audio is played again.
-    mFmodAudioData[audio] = sound;
+    FmodSound& fmodSound = mFmodAudioData[audio];
+    fmodSound.sound = sound;
+    fmodSound.lastUsed = ++mSoundUseCounter;
+
+    // SFX are fully loaded into FMOD's memory. They're kept around for reuse, but can be released if memory use gets too high.
+    if(!createStream && audioType == AudioType::SFX)
+    {
+        unsigned int length = 0;
+        sound->getLength(&length, FMOD_TIMEUNIT_PCMBYTES);
+        fmodSound.evictableBytes = length;
+        mEvictableBytes += length;
+    }
 
     // Return sound.
     return sound;
@@ -710,6 +788,43 @@ void AudioManager::DestroySound(FMOD::Sound* sound)
     }
 }
 
+bool AudioManager::IsSoundPlaying(FMOD::Sound* sound) const
+{
+    for(auto& playingSound : mPlayingSounds)
+    {
+        if(playingSound.sound == sound)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioManager::EvictSounds()
+{
+    while(mEvictableBytes > kMaxEvictableBytes)
+    {
+        // Find the least recently used sound that can be evicted. Playing sounds can't be evicted.
+        auto lruIt = mFmodAudioData.end();
+        for(auto it = mFmodAudioData.begin(); it != mFmodAudioData.end(); ++it)
+        {
+            if(it->second.evictableBytes > 0 && (lruIt == mFmodAudioData.end() || it->second.lastUsed < lruIt->second.lastUsed) &&
+               !IsSoundPlaying(it->second.sound))
+            {
+                lruIt = it;
+            }
+        }
+
+        // Everything evictable is playing, so nothing more can be done for now.
+        if(lruIt == mFmodAudioData.end()) { break; }
+
+        // Release the FMOD sound. The Audio asset is still loaded, so the sound is just recreated if played again.
+        mEvictableBytes -= lruIt->second.evictableBytes;
+        DestroySound(lruIt->second.sound);
+        mFmodAudioData.erase(lruIt);
+    }
+}
+
 FMOD::ChannelGroup* AudioManager::GetChannelGroupForAudioType(AudioType audioType) const
 {
     switch(audioType)
@@ -140,7 +140,26 @@ private:
 
     // Mapping from Audio assets to FMOD's internal sound instances.
     // This mapping stops us from creating multiple FMOD sounds for a single Audio (essentially a memory leak).
-    std::unordered_map<Audio*, FMOD::Sound*> mFmodAudioData;
+    struct FmodSound
+    {
+        FMOD::Sound* sound = nullptr;
+
+        // Value of the use counter when this sound was last played. Used to find the least recently used sound.
+        uint32_t lastUsed = 0;
+
+        // For short SFX loaded fully into FMOD's memory, the size of that memory.
+        // These sounds can be released when not recently used, even though the Audio asset is still loaded.
+        uint32_t evictableBytes = 0;
+    };
+    std::unordered_map<Audio*, FmodSound> mFmodAudioData;
+    uint32_t mSoundUseCounter = 0;
+
+    // Total evictable bytes in FMOD sounds, and the max we'll allow before releasing least recently used sounds.
+    uint32_t mEvictableBytes = 0;
+    static constexpr uint32_t kMaxEvictableBytes = 8 * 1024 * 1024;
+
+    // When streaming audio from an asset archive, how many bytes FMOD reads at a time.
+    static constexpr unsigned int kStreamChunkSize = 64 * 1024;
 
     // When an Audio asset is deleted, we want to release the underlying FMOD sound data too.
     // However, if the sound is still playing, we don't want to release until it ends or stops.
@@ -148,6 +167,8 @@ private:
 
     FMOD::Sound* CreateSound(Audio* audio, AudioType audioType, bool is3D, bool isLooping);
     void DestroySound(FMOD::Sound* sound);
+    bool IsSoundPlaying(FMOD::Sound* sound) const;
+    void EvictSounds();
 
     FMOD::ChannelGroup* GetChannelGroupForAudioType(AudioType audioType) const;
     FMOD::Channel* CreateChannel(FMOD::Sound* sound, FMOD::ChannelGroup* channelGroup);
@@ -0,0 +1,213 @@
+//
+// Clark Kromenaker
+//
+// A hash map that stores its entries in one flat array, using open addressing with linear probing.
+//
+// Compared to std::unordered_map, there's no per-entry allocation and lookups touch far less memory.
+// This works best for small keys that are cheap to hash and compare (integers, IDs, small structs of those).
+//
+// Characteristics:
+// - Entries are std::pair<TKey, TValue>, so iteration looks like iterating an STL map (entry.first, entry.second).
+// - Inserting or erasing may move entries, so pointers/iterators are invalidated by any modification.
+// - Iteration order is unspecified.
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+template<typename TKey, typename TValue, typename THash = std::hash<TKey>>
+class FlatMap
+{
+public:
+    using Entry = std::pair<TKey, TValue>;
+
+    // Iterates only the occupied slots.
+    template<typename TMap, typename TEntry>
+    class IteratorBase
+    {
+    public:
+        IteratorBase(TMap* map, size_t index) : mMap(map), mIndex(index) { SkipEmpty(); }
+
+        TEntry& operator*() const { return mMap->mSlots[mIndex]; }
+        TEntry* operator->() const { return &mMap->mSlots[mIndex]; }
+
+        IteratorBase& operator++() { ++mIndex; SkipEmpty(); return *this; }
+        bool operator==(const IteratorBase& other) const { return mIndex == other.mIndex; }
+        bool operator!=(const IteratorBase& other) const { return mIndex != other.mIndex; }
+
+    private:
+        TMap* mMap = nullptr;
+        size_t mIndex = 0;
+
+        void SkipEmpty()
+        {
+            while(mIndex < mMap->mSlots.size() && !mMap->mOccupied[mIndex])
+            {
+                ++mIndex;
+            }
+        }
+    };
+    using Iterator = IteratorBase<FlatMap, Entry>;
+    using ConstIterator = IteratorBase<const FlatMap, const Entry>;
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, mSlots.size()); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, mSlots.size()); }
+
+    // Returns a pointer to the value for a key, or null if the key isn't in the map.
+    TValue* Find(const TKey& key)
+    {
+        size_t index = 0;
+        return FindSlot(key, index) ? &mSlots[index].second : nullptr;
+    }
+
+    const TValue* Find(const TKey& key) const
+    {
+        size_t index = 0;
+        return FindSlot(key, index) ? &mSlots[index].second : nullptr;
+    }
+
+    bool Contains(const TKey& key) const
+    {
+        size_t index = 0;
+        return FindSlot(key, index);
+    }
+
+    // Returns the value for a key, adding a default-constructed value if the key isn't in the map.
+    TValue& operator[](const TKey& key)
+    {
+        size_t index = 0;
+        if(FindSlot(key, index))
+        {
+            return mSlots[index].second;
+        }
+
+        // Grow if this insert would push us past the max load factor (3/4).
+        if((mSize + 1) * 4 > mSlots.size() * 3)
+        {
+            Rehash(mSlots.empty() ? 16 : mSlots.size() * 2);
+            FindSlot(key, index);
+        }
+
+        // FindSlot leaves index at the empty slot where this key belongs.
+        mSlots[index].first = key;
+        mSlots[index].second = TValue();
+        mOccupied[index] = true;
+        ++mSize;
+        return mSlots[index].second;
+    }
+
+    // Removes a key from the map. Returns true if it was present.
+    bool Erase(const TKey& key)
+    {
+        size_t index = 0;
+        if(!FindSlot(key, index)) { return false; }
+
+        // Rather than leaving a "tombstone," shift later entries in the probe sequence back to fill the hole.
+        // This keeps lookups fast no matter how many erases have happened.
+        size_t mask = mSlots.size() - 1;
+        size_t hole = index;
+        size_t next = (hole + 1) & mask;
+        while(mOccupied[next])
+        {
+            // An entry can move into the hole only if the hole is between its ideal slot and where it is now.
+            size_t ideal = GetIdealSlot(mSlots[next].first);
+            if(((next - ideal) & mask) >= ((next - hole) & mask))
+            {
+                mSlots[hole] = std::move(mSlots[next]);
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        mSlots[hole] = Entry();
+        mOccupied[hole] = false;
+        --mSize;
+        return true;
+    }
+
+    void Clear()
+    {
+        for(size_t i = 0; i < mSlots.size(); ++i)
+        {
+            mSlots[i] = Entry();
+            mOccupied[i] = false;
+        }
+        mSize = 0;
+    }
+
+    // Makes room for at least this many entries without rehashing.
+    void Reserve(size_t count)
+    {
+        size_t slotCount = mSlots.empty() ? 16 : mSlots.size();
+        while(count * 4 > slotCount * 3)
+        {
+            slotCount *= 2;
+        }
+        if(slotCount > mSlots.size())
+        {
+            Rehash(slotCount);
+        }
+    }
+
+    size_t Size() const { return mSize; }
+    bool Empty() const { return mSize == 0; }
+
+private:
+    // Slots are either occupied or empty. Slot count is always zero or a power of two.
+    std::vector<Entry> mSlots;
+    std::vector<bool> mOccupied;
+    size_t mSize = 0;
+
+    size_t GetIdealSlot(const TKey& key) const
+    {
+        // Keys are often small sequential integers, so scramble the hash (Fibonacci hashing) to spread them across the table.
+        uint64_t hash = static_cast<uint64_t>(THash()(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(hash >> 32) & (mSlots.size() - 1);
+    }
+
+    // Returns true if the key is found, with index set to its slot.
+    // Otherwise, returns false, with index set to the empty slot where the key would go.
+    bool FindSlot(const TKey& key, size_t& index) const
+    {
+        if(mSlots.empty()) { return false; }
+
+        size_t mask = mSlots.size() - 1;
+        index = GetIdealSlot(key);
+        while(mOccupied[index])
+        {
+            if(mSlots[index].first == key)
+            {
+                return true;
+            }
+            index = (index + 1) & mask;
+        }
+        return false;
+    }
+
+    void Rehash(size_t slotCount)
+    {
+        std::vector<Entry> oldSlots(slotCount);
+        std::vector<bool> oldOccupied(slotCount, false);
+        oldSlots.swap(mSlots);
+        oldOccupied.swap(mOccupied);
+
+        // Reinsert all entries in the bigger table.
+        size_t mask = mSlots.size() - 1;
+        for(size_t i = 0; i < oldSlots.size(); ++i)
+        {
+            if(!oldOccupied[i]) { continue; }
+
+            size_t index = GetIdealSlot(oldSlots[i].first);
+            while(mOccupied[index])
+            {
+                index = (index + 1) & mask;
+            }
+            mSlots[index] = std::move(oldSlots[i]);
+            mOccupied[index] = true;
+        }
+    }
+};
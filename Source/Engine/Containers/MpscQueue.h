@@ -0,0 +1,120 @@
+//
+// Clark Kromenaker
+//
+// A lock-free queue for passing elements from any number of producer threads to exactly one consumer thread.
+// Uses a fixed-size array of pre-constructed elements internally, which are reused as the queue wraps around.
+//
+// Each slot has a sequence number that says whether it's ready to be written or read, and for which "lap" of the array.
+// Producers claim a slot by advancing the shared tail with a compare-and-swap, then publish it by bumping the slot's sequence.
+//
+// Usage:
+// - Producers: call TryPush to move an element into the queue.
+// - Consumer: call PeekReadable to get the oldest element, read it, then call Pop to give the slot back to the producers.
+//
+// Characteristics:
+// - Fixed size: max container size must be known at compile time.
+// - Thread-safe for many producers and ONE consumer.
+// - Non-blocking: if the queue is full or empty, functions fail/return null. Callers decide whether/how to wait.
+//
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+template<typename T, uint32_t TCapacity>
+class MpscQueue
+{
+    // Counters wrap at uint32 max, so capacity must divide evenly into that for indexes to stay consistent.
+    static_assert(TCapacity > 0 && (TCapacity & (TCapacity - 1)) == 0, "MpscQueue capacity must be a power of two");
+public:
+    MpscQueue()
+    {
+        // Each slot starts out writable for the first lap.
+        for(uint32_t i = 0; i < TCapacity; ++i)
+        {
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Producer: moves value into the queue. Returns false (and leaves value alone) if the queue is full.
+    bool TryPush(T& value)
+    {
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+        while(true)
+        {
+            Slot& slot = mSlots[tail % TCapacity];
+            int32_t diff = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - tail);
+            if(diff == 0)
+            {
+                // Slot is free for this lap - try to claim it. If another producer beats us to it, tail is updated and we try again.
+                if(mTail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff < 0)
+            {
+                // Slot still holds an element from the previous lap that the consumer hasn't popped - queue is full.
+                return false;
+            }
+            else
+            {
+                // Another producer claimed this slot - catch up.
+                tail = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer: returns the oldest element in the queue, or null if the queue is empty.
+    // An element may not be readable yet if a producer has claimed a slot but not finished writing it.
+    T* PeekReadable()
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        Slot& slot = mSlots[head % TCapacity];
+        if(slot.sequence.load(std::memory_order_acquire) != head + 1)
+        {
+            return nullptr;
+        }
+        return &slot.value;
+    }
+
+    // Consumer: gives the slot returned by PeekReadable back to the producers.
+    void Pop()
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        mSlots[head % TCapacity].sequence.store(head + TCapacity, std::memory_order_release);
+        mHead.store(head + 1, std::memory_order_relaxed);
+    }
+
+    // A snapshot of the number of claimed slots. May be out of date by the time it's used.
+    uint32_t Size() const
+    {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+
+    uint32_t Capacity() const
+    {
+        return TCapacity;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+private:
+    struct Slot
+    {
+        // Equals the slot's index + (lap * capacity) when writable, and one more than that when readable.
+        std::atomic<uint32_t> sequence { 0 };
+        T value;
+    };
+    Slot mSlots[TCapacity];
+
+    // Head/tail are ever-increasing counters (wrapping at uint32 max), and are modded by capacity to get an index.
+    // Head is written only by the consumer, tail by all producers. Each gets its own cache line to avoid false sharing.
+    alignas(64) std::atomic<uint32_t> mHead { 0 };
+    alignas(64) std::atomic<uint32_t> mTail { 0 };
+};
@@ -0,0 +1,95 @@
+//
+// Clark Kromenaker
+//
+// A lock-free queue for passing elements from exactly one producer thread to exactly one consumer thread.
+// Uses a fixed-size array of pre-constructed elements internally, which are reused as the queue wraps around.
+//
+// Because elements are reused rather than constructed/destructed, usage is "peek, fill, commit":
+// - Producer: call PeekWritable to get a free slot, fill it in, then call Push to make it visible to the consumer.
+// - Consumer: call PeekReadable to get the oldest element, read it, then call Pop to give the slot back to the producer.
+//
+// Characteristics:
+// - Fixed size: max container size must be known at compile time.
+// - Contiguous: elements are contiguous in memory.
+// - Thread-safe ONLY for one producer and one consumer. Any other usage requires external synchronization.
+// - Non-blocking: if the queue is full or empty, peek functions return null. Callers decide whether/how to wait.
+//
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+template<typename T, uint32_t TCapacity>
+class SpscQueue
+{
+    // Counters wrap at uint32 max, so capacity must divide evenly into that for indexes to stay consistent.
+    static_assert(TCapacity > 0 && (TCapacity & (TCapacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+public:
+    // Producer: returns the next slot to write to, or null if the queue is full.
+    T* PeekWritable()
+    {
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+        if(tail - mHead.load(std::memory_order_acquire) >= TCapacity)
+        {
+            return nullptr;
+        }
+        return &mData[tail % TCapacity];
+    }
+
+    // Producer: makes the slot returned by PeekWritable visible to the consumer.
+    void Push()
+    {
+        mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: returns the oldest element in the queue, or null if the queue is empty.
+    T* PeekReadable()
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        if(head == mTail.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &mData[head % TCapacity];
+    }
+
+    // Consumer: gives the slot returned by PeekReadable back to the producer.
+    void Pop()
+    {
+        mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Size is exact when called from the producer or consumer with the other side idle.
+    // Otherwise, it's a snapshot that may be out of date by the time it's used.
+    uint32_t Size() const
+    {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+
+    uint32_t Capacity() const
+    {
+        return TCapacity;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    bool Full() const
+    {
+        return Size() >= TCapacity;
+    }
+
+    // Elements can be accessed directly by index, for setup/teardown when no other threads are using the queue.
+    T& operator[](uint32_t i) { return mData[i]; }
+
+private:
+    // Storage for elements. Elements are constructed once and reused.
+    T mData[TCapacity];
+
+    // Head/tail are ever-increasing counters (wrapping at uint32 max), and are modded by capacity to get an index.
+    // This avoids needing to waste a slot to tell "full" from "empty."
+    // Head is written only by the consumer, tail only by the producer. Each gets its own cache line to avoid false sharing.
+    alignas(64) std::atomic<uint32_t> mHead { 0 };
+    alignas(64) std::atomic<uint32_t> mTail { 0 };
+};
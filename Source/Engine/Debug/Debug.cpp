@@ -8,6 +8,7 @@
 #include "Material.h"
 #include "Matrix4.h"
 #include "Mesh.h"
+#include "MeshDefinition.h"
 #include "Plane.h"
 #include "Rect.h"
 #include "Renderer.h"
@@ -17,12 +18,14 @@
 #include "Triangle.h"
 #include "Vector3.h"
 
-extern Mesh* line;
-extern Mesh* axes;
-
-std::list<DrawCommand> Debug::sDrawCommands;
+std::vector<DebugLine> Debug::sDrawLines;
 Shader* Debug::sDrawShader = nullptr;
 
+Mesh* Debug::sLinesMesh = nullptr;
+uint32_t Debug::sLinesMeshVertexCapacity = 0;
+std::vector<float> Debug::sLinePositions;
+std::vector<float> Debug::sLineColors;
+
 FlagSet Debug::sDebugFlags;
 
 // Default debug settings.
@@ -42,10 +45,10 @@ void Debug::Init()
 
 void Debug::Update(float deltaTime)
 {
-    // Decrement timers in all draw commands.
-    for(auto& command : sDrawCommands)
+    // Decrement timers in all queued lines.
+    for(auto& line : sDrawLines)
     {
-        command.timer -= deltaTime;
+        line.timer -= deltaTime;
     }
 
     // Check for debug setting inputs.
@@ -76,52 +79,94 @@ void Debug::Render()
         sDrawShader = ShaderCache::LoadShader("Color", "Uber", { });
     }
 
-    // We can just use any old material for now (uses default shader under the hood).
-    Material material(sDrawShader);
-    material.SetFloat("gDiscardColorTolerance", -1.0f); // disables discard color - we want magenta to render in this case
+    // Nothing to do if no lines are queued.
+    if(sDrawLines.empty()) { return; }
 
-    // Iterate over all draw commands and render them.
-    auto it = sDrawCommands.begin();
-    while(it != sDrawCommands.end())
+    // Make sure the lines mesh is big enough to hold all queued lines. If not, recreate it at a larger size.
+    uint32_t vertexCount = static_cast<uint32_t>(sDrawLines.size() * 2);
+    if(sLinesMesh == nullptr || vertexCount > sLinesMeshVertexCapacity)
     {
-        DrawCommand& command = *it;
+        delete sLinesMesh;
 
-        // Set color and world transform.
-        material.SetColor(command.color);
-        material.Activate(command.worldTransformMatrix);
-
-        // Draw the mesh.
-        if(command.mesh != nullptr)
+        // Grow by doubling to avoid recreating the mesh every time a few more lines are added.
+        sLinesMeshVertexCapacity = Math::Max(sLinesMeshVertexCapacity * 2, 1024U);
+        while(sLinesMeshVertexCapacity < vertexCount)
         {
-            command.mesh->Render();
+            sLinesMeshVertexCapacity *= 2;
         }
+        sLinePositions.resize(sLinesMeshVertexCapacity * 3);
+        sLineColors.resize(sLinesMeshVertexCapacity * 4);
+
+        MeshDefinition meshDefinition(MeshUsage::Dynamic, sLinesMeshVertexCapacity);
+        meshDefinition.SetVertexLayout(VertexLayout::Packed);
+        meshDefinition.AddVertexData(VertexAttribute::Position, new float[sLinesMeshVertexCapacity * 3]);
+        meshDefinition.AddVertexData(VertexAttribute::Color, new float[sLinesMeshVertexCapacity * 4]);
+
+        sLinesMesh = new Mesh();
+        Submesh* submesh = sLinesMesh->AddSubmesh(meshDefinition);
+        submesh->SetRenderMode(RenderMode::Lines);
+    }
 
-        // Erase from list if time is up.
-        if(command.timer <= 0.0f)
+    // Expand all lines into a single vertex stream.
+    float* positions = sLinePositions.data();
+    float* colors = sLineColors.data();
+    for(const DebugLine& line : sDrawLines)
+    {
+        positions[0] = line.from.x;
+        positions[1] = line.from.y;
+        positions[2] = line.from.z;
+        positions[3] = line.to.x;
+        positions[4] = line.to.y;
+        positions[5] = line.to.z;
+        positions += 6;
+
+        for(int i = 0; i < 2; ++i)
         {
-            it = sDrawCommands.erase(it);
+            colors[0] = line.color.r / 255.0f;
+            colors[1] = line.color.g / 255.0f;
+            colors[2] = line.color.b / 255.0f;
+            colors[3] = line.color.a / 255.0f;
+            colors += 4;
         }
-        else
+    }
+    Submesh* submesh = sLinesMesh->GetSubmesh(0);
+    submesh->SetPositions(sLinePositions.data());
+    submesh->SetColors(sLineColors.data());
+
+    // Line colors come from vertex colors, so the material color stays white.
+    // Line positions are already in world space, so no world transform is needed either.
+    Material material(sDrawShader);
+    material.SetFloat("gDiscardColorTolerance", -1.0f); // disables discard color - we want magenta to render in this case
+    material.SetColor(Color32::White);
+    material.Activate(Matrix4::Identity);
+
+    // Draw all lines in one go.
+    sLinesMesh->Render(0, 0, vertexCount);
+
+    // Remove lines whose time is up in a single pass, preserving order of the rest.
+    size_t keepCount = 0;
+    for(size_t i = 0; i < sDrawLines.size(); ++i)
+    {
+        if(sDrawLines[i].timer > 0.0f)
         {
-            it++;
+            if(keepCount != i)
+            {
+                sDrawLines[keepCount] = sDrawLines[i];
+            }
+            ++keepCount;
         }
     }
+    sDrawLines.resize(keepCount);
 }
 
 void Debug::DrawLine(const Vector3& from, const Vector3& to, const Color32& color, float duration)
 {
-    // The line "starts at" the from position.
-    // Scale the line to the end point with appropriate scale matrix.
-    Matrix4 translateMatrix = Matrix4::MakeTranslate(from);
-    Matrix4 scaleMatrix = Matrix4::MakeScale(to - from);
-
-    // Combine in order (Scale, Rotate, Translate) to generate world transform matrix.
-    DrawCommand command;
-    command.mesh = line;
-    command.worldTransformMatrix = translateMatrix * scaleMatrix;
-    command.color = color;
-    command.timer = duration;
-    sDrawCommands.push_back(command);
+    DebugLine line;
+    line.from = from;
+    line.to = to;
+    line.color = color;
+    line.timer = duration;
+    sDrawLines.push_back(line);
 }
 
 void Debug::DrawAxes(const Vector3& position, float duration)
@@ -131,11 +176,12 @@ void Debug::DrawAxes(const Vector3& position, float duration)
 
 void Debug::DrawAxes(const Matrix4& worldTransform, float duration)
 {
-    DrawCommand command;
-    command.mesh = axes;
-    command.worldTransformMatrix = worldTransform;
-    command.timer = duration;
-    sDrawCommands.push_back(command);
+    // Draw a short line along each axis, colored red/green/blue for x/y/z.
+    const float kAxisLength = 5.0f;
+    Vector3 origin = worldTransform.TransformPoint(Vector3::Zero);
+    DrawLine(origin, worldTransform.TransformPoint(Vector3::UnitX * kAxisLength), Color32::Red, duration);
+    DrawLine(origin, worldTransform.TransformPoint(Vector3::UnitY * kAxisLength), Color32::Green, duration);
+    DrawLine(origin, worldTransform.TransformPoint(Vector3::UnitZ * kAxisLength), Color32::Blue, duration);
 }
 
 void Debug::DrawRect(const Rect& rect, const Color32& color, float duration, const Matrix4* transformMatrix)
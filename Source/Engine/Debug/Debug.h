@@ -4,11 +4,12 @@
 // Provides some functions for debugging and visualizing constructs in 3D space.
 //
 #pragma once
-#include <list>
+#include <vector>
 
 #include "Color32.h"
 #include "FlagSet.h"
 #include "Matrix4.h"
+#include "Vector3.h"
 
 class AABB;
 class Mesh;
@@ -17,15 +18,14 @@ class Rect;
 class Shader;
 class Sphere;
 class Triangle;
-class Vector3;
 
-struct DrawCommand
+struct DebugLine
 {
-    // The mesh to draw.
-    Mesh* mesh = nullptr;
+    // Line endpoints, in world space.
+    Vector3 from;
+    Vector3 to;
 
-    // Parameters for drawing.
-    Matrix4 worldTransformMatrix;
+    // Color of the line.
     Color32 color = Color32::White;
 
     // Tracks how long the line remains visible.
@@ -70,10 +70,17 @@ public:
     static bool RenderAABBs() { return sDebugFlags.Get("ShowBoundingBoxes"); }
 
 private:
-    // Draw commands & shader.
-    static std::list<DrawCommand> sDrawCommands;
+    // All debug shapes are broken down into lines, which are queued here until rendered.
+    static std::vector<DebugLine> sDrawLines;
     static Shader* sDrawShader;
 
+    // Every frame, queued lines are expanded into a single vertex stream and drawn with one draw call.
+    // The mesh is grown as needed, and the staging buffers mirror its size.
+    static Mesh* sLinesMesh;
+    static uint32_t sLinesMeshVertexCapacity;
+    static std::vector<float> sLinePositions;
+    static std::vector<float> sLineColors;
+
     // Debug flags.
     static FlagSet sDebugFlags;
 
@@ -10,11 +10,13 @@
 #include "Clipboard.h"
 #include "Console.h"
 #include "ConsoleUI.h"
+#include "CookCache.h"
 #include "CursorManager.h"
 #include "DataHelper.h"
 #include "Debug.h"
 #include "FileSystem.h"
 #include "FootstepManager.h"
+#include "FrameAllocator.h"
 #include "GameProgress.h"
 #include "GK3UI.h"
 #include "InputManager.h"
@@ -22,6 +24,7 @@
 #include "Loader.h"
 #include "Localizer.h"
 #include "LocationManager.h"
+#include "MemoryTracker.h"
 #include "OSDialog.h"
 #include "Paths.h"
 #include "PersistState.h"
@@ -30,6 +33,7 @@
 #include "Renderer.h"
 #include "SaveManager.h"
 #include "SceneManager.h"
+#include "ScenePrefetcher.h"
 #include "SheepManager.h"
 #include "TextInput.h"
 #include "ThreadPool.h"
@@ -71,9 +75,9 @@ bool GEngine::Initialize()
 {
     TIMER_SCOPED("GEngine::Initialize");
 
-    // Init threads.
+    // Init threads. Thread pool uses a worker thread per core (minus one for the main thread).
     ThreadUtil::Init();
-    ThreadPool::Init(4);
+    ThreadPool::Init();
 
     // Init report streams, for system logging.
     InitReportStreams();
@@ -199,16 +203,26 @@ void GEngine::Shutdown()
 {
     // Need to block main thread until threaded work is done.
     // Otherwise, we might get exceptions during shutdown if main thread exits before background threads.
+    gScenePrefetcher.Shutdown();
     ThreadPool::Shutdown();
     Loader::Shutdown();
 
     // Shutdown scene manager (unloads scene and deletes all actors).
     gSceneManager.Shutdown();
 
+    // Stop any playing audio. Streaming audio reads from asset archives, so it must stop before the asset manager closes them.
+    gAudioManager.StopAll();
+
     // Even though asset manager is initialized first...
     // We want to shut it down earlier b/c its assets may need to destroy data in the rendering/audio systems.
     gAssetManager.Shutdown();
 
+    // Write out anything cooked during this run, so the next run can use it.
+    if(!gCookCache.Save())
+    {
+        LOG_WARNING("Failed to save cook cache.");
+    }
+
     // Shutdown renderer.
     gRenderer.Shutdown();
 
@@ -218,8 +232,14 @@ void GEngine::Shutdown()
     // Shutdown audio system.
     gAudioManager.Shutdown();
 
+    // Free the main thread's frame memory.
+    FrameAllocator::Shutdown();
+
     // Shutdown SDL.
     SDL_Quit();
+
+    // Write out any remaining log messages and stop the logging thread.
+    ShutdownLog();
 }
 
 void GEngine::Run()
@@ -265,6 +285,10 @@ void GEngine::Run()
             // OK, this frame is done!
             ++mFrameNumber;
         }
+
+        // Any frame memory allocated this frame can now be reused.
+        FrameAllocator::EndFrame();
+        MemoryTracker::EndFrame();
         PROFILER_END_FRAME();
     }
 }
@@ -378,6 +402,12 @@ bool GEngine::InitAssetManager()
         }
     }
 
+    // Cooked asset data is cached in the user data folder, unless disabled in the .INI file.
+    if(config == nullptr || config->GetBool("Cook Cache", true))
+    {
+        gCookCache.Load(Paths::GetUserDataPath("Cooked.cache"));
+    }
+
     // Add hard-coded default paths *after* any custom paths specified in .INI file.
     // Assets: loose files that aren't packed into a BRN.
     gAssetManager.AddSearchPath("Assets");
@@ -810,6 +840,9 @@ void GEngine::Update()
 
         // Perform any pending action skips.
         gActionManager.PerformPendingActionSkip();
+
+        // Use idle time to prefetch assets for likely next scenes.
+        gScenePrefetcher.Update();
     }
 
     // Update cursor based on high-level game state.
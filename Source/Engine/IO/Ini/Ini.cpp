@@ -33,62 +33,114 @@ Vector4 IniKeyValue::GetValueAsVector4() const
 }
 
 Color32 IniKeyValue::GetValueAsColor32() const
+{
+    return IniKeyValueView { key, value }.GetValueAsColor32();
+}
+
+Rect IniKeyValue::GetValueAsRect() const
+{
+    return IniKeyValueView { key, value }.GetValueAsRect();
+}
+
+std::unordered_map<std::string, IniKeyValue> IniSection::GetAsMap() const
+{
+    std::unordered_map<std::string, IniKeyValue> map;
+    for(auto& line : lines)
+    {
+        for(auto& entry : line.entries)
+        {
+            map[entry.key] = entry;
+        }
+    }
+    return map;
+}
+
+float IniKeyValueView::GetValueAsFloat() const
+{
+    return StringUtil::ToFloat(value);
+}
+
+int IniKeyValueView::GetValueAsInt() const
+{
+    return StringUtil::ToInt(value);
+}
+
+bool IniKeyValueView::GetValueAsBool() const
+{
+    return StringUtil::ToBool(value);
+}
+
+Vector2 IniKeyValueView::GetValueAsVector2() const
+{
+    return Vector2::Parse(std::string(value));
+}
+
+Vector3 IniKeyValueView::GetValueAsVector3() const
+{
+    return Vector3::Parse(std::string(value));
+}
+
+Vector4 IniKeyValueView::GetValueAsVector4() const
+{
+    return Vector4::Parse(std::string(value));
+}
+
+Color32 IniKeyValueView::GetValueAsColor32() const
 {
     // Assume string form of R/G/B
     std::size_t firstSlashIndex = value.find('/');
-    if(firstSlashIndex == std::string::npos)
+    if(firstSlashIndex == std::string_view::npos)
     {
         return Color32::Black;
     }
     std::size_t secondSlashIndex = value.find('/', firstSlashIndex + 1);
-    if(secondSlashIndex == std::string::npos)
+    if(secondSlashIndex == std::string_view::npos)
     {
         return Color32::Black;
     }
 
     // Split at slashes.
-    std::string firstNum = value.substr(0, firstSlashIndex);
-    std::string secondNum = value.substr(firstSlashIndex + 1, secondSlashIndex - firstSlashIndex - 1);
-    std::string thirdNum = value.substr(secondSlashIndex + 1, std::string::npos);
+    std::string_view firstNum = value.substr(0, firstSlashIndex);
+    std::string_view secondNum = value.substr(firstSlashIndex + 1, secondSlashIndex - firstSlashIndex - 1);
+    std::string_view thirdNum = value.substr(secondSlashIndex + 1);
 
     // Convert to number and return.
-    return Color32(std::stoi(firstNum), std::stoi(secondNum), std::stoi(thirdNum));
+    return Color32(StringUtil::ToInt(firstNum), StringUtil::ToInt(secondNum), StringUtil::ToInt(thirdNum));
 }
 
-Rect IniKeyValue::GetValueAsRect() const
+Rect IniKeyValueView::GetValueAsRect() const
 {
     // We assume the string form of {4.23, 5.23, 10.04, 5.23}
     // Values are in order of x1, z1, x2, z2 for two points.
     // First, let's get rid of the braces.
-    std::string noBraces = value;
-    if(noBraces[0] == '{' && noBraces[noBraces.size() - 1] == '}')
+    std::string_view noBraces = value;
+    if(noBraces.size() >= 2 && noBraces.front() == '{' && noBraces.back() == '}')
     {
-        noBraces = value.substr(1, value.length() - 2);
+        noBraces = noBraces.substr(1, noBraces.size() - 2);
     }
 
     // Split into 4 elements, divided by commas.
     // In at least one instance, errant commas can trip this up, so discard empty elements.
-    std::vector<std::string> elements = StringUtil::Split(noBraces, ',', true);
-    if(elements.size() < 4)
+    float elements[4];
+    int elementCount = 0;
+    while(!noBraces.empty() && elementCount < 4)
+    {
+        size_t commaIndex = noBraces.find(',');
+        std::string_view element = noBraces.substr(0, commaIndex);
+        if(!element.empty())
+        {
+            elements[elementCount] = StringUtil::ToFloat(element);
+            ++elementCount;
+        }
+        noBraces = commaIndex != std::string_view::npos ? noBraces.substr(commaIndex + 1) : std::string_view();
+    }
+    if(elementCount < 4)
     {
         return Rect();
     }
 
     // Convert to numbers and return.
-    Vector2 p1(std::stof(elements[0]), std::stof(elements[1]));
-    Vector2 p2(std::stof(elements[2]), std::stof(elements[3]));
+    Vector2 p1(elements[0], elements[1]);
+    Vector2 p2(elements[2], elements[3]);
     return Rect(p1, p2);
 }
-
-std::unordered_map<std::string, IniKeyValue> IniSection::GetAsMap() const
-{
-    std::unordered_map<std::string, IniKeyValue> map;
-    for(auto& line : lines)
-    {
-        for(auto& entry : line.entries)
-        {
-            map[entry.key] = entry;
-        }
-    }
-    return map;
-}
\ No newline at end of file
@@ -5,6 +5,7 @@
 //
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -46,4 +47,33 @@ struct IniSection
     std::vector<IniLine> lines;
 
     std::unordered_map<std::string, IniKeyValue> GetAsMap() const;
+};
+
+// Zero-copy versions of the above, produced directly from the INI text by IniReader.
+// Names, keys, and values are views into the text, so they're only valid as long as the text is (usually, the asset's data buffer).
+struct IniKeyValueView
+{
+    std::string_view key;
+    std::string_view value;
+
+    float GetValueAsFloat() const;
+    int GetValueAsInt() const;
+    bool GetValueAsBool() const;
+    Vector2 GetValueAsVector2() const;
+    Vector3 GetValueAsVector3() const;
+    Vector4 GetValueAsVector4() const;
+    Color32 GetValueAsColor32() const;
+    Rect GetValueAsRect() const;
+};
+
+struct IniLineView
+{
+    std::vector<IniKeyValueView> entries;
+};
+
+struct IniSectionView
+{
+    std::string_view name;
+    std::string_view condition;
+    std::vector<IniLineView> lines;
 };
\ No newline at end of file
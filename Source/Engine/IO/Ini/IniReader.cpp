@@ -1,27 +1,55 @@
 #include "IniReader.h"
 
-#include <iostream>
+#include <iterator>
 
-#include "mstream.h"
 #include "StringUtil.h"
-#include "TextReader.h"
 
-IniReader::IniReader(const char* filePath) :
-    mTextReader(filePath)
+namespace
 {
+    void CopySection(const IniSectionView& sectionView, IniSection& section)
+    {
+        section.name = sectionView.name;
+        section.condition = sectionView.condition;
+        section.lines.resize(sectionView.lines.size());
+        for(size_t i = 0; i < sectionView.lines.size(); ++i)
+        {
+            const std::vector<IniKeyValueView>& entryViews = sectionView.lines[i].entries;
+            std::vector<IniKeyValue>& entries = section.lines[i].entries;
+            entries.resize(entryViews.size());
+            for(size_t j = 0; j < entryViews.size(); ++j)
+            {
+                entries[j].key = entryViews[j].key;
+                entries[j].value = entryViews[j].value;
+            }
+        }
+    }
+}
 
+IniReader::IniReader(const char* filePath)
+{
+    // Read the whole file into memory - we'll tokenize from there.
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    if(file.good())
+    {
+        mOwnedText.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    mText = mOwnedText;
 }
 
 IniReader::IniReader(const uint8_t* memory, uint32_t memoryLength) :
-    mTextReader(reinterpret_cast<const char*>(memory), memoryLength)
+    mText(reinterpret_cast<const char*>(memory), memoryLength)
 {
 
 }
 
-IniReader::IniReader(std::istream* stream) :
-    mTextReader(stream)
+IniReader::IniReader(std::istream* stream)
 {
-
+    // Read the rest of the stream into memory - we'll tokenize from there.
+    if(stream != nullptr)
+    {
+        mOwnedText.assign(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+    }
+    mText = mOwnedText;
 }
 
 void IniReader::ReadAll()
@@ -30,10 +58,10 @@ void IniReader::ReadAll()
     if(!mSections.empty()) { return; }
 
     // Make sure we're at the beginning of the file.
-    mTextReader.Seek(0);
+    mPosition = 0;
 
     // Read in each section and add to sections list.
-    IniSection section;
+    IniSectionView section;
     while(ReadNextSection(section))
     {
         mSections.push_back(section);
@@ -49,7 +77,16 @@ std::unordered_map<std::string, IniKeyValue> IniReader::ReadAllAsMap()
     std::unordered_map<std::string, IniKeyValue> map;
     for(auto& section : mSections)
     {
-        std::unordered_map<std::string, IniKeyValue> sectionMap = section.GetAsMap();
+        std::unordered_map<std::string, IniKeyValue> sectionMap;
+        for(auto& line : section.lines)
+        {
+            for(auto& entry : line.entries)
+            {
+                IniKeyValue& keyValue = sectionMap[std::string(entry.key)];
+                keyValue.key = entry.key;
+                keyValue.value = entry.value;
+            }
+        }
         map.insert(sectionMap.begin(), sectionMap.end());
     }
     return map;
@@ -64,7 +101,8 @@ std::vector<IniSection> IniReader::GetSections(const std::string& name)
     {
         if(StringUtil::EqualsIgnoreCase(section.name, name))
         {
-            toReturn.push_back(section);
+            toReturn.emplace_back();
+            CopySection(section, toReturn.back());
         }
     }
     return toReturn;
@@ -73,6 +111,33 @@ std::vector<IniSection> IniReader::GetSections(const std::string& name)
 IniSection IniReader::GetSection(const std::string& name)
 {
     // Find the first section with the specified name and return it.
+    IniSection toReturn;
+    for(auto& section : mSections)
+    {
+        if(StringUtil::EqualsIgnoreCase(section.name, name))
+        {
+            CopySection(section, toReturn);
+            break;
+        }
+    }
+    return toReturn;
+}
+
+std::vector<IniSectionView> IniReader::GetSectionViews(std::string_view name)
+{
+    std::vector<IniSectionView> toReturn;
+    for(auto& section : mSections)
+    {
+        if(StringUtil::EqualsIgnoreCase(section.name, name))
+        {
+            toReturn.push_back(section);
+        }
+    }
+    return toReturn;
+}
+
+IniSectionView IniReader::GetSectionView(std::string_view name)
+{
     for(auto& section : mSections)
     {
         if(StringUtil::EqualsIgnoreCase(section.name, name))
@@ -80,19 +145,27 @@ IniSection IniReader::GetSection(const std::string& name)
             return section;
         }
     }
-    return IniSection();
+    return IniSectionView();
 }
 
 bool IniReader::ReadNextSection(IniSection& sectionOut)
+{
+    IniSectionView sectionView;
+    bool readSection = ReadNextSection(sectionView);
+    CopySection(sectionView, sectionOut);
+    return readSection;
+}
+
+bool IniReader::ReadNextSection(IniSectionView& sectionOut)
 {
     // Clear passed in section to default state.
-    sectionOut.name.clear();
-    sectionOut.condition.clear();
+    sectionOut.name = std::string_view();
+    sectionOut.condition = std::string_view();
     sectionOut.lines.clear();
 
     // Clear last read section name and condition - these should be populated by reading the upcoming lines.
-    mCurrentSectionName.clear();
-    mCurrentSectionCondition.clear();
+    mCurrentSectionName = std::string_view();
+    mCurrentSectionCondition = std::string_view();
 
     // Read until we hit the next line containing key/value data.
     // If this section has no lines yet, don't stop at a section header - this will be *this* section's header.
@@ -100,7 +173,7 @@ bool IniReader::ReadNextSection(IniSection& sectionOut)
     while(ReadNextKeyValueLine(!sectionOut.lines.empty()))
     {
         sectionOut.lines.emplace_back();
-        IniLine& iniLine = sectionOut.lines.back();
+        IniLineView& iniLine = sectionOut.lines.back();
 
         // Read each key/value pair for this line.
         while(ParseKeyValuePairFromCurrentLine())
@@ -128,24 +201,39 @@ bool IniReader::ReadKeyValuePair()
     return ParseKeyValuePairFromCurrentLine();
 }
 
-bool IniReader::ReadNextKeyValueLine(bool stopAtSectionHeader)
+const IniKeyValue& IniReader::GetKeyValue()
 {
-    // Remember the current position *before* reading the next line, so we can set it back if needs be.
-    imstream::pos_type currentPos = mTextReader.GetPosition();
+    // Assigning reuses the strings' existing memory, when possible.
+    mCurrentKeyValueCopy.key = mCurrentKeyValue.key;
+    mCurrentKeyValueCopy.value = mCurrentKeyValue.value;
+    return mCurrentKeyValueCopy;
+}
 
+bool IniReader::ReadNextKeyValueLine(bool stopAtSectionHeader)
+{
     // Keep reading the next line until we want to stop.
     // We always want to skip comments and empty lines, and sometimes we want to skip section headers.
-    std::string line;
     bool inBlockComment = false;
-    while(mTextReader.ReadLine(line))
+    while(mPosition < mText.size())
     {
-        // SanitizeLine ensures: no line break or tab characters, no whitespace before/after, removes comments, etc.
+        // Remember the position *before* reading the next line, so we can set it back if needs be.
+        size_t lineStartPos = mPosition;
+
+        // Grab the next line, and move past it.
+        size_t lineEndPos = mText.find('\n', mPosition);
+        if(lineEndPos == std::string_view::npos)
+        {
+            lineEndPos = mText.size();
+        }
+        std::string_view line = mText.substr(lineStartPos, lineEndPos - lineStartPos);
+        mPosition = lineEndPos + 1;
+
+        // SanitizeLine ensures: no line break characters, no whitespace before/after, removes comments, etc.
         StringUtil::SanitizeLine(line);
 
         // Ignore empty lines.
         if(line.empty())
         {
-            currentPos = mTextReader.GetPosition();
             continue;
         }
 
@@ -173,17 +261,17 @@ bool IniReader::ReadNextKeyValueLine(bool stopAtSectionHeader)
             // If we want to stop reading at the next section header, revert reader to position before reading this line and return.
             if(stopAtSectionHeader)
             {
-                mTextReader.Seek(currentPos);
+                mPosition = lineStartPos;
                 return false;
             }
 
             // Otherwise, this is the header for the current section - let's parse it.
             // Remove '[' and ']' from the header.
             std::size_t endHeaderIndex = line.find(']', 1);
-            if(endHeaderIndex == std::string::npos)
+            if(endHeaderIndex == std::string_view::npos)
             {
                 // No ']' at end - still accept it, but don't need to remove char at end.
-                mCurrentSectionName = line.substr(1, std::string::npos);
+                mCurrentSectionName = line.substr(1);
             }
             else
             {
@@ -194,19 +282,16 @@ bool IniReader::ReadNextKeyValueLine(bool stopAtSectionHeader)
             // A conditional section may be ignored by game code if the condition is not met.
             // The condition is usually Sheepscript code.
             std::size_t equalsIndex = mCurrentSectionName.find('=');
-            if(equalsIndex != std::string::npos)
+            if(equalsIndex != std::string_view::npos)
             {
-                mCurrentSectionCondition = mCurrentSectionName.substr(equalsIndex + 1, std::string::npos);
+                mCurrentSectionCondition = mCurrentSectionName.substr(equalsIndex + 1);
                 mCurrentSectionName = mCurrentSectionName.substr(0, equalsIndex);
             }
-
-            currentPos = mTextReader.GetPosition();
             continue;
         }
 
         // We have a new line containing key/value pair(s).
-        mCurrentLine = line;
-        mCurrentLineWorking = line;
+        mCurrentLineRemaining = line;
         return true;
     }
 
@@ -216,7 +301,7 @@ bool IniReader::ReadNextKeyValueLine(bool stopAtSectionHeader)
 
 bool IniReader::ParseKeyValuePairFromCurrentLine()
 {
-    if(mCurrentLineWorking.empty())
+    if(mCurrentLineRemaining.empty())
     {
         return false;
     }
@@ -224,68 +309,48 @@ bool IniReader::ParseKeyValuePairFromCurrentLine()
     // First, determine the token we want to work with on the current line.
     // We want the first item, if there are multiple comma-separated values.
     // Otherwise, we just want the whole remaining line.
-    std::string currentKeyValuePair;
+    std::string_view currentKeyValuePair = mCurrentLineRemaining;
+    mCurrentLineRemaining = std::string_view();
 
     // If a line can have multiple key/value pairs, we'll need to determine
     // what portion of the current line constitutes the next key/value pair.
-    std::size_t delimiterIndex = std::string::npos;
     if(mMultipleKeyValuePairsPerLine)
     {
         // Need to find index of a comma, which is the delimiter between key/value pairs on a single line.
-        // We can't just use string::find because we want to ignore commas that are inside braces.
+        // We can't just use find because we want to ignore commas that are inside braces.
         // Ex: pos={10, 20, 30} should NOT be considered multiple key/value pairs.
         int braceDepth = 0;
-        for(int i = 0; i < mCurrentLineWorking.length(); i++)
+        for(size_t i = 0; i < currentKeyValuePair.length(); i++)
         {
-            if(mCurrentLineWorking[i] == '{') { braceDepth++; }
-            if(mCurrentLineWorking[i] == '}') { braceDepth--; }
+            if(currentKeyValuePair[i] == '{') { braceDepth++; }
+            if(currentKeyValuePair[i] == '}') { braceDepth--; }
 
-            if(mCurrentLineWorking[i] == ',' && braceDepth == 0)
+            // If we find a comma separator, then we only want to deal with the parts in front of the comma.
+            // If no comma, then the rest of the line is our focus.
+            if(currentKeyValuePair[i] == ',' && braceDepth == 0)
             {
-                delimiterIndex = i;
+                mCurrentLineRemaining = currentKeyValuePair.substr(i + 1);
+                currentKeyValuePair = currentKeyValuePair.substr(0, i);
                 break;
             }
         }
-
-        // If we found a valid comma separator, then we only want to deal with the parts in front of the comma.
-        // If no comma, then the rest of the line is our focus.
-        if(delimiterIndex != std::string::npos)
-        {
-            currentKeyValuePair = mCurrentLineWorking.substr(0, delimiterIndex);
-            mCurrentLineWorking = mCurrentLineWorking.substr(delimiterIndex + 1, std::string::npos);
-        }
-        else
-        {
-            currentKeyValuePair = mCurrentLineWorking;
-            mCurrentLineWorking.clear();
-        }
-    }
-    else
-    {
-        currentKeyValuePair = mCurrentLineWorking;
-        mCurrentLineWorking.clear();
     }
 
-    // Trim off any comment on the line.
+    // Trim off any comment, and any whitespace (including rogue tab characters).
     StringUtil::TrimComment(currentKeyValuePair);
-
-    // Get rid of any rogue tab characters.
-    StringUtil::RemoveAll(currentKeyValuePair, '\t');
-
-    // Trim any whitespace.
     StringUtil::TrimWhitespace(currentKeyValuePair);
 
     // OK, so now we have a string representing a key/value pair, "model=blahblah" or similar.
     // But it might also just be a keyword (no value) like "hidden".
-    delimiterIndex = currentKeyValuePair.find('=');
-    if(delimiterIndex != std::string::npos)
+    std::size_t delimiterIndex = currentKeyValuePair.find('=');
+    if(delimiterIndex != std::string_view::npos)
     {
         mCurrentKeyValue.key = currentKeyValuePair.substr(0, delimiterIndex);
-        mCurrentKeyValue.value = currentKeyValuePair.substr(delimiterIndex + 1, std::string::npos);
+        mCurrentKeyValue.value = currentKeyValuePair.substr(delimiterIndex + 1);
 
         // Ooof, we may also have to trim these now...
-        StringUtil::Trim(mCurrentKeyValue.key);
-        StringUtil::Trim(mCurrentKeyValue.value);
+        StringUtil::TrimWhitespace(mCurrentKeyValue.key);
+        StringUtil::TrimWhitespace(mCurrentKeyValue.value);
     }
     else
     {
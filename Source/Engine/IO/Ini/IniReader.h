@@ -5,16 +5,21 @@
 // Can extract individual sections or individual key/value pairs.
 // Can also support multiple key/value pairs on a single line.
 //
+// The reader tokenizes directly from the text in memory. Each read also has a zero-copy "view" version,
+// where section names, keys, and values are string_views into the text. These are much faster to read, since nothing is copied.
+// But views are only valid as long as the text is: either the memory passed in, or this reader (if reading from a file or stream).
+//
 #pragma once
 #include <cstdint>
 #include <fstream>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "Color32.h"
 #include "Ini.h"
 #include "Rect.h"
-#include "TextReader.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
@@ -34,32 +39,42 @@ public:
     std::unordered_map<std::string, IniKeyValue> ReadAllAsMap();
     std::vector<IniSection> GetSections(const std::string& name);
     IniSection GetSection(const std::string& name);
+    std::vector<IniSectionView> GetSectionViews(std::string_view name);
+    IniSectionView GetSectionView(std::string_view name);
 
     // MODE B: Read one section at a time.
     bool ReadNextSection(IniSection& sectionOut);
+    bool ReadNextSection(IniSectionView& sectionOut);
 
     // MODE C: Read line by line.
     bool ReadLine();
     bool ReadKeyValuePair();
-    const IniKeyValue& GetKeyValue() { return mCurrentKeyValue; }
+    const IniKeyValue& GetKeyValue();
+    const IniKeyValueView& GetKeyValueView() const { return mCurrentKeyValue; }
 
 private:
-    // The stream object we use to read in the file contents.
-    TextReader mTextReader;
+    // If reading from a file or stream, the text is read into this string.
+    std::string mOwnedText;
+
+    // The text being read, and our current position in it.
+    std::string_view mText;
+    size_t mPosition = 0;
 
     // When using "read everything" mode, holds all sections read into memory.
-    std::vector<IniSection> mSections;
+    std::vector<IniSectionView> mSections;
 
     // The section we are currently in. For example, if [General] in file, this might be "General".
-    std::string mCurrentSectionName;
-    std::string mCurrentSectionCondition;
+    std::string_view mCurrentSectionName;
+    std::string_view mCurrentSectionCondition;
+
+    // The part of the current line that hasn't been parsed into key/value pairs yet.
+    std::string_view mCurrentLineRemaining;
 
-    // Whatever the current line is. Can move to next line by calling "ReadLine".
-    std::string mCurrentLine;
+    // The last parsed key/value pair.
+    IniKeyValueView mCurrentKeyValue;
 
-    // Values used when parsing a single line's key/value pairs.
-    std::string mCurrentLineWorking;
-    IniKeyValue mCurrentKeyValue;
+    // A copy of the last parsed key/value pair, for callers that want strings.
+    IniKeyValue mCurrentKeyValueCopy;
 
     // If true, we assume that each line can have multiple key/value pairs.
     // As a result, we split based on commas. Otherwise, we assume whole line has one key/value pair.
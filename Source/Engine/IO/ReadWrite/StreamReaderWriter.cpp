@@ -29,6 +29,20 @@ uint32_t StreamReader::GetPosition() const
     return static_cast<uint32_t>(pos);
 }
 
+uint32_t StreamReader::GetLength() const
+{
+    // Seek to the end to find the length, and then go back to where we were.
+    std::streampos pos = mStream->tellg();
+    mStream->seekg(0, std::ios::end);
+    std::streampos length = mStream->tellg();
+    mStream->seekg(pos);
+    if(length < 0)
+    {
+        length = 0;
+    }
+    return static_cast<uint32_t>(length);
+}
+
 uint64_t StreamReader::Read(char* buffer, uint64_t bufferSize)
 {
     mStream->read(buffer, bufferSize);
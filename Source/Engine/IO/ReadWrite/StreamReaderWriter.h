@@ -19,6 +19,7 @@ public:
     void Seek(uint32_t position);
     void Skip(uint32_t count);
     uint32_t GetPosition() const;
+    uint32_t GetLength() const;
 
     uint64_t Read(char* buffer, uint64_t bufferSize);
 
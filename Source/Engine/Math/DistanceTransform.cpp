@@ -0,0 +1,124 @@
+#include "DistanceTransform.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "JobSystem.h"
+
+namespace
+{
+    const float kInfinity = std::numeric_limits<float>::infinity();
+
+    // Columns (and rows) are independent of each other, so they're split across jobs in batches of this many.
+    const uint32_t kColumnsPerJob = 64;
+    const uint32_t kRowsPerJob = 32;
+}
+
+void DistanceTransform::Compute(const uint8_t* features, uint32_t width, uint32_t height, float* outDistancesSq, uint32_t* outNearestIndexes)
+{
+    // First, for each cell, find the nearest feature in the same column.
+    // That's just a scan down the column, and then a scan back up it.
+    std::vector<int> nearestRows(width * height);
+    JobSystem::ParallelFor(width, kColumnsPerJob, [features, width, height, &nearestRows](uint32_t x) {
+        int nearestRow = -1;
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            if(features[y * width + x] != 0)
+            {
+                nearestRow = y;
+            }
+            nearestRows[y * width + x] = nearestRow;
+        }
+
+        nearestRow = -1;
+        for(uint32_t y = height; y-- > 0;)
+        {
+            if(features[y * width + x] != 0)
+            {
+                nearestRow = y;
+            }
+            int& nearestAbove = nearestRows[y * width + x];
+            if(nearestRow >= 0 && (nearestAbove < 0 || nearestRow - static_cast<int>(y) < static_cast<int>(y) - nearestAbove))
+            {
+                nearestAbove = nearestRow;
+            }
+        }
+    });
+
+    // Then, for each row, the nearest feature overall is the one that minimizes (x - q)^2 + columnDistSq(q), over all columns q.
+    // Each column's term is a parabola, so the answer comes from the lower envelope of those parabolas.
+    // Each job needs its own scratch space, so jobs are given a batch of rows, rather than letting ParallelFor split up rows.
+    uint32_t rowBatchCount = (height + kRowsPerJob - 1) / kRowsPerJob;
+    JobSystem::ParallelFor(rowBatchCount, 1, [width, height, outDistancesSq, outNearestIndexes, &nearestRows](uint32_t rowBatch) {
+        std::vector<float> columnDistancesSq(width);
+        std::vector<uint32_t> envelopeColumns(width);
+        std::vector<float> envelopeBoundaries(width + 1);
+        uint32_t endRow = std::min(height, (rowBatch + 1) * kRowsPerJob);
+        for(uint32_t y = rowBatch * kRowsPerJob; y < endRow; ++y)
+        {
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                int nearestRow = nearestRows[y * width + x];
+                float dy = static_cast<float>(nearestRow) - static_cast<float>(y);
+                columnDistancesSq[x] = nearestRow >= 0 ? dy * dy : kInfinity;
+            }
+
+            // Where the parabolas for columns q and v intersect (they always do, since parabolas are all the same shape).
+            auto getIntersection = [&columnDistancesSq](uint32_t q, uint32_t v) {
+                float fq = static_cast<float>(q);
+                float fv = static_cast<float>(v);
+                return ((columnDistancesSq[q] + fq * fq) - (columnDistancesSq[v] + fv * fv)) / (2.0f * fq - 2.0f * fv);
+            };
+
+            // Build the lower envelope. Columns without any features don't contribute a parabola.
+            int k = -1;
+            for(uint32_t q = 0; q < width; ++q)
+            {
+                if(columnDistancesSq[q] == kInfinity) { continue; }
+                if(k < 0)
+                {
+                    k = 0;
+                    envelopeColumns[0] = q;
+                    envelopeBoundaries[0] = -kInfinity;
+                    envelopeBoundaries[1] = kInfinity;
+                    continue;
+                }
+
+                // Find where this parabola intersects the last one in the envelope. If that's before the last one even starts, the last one is hidden.
+                // The first parabola in the envelope starts at -infinity, so this always stops there at the latest.
+                float s = getIntersection(q, envelopeColumns[k]);
+                while(s <= envelopeBoundaries[k])
+                {
+                    --k;
+                    s = getIntersection(q, envelopeColumns[k]);
+                }
+                ++k;
+                envelopeColumns[k] = q;
+                envelopeBoundaries[k] = s;
+                envelopeBoundaries[k + 1] = kInfinity;
+            }
+
+            // Read back the envelope's value (and which parabola it came from) at each cell.
+            int j = 0;
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                uint32_t index = y * width + x;
+                if(k < 0)
+                {
+                    outDistancesSq[index] = kInfinity;
+                    outNearestIndexes[index] = kNoFeature;
+                    continue;
+                }
+                while(envelopeBoundaries[j + 1] < static_cast<float>(x))
+                {
+                    ++j;
+                }
+                uint32_t q = envelopeColumns[j];
+                float dx = static_cast<float>(x) - static_cast<float>(q);
+                outDistancesSq[index] = dx * dx + columnDistancesSq[q];
+                outNearestIndexes[index] = nearestRows[y * width + q] * width + q;
+            }
+        }
+    });
+}
@@ -0,0 +1,22 @@
+//
+// Clark Kromenaker
+//
+// Euclidean distance transform of a 2D grid: for every cell, finds the nearest "feature" cell and the distance to it.
+//
+// This is the linear-time algorithm from Felzenszwalb & Huttenlocher's "Distance Transforms of Sampled Functions."
+// It does one pass down each column, then one pass along each row, so the cost is proportional to the number of cells
+// (rather than checking every cell against every feature cell).
+//
+#pragma once
+#include <cstdint>
+
+namespace DistanceTransform
+{
+    // Returned as the nearest index if the grid has no feature cells at all.
+    static const uint32_t kNoFeature = UINT32_MAX;
+
+    // Features are cells where features[y * width + x] is non-zero.
+    // For each cell, outputs the squared distance (in cells) to the nearest feature, and that feature's index.
+    // If there are no features, distances are infinite and nearest indexes are kNoFeature.
+    void Compute(const uint8_t* features, uint32_t width, uint32_t height, float* outDistancesSq, uint32_t* outNearestIndexes);
+}
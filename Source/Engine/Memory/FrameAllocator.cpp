@@ -0,0 +1,136 @@
+#include "FrameAllocator.h"
+
+#include <cstdlib>
+
+#include "LinearAllocator.h"
+#include "PtrMath.h"
+
+namespace
+{
+    // Arenas start at this size. They grow (on reset) if a thread needs more memory than this in a frame.
+    const size_t kInitialArenaSize = 64 * 1024;
+
+    struct Arena
+    {
+        ~Arena()
+        {
+            Release();
+        }
+
+        void* Allocate(size_t size, size_t alignment)
+        {
+            // Lazily allocate the arena's memory block the first time a thread needs it.
+            if(block == nullptr)
+            {
+                blockSize = kInitialArenaSize;
+                block = std::malloc(blockSize);
+                allocator = LinearAllocator(block, blockSize);
+            }
+
+            // Most of the time, the allocation fits in the arena.
+            ++liveCount;
+            void* memory = allocator.Allocate(size, static_cast<unsigned short>(alignment));
+            if(memory != nullptr)
+            {
+                return memory;
+            }
+
+            // Out of space: fall back on the heap until the next reset.
+            // Allocate extra so we can align the result.
+            void* overflowMemory = std::malloc(size + alignment);
+            overflow.push_back(overflowMemory);
+            overflowSize += size + alignment;
+            return PtrMath::Align(overflowMemory, static_cast<unsigned short>(alignment));
+        }
+
+        void Deallocate()
+        {
+            // Once nothing is using the arena anymore, it's safe to reset it.
+            if(liveCount > 0 && --liveCount == 0)
+            {
+                Reset();
+            }
+        }
+
+        void Reset()
+        {
+            liveCount = 0;
+            if(block == nullptr) { return; }
+
+            // If we overflowed since the last reset, free the overflow memory and grow the arena so it'll fit next time.
+            if(!overflow.empty())
+            {
+                for(void* overflowMemory : overflow)
+                {
+                    std::free(overflowMemory);
+                }
+                overflow.clear();
+
+                std::free(block);
+                blockSize += overflowSize;
+                block = std::malloc(blockSize);
+                allocator = LinearAllocator(block, blockSize);
+                overflowSize = 0;
+            }
+            else
+            {
+                allocator.Reset();
+            }
+        }
+
+        void Release()
+        {
+            Reset();
+            std::free(block);
+            block = nullptr;
+            blockSize = 0;
+            allocator = LinearAllocator(nullptr, 0);
+        }
+
+        // The arena's memory block and an allocator that carves it up.
+        void* block = nullptr;
+        size_t blockSize = 0;
+        LinearAllocator allocator { nullptr, 0 };
+
+        // Allocations that didn't fit in the memory block. These are freed on reset.
+        std::vector<void*> overflow;
+        size_t overflowSize = 0;
+
+        // Number of allocations that haven't been deallocated yet.
+        size_t liveCount = 0;
+    };
+    thread_local Arena tArena;
+}
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment)
+{
+    return tArena.Allocate(size, alignment);
+}
+
+void FrameAllocator::Deallocate(void* memory)
+{
+    if(memory != nullptr)
+    {
+        tArena.Deallocate();
+    }
+}
+
+void FrameAllocator::EndFrame()
+{
+    tArena.Reset();
+}
+
+void FrameAllocator::Shutdown()
+{
+    tArena.Release();
+}
+
+FrameAllocator::Stats FrameAllocator::GetStats()
+{
+    Stats stats;
+    stats.allocationCount = tArena.allocator.GetAllocationCount() + tArena.overflow.size();
+    stats.allocatedSize = tArena.allocator.GetAllocatedSize() + tArena.overflowSize;
+    stats.overflowCount = tArena.overflow.size();
+    stats.capacity = tArena.blockSize;
+    return stats;
+}
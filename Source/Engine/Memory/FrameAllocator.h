@@ -0,0 +1,90 @@
+//
+// Clark Kromenaker
+//
+// Scratch memory for short-lived, per-frame allocations.
+//
+// Each thread gets its own arena (a LinearAllocator over a heap block), so allocating is just a pointer bump with no locking.
+// Deallocating does nothing - instead, the whole arena is reset at once:
+// - Any arena resets whenever all of its allocations have been deallocated (e.g. when the last frame_vector goes out of scope).
+// - The main thread's arena is also reset at the end of each frame (see GEngine), so raw allocations can just be dropped.
+//   Other threads don't have frames, so they must deallocate everything they allocate.
+//
+// If an arena runs out of space, it falls back on the heap until the next reset, and then grows to fit.
+// So after a few frames, the arena reaches a steady state where no heap allocations occur.
+//
+// Rules for using frame memory:
+// - Don't hold onto it past the end of the current frame.
+// - Deallocate it on the same thread that allocated it.
+//
+// Containers can opt into using frame memory using FrameStlAllocator (e.g. std::frame_vector<int>).
+//
+#pragma once
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class FrameAllocator
+{
+public:
+    static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    static void Deallocate(void* memory);
+
+    // Resets the main thread's arena. Call once per frame, after all frame memory is done being used.
+    static void EndFrame();
+
+    // Frees the calling thread's arena memory entirely.
+    static void Shutdown();
+
+    // Stats for the calling thread's arena, since the last reset.
+    struct Stats
+    {
+        // Number of allocations and bytes allocated (including any overflow allocations).
+        size_t allocationCount = 0;
+        size_t allocatedSize = 0;
+
+        // Number of allocations that didn't fit in the arena and had to use the heap.
+        size_t overflowCount = 0;
+
+        // Current size of the arena's memory block.
+        size_t capacity = 0;
+    };
+    static Stats GetStats();
+};
+
+// An STL-compatible allocator that allocates from the frame allocator.
+template<typename T>
+class FrameStlAllocator
+{
+public:
+    typedef T value_type;
+
+    FrameStlAllocator() = default;
+    template<typename U> FrameStlAllocator(const FrameStlAllocator<U>&) { }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* memory, size_t)
+    {
+        FrameAllocator::Deallocate(memory);
+    }
+};
+
+// All frame allocators share the same (per-thread) arenas, so they are interchangeable.
+template<typename T, typename U>
+bool operator==(const FrameStlAllocator<T>&, const FrameStlAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const FrameStlAllocator<T>&, const FrameStlAllocator<U>&) { return false; }
+
+namespace std
+{
+    // Type aliases for containers that use frame memory.
+    template<typename T>
+    using frame_vector = std::vector<T, FrameStlAllocator<T>>;
+
+    template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    using frame_unordered_map = std::unordered_map<K, V, Hash, KeyEqual, FrameStlAllocator<std::pair<const K, V>>>;
+}
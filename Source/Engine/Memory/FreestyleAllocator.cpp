@@ -57,6 +57,16 @@ void* FreestyleAllocator::Allocate(size_t size, unsigned short alignment)
     if(excessSize < sizeof(FreeBlock) || excessSize < sizeof(AllocHeader))
     {
         allocSize += excessSize;
+
+        // The whole block is being used, so it's no longer free.
+        if(prevBlock != nullptr)
+        {
+            prevBlock->next = block->next;
+        }
+        else
+        {
+            mFreeListHead = block->next;
+        }
     }
     else
     {
@@ -107,6 +117,7 @@ void FreestyleAllocator::Deallocate(void* memory)
     FreeBlock* prevPrevBlock = nullptr;
     FreeBlock* prevBlock = nullptr;
     FreeBlock* nextBlock = mFreeListHead;
+    bool inserted = false;
     while(nextBlock != nullptr)
     {
         // If free block's address is less than current block, it means
@@ -142,6 +153,7 @@ void FreestyleAllocator::Deallocate(void* memory)
                 // No prevBlock indicates this is the new linked list head.
                 mFreeListHead = freeBlock;
             }
+            inserted = true;
             break;
         }
 
@@ -151,6 +163,28 @@ void FreestyleAllocator::Deallocate(void* memory)
         nextBlock = nextBlock->next;
     }
 
+    // If the free list is empty, or this block comes after every free block, it goes at the end of the list.
+    if(!inserted)
+    {
+        if(prevBlock != nullptr && PtrMath::Diff(freeBlock, prevBlock) == prevBlock->size)
+        {
+            // No gap between the last free block and this one, so just grow the last free block.
+            prevBlock->size += freeBlock->size;
+        }
+        else
+        {
+            freeBlock->next = nullptr;
+            if(prevBlock != nullptr)
+            {
+                prevBlock->next = freeBlock;
+            }
+            else
+            {
+                mFreeListHead = freeBlock;
+            }
+        }
+    }
+
     // Perform deallocation.
     mAllocatedSize -= allocSize;
     --mAllocationCount;
@@ -0,0 +1,184 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <fstream>
+
+namespace
+{
+    // Everything here may be updated from within operator new, so it must not allocate.
+    // These are all zero-initialized before any dynamic initialization, so they're usable even during static init.
+    struct TagCounters
+    {
+        std::atomic<size_t> liveBytes;
+        std::atomic<size_t> liveCount;
+        std::atomic<size_t> peakBytes;
+
+        // Running totals of all allocations ever made. Used to calculate per-frame rates.
+        std::atomic<size_t> totalAllocCount;
+        std::atomic<size_t> totalAllocBytes;
+    };
+    TagCounters tagCounters[static_cast<int>(MemoryTag::Count)];
+    TagCounters totalCounters;
+
+    // Per-frame rates and baselines are only read/written on the main thread.
+    struct TagFrameInfo
+    {
+        size_t lastTotalAllocCount = 0;
+        size_t lastTotalAllocBytes = 0;
+        size_t frameAllocCount = 0;
+        size_t frameAllocBytes = 0;
+        size_t baselineBytes = 0;
+    };
+    TagFrameInfo tagFrameInfos[static_cast<int>(MemoryTag::Count)];
+    TagFrameInfo totalFrameInfo;
+
+    thread_local MemoryTag currentTag = MemoryTag::Untagged;
+
+    void AddAllocation(TagCounters& counters, size_t size)
+    {
+        size_t liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        counters.liveCount.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocCount.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocBytes.fetch_add(size, std::memory_order_relaxed);
+
+        // Update high-water mark. Most of the time, the first check fails and we skip this.
+        size_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        while(liveBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) { }
+    }
+
+    void RemoveAllocation(TagCounters& counters, size_t size)
+    {
+        counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        counters.liveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void UpdateFrameInfo(const TagCounters& counters, TagFrameInfo& frameInfo)
+    {
+        size_t totalAllocCount = counters.totalAllocCount.load(std::memory_order_relaxed);
+        size_t totalAllocBytes = counters.totalAllocBytes.load(std::memory_order_relaxed);
+        frameInfo.frameAllocCount = totalAllocCount - frameInfo.lastTotalAllocCount;
+        frameInfo.frameAllocBytes = totalAllocBytes - frameInfo.lastTotalAllocBytes;
+        frameInfo.lastTotalAllocCount = totalAllocCount;
+        frameInfo.lastTotalAllocBytes = totalAllocBytes;
+    }
+
+    MemoryTracker::TagStats GetStats(const TagCounters& counters, const TagFrameInfo& frameInfo)
+    {
+        MemoryTracker::TagStats stats;
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.liveCount = counters.liveCount.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.baselineBytes = frameInfo.baselineBytes;
+        stats.frameAllocCount = frameInfo.frameAllocCount;
+        stats.frameAllocBytes = frameInfo.frameAllocBytes;
+        return stats;
+    }
+}
+
+bool MemoryTracker::IsEnabled()
+{
+    #if defined(MEMORY_TRACKING_ENABLED)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+    switch(tag)
+    {
+    case MemoryTag::Untagged:
+        return "Untagged";
+    case MemoryTag::Textures:
+        return "Textures";
+    case MemoryTag::BSP:
+        return "BSP";
+    case MemoryTag::Models:
+        return "Models";
+    case MemoryTag::Animation:
+        return "Animation";
+    case MemoryTag::Audio:
+        return "Audio";
+    case MemoryTag::Sheep:
+        return "Sheep";
+    case MemoryTag::Scene:
+        return "Scene";
+    case MemoryTag::Assets:
+        return "Assets";
+    default:
+        return "Unknown";
+    }
+}
+
+MemoryTag MemoryTracker::GetCurrentTag()
+{
+    return currentTag;
+}
+
+void MemoryTracker::SetCurrentTag(MemoryTag tag)
+{
+    currentTag = tag;
+}
+
+void MemoryTracker::OnAllocate(size_t size, MemoryTag tag)
+{
+    AddAllocation(tagCounters[static_cast<int>(tag)], size);
+    AddAllocation(totalCounters, size);
+}
+
+void MemoryTracker::OnDeallocate(size_t size, MemoryTag tag)
+{
+    RemoveAllocation(tagCounters[static_cast<int>(tag)], size);
+    RemoveAllocation(totalCounters, size);
+}
+
+void MemoryTracker::EndFrame()
+{
+    for(int i = 0; i < static_cast<int>(MemoryTag::Count); ++i)
+    {
+        UpdateFrameInfo(tagCounters[i], tagFrameInfos[i]);
+    }
+    UpdateFrameInfo(totalCounters, totalFrameInfo);
+}
+
+MemoryTracker::TagStats MemoryTracker::GetTagStats(MemoryTag tag)
+{
+    return GetStats(tagCounters[static_cast<int>(tag)], tagFrameInfos[static_cast<int>(tag)]);
+}
+
+MemoryTracker::TagStats MemoryTracker::GetTotalStats()
+{
+    return GetStats(totalCounters, totalFrameInfo);
+}
+
+void MemoryTracker::SetBaseline()
+{
+    for(int i = 0; i < static_cast<int>(MemoryTag::Count); ++i)
+    {
+        tagFrameInfos[i].baselineBytes = tagCounters[i].liveBytes.load(std::memory_order_relaxed);
+    }
+    totalFrameInfo.baselineBytes = totalCounters.liveBytes.load(std::memory_order_relaxed);
+}
+
+bool MemoryTracker::DumpToCSV(const std::string& filePath)
+{
+    std::ofstream file(filePath);
+    if(!file.good()) { return false; }
+
+    // One row per tag, followed by a row for totals.
+    file << "Tag,Live Bytes,Live Count,Peak Bytes,Baseline Bytes,Allocs Last Frame,Bytes Last Frame\n";
+    for(int i = 0; i <= static_cast<int>(MemoryTag::Count); ++i)
+    {
+        bool isTotal = i == static_cast<int>(MemoryTag::Count);
+        TagStats stats = isTotal ? GetTotalStats() : GetTagStats(static_cast<MemoryTag>(i));
+        file << (isTotal ? "Total" : GetTagName(static_cast<MemoryTag>(i))) << ","
+             << stats.liveBytes << ","
+             << stats.liveCount << ","
+             << stats.peakBytes << ","
+             << stats.baselineBytes << ","
+             << stats.frameAllocCount << ","
+             << stats.frameAllocBytes << "\n";
+    }
+    return file.good();
+}
@@ -1,36 +1,149 @@
-#if 0
+#include "MemoryTracker.h"
+
+#if defined(MEMORY_TRACKING_ENABLED)
 #include <cstdlib>
-#include <iostream>
+#include <new>
+
+#include "PtrMath.h"
 
 // Replacements for default C++ new/new[] and delete/delete[].
 // Overriding the default functions gives us a way to "meter" when memory is allocated or deleted.
+namespace
+{
+    // Each allocation is preceded by a small header, so we know how much to subtract from which tag on delete.
+    struct AllocHeader
+    {
+        // Size requested by the caller.
+        size_t size;
+
+        // Offset from the start of the malloc'd block to the memory returned to the caller.
+        uint32_t offset;
+
+        // Tag that was current when the allocation was made.
+        MemoryTag tag;
+    };
+
+    // Header space is a multiple of the default new alignment, so memory returned to the caller stays aligned.
+    const size_t kHeaderSize = (sizeof(AllocHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    void* TrackedAllocate(size_t size, size_t alignment)
+    {
+        // For over-aligned types, allocate extra so we can align the result.
+        size_t padding = alignment > alignof(std::max_align_t) ? alignment : 0;
+        void* block = std::malloc(size + kHeaderSize + padding);
+        if(block == nullptr) { return nullptr; }
+
+        void* memory = PtrMath::Add(block, kHeaderSize);
+        if(padding > 0)
+        {
+            memory = PtrMath::Align(memory, static_cast<unsigned short>(alignment));
+        }
+
+        // Header goes right before the memory returned to the caller.
+        AllocHeader* header = static_cast<AllocHeader*>(PtrMath::Subtract(memory, kHeaderSize));
+        header->size = size;
+        header->offset = static_cast<uint32_t>(PtrMath::Diff(memory, block));
+        header->tag = MemoryTracker::GetCurrentTag();
+        MemoryTracker::OnAllocate(size, header->tag);
+        return memory;
+    }
+
+    void* TrackedAllocateOrThrow(size_t size, size_t alignment)
+    {
+        void* memory = TrackedAllocate(size, alignment);
+        if(memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void TrackedDeallocate(void* memory)
+    {
+        if(memory == nullptr) { return; }
+        AllocHeader* header = static_cast<AllocHeader*>(PtrMath::Subtract(memory, kHeaderSize));
+        MemoryTracker::OnDeallocate(header->size, header->tag);
+        std::free(PtrMath::Subtract(memory, header->offset));
+    }
+}
+
 void* operator new(size_t size)
 {
-    return std::malloc(size);
+    return TrackedAllocateOrThrow(size, alignof(std::max_align_t));
 }
 
-void operator delete(void* mem) noexcept
+void* operator new[](size_t size)
 {
-    std::free(mem);
+    return TrackedAllocateOrThrow(size, alignof(std::max_align_t));
 }
 
-void operator delete(void* mem, size_t size) noexcept
+void* operator new(size_t size, const std::nothrow_t&) noexcept
 {
-    std::free(mem);
+    return TrackedAllocate(size, alignof(std::max_align_t));
 }
 
-void* operator new[](size_t size)
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
 {
-    return std::malloc(size);
+    return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* mem) noexcept
+{
+    TrackedDeallocate(mem);
 }
 
 void operator delete[](void* mem) noexcept
 {
-    std::free(mem);
+    TrackedDeallocate(mem);
+}
+
+void operator delete(void* mem, size_t size) noexcept
+{
+    TrackedDeallocate(mem);
 }
 
 void operator delete[](void* mem, size_t size) noexcept
 {
-    std::free(mem);
+    TrackedDeallocate(mem);
+}
+
+void operator delete(void* mem, const std::nothrow_t&) noexcept
+{
+    TrackedDeallocate(mem);
+}
+
+void operator delete[](void* mem, const std::nothrow_t&) noexcept
+{
+    TrackedDeallocate(mem);
+}
+
+void operator delete(void* mem, std::align_val_t alignment) noexcept
+{
+    TrackedDeallocate(mem);
+}
+
+void operator delete[](void* mem, std::align_val_t alignment) noexcept
+{
+    TrackedDeallocate(mem);
+}
+
+void operator delete(void* mem, size_t size, std::align_val_t alignment) noexcept
+{
+    TrackedDeallocate(mem);
+}
+
+void operator delete[](void* mem, size_t size, std::align_val_t alignment) noexcept
+{
+    TrackedDeallocate(mem);
 }
-#endif
\ No newline at end of file
+#endif
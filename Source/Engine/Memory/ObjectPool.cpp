@@ -0,0 +1,85 @@
+#include "ObjectPool.h"
+
+#include <new>
+
+ObjectPool::ObjectPool()
+{
+    // Size classes are created up front, so no lock is needed to find one.
+    // This is cheap, since a size class doesn't allocate any chunks until it's used.
+    for(size_t size = kSizeClassGranularity; size <= kMaxPooledSize; size += kSizeClassGranularity)
+    {
+        mSizeClasses.push_back(std::make_unique<SizeClass>(size));
+    }
+}
+
+void* ObjectPool::Allocate(size_t size)
+{
+    SizeClass* sizeClass = GetSizeClass(size);
+    if(sizeClass == nullptr)
+    {
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(sizeClass->mutex);
+    return sizeClass->allocator.Allocate();
+}
+
+void ObjectPool::Deallocate(void* memory, size_t size)
+{
+    if(memory == nullptr) { return; }
+
+    SizeClass* sizeClass = GetSizeClass(size);
+    if(sizeClass == nullptr)
+    {
+        ::operator delete(memory);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(sizeClass->mutex);
+    sizeClass->allocator.Deallocate(memory);
+}
+
+void* ObjectPool::Allocate(size_t size, std::align_val_t alignment)
+{
+    if(static_cast<size_t>(alignment) <= kSizeClassGranularity)
+    {
+        return Allocate(size);
+    }
+    return ::operator new(size, alignment);
+}
+
+void ObjectPool::Deallocate(void* memory, size_t size, std::align_val_t alignment)
+{
+    if(static_cast<size_t>(alignment) <= kSizeClassGranularity)
+    {
+        Deallocate(memory, size);
+        return;
+    }
+    ::operator delete(memory, alignment);
+}
+
+void ObjectPool::ReleaseUnusedMemory()
+{
+    for(auto& sizeClass : mSizeClasses)
+    {
+        std::lock_guard<std::mutex> lock(sizeClass->mutex);
+        sizeClass->allocator.ReleaseUnusedChunks();
+    }
+}
+
+size_t ObjectPool::GetAllocationCount()
+{
+    size_t count = 0;
+    for(auto& sizeClass : mSizeClasses)
+    {
+        std::lock_guard<std::mutex> lock(sizeClass->mutex);
+        count += sizeClass->allocator.GetAllocationCount();
+    }
+    return count;
+}
+
+ObjectPool::SizeClass* ObjectPool::GetSizeClass(size_t size)
+{
+    if(size == 0 || size > kMaxPooledSize) { return nullptr; }
+    return mSizeClasses[(size - 1) / kSizeClassGranularity].get();
+}
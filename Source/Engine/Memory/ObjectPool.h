@@ -0,0 +1,64 @@
+//
+// Clark Kromenaker
+//
+// A thread-safe pool for a family of objects, such as all Actors or all Components.
+//
+// Objects in a family come in many sizes (one for each subclass), so allocations are grouped into size classes.
+// Each size class gets its own PoolAllocator and its own lock. Allocations too big for any size class use the heap.
+//
+// The intended use is as a class-level operator new/delete, so that a class and all its subclasses are pooled:
+//
+//     void* MyClass::operator new(size_t size) { return pool.Allocate(size); }
+//     void MyClass::operator delete(void* memory, size_t size) { pool.Deallocate(memory, size); }
+//
+// Note that the class needs a virtual destructor for operator delete to receive the size of the actual subclass.
+// The class should also have aligned (std::align_val_t) versions, or an over-aligned subclass silently gets memory that isn't aligned enough.
+//
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "PoolAllocator.h"
+
+class ObjectPool
+{
+public:
+    ObjectPool();
+
+    void* Allocate(size_t size);
+    void Deallocate(void* memory, size_t size);
+
+    // For types with greater than default alignment. Pooled memory is only aligned to max_align_t, so anything more aligned uses the heap.
+    void* Allocate(size_t size, std::align_val_t alignment);
+    void Deallocate(void* memory, size_t size, std::align_val_t alignment);
+
+    // Returns memory that isn't being used back to the heap. A good time for this is after unloading a scene.
+    void ReleaseUnusedMemory();
+
+    // Number of objects currently allocated from the pool (not counting ones too big for the pool).
+    size_t GetAllocationCount();
+
+private:
+    // Sizes are rounded up to a multiple of this to find their size class.
+    static const size_t kSizeClassGranularity = alignof(std::max_align_t);
+
+    // Objects bigger than this aren't pooled.
+    static const size_t kMaxPooledSize = 2048;
+
+    // Each chunk allocated by a size class is about this size.
+    static const size_t kChunkSize = 16 * 1024;
+
+    struct SizeClass
+    {
+        SizeClass(size_t blockSize) : allocator(blockSize, kChunkSize / blockSize) { }
+
+        std::mutex mutex;
+        PoolAllocator allocator;
+    };
+    std::vector<std::unique_ptr<SizeClass>> mSizeClasses;
+
+    SizeClass* GetSizeClass(size_t size);
+};
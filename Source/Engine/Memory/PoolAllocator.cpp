@@ -0,0 +1,123 @@
+#include "PoolAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+#include "PtrMath.h"
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerChunk) :
+    mBlocksPerChunk(blocksPerChunk > 0 ? blocksPerChunk : 1)
+{
+    // Blocks must be big enough to hold a free list pointer.
+    // Rounding up to the default alignment also ensures every block in a chunk is aligned.
+    const size_t kAlignment = alignof(std::max_align_t);
+    mBlockSize = std::max(blockSize, sizeof(FreeBlock));
+    mBlockSize = (mBlockSize + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    for(void* chunk : mChunks)
+    {
+        ::operator delete(chunk);
+    }
+}
+
+void* PoolAllocator::Allocate()
+{
+    // Get more blocks if we've run out.
+    if(mFreeList == nullptr)
+    {
+        AllocateChunk();
+    }
+
+    // Pop a block off the free list.
+    FreeBlock* block = mFreeList;
+    mFreeList = block->next;
+    ++mAllocationCount;
+    return block;
+}
+
+void PoolAllocator::Deallocate(void* memory)
+{
+    if(memory == nullptr) { return; }
+
+    // Push the block onto the free list. Most recently freed blocks are reused first, since they're likely still in cache.
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = mFreeList;
+    mFreeList = block;
+    --mAllocationCount;
+}
+
+void PoolAllocator::ReleaseUnusedChunks()
+{
+    if(mChunks.empty()) { return; }
+
+    // Easy case: nothing allocated, so all chunks are unused.
+    if(mAllocationCount == 0)
+    {
+        for(void* chunk : mChunks)
+        {
+            ::operator delete(chunk);
+        }
+        mChunks.clear();
+        mFreeList = nullptr;
+        return;
+    }
+
+    // Otherwise, count free blocks in each chunk. Sorting chunks by address lets us find a block's chunk with a binary search.
+    std::sort(mChunks.begin(), mChunks.end(), PtrMath::LessThan);
+    std::vector<size_t> freeCounts(mChunks.size(), 0);
+    auto findChunk = [this](void* block) {
+        return static_cast<size_t>(std::upper_bound(mChunks.begin(), mChunks.end(), block, PtrMath::LessThan) - mChunks.begin() - 1);
+    };
+    for(FreeBlock* block = mFreeList; block != nullptr; block = block->next)
+    {
+        ++freeCounts[findChunk(block)];
+    }
+
+    // Rebuild the free list, leaving out blocks from chunks that are entirely free.
+    FreeBlock* oldFreeList = mFreeList;
+    mFreeList = nullptr;
+    while(oldFreeList != nullptr)
+    {
+        FreeBlock* block = oldFreeList;
+        oldFreeList = oldFreeList->next;
+        if(freeCounts[findChunk(block)] < mBlocksPerChunk)
+        {
+            block->next = mFreeList;
+            mFreeList = block;
+        }
+    }
+
+    // Free the unused chunks.
+    size_t keptCount = 0;
+    for(size_t i = 0; i < mChunks.size(); ++i)
+    {
+        if(freeCounts[i] == mBlocksPerChunk)
+        {
+            ::operator delete(mChunks[i]);
+        }
+        else
+        {
+            mChunks[keptCount] = mChunks[i];
+            ++keptCount;
+        }
+    }
+    mChunks.resize(keptCount);
+}
+
+void PoolAllocator::AllocateChunk()
+{
+    // The default operator new guarantees alignment suitable for any type, so blocks are all aligned too.
+    void* chunk = ::operator new(mBlockSize * mBlocksPerChunk);
+    mChunks.push_back(chunk);
+
+    // Add all blocks in the chunk to the free list (in reverse, so the first allocations are in address order).
+    for(size_t i = mBlocksPerChunk; i > 0; --i)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(PtrMath::Add(chunk, static_cast<int>((i - 1) * mBlockSize)));
+        block->next = mFreeList;
+        mFreeList = block;
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Clark Kromenaker
+//
+// Allocates fixed-size blocks of memory.
+//
+// Blocks are carved out of larger chunks, which are allocated as needed.
+// Deallocated blocks are put on a free list and reused by later allocations.
+//
+// Because all blocks are the same size, allocating and deallocating are very fast and there's no fragmentation.
+// But the allocator can only be used for allocations of up to the block size.
+//
+#pragma once
+#include <cstddef>
+#include <vector>
+
+class PoolAllocator
+{
+public:
+    PoolAllocator(size_t blockSize, size_t blocksPerChunk);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* Allocate();
+    void Deallocate(void* memory);
+
+    // Frees any chunks that have no allocated blocks.
+    void ReleaseUnusedChunks();
+
+    size_t GetBlockSize() const { return mBlockSize; }
+    size_t GetAllocationCount() const { return mAllocationCount; }
+    size_t GetChunkCount() const { return mChunks.size(); }
+
+private:
+    // When a block is free, its memory is used to point to the next free block.
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    // Size of each block, and how many blocks are in each chunk.
+    size_t mBlockSize = 0;
+    size_t mBlocksPerChunk = 0;
+
+    // Chunks of memory that blocks are allocated from.
+    std::vector<void*> mChunks;
+
+    // Blocks that are available to be allocated.
+    FreeBlock* mFreeList = nullptr;
+
+    // Allocation stats.
+    size_t mAllocationCount = 0;
+
+    void AllocateChunk();
+};
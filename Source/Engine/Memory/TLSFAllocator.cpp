@@ -0,0 +1,354 @@
+#include "TLSFAllocator.h"
+
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    // Index of the highest set bit. Value must not be zero.
+    int FindLastSet(size_t value)
+    {
+        #if defined(_MSC_VER)
+        unsigned long index = 0;
+        #if defined(_WIN64)
+        _BitScanReverse64(&index, value);
+        #else
+        _BitScanReverse(&index, value);
+        #endif
+        return static_cast<int>(index);
+        #else
+        return 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+        #endif
+    }
+
+    // Index of the lowest set bit. Value must not be zero.
+    int FindFirstSet(uint32_t value)
+    {
+        #if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward(&index, value);
+        return static_cast<int>(index);
+        #else
+        return __builtin_ctz(value);
+        #endif
+    }
+
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    unsigned char* AlignUp(unsigned char* pointer, size_t alignment)
+    {
+        return reinterpret_cast<unsigned char*>(AlignUp(reinterpret_cast<uintptr_t>(pointer), alignment));
+    }
+}
+
+TLSFAllocator::TLSFAllocator(void* memory, size_t size) :
+    mMemory(memory),
+    mSize(size)
+{
+    Reset();
+}
+
+void* TLSFAllocator::Allocate(size_t size, unsigned short alignment)
+{
+    // Alignment must be a power of two.
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    // Figure out how big a block we need: header plus requested size, rounded up to block alignment.
+    size_t blockSize = AlignUp(size + kHeaderSize, kBlockAlignment);
+    if(blockSize < kMinBlockSize)
+    {
+        blockSize = kMinBlockSize;
+    }
+
+    // Blocks are always aligned well enough for small alignments.
+    // For bigger alignments, find a block with enough extra room that we can split off a free block in front to get aligned.
+    size_t searchSize = blockSize;
+    if(alignment > kBlockAlignment)
+    {
+        searchSize += alignment + kMinBlockSize;
+    }
+
+    BlockHeader* block = FindFreeBlock(searchSize);
+    if(block == nullptr)
+    {
+        return nullptr;
+    }
+    RemoveFreeBlock(block);
+
+    // Split off a free block in front, if needed for alignment.
+    if(alignment > kBlockAlignment)
+    {
+        unsigned char* memory = reinterpret_cast<unsigned char*>(block) + kHeaderSize;
+        unsigned char* alignedMemory = AlignUp(memory, alignment);
+
+        // The gap must be big enough to be its own free block.
+        size_t gap = static_cast<size_t>(alignedMemory - memory);
+        if(gap > 0 && gap < kMinBlockSize)
+        {
+            alignedMemory = AlignUp(memory + kMinBlockSize, alignment);
+            gap = static_cast<size_t>(alignedMemory - memory);
+        }
+
+        if(gap > 0)
+        {
+            BlockHeader* alignedBlock = SplitBlock(block, gap);
+            block->size |= kFreeFlag;
+            InsertFreeBlock(block);
+            block = alignedBlock;
+        }
+    }
+
+    // Return any excess at the end of the block to the free lists.
+    if(GetBlockSize(block) >= blockSize + kMinBlockSize)
+    {
+        BlockHeader* remainder = SplitBlock(block, blockSize);
+        remainder->size |= kFreeFlag;
+        InsertFreeBlock(remainder);
+    }
+
+    // Mark block as used.
+    block->size &= ~kFreeFlag;
+    mAllocatedSize += GetBlockSize(block);
+    ++mAllocationCount;
+    return reinterpret_cast<unsigned char*>(block) + kHeaderSize;
+}
+
+void TLSFAllocator::Deallocate(void* memory)
+{
+    if(memory == nullptr) { return; }
+
+    // Header is stored right before the memory.
+    BlockHeader* block = reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(memory) - kHeaderSize);
+    assert((block->size & kFreeFlag) == 0);
+    mAllocatedSize -= GetBlockSize(block);
+    --mAllocationCount;
+
+    // Merge with the previous block if it's free.
+    BlockHeader* prevBlock = block->prevPhysical;
+    if(prevBlock != nullptr && (prevBlock->size & kFreeFlag) != 0)
+    {
+        RemoveFreeBlock(prevBlock);
+        prevBlock->size += GetBlockSize(block);
+        block = prevBlock;
+    }
+    else
+    {
+        block->size |= kFreeFlag;
+    }
+
+    // Merge with the next block if it's free.
+    BlockHeader* nextBlock = GetNextPhysical(block);
+    if((nextBlock->size & kFreeFlag) != 0)
+    {
+        RemoveFreeBlock(nextBlock);
+        block->size += GetBlockSize(nextBlock);
+        nextBlock = GetNextPhysical(block);
+    }
+    nextBlock->prevPhysical = block;
+
+    InsertFreeBlock(block);
+}
+
+void TLSFAllocator::Reset()
+{
+    // Clear free lists.
+    mFirstLevelBitmap = 0;
+    for(int i = 0; i < kFirstLevelCount; ++i)
+    {
+        mSecondLevelBitmaps[i] = 0;
+        for(int j = 0; j < kSecondLevelCount; ++j)
+        {
+            mFreeLists[i][j] = nullptr;
+        }
+    }
+
+    // Reset stats.
+    mAllocationCount = 0;
+    mAllocatedSize = 0;
+    mFreeSize = 0;
+    mFreeBlockCount = 0;
+
+    // Blocks must be aligned, so the usable memory may be slightly smaller than what we were given.
+    // We also reserve a header at the end: a zero-size "used" block that stops merging from running off the end.
+    unsigned char* start = AlignUp(static_cast<unsigned char*>(mMemory), kBlockAlignment);
+    unsigned char* end = static_cast<unsigned char*>(mMemory) + mSize;
+    if(end < start + kMinBlockSize + kHeaderSize) { return; }
+    size_t totalSize = (static_cast<size_t>(end - start) - kHeaderSize) & ~(kBlockAlignment - 1);
+
+    // Blocks bigger than the biggest first-level size aren't supported.
+    size_t maxBlockSize = static_cast<size_t>(1) << kMaxFirstLevelIndex;
+    if(totalSize > maxBlockSize)
+    {
+        totalSize = maxBlockSize;
+    }
+
+    // Treat all our memory as one giant free block.
+    BlockHeader* block = reinterpret_cast<BlockHeader*>(start);
+    block->prevPhysical = nullptr;
+    block->size = totalSize | kFreeFlag;
+
+    BlockHeader* sentinel = GetNextPhysical(block);
+    sentinel->prevPhysical = block;
+    sentinel->size = 0;
+
+    InsertFreeBlock(block);
+}
+
+size_t TLSFAllocator::GetLargestFreeBlockSize() const
+{
+    if(mFirstLevelBitmap == 0) { return 0; }
+
+    // The largest free block is in the highest non-empty free list.
+    int firstLevel = FindLastSet(mFirstLevelBitmap);
+    int secondLevel = FindLastSet(mSecondLevelBitmaps[firstLevel]);
+
+    // Blocks in one list can still vary in size a bit.
+    size_t largestSize = 0;
+    for(BlockHeader* block = mFreeLists[firstLevel][secondLevel]; block != nullptr; block = block->nextFree)
+    {
+        if(GetBlockSize(block) > largestSize)
+        {
+            largestSize = GetBlockSize(block);
+        }
+    }
+    return largestSize;
+}
+
+float TLSFAllocator::GetFragmentation() const
+{
+    if(mFreeSize == 0) { return 0.0f; }
+    return 1.0f - static_cast<float>(GetLargestFreeBlockSize()) / static_cast<float>(mFreeSize);
+}
+
+void TLSFAllocator::MappingInsert(size_t size, int& outFirstLevel, int& outSecondLevel)
+{
+    if(size < kSmallBlockSize)
+    {
+        // Small blocks are split linearly, so each list holds just one size.
+        outFirstLevel = 0;
+        outSecondLevel = static_cast<int>(size / kBlockAlignment);
+    }
+    else
+    {
+        // First level is the power of two; second level is the next few bits after the highest set bit.
+        int lastSet = FindLastSet(size);
+        outSecondLevel = static_cast<int>(size >> (lastSet - kSecondLevelCountLog2)) ^ kSecondLevelCount;
+        outFirstLevel = lastSet - (kFirstLevelShift - 1);
+    }
+}
+
+void TLSFAllocator::MappingSearch(size_t size, int& outFirstLevel, int& outSecondLevel)
+{
+    // Round up to the next list's size, so that ANY block in the resulting list is big enough.
+    if(size >= kSmallBlockSize)
+    {
+        size += (static_cast<size_t>(1) << (FindLastSet(size) - kSecondLevelCountLog2)) - 1;
+    }
+    MappingInsert(size, outFirstLevel, outSecondLevel);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::FindFreeBlock(size_t size)
+{
+    int firstLevel = 0;
+    int secondLevel = 0;
+    MappingSearch(size, firstLevel, secondLevel);
+    if(firstLevel >= kFirstLevelCount) { return nullptr; }
+
+    // Look for a non-empty list in this first level that's at least as big as the desired second level.
+    uint32_t secondLevelMap = mSecondLevelBitmaps[firstLevel] & (~0U << secondLevel);
+    if(secondLevelMap == 0)
+    {
+        // Nothing big enough there - use the smallest non-empty list in a higher first level.
+        uint32_t firstLevelMap = mFirstLevelBitmap & (~0U << (firstLevel + 1));
+        if(firstLevelMap == 0)
+        {
+            return nullptr;
+        }
+        firstLevel = FindFirstSet(firstLevelMap);
+        secondLevelMap = mSecondLevelBitmaps[firstLevel];
+    }
+    secondLevel = FindFirstSet(secondLevelMap);
+    return mFreeLists[firstLevel][secondLevel];
+}
+
+void TLSFAllocator::InsertFreeBlock(BlockHeader* block)
+{
+    int firstLevel = 0;
+    int secondLevel = 0;
+    MappingInsert(GetBlockSize(block), firstLevel, secondLevel);
+
+    // Add to head of the list.
+    BlockHeader* head = mFreeLists[firstLevel][secondLevel];
+    block->prevFree = nullptr;
+    block->nextFree = head;
+    if(head != nullptr)
+    {
+        head->prevFree = block;
+    }
+    mFreeLists[firstLevel][secondLevel] = block;
+
+    // This list is definitely non-empty now.
+    mFirstLevelBitmap |= (1U << firstLevel);
+    mSecondLevelBitmaps[firstLevel] |= (1U << secondLevel);
+
+    mFreeSize += GetBlockSize(block);
+    ++mFreeBlockCount;
+}
+
+void TLSFAllocator::RemoveFreeBlock(BlockHeader* block)
+{
+    int firstLevel = 0;
+    int secondLevel = 0;
+    MappingInsert(GetBlockSize(block), firstLevel, secondLevel);
+
+    // Unlink from the list.
+    if(block->prevFree != nullptr)
+    {
+        block->prevFree->nextFree = block->nextFree;
+    }
+    else
+    {
+        mFreeLists[firstLevel][secondLevel] = block->nextFree;
+    }
+    if(block->nextFree != nullptr)
+    {
+        block->nextFree->prevFree = block->prevFree;
+    }
+
+    // Clear bitmap bits if this list (and maybe first level) is empty now.
+    if(mFreeLists[firstLevel][secondLevel] == nullptr)
+    {
+        mSecondLevelBitmaps[firstLevel] &= ~(1U << secondLevel);
+        if(mSecondLevelBitmaps[firstLevel] == 0)
+        {
+            mFirstLevelBitmap &= ~(1U << firstLevel);
+        }
+    }
+
+    mFreeSize -= GetBlockSize(block);
+    --mFreeBlockCount;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::SplitBlock(BlockHeader* block, size_t size)
+{
+    // Block keeps the first "size" bytes. The rest becomes a new (used) block.
+    // Caller decides what to do with each piece.
+    BlockHeader* remainder = reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(block) + size);
+    remainder->prevPhysical = block;
+    remainder->size = GetBlockSize(block) - size;
+    block->size = size | (block->size & kFlagsMask);
+
+    GetNextPhysical(remainder)->prevPhysical = remainder;
+    return remainder;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::GetNextPhysical(BlockHeader* block)
+{
+    return reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(block) + GetBlockSize(block));
+}
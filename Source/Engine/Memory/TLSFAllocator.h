@@ -0,0 +1,108 @@
+//
+// Clark Kromenaker
+//
+// An allocator that can accommodate allocations and deallocations of any size and in any order, in constant time.
+//
+// Uses the "two-level segregated fit" (TLSF) algorithm. Free blocks are kept in many free lists, one per size range.
+// The first level splits sizes by power of two, and the second level splits each power of two range linearly.
+// A bitmap per level tracks which free lists are non-empty, so finding a big enough block is just a couple bit scans.
+//
+// Freed blocks are immediately merged with free neighbors, which keeps fragmentation low.
+//
+// Has the same interface as FreestyleAllocator, but allocate/deallocate don't slow down as the number of free blocks grows.
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+class TLSFAllocator
+{
+public:
+    TLSFAllocator(void* memory, size_t size);
+
+    void* Allocate(size_t size, unsigned short alignment = 4);
+    void Deallocate(void* memory);
+
+    void Reset();
+
+    size_t GetAllocationCount() const { return mAllocationCount; }
+    size_t GetAllocatedSize() const { return mAllocatedSize; }
+
+    // Fragmentation stats.
+    size_t GetFreeSize() const { return mFreeSize; }
+    size_t GetFreeBlockCount() const { return mFreeBlockCount; }
+    size_t GetLargestFreeBlockSize() const;
+
+    // Ranges from 0 (all free memory is in one block) to nearly 1 (free memory is split into many small blocks).
+    float GetFragmentation() const;
+
+private:
+    // Every block (free or used) starts with a header.
+    struct BlockHeader
+    {
+        // The block physically before this one in memory (null for the first block).
+        // Lets us find and merge with a free previous block when this block is freed.
+        BlockHeader* prevPhysical;
+
+        // Size of the block (including header). The low bit is used as a flag, since sizes are always a multiple of the alignment.
+        size_t size;
+
+        // Links to other free blocks in the same free list. Only valid if this block is free.
+        // In a used block, this space is part of the memory returned to the caller.
+        BlockHeader* nextFree;
+        BlockHeader* prevFree;
+    };
+
+    // Blocks are always aligned to and a multiple of this size.
+    static const size_t kBlockAlignment = 16;
+
+    // Memory returned to the caller starts this far into the block.
+    static const size_t kHeaderSize = 16;
+
+    // Smallest possible block: must be able to hold free list links.
+    static const size_t kMinBlockSize = 32;
+
+    // Flag stored in the low bit of the block size.
+    static const size_t kFreeFlag = 1;
+    static const size_t kFlagsMask = kFreeFlag;
+
+    // Each first-level range is split into this many second-level lists.
+    static const int kSecondLevelCountLog2 = 4;
+    static const int kSecondLevelCount = 1 << kSecondLevelCountLog2;
+
+    // Blocks smaller than this all go in the first first-level range, split linearly.
+    static const int kFirstLevelShift = kSecondLevelCountLog2 + 4; // log2(kBlockAlignment) == 4
+    static const size_t kSmallBlockSize = static_cast<size_t>(1) << kFirstLevelShift;
+
+    // Supports blocks of up to 4GB.
+    static const int kMaxFirstLevelIndex = 32;
+    static const int kFirstLevelCount = kMaxFirstLevelIndex - kFirstLevelShift + 2;
+
+    // The allocator's memory.
+    void* mMemory = nullptr;
+    size_t mSize = 0;
+
+    // Allocation stats.
+    size_t mAllocationCount = 0;
+    size_t mAllocatedSize = 0;
+    size_t mFreeSize = 0;
+    size_t mFreeBlockCount = 0;
+
+    // Bitmaps of which free lists have blocks in them.
+    uint32_t mFirstLevelBitmap = 0;
+    uint32_t mSecondLevelBitmaps[kFirstLevelCount] = { 0 };
+
+    // Heads of the free lists.
+    BlockHeader* mFreeLists[kFirstLevelCount][kSecondLevelCount] = { { nullptr } };
+
+    static void MappingInsert(size_t size, int& outFirstLevel, int& outSecondLevel);
+    static void MappingSearch(size_t size, int& outFirstLevel, int& outSecondLevel);
+
+    BlockHeader* FindFreeBlock(size_t size);
+    void InsertFreeBlock(BlockHeader* block);
+    void RemoveFreeBlock(BlockHeader* block);
+
+    BlockHeader* SplitBlock(BlockHeader* block, size_t size);
+    static BlockHeader* GetNextPhysical(BlockHeader* block);
+    static size_t GetBlockSize(const BlockHeader* block) { return block->size & ~kFlagsMask; }
+};
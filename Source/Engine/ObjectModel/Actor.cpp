@@ -2,6 +2,7 @@
 
 #include "Debug.h"
 #include "Component.h"
+#include "ObjectPool.h"
 #include "RectTransform.h"
 #include "SceneManager.h"
 
@@ -15,6 +16,17 @@ TYPEINFO_INIT(Actor, NoBaseClass, 30)
     TYPEINFO_VAR(Actor, VariableType::Bool, mUpdateEnabled);
 }
 
+namespace
+{
+    // All actors are allocated from this pool.
+    // It's a function static so it's guaranteed to exist before the first actor is created.
+    ObjectPool& GetActorPool()
+    {
+        static ObjectPool pool;
+        return pool;
+    }
+}
+
 Actor::Actor()
 {
     gSceneManager.AddActor(this);
@@ -60,6 +72,31 @@ Actor::~Actor()
     mComponents.clear();
 }
 
+void* Actor::operator new(size_t size)
+{
+    return GetActorPool().Allocate(size);
+}
+
+void* Actor::operator new(size_t size, std::align_val_t alignment)
+{
+    return GetActorPool().Allocate(size, alignment);
+}
+
+void Actor::operator delete(void* memory, size_t size)
+{
+    GetActorPool().Deallocate(memory, size);
+}
+
+void Actor::operator delete(void* memory, size_t size, std::align_val_t alignment)
+{
+    GetActorPool().Deallocate(memory, size, alignment);
+}
+
+void Actor::ReleaseUnusedPoolMemory()
+{
+    GetActorPool().ReleaseUnusedMemory();
+}
+
 void Actor::Update(float deltaTime)
 {
     if(IsActive() && mUpdateEnabled)
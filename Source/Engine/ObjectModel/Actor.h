@@ -4,6 +4,7 @@
 // Any object that exists in the game world and has position/rotation/scale.
 //
 #pragma once
+#include <new>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,13 @@ public:
     Actor(const std::string& name, TransformType transformType);
     virtual ~Actor();
 
+    // Actors (including subclasses) are allocated from a pool, rather than the general heap.
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, std::align_val_t alignment);
+    static void operator delete(void* memory, size_t size);
+    static void operator delete(void* memory, size_t size, std::align_val_t alignment);
+    static void ReleaseUnusedPoolMemory();
+
     void Update(float deltaTime);
     void LateUpdate(float deltaTime);
 
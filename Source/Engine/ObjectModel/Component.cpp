@@ -1,17 +1,54 @@
 #include "Component.h"
 
 #include "Actor.h"
+#include "ObjectPool.h"
 
 TYPEINFO_INIT(Component, NoBaseClass, 1)
 {
     TYPEINFO_VAR(Component, VariableType::Bool, mEnabled);
 }
 
+namespace
+{
+    // All components are allocated from this pool.
+    // It's a function static so it's guaranteed to exist before the first component is created.
+    ObjectPool& GetComponentPool()
+    {
+        static ObjectPool pool;
+        return pool;
+    }
+}
+
 Component::Component(Actor* owner) : mOwner(owner)
 {
 
 }
 
+void* Component::operator new(size_t size)
+{
+    return GetComponentPool().Allocate(size);
+}
+
+void* Component::operator new(size_t size, std::align_val_t alignment)
+{
+    return GetComponentPool().Allocate(size, alignment);
+}
+
+void Component::operator delete(void* memory, size_t size)
+{
+    GetComponentPool().Deallocate(memory, size);
+}
+
+void Component::operator delete(void* memory, size_t size, std::align_val_t alignment)
+{
+    GetComponentPool().Deallocate(memory, size, alignment);
+}
+
+void Component::ReleaseUnusedPoolMemory()
+{
+    GetComponentPool().ReleaseUnusedMemory();
+}
+
 void Component::SetEnabled(bool enabled)
 {
     if(mEnabled != enabled)
@@ -4,6 +4,9 @@
 // A component is a reusable bit of functionality that can be attached to an Actor.
 //
 #pragma once
+#include <cstddef>
+#include <new>
+
 #include "TypeInfo.h"
 
 class Actor;
@@ -15,6 +18,13 @@ public:
     Component(Actor* owner);
     virtual ~Component() = default;
 
+    // Components (including subclasses) are allocated from a pool, rather than the general heap.
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, std::align_val_t alignment);
+    static void operator delete(void* memory, size_t size);
+    static void operator delete(void* memory, size_t size, std::align_val_t alignment);
+    static void ReleaseUnusedPoolMemory();
+
     void Update(float deltaTime);
     void LateUpdate(float deltaTime);
 
@@ -251,6 +251,7 @@ void Transform::SetDirty()
 {
     mLocalToWorldDirty = true;
     mWorldToLocalDirty = true;
+    ++mChangeCount;
 
     for(auto& child : mChildren)
     {
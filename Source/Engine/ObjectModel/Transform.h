@@ -7,6 +7,7 @@
 #pragma once
 #include "Component.h"
 
+#include <cstdint>
 #include <vector>
 
 #include "Matrix4.h"
@@ -82,6 +83,10 @@ public:
 
     void SetDirty();
 
+    // Incremented whenever this transform (or any parent) changes.
+    // Lets other systems cheaply check whether something they calculated from this transform is out of date.
+    uint32_t GetChangeCount() const { return mChangeCount; }
+
 protected:
     virtual void CalcLocalPosition() { }
 
@@ -99,6 +104,7 @@ protected:
     // We only recalculate our matrices when we have to. This keeps track of that.
     bool mLocalToWorldDirty = true;
     bool mWorldToLocalDirty = true;
+    uint32_t mChangeCount = 0;
 
     // If we are a child of any other transform, parent is set.
     // If we have any children, they are in the children vector.
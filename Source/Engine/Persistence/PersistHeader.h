@@ -20,7 +20,9 @@ struct SaveHeader
     char saveId[4] = { 'S', 'A', 'V', 'E' };
 
     // Save file version.
-    int32_t saveVersion = 4;
+    // Version 5 saves topic and noun/verb counts with separate actor/noun/verb names.
+    // Version 6 stores everything after this header in compressed chunks (see SaveChunks.h).
+    int32_t saveVersion = 6;
 
     // Size of this header (after this point); always 232.
     int32_t saveHeaderSize = 232;
@@ -1,5 +1,7 @@
 #include "PersistState.h"
 
+#include <sstream>
+
 #include "IniReader.h"
 #include "IniWriter.h"
 
@@ -38,12 +40,34 @@ PersistState::PersistState(const char* filePath, PersistFormat format, PersistMo
     }
 }
 
+PersistState::PersistState(PersistMode mode, std::vector<uint8_t> bytes) :
+    mFormat(PersistFormat::Binary),
+    mMode(mode),
+    mLoadBytes(std::move(bytes))
+{
+    if(mode == PersistMode::Save)
+    {
+        mSaveStream = new std::ostringstream(std::ios::out | std::ios::binary);
+        mBinaryWriter = new BinaryWriter(mSaveStream);
+    }
+    else if(mode == PersistMode::Load)
+    {
+        mBinaryReader = new BinaryReader(mLoadBytes.data(), static_cast<uint32_t>(mLoadBytes.size()));
+    }
+}
+
 PersistState::~PersistState()
 {
     delete mBinaryReader;
     delete mBinaryWriter;
     delete mIniReader;
     delete mIniWriter;
+    delete mSaveStream;
+}
+
+std::string PersistState::GetSavedBytes() const
+{
+    return mSaveStream != nullptr ? mSaveStream->str() : std::string();
 }
 
 void PersistState::Xfer(const char* name, uint8_t* bytes, size_t bytesSize)
@@ -7,17 +7,20 @@
 #pragma once
 #include <bitset>
 #include <cstdint>
+#include <iosfwd>
 #include <set>
 #include <type_traits> // std::enable_if
 #include <utility> // std::declval
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "AssetManager.h"
 #include "BinaryReader.h"
 #include "BinaryWriter.h"
 #include "StringUtil.h" // for string maps
+#include "Symbol.h"
 
 class IniReader;
 class IniWriter;
@@ -58,6 +61,10 @@ class PersistState
 {
 public:
     PersistState(const char* filePath, PersistFormat format, PersistMode mode);
+
+    // Binary save/load to/from memory, rather than a file.
+    // When saving, the saved bytes are retrieved with GetSavedBytes. When loading, the bytes to load are passed in.
+    explicit PersistState(PersistMode mode, std::vector<uint8_t> bytes = std::vector<uint8_t>());
     ~PersistState();
 
     PersistState(PersistState& other) = delete;
@@ -121,6 +128,7 @@ public:
     template<typename T> void Xfer(const char* name, std::unordered_set<T>& set);
     template<typename T> void Xfer(const char* name, std::unordered_map<std::string, T>& map);
     template<typename T> void Xfer(const char* name, std::string_map_ci<T>& map);
+    template<typename T> void Xfer(const char* name, SymbolMap<T>& map);
     template<int T> void Xfer(const char* name, std::bitset<T>& bitset);
     template<typename T, typename U> void Xfer(const char* name, std::pair<T, U>& pair);
     void Xfer(const char* name, std::string_set_ci& set);
@@ -147,6 +155,7 @@ public:
     // Helpers
     BinaryReader* GetBinaryReader() const { return mBinaryReader; }
     BinaryWriter* GetBinaryWriter() const { return mBinaryWriter; }
+    std::string GetSavedBytes() const;
 
 private:
     PersistFormat mFormat = PersistFormat::Text;
@@ -158,6 +167,10 @@ private:
     BinaryWriter* mBinaryWriter = nullptr;
     IniWriter* mIniWriter = nullptr;
 
+    // When saving/loading to/from memory, the memory being saved to or loaded from.
+    std::ostringstream* mSaveStream = nullptr;
+    std::vector<uint8_t> mLoadBytes;
+
     int mFormatVersionNumber = 1;
 };
 
@@ -302,6 +315,33 @@ inline void PersistState::Xfer(const char* name, std::string_map_ci<T>& map)
     }
 }
 
+template<typename T>
+inline void PersistState::Xfer(const char* name, SymbolMap<T>& map)
+{
+    // Saved by name, same as a string map, since symbol IDs aren't stable between runs.
+    if(mBinaryReader != nullptr)
+    {
+        map.Clear();
+        uint64_t size = mBinaryReader->ReadULong();
+        for(uint64_t i = 0; i < size; ++i)
+        {
+            Symbol key(mBinaryReader->ReadString32());
+            T value;
+            Xfer("", value);
+            map[key] = value;
+        }
+    }
+    else if(mBinaryWriter != nullptr)
+    {
+        mBinaryWriter->WriteULong(map.Size());
+        for(auto& entry : map)
+        {
+            mBinaryWriter->WriteString32(entry.first.GetName());
+            Xfer("", entry.second);
+        }
+    }
+}
+
 template<int T>
 inline void PersistState::Xfer(const char* name, std::bitset<T>& bitset)
 {
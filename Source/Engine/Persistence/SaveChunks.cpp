@@ -0,0 +1,224 @@
+#include "SaveChunks.h"
+
+#include <cstring>
+
+#include "zlib.h"
+
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+
+#if !defined(TESTS)
+#include "ReportManager.h"
+#else
+#define LOG_ERROR(...)
+#endif
+
+namespace
+{
+    // Identifies the table of contents.
+    const char kTableOfContentsId[4] = { 'C', 'H', 'N', 'K' };
+
+    // Size of the table of contents header (id + chunk count), and of each chunk's entry in it.
+    const uint32_t kTableOfContentsHeaderSize = 8;
+    const uint32_t kTableOfContentsEntrySize = 24;
+
+    // Chunk flags.
+    const uint32_t kChunkFlagCompressed = 1;
+
+    // Limits used to reject corrupt tables of contents. Real saves have a handful of chunks, each a few MB at most.
+    const uint32_t kMaxChunkCount = 64;
+    const uint32_t kMaxChunkSize = 256 * 1024 * 1024;
+
+    // Saving happens during gameplay, so favor speed over compression ratio.
+    const int kCompressionLevel = Z_BEST_SPEED;
+
+    uint32_t CalculateChecksum(const uint8_t* data, uint32_t size)
+    {
+        uLong crc = crc32(0L, Z_NULL, 0);
+        return static_cast<uint32_t>(crc32(crc, data, size));
+    }
+}
+
+bool SaveChunk::HasId(const char* otherId) const
+{
+    return memcmp(id, otherId, 4) == 0;
+}
+
+SaveChunk SaveChunks::Create(const char* id, const uint8_t* data, uint32_t size, const std::vector<SaveChunk>& previousChunks, BinaryReader* previousReader)
+{
+    SaveChunk chunk;
+    memcpy(chunk.id, id, 4);
+    chunk.size = size;
+    chunk.checksum = CalculateChecksum(data, size);
+
+    // If this chunk hasn't changed since the previous save, no need to compress it again - just read its stored data.
+    if(previousReader != nullptr)
+    {
+        for(const SaveChunk& previousChunk : previousChunks)
+        {
+            if(previousChunk.HasId(id) && previousChunk.size == chunk.size && previousChunk.checksum == chunk.checksum)
+            {
+                SaveChunk reusedChunk = previousChunk;
+                if(ReadChunk(*previousReader, reusedChunk))
+                {
+                    chunk.compressed = reusedChunk.compressed;
+                    chunk.storedData = std::move(reusedChunk.storedData);
+                    return chunk;
+                }
+                break;
+            }
+        }
+    }
+
+    // Compress the data. If that doesn't make it any smaller (e.g. the thumbnail, which is already PNG compressed), just store it as-is.
+    uLongf compressedSize = compressBound(size);
+    chunk.storedData.resize(compressedSize);
+    int result = compress2(chunk.storedData.data(), &compressedSize, data, size, kCompressionLevel);
+    if(result == Z_OK && compressedSize < size)
+    {
+        chunk.compressed = true;
+        chunk.storedData.resize(compressedSize);
+    }
+    else
+    {
+        chunk.compressed = false;
+        chunk.storedData.assign(data, data + size);
+    }
+    return chunk;
+}
+
+void SaveChunks::Write(BinaryWriter& writer, const std::vector<SaveChunk>& chunks)
+{
+    // Chunk offsets are relative to the start of the table of contents.
+    // The first chunk's data comes right after the table of contents.
+    uint32_t offset = kTableOfContentsHeaderSize + kTableOfContentsEntrySize * static_cast<uint32_t>(chunks.size());
+
+    writer.Write(kTableOfContentsId, 4);
+    writer.WriteUInt(static_cast<uint32_t>(chunks.size()));
+    for(const SaveChunk& chunk : chunks)
+    {
+        writer.Write(chunk.id, 4);
+        writer.WriteUInt(chunk.compressed ? kChunkFlagCompressed : 0);
+        writer.WriteUInt(offset);
+        writer.WriteUInt(static_cast<uint32_t>(chunk.storedData.size()));
+        writer.WriteUInt(chunk.size);
+        writer.WriteUInt(chunk.checksum);
+        offset += static_cast<uint32_t>(chunk.storedData.size());
+    }
+
+    for(const SaveChunk& chunk : chunks)
+    {
+        writer.Write(chunk.storedData.data(), static_cast<uint32_t>(chunk.storedData.size()));
+    }
+}
+
+bool SaveChunks::ReadTableOfContents(BinaryReader& reader, std::vector<SaveChunk>& outChunks)
+{
+    uint32_t tableOfContentsPosition = reader.GetPosition();
+    uint64_t fileLength = reader.GetLength();
+
+    char id[4] = { 0 };
+    reader.Read(id, 4);
+    if(memcmp(id, kTableOfContentsId, 4) != 0)
+    {
+        LOG_ERROR("Save file has an invalid table of contents.");
+        return false;
+    }
+
+    // The chunk count must be sane, and the whole table of contents must be in the file.
+    uint32_t chunkCount = reader.ReadUInt();
+    uint64_t tableOfContentsEnd = tableOfContentsPosition + kTableOfContentsHeaderSize + static_cast<uint64_t>(kTableOfContentsEntrySize) * chunkCount;
+    if(!reader.CanRead() || chunkCount > kMaxChunkCount || tableOfContentsEnd > fileLength)
+    {
+        LOG_ERROR("Save file table of contents is truncated.");
+        return false;
+    }
+
+    for(uint32_t i = 0; i < chunkCount; ++i)
+    {
+        SaveChunk& chunk = outChunks.emplace_back();
+        reader.Read(chunk.id, 4);
+        chunk.compressed = (reader.ReadUInt() & kChunkFlagCompressed) != 0;
+        uint64_t offset = tableOfContentsPosition + static_cast<uint64_t>(reader.ReadUInt());
+        chunk.storedSize = reader.ReadUInt();
+        chunk.size = reader.ReadUInt();
+        chunk.checksum = reader.ReadUInt();
+
+        // Each chunk's data must be after the table of contents and within the file.
+        if(offset < tableOfContentsEnd || offset + chunk.storedSize > fileLength || chunk.size > kMaxChunkSize)
+        {
+            LOG_ERROR("Save file chunk %.4s is corrupt.", chunk.id);
+            outChunks.clear();
+            return false;
+        }
+        chunk.offset = static_cast<uint32_t>(offset);
+    }
+
+    if(!reader.CanRead())
+    {
+        LOG_ERROR("Save file table of contents is truncated.");
+        outChunks.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SaveChunks::ReadChunk(BinaryReader& reader, SaveChunk& chunk)
+{
+    // Don't trust the stored size until we know the data is actually in the file.
+    reader.Seek(chunk.offset);
+    if(static_cast<uint64_t>(chunk.offset) + chunk.storedSize > reader.GetLength())
+    {
+        LOG_ERROR("Save file chunk %.4s is truncated.", chunk.id);
+        return false;
+    }
+    chunk.storedData.resize(chunk.storedSize);
+    if(reader.Read(chunk.storedData.data(), chunk.storedSize) != chunk.storedSize)
+    {
+        LOG_ERROR("Save file chunk %.4s is truncated.", chunk.id);
+        return false;
+    }
+    return true;
+}
+
+bool SaveChunks::Decompress(const SaveChunk& chunk, std::vector<uint8_t>& outData)
+{
+    if(chunk.size > kMaxChunkSize)
+    {
+        LOG_ERROR("Save file chunk %.4s has an unexpected size.", chunk.id);
+        return false;
+    }
+
+    size_t start = outData.size();
+    outData.resize(start + chunk.size);
+    uint8_t* data = outData.data() + start;
+    if(chunk.compressed)
+    {
+        uLongf size = chunk.size;
+        int result = uncompress(data, &size, chunk.storedData.data(), static_cast<uLong>(chunk.storedData.size()));
+        if(result != Z_OK || size != chunk.size)
+        {
+            LOG_ERROR("Failed to decompress save file chunk %.4s: %i", chunk.id, result);
+            outData.resize(start);
+            return false;
+        }
+    }
+    else
+    {
+        if(chunk.storedData.size() != chunk.size)
+        {
+            LOG_ERROR("Save file chunk %.4s has an unexpected size.", chunk.id);
+            outData.resize(start);
+            return false;
+        }
+        memcpy(data, chunk.storedData.data(), chunk.size);
+    }
+
+    if(CalculateChecksum(data, chunk.size) != chunk.checksum)
+    {
+        LOG_ERROR("Save file chunk %.4s is corrupt.", chunk.id);
+        outData.resize(start);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+//
+// Clark Kromenaker
+//
+// From save version 6, everything after the save header is stored in "chunks" (e.g. persist header, game state, scene state).
+// Each chunk is zlib compressed separately, and a table of contents at the start lists where each chunk is in the file.
+//
+// This means the save/load screens can read just the persist header chunk, without reading or decompressing the rest of the save.
+// And when overwriting a save, any chunk that hasn't changed since the previous save is copied over as-is, rather than compressed again.
+// Only the previous save's table of contents is read to find those; a chunk's data is only read if it's going to be reused.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class BinaryReader;
+class BinaryWriter;
+
+struct SaveChunk
+{
+    // Four character identifier (e.g. "HEAD").
+    char id[4] = { 0 };
+
+    // Size and CRC32 of the chunk's data, uncompressed.
+    uint32_t size = 0;
+    uint32_t checksum = 0;
+
+    // If false, the chunk's data is stored uncompressed (e.g. when compressing it didn't make it any smaller).
+    bool compressed = false;
+
+    // Where the chunk's data is in the file, and its size there. Only set when read from a table of contents.
+    uint32_t offset = 0;
+    uint32_t storedSize = 0;
+
+    // The chunk's data, as stored in the file (so, compressed if "compressed" is true).
+    std::vector<uint8_t> storedData;
+
+    bool HasId(const char* otherId) const;
+};
+
+namespace SaveChunks
+{
+    // Creates a chunk from uncompressed data.
+    // If a chunk in previousChunks (a previous save's table of contents) has the same id, size, and checksum,
+    // its stored data is read from previousReader and reused, rather than compressing again.
+    SaveChunk Create(const char* id, const uint8_t* data, uint32_t size, const std::vector<SaveChunk>& previousChunks, BinaryReader* previousReader);
+
+    // Writes a table of contents, followed by each chunk's stored data.
+    void Write(BinaryWriter& writer, const std::vector<SaveChunk>& chunks);
+
+    // Reads a table of contents (at the reader's current position). This doesn't read any chunk's data.
+    // Fails if any chunk doesn't fit in the file or is unreasonably large, so a corrupt save can't cause huge allocations.
+    bool ReadTableOfContents(BinaryReader& reader, std::vector<SaveChunk>& outChunks);
+
+    // Reads a chunk's stored data, using the offset from the table of contents.
+    bool ReadChunk(BinaryReader& reader, SaveChunk& chunk);
+
+    // Decompresses a chunk's stored data, appending it to outData. Fails if the data doesn't match the chunk's size and checksum.
+    bool Decompress(const SaveChunk& chunk, std::vector<uint8_t>& outData);
+}
@@ -1,5 +1,7 @@
 #include "SaveManager.h"
 
+#include <memory>
+
 #include "ActionManager.h"
 #include "FileSystem.h"
 #include "GameProgress.h"
@@ -13,6 +15,7 @@
 #include "ProgressBar.h"
 #include "Renderer.h"
 #include "ReportManager.h"
+#include "SaveChunks.h"
 #include "SceneManager.h"
 #include "SheepManager.h"
 #include "Sidney.h"
@@ -67,6 +70,71 @@ namespace
             return a.filePath.compare(b.filePath) > 0;
         }
     };
+
+    // From save version 6, everything after the save header is stored in chunks.
+    // These are the chunk ids, in the order they're stored (and loaded) in.
+    // Game state is split up by subsystem, since most saves only change some of it. (Early version 6 saves have one "GAME" chunk instead.)
+    const char* kHeaderChunkId = "HEAD";
+    const char* kEngineChunkId = "ENGN";
+    const char* kLocationChunkId = "LOCN";
+    const char* kInventoryChunkId = "INVT";
+    const char* kProgressChunkId = "PROG";
+    const char* kActionsChunkId = "ACTN";
+    const char* kTimersChunkId = "TIMR";
+    const char* kSidneyChunkId = "SIDN";
+    const char* kSceneChunkId = "SCNE";
+    const char* kSheepChunkId = "SHEP";
+
+    // Opens a save file for loading and reads its save header.
+    // Returns a persist state for reading everything after the save header, or null if the save file is corrupt.
+    //
+    // From save version 6, the rest of the save is in compressed chunks. Those are decompressed into memory, so the rest of the save can be read in order, like older versions.
+    // If headerOnly is true, only the persist header chunk is read; the other chunks aren't read or decompressed at all.
+    PersistState* OpenSaveForLoad(const std::string& path, SaveHeader& outSaveHeader, bool headerOnly)
+    {
+        PersistState* fileState = new PersistState(path.c_str(), PersistFormat::Binary, PersistMode::Load);
+        outSaveHeader.OnPersist(*fileState);
+        if(outSaveHeader.saveVersion < 6)
+        {
+            return fileState;
+        }
+
+        std::vector<SaveChunk> chunks;
+        std::vector<uint8_t> bytes;
+        bool succeeded = SaveChunks::ReadTableOfContents(*fileState->GetBinaryReader(), chunks);
+        for(SaveChunk& chunk : chunks)
+        {
+            if(!succeeded) { break; }
+            if(headerOnly && !chunk.HasId(kHeaderChunkId)) { continue; }
+            succeeded = SaveChunks::ReadChunk(*fileState->GetBinaryReader(), chunk) && SaveChunks::Decompress(chunk, bytes);
+        }
+        delete fileState;
+
+        if(!succeeded)
+        {
+            LOG_ERROR("Failed to read save file %s.", path.c_str());
+            return nullptr;
+        }
+        return new PersistState(PersistMode::Load, std::move(bytes));
+    }
+
+    // Opens an existing save file and reads its table of contents, so that any chunks that don't change when it is overwritten can be reused.
+    // Only the table of contents is read here. A chunk's data is only read if it turns out to be unchanged.
+    // Returns null if there's no previous save (or it's too old or corrupt to reuse anything from).
+    std::unique_ptr<PersistState> OpenPreviousChunks(const std::string& path, std::vector<SaveChunk>& outChunks)
+    {
+        if(!File::Exists(path)) { return nullptr; }
+
+        std::unique_ptr<PersistState> ps(new PersistState(path.c_str(), PersistFormat::Binary, PersistMode::Load));
+        SaveHeader saveHeader;
+        saveHeader.OnPersist(*ps);
+        if(saveHeader.saveVersion < 6 || !SaveChunks::ReadTableOfContents(*ps->GetBinaryReader(), outChunks))
+        {
+            outChunks.clear();
+            return nullptr;
+        }
+        return ps;
+    }
 }
 
 SaveManager gSaveManager;
@@ -234,12 +302,14 @@ void SaveManager::RescanSaveDirectory()
     for(std::string& saveFileName : saveFileNames)
     {
         // Load in the relevant data.
+        // Only the headers are needed here, so skip reading the rest of the save.
         std::string path = Path::Combine({ Paths::GetUserDataPath(), "Save Games", saveFileName });
-        PersistState ps(path.c_str(), PersistFormat::Binary, PersistMode::Load);
-
-        // Read in save header.
         SaveHeader saveHeader;
-        saveHeader.OnPersist(ps);
+        std::unique_ptr<PersistState> ps(OpenSaveForLoad(path, saveHeader, true));
+        if(ps == nullptr)
+        {
+            continue;
+        }
 
         //TODO: If we detect that this save file is not valid with the current version of the game (based on SaveHeader data), skip it.
 
@@ -247,7 +317,7 @@ void SaveManager::RescanSaveDirectory()
         mSaves.emplace_back();
         mSaves.back().filePath = path;
         mSaves.back().saveHeader = saveHeader;
-        mSaves.back().persistHeader.OnPersist(ps);
+        mSaves.back().persistHeader.OnPersist(*ps);
 
         // We do allow saves that don't use the standard naming convention (saveXXXX.gk3).
         // However, only those with the standard naming convention are used to derive the next save number.
@@ -305,7 +375,8 @@ void SaveManager::SaveInternal(const std::string& saveDescription)
     std::string savePath = Path::Combine({ saveFolderPath, fileName });
 
     // Create the persistinator.
-    PersistState ps(savePath.c_str(), PersistFormat::Binary, PersistMode::Save);
+    // Everything is saved to memory first, so it can be split into chunks and compressed before writing to disk.
+    PersistState ps(PersistMode::Save);
 
     // Create save header for the save.
     // I don't really see a reason/need to use non-default values for almost everything in there!
@@ -316,6 +387,7 @@ void SaveManager::SaveInternal(const std::string& saveDescription)
 
     // Write out the save header.
     saveHeader.OnPersist(ps);
+    uint32_t saveHeaderEnd = ps.GetBinaryWriter()->GetPosition();
 
     // Create the persist header.
     PersistHeader persistHeader;
@@ -343,22 +415,65 @@ void SaveManager::SaveInternal(const std::string& saveDescription)
 
     // Write out the persist header.
     persistHeader.OnPersist(ps);
+    uint32_t persistHeaderEnd = ps.GetBinaryWriter()->GetPosition();
 
     // Set the save format version number to save with.
     ps.SetFormatVersionNumber(saveHeader.saveVersion);
 
     // Persist the ENTIRE game...
-    OnPersist(ps);
+    std::vector<ChunkEnd> gameChunkEnds;
+    OnPersist(ps, &gameChunkEnds);
+    uint32_t gameEnd = ps.GetBinaryWriter()->GetPosition();
 
     // And also persist scene data.
+    uint32_t sceneEnd = gameEnd;
     Scene* scene = gSceneManager.GetScene();
     if(scene != nullptr)
     {
         scene->OnPersist(ps);
+        sceneEnd = ps.GetBinaryWriter()->GetPosition();
 
         // Save running sheep scripts.
         gSheepManager.OnPersist(ps);
     }
+    std::string bytes = ps.GetSavedBytes();
+
+    // Split everything after the save header into chunks.
+    // If overwriting a save, chunks that haven't changed since then are reused, rather than compressed again.
+    {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+        uint32_t end = static_cast<uint32_t>(bytes.size());
+        std::vector<SaveChunk> chunks;
+        {
+            // The previous save must be closed before it's overwritten below.
+            std::vector<SaveChunk> previousChunks;
+            std::unique_ptr<PersistState> previousSave = OpenPreviousChunks(savePath, previousChunks);
+            BinaryReader* previousReader = previousSave != nullptr ? previousSave->GetBinaryReader() : nullptr;
+
+            chunks.push_back(SaveChunks::Create(kHeaderChunkId, data + saveHeaderEnd, persistHeaderEnd - saveHeaderEnd, previousChunks, previousReader));
+            uint32_t chunkStart = persistHeaderEnd;
+            for(const ChunkEnd& chunkEnd : gameChunkEnds)
+            {
+                chunks.push_back(SaveChunks::Create(chunkEnd.id, data + chunkStart, chunkEnd.end - chunkStart, previousChunks, previousReader));
+                chunkStart = chunkEnd.end;
+            }
+            if(scene != nullptr)
+            {
+                chunks.push_back(SaveChunks::Create(kSceneChunkId, data + gameEnd, sceneEnd - gameEnd, previousChunks, previousReader));
+                chunks.push_back(SaveChunks::Create(kSheepChunkId, data + sceneEnd, end - sceneEnd, previousChunks, previousReader));
+            }
+        }
+
+        // The save header is written as-is, followed by the chunks.
+        BinaryWriter writer(savePath.c_str());
+        writer.Write(data, saveHeaderEnd);
+        SaveChunks::Write(writer, chunks);
+        if(!writer.CanWrite())
+        {
+            LOG_ERROR("Failed to write save file %s.", savePath.c_str());
+            return;
+        }
+    }
     LOG_GENERIC("Saved to file %s.", savePath.c_str());
 
     // Update entry in save list.
@@ -390,11 +505,13 @@ void SaveManager::SaveInternal(const std::string& saveDescription)
 
 void SaveManager::LoadInternal(const std::string& loadPath)
 {
-    mLoadPersistState = new PersistState(loadPath.c_str(), PersistFormat::Binary, PersistMode::Load);
-
     // Read past save header.
     SaveHeader saveHeader;
-    saveHeader.OnPersist(*mLoadPersistState);
+    mLoadPersistState = OpenSaveForLoad(loadPath, saveHeader, false);
+    if(mLoadPersistState == nullptr)
+    {
+        return;
+    }
 
     // Store the save version number in the PersistState.
     // This allows load code to detect which version of the save file this is to try to stay compatible.
@@ -408,6 +525,11 @@ void SaveManager::LoadInternal(const std::string& loadPath)
 
     // Ok, looks like we will actually load this save!
     // Let's unload the current scene to start with a clean slate.
+    // If the save is in the current location and timeblock (e.g. a quick load), the scene's assets will almost all be used again, so retain them.
+    // Saves before version 4 don't restore BSP or walker boundary state, so those must be freshly loaded.
+    bool retainSceneAssets = saveHeader.saveVersion >= 4 && gSceneManager.GetScene() != nullptr &&
+                             StringUtil::EqualsIgnoreCase(persistHeader.location, gLocationManager.GetLocation()) &&
+                             StringUtil::EqualsIgnoreCase(persistHeader.timeblock, gGameProgress.GetTimeblock().ToString());
     gSceneManager.UnloadScene([this, loadPath](){
 
         // Load everything!
@@ -419,6 +541,9 @@ void SaveManager::LoadInternal(const std::string& loadPath)
             gGameProgress.StartTimeblock(gGameProgress.GetTimeblock(), true, nullptr);
             LOG_GENERIC("Loaded save file %s.", loadPath.c_str());
             delete mLoadPersistState;
+
+            // No scene is loaded until the timeblock screen is done, so there's no point holding onto the previous scene's assets.
+            gAssetManager.UnloadAssets(AssetScope::Retained);
         }
         else
         {
@@ -444,29 +569,43 @@ void SaveManager::LoadInternal(const std::string& loadPath)
                 LOG_GENERIC("Loaded save file %s.", loadPath.c_str());
             }, false);
         }
-    });
+    }, retainSceneAssets);
 }
 
-void SaveManager::OnPersist(PersistState& ps)
+void SaveManager::OnPersist(PersistState& ps, std::vector<ChunkEnd>* outChunkEnds)
 {
+    auto endChunk = [&ps, outChunkEnds](const char* id) {
+        if(outChunkEnds != nullptr)
+        {
+            outChunkEnds->push_back({ id, ps.GetBinaryWriter()->GetPosition() });
+        }
+    };
+
     // OK, so the original GK3 had quite an impressive generalized save system. Via RTTI, it would save/load almost every class in the game!
     // This is very cool for a variety of reasons (being able to quick save/load at virtually any moment and get the correct load result).
     //
     // HOWEVER, for simplicities sake, I'm going to go with a less complex approach for now:
     // Just save important progress data and use that to reload the scene.
     GEngine::Instance()->OnPersist(ps);
+    endChunk(kEngineChunkId);
     gLocationManager.OnPersist(ps);
+    endChunk(kLocationChunkId);
     gInventoryManager.OnPersist(ps);
+    endChunk(kInventoryChunkId);
     gGameProgress.OnPersist(ps);
+    endChunk(kProgressChunkId);
     gActionManager.OnPersist(ps);
+    endChunk(kActionsChunkId);
 
     // Game timers were added in save version 3 and higher.
     if(ps.GetFormatVersionNumber() >= 3)
     {
         GameTimers::OnPersist(ps);
+        endChunk(kTimersChunkId);
     }
 
     // The Sidney UI is somewhat unique in that it actually stores some important state data in there.
     // Maybe its a sign that a "SidneyManager" would make sense? Shrug.
     gGK3UI.GetSidney()->OnPersist(ps);
+    endChunk(kSidneyChunkId);
 }
\ No newline at end of file
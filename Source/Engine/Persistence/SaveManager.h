@@ -115,7 +115,14 @@ private:
     void SaveInternal(const std::string& saveDescription);
     void LoadInternal(const std::string& loadPath);
 
-    void OnPersist(PersistState& ps);
+    // When saving, game state is split into a chunk per subsystem, so chunks that haven't changed can be reused on the next save.
+    // If provided, this is filled in with each chunk's id and where its data ends.
+    struct ChunkEnd
+    {
+        const char* id = nullptr;
+        uint32_t end = 0;
+    };
+    void OnPersist(PersistState& ps, std::vector<ChunkEnd>* outChunkEnds = nullptr);
 };
 
 extern SaveManager gSaveManager;
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "AABBTree.h"
+
+#include <cfloat>
+
+#include "Collisions.h"
+#include "GMath.h"
+#include "Ray.h"
+
+namespace
+{
+    AABB Union(const AABB& a, const AABB& b)
+    {
+        AABB result = a;
+        result.GrowToContain(b.GetMin());
+        result.GrowToContain(b.GetMax());
+        return result;
+    }
+
+    float SurfaceArea(const AABB& aabb)
+    {
+        Vector3 size = aabb.GetSize();
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return outer.ContainsPoint(inner.GetMin()) && outer.ContainsPoint(inner.GetMax());
+    }
+}
+
+int AABBTree::Insert(const AABB& aabb, void* userData)
+{
+    int proxyId = AllocateNode();
+    Vector3 margin(kFatMargin, kFatMargin, kFatMargin);
+    mNodes[proxyId].aabb = AABB(aabb.GetMin() - margin, aabb.GetMax() + margin);
+    mNodes[proxyId].userData = userData;
+    mNodes[proxyId].height = 0;
+    InsertLeaf(proxyId);
+    return proxyId;
+}
+
+void AABBTree::Remove(int proxyId)
+{
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+}
+
+bool AABBTree::Move(int proxyId, const AABB& aabb)
+{
+    // Still fits, so nothing to do.
+    if(Contains(mNodes[proxyId].aabb, aabb)) { return false; }
+
+    // Otherwise, reinsert with a new fat AABB.
+    RemoveLeaf(proxyId);
+    Vector3 margin(kFatMargin, kFatMargin, kFatMargin);
+    mNodes[proxyId].aabb = AABB(aabb.GetMin() - margin, aabb.GetMax() + margin);
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void AABBTree::Raycast(const Ray& ray, float maxRayT, const std::function<float(int proxyId)>& callback) const
+{
+    if(mRootIndex == kNullProxy) { return; }
+
+    // Dividing by zero gives infinity, which the slab test handles fine.
+    Vector3 invDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+    // Nodes still to visit, along with the t at which the ray enters them.
+    struct StackEntry
+    {
+        int nodeIndex;
+        float rayT;
+    };
+    std::vector<StackEntry> stack;
+    stack.reserve(64);
+
+    float rayT = 0.0f;
+    if(!Intersect::TestRayAABB(ray.origin, invDirection, mNodes[mRootIndex].aabb, maxRayT, rayT)) { return; }
+    stack.push_back({ mRootIndex, rayT });
+
+    while(!stack.empty())
+    {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+
+        // The callback may have shortened the ray since this node was pushed.
+        if(entry.rayT > maxRayT) { continue; }
+
+        const Node& node = mNodes[entry.nodeIndex];
+        if(node.IsLeaf())
+        {
+            maxRayT = Math::Min(maxRayT, callback(entry.nodeIndex));
+            continue;
+        }
+
+        // Visit the closer child first (by pushing it last).
+        float rayT1 = 0.0f;
+        float rayT2 = 0.0f;
+        bool hit1 = Intersect::TestRayAABB(ray.origin, invDirection, mNodes[node.child1].aabb, maxRayT, rayT1);
+        bool hit2 = Intersect::TestRayAABB(ray.origin, invDirection, mNodes[node.child2].aabb, maxRayT, rayT2);
+        if(hit1 && hit2)
+        {
+            if(rayT1 < rayT2)
+            {
+                stack.push_back({ node.child2, rayT2 });
+                stack.push_back({ node.child1, rayT1 });
+            }
+            else
+            {
+                stack.push_back({ node.child1, rayT1 });
+                stack.push_back({ node.child2, rayT2 });
+            }
+        }
+        else if(hit1)
+        {
+            stack.push_back({ node.child1, rayT1 });
+        }
+        else if(hit2)
+        {
+            stack.push_back({ node.child2, rayT2 });
+        }
+    }
+}
+
+int AABBTree::AllocateNode()
+{
+    // Reuse a free node if there is one.
+    if(mFreeListIndex != kNullProxy)
+    {
+        int nodeIndex = mFreeListIndex;
+        mFreeListIndex = mNodes[nodeIndex].parent;
+        mNodes[nodeIndex] = Node();
+        return nodeIndex;
+    }
+
+    mNodes.emplace_back();
+    return static_cast<int>(mNodes.size()) - 1;
+}
+
+void AABBTree::FreeNode(int nodeIndex)
+{
+    mNodes[nodeIndex].userData = nullptr;
+    mNodes[nodeIndex].height = -1;
+    mNodes[nodeIndex].parent = mFreeListIndex;
+    mFreeListIndex = nodeIndex;
+}
+
+void AABBTree::InsertLeaf(int leafIndex)
+{
+    if(mRootIndex == kNullProxy)
+    {
+        mRootIndex = leafIndex;
+        mNodes[leafIndex].parent = kNullProxy;
+        return;
+    }
+
+    // Walk down the tree to find the best sibling for the new leaf.
+    // At each level, compare the cost (increase in surface area) of pairing with this node vs. descending into either child.
+    AABB leafAABB = mNodes[leafIndex].aabb;
+    int index = mRootIndex;
+    while(!mNodes[index].IsLeaf())
+    {
+        const Node& node = mNodes[index];
+        float area = SurfaceArea(node.aabb);
+        float combinedArea = SurfaceArea(Union(node.aabb, leafAABB));
+
+        // Cost of creating a new parent for this node and the new leaf.
+        float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down - this node's AABB grows either way.
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        int children[2] = { node.child1, node.child2 };
+        for(int i = 0; i < 2; ++i)
+        {
+            const Node& child = mNodes[children[i]];
+            float childCombinedArea = SurfaceArea(Union(child.aabb, leafAABB));
+            if(child.IsLeaf())
+            {
+                childCosts[i] = childCombinedArea + inheritanceCost;
+            }
+            else
+            {
+                childCosts[i] = (childCombinedArea - SurfaceArea(child.aabb)) + inheritanceCost;
+            }
+        }
+
+        // Stop here if pairing with this node is cheapest.
+        if(cost < childCosts[0] && cost < childCosts[1]) { break; }
+        index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+    }
+
+    // Create a new parent for the sibling and the leaf.
+    int siblingIndex = index;
+    int oldParentIndex = mNodes[siblingIndex].parent;
+    int newParentIndex = AllocateNode();
+    mNodes[newParentIndex].parent = oldParentIndex;
+    mNodes[newParentIndex].aabb = Union(leafAABB, mNodes[siblingIndex].aabb);
+    mNodes[newParentIndex].height = mNodes[siblingIndex].height + 1;
+    mNodes[newParentIndex].child1 = siblingIndex;
+    mNodes[newParentIndex].child2 = leafIndex;
+    mNodes[siblingIndex].parent = newParentIndex;
+    mNodes[leafIndex].parent = newParentIndex;
+
+    if(oldParentIndex == kNullProxy)
+    {
+        mRootIndex = newParentIndex;
+    }
+    else if(mNodes[oldParentIndex].child1 == siblingIndex)
+    {
+        mNodes[oldParentIndex].child1 = newParentIndex;
+    }
+    else
+    {
+        mNodes[oldParentIndex].child2 = newParentIndex;
+    }
+
+    // Ancestors now need bigger AABBs, and may need rebalancing.
+    RefitAncestors(newParentIndex);
+}
+
+void AABBTree::RemoveLeaf(int leafIndex)
+{
+    if(leafIndex == mRootIndex)
+    {
+        mRootIndex = kNullProxy;
+        return;
+    }
+
+    // The leaf's parent goes away, and the leaf's sibling takes its place.
+    int parentIndex = mNodes[leafIndex].parent;
+    int grandParentIndex = mNodes[parentIndex].parent;
+    int siblingIndex = mNodes[parentIndex].child1 == leafIndex ? mNodes[parentIndex].child2 : mNodes[parentIndex].child1;
+    if(grandParentIndex == kNullProxy)
+    {
+        mRootIndex = siblingIndex;
+        mNodes[siblingIndex].parent = kNullProxy;
+        FreeNode(parentIndex);
+        return;
+    }
+
+    if(mNodes[grandParentIndex].child1 == parentIndex)
+    {
+        mNodes[grandParentIndex].child1 = siblingIndex;
+    }
+    else
+    {
+        mNodes[grandParentIndex].child2 = siblingIndex;
+    }
+    mNodes[siblingIndex].parent = grandParentIndex;
+    FreeNode(parentIndex);
+
+    // Ancestors may now be able to shrink, and may need rebalancing.
+    RefitAncestors(grandParentIndex);
+}
+
+void AABBTree::RefitAncestors(int nodeIndex)
+{
+    int index = nodeIndex;
+    while(index != kNullProxy)
+    {
+        index = Balance(index);
+
+        Node& node = mNodes[index];
+        node.height = 1 + Math::Max(mNodes[node.child1].height, mNodes[node.child2].height);
+        node.aabb = Union(mNodes[node.child1].aabb, mNodes[node.child2].aabb);
+        index = node.parent;
+    }
+}
+
+int AABBTree::Balance(int nodeIndex)
+{
+    // Performs a left or right rotation if the subtree at this node is imbalanced.
+    // Returns the index of the node now at the top of this subtree.
+    int iA = nodeIndex;
+    Node& a = mNodes[iA];
+    if(a.IsLeaf() || a.height < 2) { return iA; }
+
+    int iB = a.child1;
+    int iC = a.child2;
+    Node& b = mNodes[iB];
+    Node& c = mNodes[iC];
+    int balance = c.height - b.height;
+
+    // C is too tall - rotate it up.
+    if(balance > 1)
+    {
+        int iF = c.child1;
+        int iG = c.child2;
+        Node& f = mNodes[iF];
+        Node& g = mNodes[iG];
+
+        // Swap A and C.
+        c.child1 = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+        if(c.parent == kNullProxy)
+        {
+            mRootIndex = iC;
+        }
+        else if(mNodes[c.parent].child1 == iA)
+        {
+            mNodes[c.parent].child1 = iC;
+        }
+        else
+        {
+            mNodes[c.parent].child2 = iC;
+        }
+
+        // The taller of C's children stays with C; the other moves to A.
+        if(f.height > g.height)
+        {
+            c.child2 = iF;
+            a.child2 = iG;
+            g.parent = iA;
+            a.aabb = Union(b.aabb, g.aabb);
+            c.aabb = Union(a.aabb, f.aabb);
+            a.height = 1 + Math::Max(b.height, g.height);
+            c.height = 1 + Math::Max(a.height, f.height);
+        }
+        else
+        {
+            c.child2 = iG;
+            a.child2 = iF;
+            f.parent = iA;
+            a.aabb = Union(b.aabb, f.aabb);
+            c.aabb = Union(a.aabb, g.aabb);
+            a.height = 1 + Math::Max(b.height, f.height);
+            c.height = 1 + Math::Max(a.height, g.height);
+        }
+        return iC;
+    }
+
+    // B is too tall - rotate it up.
+    if(balance < -1)
+    {
+        int iD = b.child1;
+        int iE = b.child2;
+        Node& d = mNodes[iD];
+        Node& e = mNodes[iE];
+
+        // Swap A and B.
+        b.child1 = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+        if(b.parent == kNullProxy)
+        {
+            mRootIndex = iB;
+        }
+        else if(mNodes[b.parent].child1 == iA)
+        {
+            mNodes[b.parent].child1 = iB;
+        }
+        else
+        {
+            mNodes[b.parent].child2 = iB;
+        }
+
+        // The taller of B's children stays with B; the other moves to A.
+        if(d.height > e.height)
+        {
+            b.child2 = iD;
+            a.child1 = iE;
+            e.parent = iA;
+            a.aabb = Union(c.aabb, e.aabb);
+            b.aabb = Union(a.aabb, d.aabb);
+            a.height = 1 + Math::Max(c.height, e.height);
+            b.height = 1 + Math::Max(a.height, d.height);
+        }
+        else
+        {
+            b.child2 = iE;
+            a.child1 = iD;
+            d.parent = iA;
+            a.aabb = Union(c.aabb, d.aabb);
+            b.aabb = Union(a.aabb, e.aabb);
+            a.height = 1 + Math::Max(c.height, d.height);
+            b.height = 1 + Math::Max(a.height, e.height);
+        }
+        return iB;
+    }
+    return iA;
+}
@@ -0,0 +1,81 @@
+//
+// Clark Kromenaker
+//
+// A dynamic AABB tree, for quickly finding which of many moving objects a ray might hit.
+//
+// Each object inserted gets a "proxy" - a leaf in the tree with an AABB slightly larger than the object's ("fat" AABB).
+// Because of that extra margin, small movements don't require any changes to the tree - only moving outside the fat AABB does.
+// When a leaf is inserted, it goes where it least increases the tree's total surface area, and rotations keep the tree balanced.
+//
+// The tree only answers "might the ray hit this?" - callers still do precise tests against the objects it finds.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "AABB.h"
+
+class Ray;
+
+class AABBTree
+{
+public:
+    static const int kNullProxy = -1;
+
+    // Adds an object with the given AABB, returning the proxy ID used to refer to it.
+    int Insert(const AABB& aabb, void* userData);
+
+    // Removes a proxy from the tree. The proxy ID may be reused by later inserts.
+    void Remove(int proxyId);
+
+    // Updates a proxy's AABB. If the AABB still fits within the proxy's fat AABB, nothing changes and this returns false.
+    bool Move(int proxyId, const AABB& aabb);
+
+    void* GetUserData(int proxyId) const { return mNodes[proxyId].userData; }
+    const AABB& GetFatAABB(int proxyId) const { return mNodes[proxyId].aabb; }
+
+    // Calls the callback for each proxy whose fat AABB the ray hits before maxRayT, roughly in order of distance.
+    // The callback returns the max t to continue searching to - return the closest hit so far to skip anything farther away.
+    void Raycast(const Ray& ray, float maxRayT, const std::function<float(int proxyId)>& callback) const;
+
+    int GetHeight() const { return mRootIndex != kNullProxy ? mNodes[mRootIndex].height : 0; }
+
+private:
+    // How much to expand AABBs by, in each direction.
+    static constexpr float kFatMargin = 4.0f;
+
+    struct Node
+    {
+        // For leaves, the fat AABB of the object. For internal nodes, the AABB containing both children.
+        AABB aabb;
+
+        // For leaves, the object this proxy refers to.
+        void* userData = nullptr;
+
+        // Parent node. For nodes in the free list, the next free node instead.
+        int parent = kNullProxy;
+
+        // Children of internal nodes. Leaves have none.
+        int child1 = kNullProxy;
+        int child2 = kNullProxy;
+
+        // Leaves have height 0. A height of -1 means the node is free.
+        int height = -1;
+
+        bool IsLeaf() const { return child1 == kNullProxy; }
+    };
+
+    // All nodes - leaves, internal nodes, and free nodes.
+    std::vector<Node> mNodes;
+    int mRootIndex = kNullProxy;
+    int mFreeListIndex = kNullProxy;
+
+    int AllocateNode();
+    void FreeNode(int nodeIndex);
+
+    void InsertLeaf(int leafIndex);
+    void RemoveLeaf(int leafIndex);
+    void RefitAncestors(int nodeIndex);
+    int Balance(int nodeIndex);
+};
@@ -0,0 +1,81 @@
+#include "CollisionMesh.h"
+
+#include <algorithm>
+
+#include "AABB.h"
+#include "Collisions.h"
+#include "Ray.h"
+#include "Sphere.h"
+
+void CollisionMesh::AddTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+{
+    mPositions.insert(mPositions.end(), { p0.x, p0.y, p0.z, p1.x, p1.y, p1.z, p2.x, p2.y, p2.z });
+}
+
+void CollisionMesh::Build()
+{
+    mBVH.Build(mPositions.data(), nullptr, GetTriangleCount());
+}
+
+Triangle CollisionMesh::GetTriangle(uint32_t index) const
+{
+    const float* p = &mPositions[index * 9];
+    return Triangle(Vector3(p[0], p[1], p[2]), Vector3(p[3], p[4], p[5]), Vector3(p[6], p[7], p[8]));
+}
+
+void CollisionMesh::Query(const AABB& aabb, std::vector<uint32_t>& outTriangleIndexes) const
+{
+    // Sort results, so callers that check "t < closestT" resolve ties the same way as checking every triangle in order.
+    size_t firstResult = outTriangleIndexes.size();
+    mBVH.Query(aabb, outTriangleIndexes);
+    std::sort(outTriangleIndexes.begin() + firstResult, outTriangleIndexes.end());
+}
+
+bool CollisionMesh::Raycast(const Ray& ray, float& outRayT, uint32_t& outTriangleIndex) const
+{
+    float u = 0.0f;
+    float v = 0.0f;
+    return mBVH.Raycast(ray, outRayT, outTriangleIndex, u, v);
+}
+
+bool CollisionMesh::SweepSphere(const Sphere& sphere, const Vector3& velocity, float maxT, float& outT, Vector3& outCollisionNormal, Triangle& outTriangle) const
+{
+    // Only triangles within the volume swept by the sphere can be hit.
+    Vector3 radius(sphere.radius, sphere.radius, sphere.radius);
+    AABB sweptAABB = AABB::FromPoints(sphere.center, sphere.center + velocity * maxT);
+    sweptAABB = AABB(sweptAABB.GetMin() - radius, sweptAABB.GetMax() + radius);
+
+    mQueryResults.clear();
+    Query(sweptAABB, mQueryResults);
+
+    bool collided = false;
+    outT = maxT;
+    for(uint32_t triangleIndex : mQueryResults)
+    {
+        Triangle triangle = GetTriangle(triangleIndex);
+
+        // Check collision and record the t/normal if it's smaller than any previously discovered one.
+        float sphereT = 0.0f;
+        Vector3 normal;
+        if(Collide::SphereTriangle(sphere, triangle, velocity, sphereT, normal))
+        {
+            // If a triangle reports a negative-t collision, it means we are already intersecting it.
+            // We better be actively intersecting in this case.
+            //TODO: Probably Collide::SphereTriangle should handle this internally?
+            Vector3 intersectPoint;
+            if(sphereT < 0.0f && !Intersect::TestSphereTriangle(sphere, triangle, intersectPoint))
+            {
+                continue;
+            }
+
+            if(sphereT < outT)
+            {
+                collided = true;
+                outT = sphereT;
+                outCollisionNormal = normal;
+                outTriangle = triangle;
+            }
+        }
+    }
+    return collided;
+}
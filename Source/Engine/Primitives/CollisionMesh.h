@@ -0,0 +1,48 @@
+//
+// Clark Kromenaker
+//
+// A static set of triangles for collision queries (e.g. camera collision against invisible bounds geometry).
+//
+// Triangles are added once, then Build creates a BVH over them. After that, queries only test triangles near the query shape,
+// rather than every triangle in the mesh. Triangles can't be changed after building - this is for geometry that never moves.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Triangle.h"
+#include "TriangleBVH.h"
+
+class AABB;
+class Ray;
+class Sphere;
+
+class CollisionMesh
+{
+public:
+    void AddTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2);
+    void Build();
+
+    uint32_t GetTriangleCount() const { return static_cast<uint32_t>(mPositions.size() / 9); }
+    Triangle GetTriangle(uint32_t index) const;
+
+    // Finds all triangles whose bounds might overlap the AABB, in the order they were added.
+    void Query(const AABB& aabb, std::vector<uint32_t>& outTriangleIndexes) const;
+
+    // Finds the closest triangle hit by the ray.
+    bool Raycast(const Ray& ray, float& outRayT, uint32_t& outTriangleIndex) const;
+
+    // Moves a sphere by a velocity, and finds the first triangle it collides with before maxT (a fraction of the velocity).
+    // A sphere that already intersects a triangle collides with it at a negative t.
+    bool SweepSphere(const Sphere& sphere, const Vector3& velocity, float maxT, float& outT, Vector3& outCollisionNormal, Triangle& outTriangle) const;
+
+private:
+    // Nine floats (three points) per triangle.
+    std::vector<float> mPositions;
+
+    // Accelerates queries. Built over mPositions.
+    TriangleBVH mBVH;
+
+    // Reused between queries, to avoid allocating each time.
+    mutable std::vector<uint32_t> mQueryResults;
+};
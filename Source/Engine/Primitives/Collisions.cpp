@@ -1,5 +1,13 @@
 #include "Collisions.h"
 
+#include <cmath>
+
+// SSE2 is always available on x64, but not on other platforms (e.g. ARM).
+#if defined(__SSE2__) || defined(_M_X64)
+#define USE_SSE_TRIANGLE_TESTS
+#include <emmintrin.h>
+#endif
+
 #include "AABB.h"
 #include "Debug.h"
 #include "Frustum.h"
@@ -11,6 +19,7 @@
 #include "Rect.h"
 #include "Sphere.h"
 #include "Triangle.h"
+#include "TriangleBatch.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
@@ -122,14 +131,16 @@ bool Intersect::TestSphereLine(const Sphere& s, const Line& l, int& numIntersect
 
 bool Intersect::TestAABBAABB(const AABB& aabb1, const AABB& aabb2)
 {
-    // There are 4 cases where the AABBs are not intersecting.
+    // There are 6 cases where the AABBs are not intersecting - separated on either side of each axis.
     bool case1 = aabb1.GetMax().x < aabb2.GetMin().x;
     bool case2 = aabb1.GetMin().x > aabb2.GetMax().x;
     bool case3 = aabb1.GetMax().y < aabb2.GetMin().y;
     bool case4 = aabb1.GetMin().y > aabb2.GetMax().y;
+    bool case5 = aabb1.GetMax().z < aabb2.GetMin().z;
+    bool case6 = aabb1.GetMin().z > aabb2.GetMax().z;
 
     // If none of those cases are true, they must be intersecting.
-    return !case1 && !case2 && !case3 && !case4;
+    return !case1 && !case2 && !case3 && !case4 && !case5 && !case6;
 }
 
 bool Intersect::TestPlanePlane(const Plane& p1, const Plane& p2)
@@ -207,6 +218,35 @@ bool Intersect::TestRayAABB(const Ray& r, const AABB& aabb, float& outRayT)
     return true;
 }
 
+bool Intersect::TestRayAABB(const Vector3& rayOrigin, const Vector3& rayInvDirection, const AABB& aabb, float maxRayT, float& outRayT)
+{
+    Vector3 min = aabb.GetMin();
+    Vector3 max = aabb.GetMax();
+
+    float t1 = (min.x - rayOrigin.x) * rayInvDirection.x;
+    float t2 = (max.x - rayOrigin.x) * rayInvDirection.x;
+    float t3 = (min.y - rayOrigin.y) * rayInvDirection.y;
+    float t4 = (max.y - rayOrigin.y) * rayInvDirection.y;
+    float t5 = (min.z - rayOrigin.z) * rayInvDirection.z;
+    float t6 = (max.z - rayOrigin.z) * rayInvDirection.z;
+
+    // If the ray is parallel to an axis and starts exactly on that axis' slab boundary, some of these are NaN (zero times infinity).
+    // fmin/fmax ignore NaNs, so that axis just doesn't constrain the result - as if the ray were inside the slab.
+    float tMin = std::fmax(std::fmax(std::fmin(t1, t2), std::fmin(t3, t4)), std::fmin(t5, t6));
+    float tMax = std::fmin(std::fmin(std::fmax(t1, t2), std::fmax(t3, t4)), std::fmax(t5, t6));
+
+    // Clamp to the part of the ray we care about.
+    tMin = std::fmax(tMin, 0.0f);
+    tMax = std::fmin(tMax, maxRayT);
+    if(tMin > tMax)
+    {
+        return false;
+    }
+
+    outRayT = tMin;
+    return true;
+}
+
 bool Intersect::TestRayTriangle(const Ray& r, const Triangle& t, float& outRayT)
 {
     return TestRayTriangle(r, t.p0, t.p1, t.p2, outRayT);
@@ -249,6 +289,95 @@ bool Intersect::TestRayTriangle(const Ray& r, const Vector3& p0, const Vector3&
     return true;
 }
 
+int Intersect::TestRayTriangleBlock(const Ray& r, const TriangleBlock& block, bool frontFacesOnly, float outRayT[4], float outU[4], float outV[4])
+{
+    // This is the same math as TestRayTriangle - see there for more details.
+    #if defined(USE_SSE_TRIANGLE_TESTS)
+    __m128 dirX = _mm_set1_ps(r.direction.x);
+    __m128 dirY = _mm_set1_ps(r.direction.y);
+    __m128 dirZ = _mm_set1_ps(r.direction.z);
+    __m128 e1X = _mm_load_ps(block.edge1[0]);
+    __m128 e1Y = _mm_load_ps(block.edge1[1]);
+    __m128 e1Z = _mm_load_ps(block.edge1[2]);
+    __m128 e2X = _mm_load_ps(block.edge2[0]);
+    __m128 e2Y = _mm_load_ps(block.edge2[1]);
+    __m128 e2Z = _mm_load_ps(block.edge2[2]);
+
+    // p = dir x e2
+    __m128 pX = _mm_sub_ps(_mm_mul_ps(dirY, e2Z), _mm_mul_ps(dirZ, e2Y));
+    __m128 pY = _mm_sub_ps(_mm_mul_ps(dirZ, e2X), _mm_mul_ps(dirX, e2Z));
+    __m128 pZ = _mm_sub_ps(_mm_mul_ps(dirX, e2Y), _mm_mul_ps(dirY, e2X));
+    __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1X, pX), _mm_mul_ps(e1Y, pY)), _mm_mul_ps(e1Z, pZ));
+
+    // Parallel to the triangle plane is not a hit. For front faces only, "a" must also be positive.
+    __m128 epsilon = _mm_set1_ps(Math::kEpsilon);
+    __m128 mask;
+    if(frontFacesOnly)
+    {
+        mask = _mm_cmpge_ps(a, epsilon);
+    }
+    else
+    {
+        __m128 absA = _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+        mask = _mm_cmpge_ps(absA, epsilon);
+    }
+    __m128 f = _mm_div_ps(_mm_set1_ps(1.0f), a);
+
+    // s = origin - p0
+    __m128 sX = _mm_sub_ps(_mm_set1_ps(r.origin.x), _mm_load_ps(block.p0[0]));
+    __m128 sY = _mm_sub_ps(_mm_set1_ps(r.origin.y), _mm_load_ps(block.p0[1]));
+    __m128 sZ = _mm_sub_ps(_mm_set1_ps(r.origin.z), _mm_load_ps(block.p0[2]));
+    __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sX, pX), _mm_mul_ps(sY, pY)), _mm_mul_ps(sZ, pZ)));
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+    // q = s x e1
+    __m128 qX = _mm_sub_ps(_mm_mul_ps(sY, e1Z), _mm_mul_ps(sZ, e1Y));
+    __m128 qY = _mm_sub_ps(_mm_mul_ps(sZ, e1X), _mm_mul_ps(sX, e1Z));
+    __m128 qZ = _mm_sub_ps(_mm_mul_ps(sX, e1Y), _mm_mul_ps(sY, e1X));
+    __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qX), _mm_mul_ps(dirY, qY)), _mm_mul_ps(dirZ, qZ)));
+    mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+    __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2X, qX), _mm_mul_ps(e2Y, qY)), _mm_mul_ps(e2Z, qZ)));
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+
+    _mm_storeu_ps(outRayT, t);
+    _mm_storeu_ps(outU, u);
+    _mm_storeu_ps(outV, v);
+    return _mm_movemask_ps(mask);
+    #else
+    // Without SSE, just test each lane in turn. The loops are simple enough that the compiler may vectorize them anyway.
+    int hitMask = 0;
+    for(int lane = 0; lane < TriangleBlock::kWidth; ++lane)
+    {
+        Vector3 e1(block.edge1[0][lane], block.edge1[1][lane], block.edge1[2][lane]);
+        Vector3 e2(block.edge2[0][lane], block.edge2[1][lane], block.edge2[2][lane]);
+        Vector3 p = Vector3::Cross(r.direction, e2);
+        float a = Vector3::Dot(e1, p);
+        if(frontFacesOnly ? (a < Math::kEpsilon) : Math::IsZero(a)) { continue; }
+
+        float f = 1.0f / a;
+        Vector3 s = r.origin - Vector3(block.p0[0][lane], block.p0[1][lane], block.p0[2][lane]);
+        float u = f * Vector3::Dot(s, p);
+        if(u < 0.0f || u > 1.0f) { continue; }
+
+        Vector3 q = Vector3::Cross(s, e1);
+        float v = f * Vector3::Dot(r.direction, q);
+        if(v < 0.0f || u + v > 1.0f) { continue; }
+
+        float t = f * Vector3::Dot(e2, q);
+        if(t < 0.0f) { continue; }
+
+        outRayT[lane] = t;
+        outU[lane] = u;
+        outV[lane] = v;
+        hitMask |= (1 << lane);
+    }
+    return hitMask;
+    #endif
+}
+
 bool Intersect::LineLine2D(const Vector2& line0P0, const Vector2& line0P1, const Vector2& line1P0, const Vector2& line1P1, float& outLine0T)
 {
     //TODO: I regret not commenting this code when it was added! Figure out what the algorithm is here, and why it works.
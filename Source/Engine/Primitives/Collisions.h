@@ -17,6 +17,7 @@ class Ray;
 class Rect;
 class Sphere;
 class Triangle;
+struct TriangleBlock;
 class Vector2;
 class Vector3;
 
@@ -58,9 +59,15 @@ namespace Intersect
 
     // Ray
     bool TestRayAABB(const Ray& r, const AABB& aabb, float& outRayT);
+    // Faster variant for testing one ray against many AABBs: takes a precomputed inverse direction, and ignores hits beyond maxRayT.
+    // Gives the t at which the ray enters the AABB (zero if the ray starts inside it).
+    bool TestRayAABB(const Vector3& rayOrigin, const Vector3& rayInvDirection, const AABB& aabb, float maxRayT, float& outRayT);
     bool TestRayTriangle(const Ray& r, const Triangle& t, float& outRayT);
     bool TestRayTriangle(const Ray& r, const Vector3& p0, const Vector3& p1, const Vector3& p2, float& outRayT);
     bool TestRayTriangle(const Ray& r, const Vector3& p0, const Vector3& p1, const Vector3& p2, float& outRayT, float& outU, float& outV);
+    // Same test as TestRayTriangle, but against all four triangles in a block at once (using SIMD, where available).
+    // Returns a bitmask of triangles hit (bit N = lane N). The t/u/v values are only valid for lanes that were hit.
+    int TestRayTriangleBlock(const Ray& r, const TriangleBlock& block, bool frontFacesOnly, float outRayT[4], float outU[4], float outV[4]);
 
     //bool TestRaySphere(const Ray& r, const Sphere& s);
     //bool TestRayPlane(const Ray& r, const Plane& p);
@@ -0,0 +1,242 @@
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "Collisions.h"
+#include "Ray.h"
+
+namespace
+{
+    void GetTriangle(uint32_t triangleIndex, const float* positions, const unsigned short* indexes, Vector3& p0, Vector3& p1, Vector3& p2)
+    {
+        uint32_t offset = triangleIndex * 3;
+        uint32_t i0 = indexes != nullptr ? indexes[offset] : offset;
+        uint32_t i1 = indexes != nullptr ? indexes[offset + 1] : offset + 1;
+        uint32_t i2 = indexes != nullptr ? indexes[offset + 2] : offset + 2;
+        p0 = Vector3(positions[i0 * 3], positions[i0 * 3 + 1], positions[i0 * 3 + 2]);
+        p1 = Vector3(positions[i1 * 3], positions[i1 * 3 + 1], positions[i1 * 3 + 2]);
+        p2 = Vector3(positions[i2 * 3], positions[i2 * 3 + 1], positions[i2 * 3 + 2]);
+    }
+
+    void GrowToContain(AABB& aabb, const AABB& other)
+    {
+        aabb.GrowToContain(other.GetMin());
+        aabb.GrowToContain(other.GetMax());
+    }
+}
+
+void TriangleBVH::Build(const float* positions, const unsigned short* indexes, uint32_t triangleCount)
+{
+    mNodes.clear();
+    mBatch.Clear();
+    mTriangles.resize(triangleCount);
+    if(triangleCount == 0) { return; }
+
+    // Splitting is done on triangle centroids, so calculate those up front.
+    std::vector<Vector3> centroids(triangleCount);
+    for(uint32_t i = 0; i < triangleCount; ++i)
+    {
+        Vector3 p0, p1, p2;
+        GetTriangle(i, positions, indexes, p0, p1, p2);
+        centroids[i] = (p0 + p1 + p2) / 3.0f;
+        mTriangles[i] = i;
+    }
+
+    // A binary tree with one triangle per leaf has 2N-1 nodes, so that's the most we'll need.
+    mNodes.reserve(triangleCount * 2);
+    BuildNode(0, triangleCount, centroids, positions, indexes);
+
+    // Pack each leaf's triangles into their own blocks.
+    for(Node& node : mNodes)
+    {
+        if(node.count == 0) { continue; }
+        mBatch.EndBlock();
+        node.firstBlock = mBatch.GetBlockCount();
+        for(uint32_t i = node.start; i < node.start + node.count; ++i)
+        {
+            Vector3 p0, p1, p2;
+            GetTriangle(mTriangles[i], positions, indexes, p0, p1, p2);
+            mBatch.Add(p0, p1, p2, mTriangles[i]);
+        }
+    }
+}
+
+void TriangleBVH::Refit(const float* positions, const unsigned short* indexes)
+{
+    // Since children always come after their parent, walking backwards visits all children before their parents.
+    for(size_t i = mNodes.size(); i-- > 0;)
+    {
+        Node& node = mNodes[i];
+        if(node.count > 0)
+        {
+            node.bounds = CalculateLeafBounds(node, positions, indexes);
+            for(uint32_t j = 0; j < node.count; ++j)
+            {
+                Vector3 p0, p1, p2;
+                GetTriangle(mTriangles[node.start + j], positions, indexes, p0, p1, p2);
+                mBatch.GetBlock(node.firstBlock + j / TriangleBlock::kWidth).SetTriangle(j % TriangleBlock::kWidth, p0, p1, p2);
+            }
+        }
+        else
+        {
+            node.bounds = mNodes[i + 1].bounds;
+            GrowToContain(node.bounds, mNodes[node.start].bounds);
+        }
+    }
+}
+
+bool TriangleBVH::Raycast(const Ray& ray, float& outRayT, uint32_t& outTriangleIndex, float& outU, float& outV) const
+{
+    outRayT = FLT_MAX;
+    if(mNodes.empty()) { return false; }
+
+    // Dividing by zero gives infinity, which the slab test handles fine.
+    Vector3 invDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+    // Nodes still to visit, along with the t at which the ray enters them.
+    // Median splits keep the tree shallow (~log2(N) deep), and each level pushes at most two nodes, so this is plenty.
+    struct StackEntry
+    {
+        uint32_t nodeIndex;
+        float rayT;
+    };
+    StackEntry stack[64];
+    int stackSize = 0;
+
+    float rayT = 0.0f;
+    if(!Intersect::TestRayAABB(ray.origin, invDirection, mNodes[0].bounds, FLT_MAX, rayT)) { return false; }
+    stack[stackSize++] = { 0, rayT };
+
+    while(stackSize > 0)
+    {
+        StackEntry entry = stack[--stackSize];
+
+        // If we've since found a hit closer than where the ray enters this node, nothing in here can beat it.
+        if(entry.rayT > outRayT) { continue; }
+
+        const Node& node = mNodes[entry.nodeIndex];
+        if(node.count > 0)
+        {
+            uint32_t blockCount = (node.count + TriangleBlock::kWidth - 1) / TriangleBlock::kWidth;
+            TriangleBatchHit hit;
+            if(mBatch.Raycast(ray, node.firstBlock, blockCount, outRayT, false, hit))
+            {
+                outRayT = hit.t;
+                outTriangleIndex = hit.id;
+                outU = hit.u;
+                outV = hit.v;
+            }
+        }
+        else
+        {
+            // Visit the closer child first (by pushing it last), since a hit there lets us skip the other.
+            uint32_t firstChild = entry.nodeIndex + 1;
+            uint32_t secondChild = node.start;
+            float firstRayT = 0.0f;
+            float secondRayT = 0.0f;
+            bool hitFirst = Intersect::TestRayAABB(ray.origin, invDirection, mNodes[firstChild].bounds, outRayT, firstRayT);
+            bool hitSecond = Intersect::TestRayAABB(ray.origin, invDirection, mNodes[secondChild].bounds, outRayT, secondRayT);
+            if(hitFirst && hitSecond)
+            {
+                if(firstRayT < secondRayT)
+                {
+                    stack[stackSize++] = { secondChild, secondRayT };
+                    stack[stackSize++] = { firstChild, firstRayT };
+                }
+                else
+                {
+                    stack[stackSize++] = { firstChild, firstRayT };
+                    stack[stackSize++] = { secondChild, secondRayT };
+                }
+            }
+            else if(hitFirst)
+            {
+                stack[stackSize++] = { firstChild, firstRayT };
+            }
+            else if(hitSecond)
+            {
+                stack[stackSize++] = { secondChild, secondRayT };
+            }
+        }
+    }
+    return outRayT < FLT_MAX;
+}
+
+void TriangleBVH::Query(const AABB& aabb, std::vector<uint32_t>& outTriangleIndexes) const
+{
+    if(mNodes.empty()) { return; }
+
+    uint32_t stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0)
+    {
+        const Node& node = mNodes[stack[--stackSize]];
+        if(!Intersect::TestAABBAABB(node.bounds, aabb)) { continue; }
+
+        if(node.count > 0)
+        {
+            outTriangleIndexes.insert(outTriangleIndexes.end(), mTriangles.begin() + node.start, mTriangles.begin() + node.start + node.count);
+        }
+        else
+        {
+            uint32_t nodeIndex = static_cast<uint32_t>(&node - mNodes.data());
+            stack[stackSize++] = node.start;
+            stack[stackSize++] = nodeIndex + 1;
+        }
+    }
+}
+
+uint32_t TriangleBVH::BuildNode(uint32_t start, uint32_t count, const std::vector<Vector3>& centroids, const float* positions, const unsigned short* indexes)
+{
+    uint32_t nodeIndex = static_cast<uint32_t>(mNodes.size());
+    mNodes.emplace_back();
+    mNodes[nodeIndex].start = start;
+    mNodes[nodeIndex].count = count;
+    mNodes[nodeIndex].bounds = CalculateLeafBounds(mNodes[nodeIndex], positions, indexes);
+    if(count <= kMaxLeafTriangles) { return nodeIndex; }
+
+    // Split along the axis where the centroids are most spread out.
+    AABB centroidBounds(centroids[mTriangles[start]], centroids[mTriangles[start]]);
+    for(uint32_t i = start + 1; i < start + count; ++i)
+    {
+        centroidBounds.GrowToContain(centroids[mTriangles[i]]);
+    }
+    Vector3 size = centroidBounds.GetSize();
+    int axis = 0;
+    if(size.y > size.x) { axis = 1; }
+    if(size.z > size[axis]) { axis = 2; }
+
+    // If all centroids are in the same spot, there's no useful way to split - just keep it as one (larger) leaf.
+    if(size[axis] <= 0.0f) { return nodeIndex; }
+
+    // Split at the median, so each side gets half the triangles. This keeps the tree balanced.
+    uint32_t mid = start + count / 2;
+    std::nth_element(mTriangles.begin() + start, mTriangles.begin() + mid, mTriangles.begin() + start + count,
+                     [&centroids, axis](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    // Note that building children can reallocate mNodes, so don't hold a reference to this node across these calls.
+    BuildNode(start, mid - start, centroids, positions, indexes);
+    uint32_t secondChild = BuildNode(mid, start + count - mid, centroids, positions, indexes);
+    mNodes[nodeIndex].start = secondChild;
+    mNodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+AABB TriangleBVH::CalculateLeafBounds(const Node& node, const float* positions, const unsigned short* indexes) const
+{
+    Vector3 p0, p1, p2;
+    GetTriangle(mTriangles[node.start], positions, indexes, p0, p1, p2);
+    AABB bounds(p0, p0);
+    bounds.GrowToContain(p1);
+    bounds.GrowToContain(p2);
+    for(uint32_t i = node.start + 1; i < node.start + node.count; ++i)
+    {
+        GetTriangle(mTriangles[i], positions, indexes, p0, p1, p2);
+        bounds.GrowToContain(p0);
+        bounds.GrowToContain(p1);
+        bounds.GrowToContain(p2);
+    }
+    return bounds;
+}
@@ -0,0 +1,72 @@
+//
+// Clark Kromenaker
+//
+// A bounding volume hierarchy over a set of triangles, used to accelerate raycasts.
+//
+// Brute-force raycasting a mesh means testing every triangle. Instead, the BVH groups nearby triangles into a tree of AABBs.
+// A raycast only visits the parts of the tree whose AABBs the ray passes through, and stops descending once a closer hit is known.
+//
+// Each leaf's triangles are packed into their own TriangleBlocks, so a leaf is tested against the ray with a single SIMD test.
+// The BVH doesn't keep any pointers to vertex data - positions (and optional indexes) are passed in when building or refitting.
+// If vertex positions change, but the triangles themselves don't, call Refit rather than Build.
+// Refit updates the AABBs and packed triangles in place, which is much cheaper than rebuilding (though the tree quality degrades if vertices move a lot).
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "AABB.h"
+#include "TriangleBatch.h"
+
+class Ray;
+
+class TriangleBVH
+{
+public:
+    // Builds the tree. Positions are packed XYZ floats. Indexes are three per triangle; if null, every three vertices is a triangle.
+    void Build(const float* positions, const unsigned short* indexes, uint32_t triangleCount);
+
+    // Updates the tree for new vertex positions, keeping the same tree structure.
+    void Refit(const float* positions, const unsigned short* indexes);
+
+    // Finds the closest triangle hit by the ray.
+    bool Raycast(const Ray& ray, float& outRayT, uint32_t& outTriangleIndex, float& outU, float& outV) const;
+
+    // Finds triangles that may overlap the AABB (those in leaves whose bounds overlap it). Results are added to the vector.
+    void Query(const AABB& aabb, std::vector<uint32_t>& outTriangleIndexes) const;
+
+    bool IsBuilt() const { return !mNodes.empty(); }
+    uint32_t GetTriangleCount() const { return static_cast<uint32_t>(mTriangles.size()); }
+
+private:
+    // Leaves stop splitting at this many triangles - one block's worth.
+    static const uint32_t kMaxLeafTriangles = TriangleBlock::kWidth;
+
+    struct Node
+    {
+        // Bounds of all triangles under this node.
+        AABB bounds;
+
+        // For leaves, the first triangle in mTriangles. For internal nodes, the index of the second child.
+        // The first child of an internal node is always the next node in the list.
+        uint32_t start = 0;
+
+        // For leaves, the number of triangles. Zero for internal nodes.
+        uint32_t count = 0;
+
+        // For leaves, the first block in mBatch containing this leaf's triangles.
+        uint32_t firstBlock = 0;
+    };
+
+    // Nodes are stored depth-first, so a node's children always come after it.
+    std::vector<Node> mNodes;
+
+    // Triangle indexes, reordered so each leaf's triangles are contiguous.
+    std::vector<uint32_t> mTriangles;
+
+    // Triangle data for the leaves, ready for ray tests.
+    TriangleBatch mBatch;
+
+    uint32_t BuildNode(uint32_t start, uint32_t count, const std::vector<Vector3>& centroids, const float* positions, const unsigned short* indexes);
+    AABB CalculateLeafBounds(const Node& node, const float* positions, const unsigned short* indexes) const;
+};
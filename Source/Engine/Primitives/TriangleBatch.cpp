@@ -0,0 +1,69 @@
+#include "TriangleBatch.h"
+
+#include <cfloat>
+
+#include "Collisions.h"
+#include "Ray.h"
+
+void TriangleBlock::SetTriangle(int lane, const Vector3& point0, const Vector3& point1, const Vector3& point2)
+{
+    Vector3 e1 = point1 - point0;
+    Vector3 e2 = point2 - point0;
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        p0[axis][lane] = point0[axis];
+        edge1[axis][lane] = e1[axis];
+        edge2[axis][lane] = e2[axis];
+    }
+}
+
+void TriangleBatch::Clear()
+{
+    mBlocks.clear();
+    mNextLane = TriangleBlock::kWidth;
+}
+
+void TriangleBatch::Add(const Vector3& p0, const Vector3& p1, const Vector3& p2, uint32_t id)
+{
+    if(mNextLane >= TriangleBlock::kWidth)
+    {
+        mBlocks.emplace_back();
+        mNextLane = 0;
+    }
+
+    TriangleBlock& block = mBlocks.back();
+    block.SetTriangle(mNextLane, p0, p1, p2);
+    block.ids[mNextLane] = id;
+    ++mNextLane;
+}
+
+bool TriangleBatch::Raycast(const Ray& ray, uint32_t firstBlock, uint32_t blockCount, float maxRayT, bool frontFacesOnly, TriangleBatchHit& outHit) const
+{
+    float closestT = maxRayT;
+    bool hit = false;
+    for(uint32_t i = firstBlock; i < firstBlock + blockCount; ++i)
+    {
+        float t[TriangleBlock::kWidth];
+        float u[TriangleBlock::kWidth];
+        float v[TriangleBlock::kWidth];
+        int hitMask = Intersect::TestRayTriangleBlock(ray, mBlocks[i], frontFacesOnly, t, u, v);
+        for(int lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
+        {
+            if((hitMask & 1) != 0 && t[lane] < closestT)
+            {
+                closestT = t[lane];
+                outHit.t = t[lane];
+                outHit.u = u[lane];
+                outHit.v = v[lane];
+                outHit.id = mBlocks[i].ids[lane];
+                hit = true;
+            }
+        }
+    }
+    return hit;
+}
+
+bool TriangleBatch::Raycast(const Ray& ray, TriangleBatchHit& outHit) const
+{
+    return Raycast(ray, 0, GetBlockCount(), FLT_MAX, false, outHit);
+}
@@ -0,0 +1,74 @@
+//
+// Clark Kromenaker
+//
+// Triangles packed for fast ray intersection tests.
+//
+// Triangles are stored four at a time in "blocks", in structure-of-arrays form (all four X values together, then all Y values, etc).
+// That lets a single SIMD instruction do the same step of the ray/triangle test for all four triangles at once.
+// Each block stores the triangle's first point and its two edges, since that's what the ray/triangle test actually uses.
+//
+// Unused lanes in a block are degenerate (zero-area) triangles, which never report a hit.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class Ray;
+class Vector3;
+
+struct TriangleBlock
+{
+    static const int kWidth = 4;
+
+    // First point of each triangle, indexed [axis][lane].
+    alignas(16) float p0[3][kWidth] = { };
+
+    // Edges p1 - p0 and p2 - p0, indexed [axis][lane].
+    alignas(16) float edge1[3][kWidth] = { };
+    alignas(16) float edge2[3][kWidth] = { };
+
+    // An ID for each triangle, so the caller can tell which one was hit.
+    uint32_t ids[kWidth] = { };
+
+    void SetTriangle(int lane, const Vector3& p0, const Vector3& p1, const Vector3& p2);
+};
+
+struct TriangleBatchHit
+{
+    float t = 0.0f;
+
+    // Barycentric coordinates of the hit, as calculated by Intersect::TestRayTriangle.
+    float u = 0.0f;
+    float v = 0.0f;
+
+    // ID of the triangle hit.
+    uint32_t id = 0;
+};
+
+class TriangleBatch
+{
+public:
+    void Clear();
+
+    // Adds a triangle to the current block, starting a new block if the current one is full.
+    void Add(const Vector3& p0, const Vector3& p1, const Vector3& p2, uint32_t id);
+
+    // Leaves the rest of the current block empty, so the next triangle added starts a new block.
+    // Useful for keeping groups of triangles (e.g. a BVH leaf) in their own blocks.
+    void EndBlock() { mNextLane = TriangleBlock::kWidth; }
+
+    uint32_t GetBlockCount() const { return static_cast<uint32_t>(mBlocks.size()); }
+    TriangleBlock& GetBlock(uint32_t index) { return mBlocks[index]; }
+    const TriangleBlock& GetBlock(uint32_t index) const { return mBlocks[index]; }
+
+    // Finds the nearest triangle hit in the given range of blocks, closer than maxRayT.
+    // If frontFacesOnly is set, triangles facing away from the ray are ignored (assuming clockwise winding, like Triangle::GetNormal).
+    bool Raycast(const Ray& ray, uint32_t firstBlock, uint32_t blockCount, float maxRayT, bool frontFacesOnly, TriangleBatchHit& outHit) const;
+    bool Raycast(const Ray& ray, TriangleBatchHit& outHit) const;
+
+private:
+    std::vector<TriangleBlock> mBlocks;
+
+    // The lane in the last block that the next triangle goes in.
+    int mNextLane = TriangleBlock::kWidth;
+};
@@ -1,6 +1,7 @@
 #include "BSP.h"
 
 #include <bitset>
+#include <functional>
 #include <iostream>
 
 #include "BinaryReader.h"
@@ -153,30 +154,43 @@ bool BSP::RaycastNearest(const Ray& ray, RaycastHit& outHitInfo, bool forWalk)
     outHitInfo.t = FLT_MAX;
     std::string* closest = nullptr;
 
-    // Iterate polygons and check each one for intersection with the ray.
-    // We must iterate ALL polygons (can't stop at first hit) in case a subsequent polygon is nearer to the start of the ray.
-    for(BSPPolygon& polygon : mPolygons)
+    // Check the ray against ALL triangles (can't stop at first hit) in case a subsequent triangle is nearer to the start of the ray.
+    // Triangles are tested a block at a time. Only the (rare) hits need any further checks.
+    // Like RaycastPolygon, the ray must hit the front side of a triangle for it to count.
+    uint32_t blockCount = mRaycastBatch.GetBlockCount();
+    for(uint32_t i = 0; i < blockCount; ++i)
     {
-        // Ignore polygons that are part of non-interactive surfaces.
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(surface.interactive || (forWalk && surface.walkHitTest))
+        const TriangleBlock& block = mRaycastBatch.GetBlock(i);
+        float t[TriangleBlock::kWidth];
+        float u[TriangleBlock::kWidth];
+        float v[TriangleBlock::kWidth];
+        int hitMask = Intersect::TestRayTriangleBlock(ray, block, true, t, u, v);
+        for(int lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
         {
-            // Do the raycast against the polygon.
+            if((hitMask & 1) == 0) { continue; }
+
+            // Ignore polygons that are part of non-interactive surfaces.
+            const RaycastTriangle& triangle = mRaycastTriangles[block.ids[lane]];
+            const BSPPolygon& polygon = mPolygons[triangle.polygonIndex];
+            BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
+            if(!surface.interactive && !(forWalk && surface.walkHitTest)) { continue; }
+
+            // Hit tests can be "see through" in places.
+            if(!IsHitOpaque(polygon, triangle.fanIndex, u[lane], v[lane])) { continue; }
+
             RaycastHit hitInfo;
-            if(RaycastPolygon(ray, &polygon, hitInfo))
-            {
-                hitInfo.name = mObjectNames[surface.objectIndex];
-                RaycastTool::LogRaycastHit(hitInfo);
+            hitInfo.t = t[lane];
+            hitInfo.name = mObjectNames[surface.objectIndex];
+            RaycastTool::LogRaycastHit(hitInfo);
 
-                // Is it closer than any other polygon so far? Then it's our nearest hit.
-                if(hitInfo.t < outHitInfo.t)
-                {
-                    // Save closest distance.
-                    outHitInfo.t = hitInfo.t;
+            // Is it closer than any other hit so far? Then it's our nearest hit.
+            if(hitInfo.t < outHitInfo.t)
+            {
+                // Save closest distance.
+                outHitInfo.t = hitInfo.t;
 
-                    // Track name of closest object hit.
-                    closest = &mObjectNames[surface.objectIndex];
-                }
+                // Track name of closest object hit.
+                closest = &mObjectNames[surface.objectIndex];
             }
         }
     }
@@ -207,40 +221,9 @@ bool BSP::RaycastPolygon(const Ray& ray, const BSPPolygon* polygon, RaycastHit&
             // See if the ray intersects the triangle.
             float u = 0.0f;
             float v = 0.0f;
-            if(Intersect::TestRayTriangle(ray, p0, p1, p2, outHitInfo.t, u, v))
+            if(Intersect::TestRayTriangle(ray, p0, p1, p2, outHitInfo.t, u, v) && IsHitOpaque(*polygon, i, u, v))
             {
-                // The ray definitely hit this polygon. But if this is a hit test, we need to do more work!
-                if(mSurfaces[polygon->surfaceIndex].hitTest && mSurfaces[polygon->surfaceIndex].texture->GetRenderType() != Texture::RenderType::Opaque)
-                {
-                    // When we did the Ray/Triangle intersection test, we also calculated the barycentric coordinates as a byproduct of that test.
-                    // We can use those here to calculate the UV coordinates associated with the ray hit point.
-                    Vector2 uv0 = mUVs[mVertexIndices[polygon->vertexIndexOffset]];
-                    Vector2 uv1 = mUVs[mVertexIndices[polygon->vertexIndexOffset + i]];
-                    Vector2 uv2 = mUVs[mVertexIndices[polygon->vertexIndexOffset + i + 1]];
-
-                    //TODO: This math doesn't totally make sense to me, and I think it needs more scrutinizing.
-                    //TODO: Why do u/v/w not correlate to uv0/uv1/uv2 here? Why do we need to negate and flop the UVs?
-                    Vector2 pointUV = uv1 * u + uv2 * v + uv0 * (1.0f - u - v);
-                    pointUV.y *= -1.0f;
-                    pointUV.y = 1.0f - pointUV.y;
-
-                    // We got the UV, convert that into a specific pixel color from this polygon's surface texture.
-                    Vector2 pixelPos(pointUV.x * mSurfaces[polygon->surfaceIndex].texture->GetWidth(),
-                                     pointUV.y * mSurfaces[polygon->surfaceIndex].texture->GetHeight());
-                    Color32 color = mSurfaces[polygon->surfaceIndex].texture->GetPixelColor(pixelPos.x, pixelPos.y);
-
-                    // If the color is transparent, this doesn't count as a hit - the ray "goes through" the transparent area.
-                    // But if at all opaque, we count this as a hit.
-                    if(color != Color32::Magenta)
-                    {
-                        return true;
-                    }
-                }
-                else
-                {
-                    // This is not a hit test object, so our lives are easier. Just return that we hit it!
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -261,6 +244,20 @@ void BSP::SetFloorObjectName(const std::string& floorObjectName)
             surface.walkHitTest = true;
         }
     }
+
+    // Pack the floor's triangles for floor queries.
+    mFloorBatch.Clear();
+    for(uint32_t i = 0; i < mRaycastTriangles.size(); ++i)
+    {
+        const BSPPolygon& polygon = mPolygons[mRaycastTriangles[i].polygonIndex];
+        if(mSurfaces[polygon.surfaceIndex].objectIndex == mFloorObjectIndex)
+        {
+            uint32_t fanIndex = mRaycastTriangles[i].fanIndex;
+            mFloorBatch.Add(mVertices[mVertexIndices[polygon.vertexIndexOffset]],
+                            mVertices[mVertexIndices[polygon.vertexIndexOffset + fanIndex]],
+                            mVertices[mVertexIndices[polygon.vertexIndexOffset + fanIndex + 1]], i);
+        }
+    }
 }
 
 bool BSP::GetFloorInfo(const Vector3& position, float& outHeight, Texture*& outTexture)
@@ -279,32 +276,14 @@ bool BSP::GetFloorInfo(const Vector3& position, float& outHeight, Texture*& outT
     // Create ray with origin high in the sky and pointing straight down.
     Ray ray(rayOrigin, -Vector3::UnitY);
 
-    // Iterate polygons.
-    float nearestT = FLT_MAX;
-    for(auto& polygon : mPolygons)
-    {
-        // Only consider polygons that are part of the floor object.
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(surface.objectIndex != mFloorObjectIndex) { continue; }
+    // Find the nearest floor triangle under the position.
+    TriangleBatchHit hit;
+    if(!mFloorBatch.Raycast(ray, hit)) { return false; }
 
-        // See if ray intersects any triangles in this polygon.
-        Vector3 p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
-        for(int i = 1; i < polygon.vertexIndexCount - 1; i++)
-        {
-            Vector3 p1 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i]];
-            Vector3 p2 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i + 1]];
-            float t = 0.0f;
-            if(Intersect::TestRayTriangle(ray, p0, p1, p2, t) && t < nearestT)
-            {
-                nearestT = t;
-                outHeight = ray.GetPoint(t).y;
-                outTexture = surface.texture;
-            }
-        }
-    }
-
-    // Return whether we hit anything.
-    return nearestT != FLT_MAX;
+    const BSPPolygon& polygon = mPolygons[mRaycastTriangles[hit.id].polygonIndex];
+    outHeight = ray.GetPoint(hit.t).y;
+    outTexture = mSurfaces[polygon.surfaceIndex].texture;
+    return true;
 }
 
 void BSP::SetVisible(const std::string& objectName, bool visible)
@@ -425,32 +404,19 @@ void BSP::ApplyLightmap(const BSPLightmap& lightmap)
     }
 
     // Update light colors now that lightmap textures are populated.
+    // Each light's color is the average color of its surface's lightmap, which the lightmap calculated when it loaded.
+    // (Using a single center point of the lightmap was also tried, but averaging all pixels gives better results.)
+    const std::vector<Color32>& averageColors = lightmap.GetAverageColors();
     for(auto& light : mLights)
     {
-        if(mSurfaces[light.surfaceIndex].lightmapTexture != nullptr)
+        if(light.surfaceIndex < averageColors.size())
         {
-            int width = mSurfaces[light.surfaceIndex].lightmapTexture->GetWidth();
-            int height = mSurfaces[light.surfaceIndex].lightmapTexture->GetHeight();
-
-            // Use a single center point to calculate the color?
-            //light.color = mSurfaces[light.surfaceIndex].lightmapTexture->GetPixelColor(width / 2, height / 2);
-
-            // Or sum and average all pixels in the lightmap?
-            Vector3 sums;
-            for(int i = 0; i < width; ++i)
-            {
-                for(int j = 0; j < height; ++j)
-                {
-                    Color32 color = mSurfaces[light.surfaceIndex].lightmapTexture->GetPixelColor(i, j);
-                    sums.x += color.r;
-                    sums.y += color.g;
-                    sums.z += color.b;
-                }
-            }
-            sums /= static_cast<float>(width * height);
-            light.color = Color32(static_cast<int>(sums.x), static_cast<int>(sums.y), static_cast<int>(sums.z));
+            light.color = averageColors[light.surfaceIndex];
         }
     }
+
+    // Light colors are known, so the lights can be bucketed for lookups.
+    BuildAmbientLightGrid();
 }
 
 void BSP::DebugDrawAmbientLights(const Vector3& position)
@@ -467,13 +433,24 @@ void BSP::DebugDrawAmbientLights(const Vector3& position)
     }
 }
 
-Color32 BSP::CalculateAmbientLightColor(const Vector3& position)
+Color32 BSP::CalculateAmbientLightColor(const Vector3& position) const
 {
-    //TODO: Unclear if this logic is right - may need more work.
-    // For each ambient light, see if the position lands inside the light's "sphere of influence."
+    // Find the grid cell containing the position. Outside the grid, no light's sphere can contain the position.
     Color32 color = Color32::Black;
-    for(auto& light : mLights)
+    if(mLightGridCellStarts.empty()) { return color; }
+    int cellIndex = 0;
+    for(int axis = 2; axis >= 0; --axis)
+    {
+        float cell = (position[axis] - mLightGridMin[axis]) / mLightGridCellSize;
+        if(!(cell >= 0.0f && cell <= mLightGridCellCounts[axis])) { return color; }
+        cellIndex = cellIndex * mLightGridCellCounts[axis] + Math::Min(static_cast<int>(cell), mLightGridCellCounts[axis] - 1);
+    }
+
+    //TODO: Unclear if this logic is right - may need more work.
+    // For each ambient light near the position, see if the position lands inside the light's "sphere of influence."
+    for(uint32_t i = mLightGridCellStarts[cellIndex]; i < mLightGridCellStarts[cellIndex + 1]; ++i)
     {
+        const BSPAmbientLight& light = mLights[mLightGridLights[i]];
         float distSq = (position - light.position).GetLengthSq();
         float radiusSq = light.radius * light.radius;
         if(distSq <= radiusSq)
@@ -508,6 +485,96 @@ Color32 BSP::CalculateAmbientLightColor(const Vector3& position)
     */
 }
 
+void BSP::BuildAmbientLightGrid()
+{
+    mLightGridCellStarts.clear();
+    mLightGridLights.clear();
+    ++mAmbientLightChangeCount;
+
+    // Black lights contribute nothing, so they can be left out entirely.
+    std::vector<uint32_t> lightIndexes;
+    for(uint32_t i = 0; i < mLights.size(); ++i)
+    {
+        if(mLights[i].color.r != 0 || mLights[i].color.g != 0 || mLights[i].color.b != 0)
+        {
+            lightIndexes.push_back(i);
+        }
+    }
+    if(lightIndexes.empty()) { return; }
+
+    // The grid covers all the lights' spheres.
+    AABB gridBounds;
+    for(size_t i = 0; i < lightIndexes.size(); ++i)
+    {
+        const BSPAmbientLight& light = mLights[lightIndexes[i]];
+        Vector3 radius(light.radius, light.radius, light.radius);
+        if(i == 0)
+        {
+            gridBounds = AABB(light.position - radius, light.position + radius);
+        }
+        else
+        {
+            gridBounds.GrowToContain(light.position - radius);
+            gridBounds.GrowToContain(light.position + radius);
+        }
+    }
+    mLightGridMin = gridBounds.GetMin();
+
+    // Cells are cubes, sized so the longest axis has the max number of cells.
+    Vector3 gridSize = gridBounds.GetSize();
+    mLightGridCellSize = Math::Max(Math::Max(gridSize.x, gridSize.y), gridSize.z) / kMaxLightGridCellsPerAxis;
+    if(mLightGridCellSize <= 0.0f) { mLightGridCellSize = 1.0f; }
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        mLightGridCellCounts[axis] = Math::Clamp(Math::CeilToInt(gridSize[axis] / mLightGridCellSize), 1, kMaxLightGridCellsPerAxis);
+    }
+
+    // Calls the function for each cell overlapped by a light's sphere.
+    auto forEachCell = [this](const BSPAmbientLight& light, const std::function<void(int)>& callback) {
+        int minCell[3];
+        int maxCell[3];
+        for(int axis = 0; axis < 3; ++axis)
+        {
+            minCell[axis] = Math::Clamp(Math::FloorToInt((light.position[axis] - light.radius - mLightGridMin[axis]) / mLightGridCellSize), 0, mLightGridCellCounts[axis] - 1);
+            maxCell[axis] = Math::Clamp(Math::FloorToInt((light.position[axis] + light.radius - mLightGridMin[axis]) / mLightGridCellSize), 0, mLightGridCellCounts[axis] - 1);
+        }
+        for(int z = minCell[2]; z <= maxCell[2]; ++z)
+        {
+            for(int y = minCell[1]; y <= maxCell[1]; ++y)
+            {
+                for(int x = minCell[0]; x <= maxCell[0]; ++x)
+                {
+                    // Skip cells near the corners of the sphere's bounds, which the sphere doesn't actually reach.
+                    Vector3 cellMin = mLightGridMin + Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * mLightGridCellSize;
+                    AABB cellAABB(cellMin, cellMin + Vector3(mLightGridCellSize, mLightGridCellSize, mLightGridCellSize));
+                    if((cellAABB.GetClosestPoint(light.position) - light.position).GetLengthSq() <= light.radius * light.radius)
+                    {
+                        callback((z * mLightGridCellCounts[1] + y) * mLightGridCellCounts[0] + x);
+                    }
+                }
+            }
+        }
+    };
+
+    // Count lights per cell, convert counts to start offsets, then fill in each cell's lights.
+    int cellCount = mLightGridCellCounts[0] * mLightGridCellCounts[1] * mLightGridCellCounts[2];
+    mLightGridCellStarts.resize(cellCount + 1, 0);
+    for(uint32_t lightIndex : lightIndexes)
+    {
+        forEachCell(mLights[lightIndex], [this](int cellIndex) { ++mLightGridCellStarts[cellIndex + 1]; });
+    }
+    for(int i = 0; i < cellCount; ++i)
+    {
+        mLightGridCellStarts[i + 1] += mLightGridCellStarts[i];
+    }
+    mLightGridLights.resize(mLightGridCellStarts[cellCount]);
+    std::vector<uint32_t> cellFill(mLightGridCellStarts.begin(), mLightGridCellStarts.end() - 1);
+    for(uint32_t lightIndex : lightIndexes)
+    {
+        forEachCell(mLights[lightIndex], [this, &cellFill, lightIndex](int cellIndex) { mLightGridLights[cellFill[cellIndex]++] = lightIndex; });
+    }
+}
+
 // For debugging BSP issues, helpful to track polygons rendered and tree depth.
 namespace
 {
@@ -603,6 +670,33 @@ uint32_t BSP::GetObjectIndex(const std::string& objectName) const
     return UINT32_MAX;
 }
 
+bool BSP::IsHitOpaque(const BSPPolygon& polygon, int fanIndex, float u, float v) const
+{
+    // Only hit tests can be see-through - everything else is always a hit.
+    const BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
+    if(!surface.hitTest || surface.texture->GetRenderType() == Texture::RenderType::Opaque) { return true; }
+
+    // When we did the Ray/Triangle intersection test, we also calculated the barycentric coordinates as a byproduct of that test.
+    // We can use those here to calculate the UV coordinates associated with the ray hit point.
+    Vector2 uv0 = mUVs[mVertexIndices[polygon.vertexIndexOffset]];
+    Vector2 uv1 = mUVs[mVertexIndices[polygon.vertexIndexOffset + fanIndex]];
+    Vector2 uv2 = mUVs[mVertexIndices[polygon.vertexIndexOffset + fanIndex + 1]];
+
+    //TODO: This math doesn't totally make sense to me, and I think it needs more scrutinizing.
+    //TODO: Why do u/v/w not correlate to uv0/uv1/uv2 here? Why do we need to negate and flop the UVs?
+    Vector2 pointUV = uv1 * u + uv2 * v + uv0 * (1.0f - u - v);
+    pointUV.y *= -1.0f;
+    pointUV.y = 1.0f - pointUV.y;
+
+    // We got the UV, convert that into a specific pixel color from this polygon's surface texture.
+    Vector2 pixelPos(pointUV.x * surface.texture->GetWidth(), pointUV.y * surface.texture->GetHeight());
+    Color32 color = surface.texture->GetPixelColor(pixelPos.x, pixelPos.y);
+
+    // If the color is transparent, this doesn't count as a hit - the ray "goes through" the transparent area.
+    // But if at all opaque, we count this as a hit.
+    return color != Color32::Magenta;
+}
+
 void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
 {
     BinaryReader reader(data, dataLength);
@@ -806,6 +900,21 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
     // Create vertex array.
     mVertexArray = VertexArray(meshDefinition);
 
+    // Pack all polygon triangles for raycasts.
+    mRaycastTriangles.clear();
+    mRaycastBatch.Clear();
+    for(uint32_t i = 0; i < mPolygons.size(); ++i)
+    {
+        const BSPPolygon& polygon = mPolygons[i];
+        Vector3 p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
+        for(uint32_t j = 1; j + 1 < polygon.vertexIndexCount; ++j)
+        {
+            mRaycastBatch.Add(p0, mVertices[mVertexIndices[polygon.vertexIndexOffset + j]], mVertices[mVertexIndices[polygon.vertexIndexOffset + j + 1]],
+                              static_cast<uint32_t>(mRaycastTriangles.size()));
+            mRaycastTriangles.push_back({ i, j });
+        }
+    }
+
     // RC3 has a single notable surface that is stretched and z-fights pretty bad. It's even present in the original game.
     // Force it invisible to fix that!
     if(StringUtil::StartsWith(GetName(), "RC3") && mSurfaces.size() > 582)
@@ -16,6 +16,7 @@
 #include "Plane.h"
 #include "Ray.h"
 #include "Collisions.h"
+#include "TriangleBatch.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
@@ -153,6 +154,8 @@ class BSP : public Asset
 {
     TYPEINFO_SUB(BSP, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::BSP;
+
     BSP(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     void Load(AssetData& data);
 
@@ -178,7 +181,8 @@ public:
     // Lightmaps
     void ApplyLightmap(const BSPLightmap& lightmap);
     void DebugDrawAmbientLights(const Vector3& position);
-    Color32 CalculateAmbientLightColor(const Vector3& position);
+    Color32 CalculateAmbientLightColor(const Vector3& position) const;
+    uint32_t GetAmbientLightChangeCount() const { return mAmbientLightChangeCount; }
 
     // Rendering
     void RenderOpaque(const Vector3& cameraPosition, const Vector3& cameraDirection);
@@ -231,12 +235,39 @@ private:
     // Kind of like light probes, but way simpler/jankier.
     std::vector<BSPAmbientLight> mLights;
 
+    // Ambient lights are bucketed into a uniform grid, so calculating ambient color only checks lights near the position.
+    // Each cell lists the lights whose spheres overlap it; a cell's lights are in mLightGridLights, from its start to the next cell's start.
+    static const int kMaxLightGridCellsPerAxis = 32;
+    Vector3 mLightGridMin;
+    float mLightGridCellSize = 1.0f;
+    int mLightGridCellCounts[3] = { 0, 0, 0 };
+    std::vector<uint32_t> mLightGridCellStarts;
+    std::vector<uint32_t> mLightGridLights;
+
+    // Incremented whenever ambient lights change, so callers caching ambient colors know to recalculate.
+    uint32_t mAmbientLightChangeCount = 0;
+
     // Index of the object used for the floor in the BSP.
     uint32_t mFloorObjectIndex = UINT32_MAX;
 
+    // For raycasts, every polygon's triangles are packed for fast intersection tests.
+    // Each triangle's ID is an index into mRaycastTriangles, which identifies the polygon and triangle within the polygon's fan.
+    struct RaycastTriangle
+    {
+        uint32_t polygonIndex = 0;
+        uint32_t fanIndex = 0;
+    };
+    std::vector<RaycastTriangle> mRaycastTriangles;
+    TriangleBatch mRaycastBatch;
+
+    // Floor queries happen constantly (for every walking actor), so floor triangles get their own batch.
+    TriangleBatch mFloorBatch;
+
     uint32_t GetObjectIndex(const std::string& objectName) const;
+    bool IsHitOpaque(const BSPPolygon& polygon, int fanIndex, float u, float v) const;
 
     void ParseFromData(uint8_t* data, uint32_t dataLength);
+    void BuildAmbientLightGrid();
 
     #if defined(USE_TRUE_BSP_RENDERING)
     void RenderTree(const BSPNode& node, const Vector3& cameraPosition, const Vector3& cameraDirection);
@@ -43,6 +43,7 @@ void BSPLightmap::Load(AssetData& data)
         texture->SetFilterMode(Texture::FilterMode::Bilinear);
         texture->SetWrapMode(Texture::WrapMode::Clamp);
         mLightmapTextures.push_back(texture);
+        mAverageColors.push_back(texture->GetAverageColor());
     }
 
     /*
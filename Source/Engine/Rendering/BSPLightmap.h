@@ -16,22 +16,30 @@
 #include <string>
 #include <vector>
 
+#include "Color32.h"
+
 class Texture;
 
 class BSPLightmap : public Asset
 {
     TYPEINFO_SUB(BSPLightmap, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Textures;
+
     BSPLightmap(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~BSPLightmap();
 
     void Load(AssetData& data);
 
     const std::vector<Texture*>& GetLightmapTextures() const { return mLightmapTextures; }
+    const std::vector<Color32>& GetAverageColors() const { return mAverageColors; }
 
 private:
     // Textures loaded from the MUL file.
     // Order is important, and aligns with order of surfaces in BSP file.
     // Unlike most Textures, this asset owns these Textures, and is responsible for cleanup!
     std::vector<Texture*> mLightmapTextures;
+
+    // The average color of each lightmap texture. BSP ambient lights use these, so they're calculated once at load time.
+    std::vector<Color32> mAverageColors;
 };
\ No newline at end of file
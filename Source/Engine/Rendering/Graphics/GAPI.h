@@ -149,7 +149,7 @@ public:
     // Vertex & Index Buffers
     virtual BufferHandle CreateVertexBuffer(uint32_t vertexCount, const VertexDefinition& vertexDefinition, void* data, MeshUsage usage) = 0;
     virtual void DestroyVertexBuffer(BufferHandle handle) = 0;
-    virtual void SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data) = 0;
+    virtual void SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data) = 0;
 
     virtual BufferHandle CreateIndexBuffer(uint32_t indexCount, uint16_t* indexData, MeshUsage usage) = 0;
     virtual void DestroyIndexBuffer(BufferHandle handle) = 0;
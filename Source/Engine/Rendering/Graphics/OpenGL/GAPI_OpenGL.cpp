@@ -618,7 +618,7 @@ void GAPI_OpenGL::DestroyVertexBuffer(BufferHandle handle)
     }
 }
 
-void GAPI_OpenGL::SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data)
+void GAPI_OpenGL::SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data)
 {
     glBindBuffer(GL_ARRAY_BUFFER, static_cast<VertexBuffer*>(handle)->vbo);
     glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
@@ -47,7 +47,7 @@ public:
 
     BufferHandle CreateVertexBuffer(uint32_t vertexCount, const VertexDefinition& vertexDefinition, void* data, MeshUsage usage) override;
     void DestroyVertexBuffer(BufferHandle handle) override;
-    void SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data) override;
+    void SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data) override;
 
     BufferHandle CreateIndexBuffer(uint32_t indexCount, uint16_t* indexData, MeshUsage usage) override;
     void DestroyIndexBuffer(BufferHandle handle) override;
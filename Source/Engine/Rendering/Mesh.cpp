@@ -55,12 +55,14 @@ bool Mesh::Raycast(const Ray& ray, float& outRayT, int& outSubmeshIndex, Vector2
         for(int i = 0; i < mSubmeshes.size(); ++i)
         {
             float submeshRayT = FLT_MAX;
-            if(mSubmeshes[i]->Raycast(ray, submeshRayT, outUV))
+            Vector2 submeshUV;
+            if(mSubmeshes[i]->Raycast(ray, submeshRayT, submeshUV))
             {
                 if(submeshRayT < outRayT)
                 {
                     outRayT = submeshRayT;
                     outSubmeshIndex = i;
+                    outUV = submeshUV;
                 }
             }
         }
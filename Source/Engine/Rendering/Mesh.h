@@ -26,12 +26,15 @@ public:
     void Render(unsigned int submeshIndex);
     void Render(unsigned int submeshIndex, unsigned int offset, unsigned int count);
 
-    void SetMeshToLocalMatrix(const Matrix4& mat) { mMeshToLocalMatrix = mat; }
+    void SetMeshToLocalMatrix(const Matrix4& mat) { mMeshToLocalMatrix = mat; ++mChangeCount; }
     Matrix4& GetMeshToLocalMatrix() { return mMeshToLocalMatrix; }
 
-    void SetAABB(const AABB& aabb) { mAABB = aabb; }
+    void SetAABB(const AABB& aabb) { mAABB = aabb; ++mChangeCount; }
     const AABB& GetAABB() const { return mAABB; }
 
+    // Incremented whenever the mesh's matrix or AABB changes (e.g. during vertex animation).
+    uint32_t GetChangeCount() const { return mChangeCount; }
+
     Submesh* AddSubmesh(const MeshDefinition& meshDefinition);
 
     Submesh* GetSubmesh(int index) const { return index >= 0 && index < static_cast<int>(mSubmeshes.size()) ? mSubmeshes[index] : nullptr; }
@@ -52,4 +55,7 @@ private:
 
     // An AABB for the mesh, in its own local space.
     AABB mAABB;
+
+    // Tracks changes to the above, so cached world bounds can be updated only when needed.
+    uint32_t mChangeCount = 0;
 };
@@ -118,6 +118,7 @@ void MeshRenderer::SetModel(Model* model)
     // Clear any existing.
     mMeshes.clear();
     mMaterials.clear();
+    ++mBoundsChangeCount;
 
     // Add each mesh.
     if(model != nullptr)
@@ -138,6 +139,7 @@ void MeshRenderer::SetMesh(Mesh* mesh)
 {
     mMeshes.clear();
     mMaterials.clear();
+    ++mBoundsChangeCount;
     AddMesh(mesh);
 }
 
@@ -151,6 +153,7 @@ void MeshRenderer::AddMesh(Mesh* mesh)
 
     // Add mesh to array.
     mMeshes.push_back(mesh);
+    ++mBoundsChangeCount;
 
     // Create a material for each submesh.
     const std::vector<Submesh*>& submeshes = mesh->GetSubmeshes();
@@ -313,6 +316,65 @@ AABB MeshRenderer::GetAABB() const
     return toReturn;
 }
 
+AABB MeshRenderer::GetWorldBounds() const
+{
+    if(mMeshes.empty()) { return AABB(); }
+
+    // Calculate AABB that contains all corners of all meshes, in world space.
+    const Matrix4& localToWorldMatrix = GetOwner()->GetTransform()->GetLocalToWorldMatrix();
+    AABB toReturn;
+    for(size_t i = 0; i < mMeshes.size(); ++i)
+    {
+        Matrix4 meshToWorldMatrix = localToWorldMatrix * mMeshes[i]->GetMeshToLocalMatrix();
+
+        const AABB& meshAABB = mMeshes[i]->GetAABB();
+        Vector3 min = meshAABB.GetMin();
+        Vector3 max = meshAABB.GetMax();
+        for(int corner = 0; corner < 8; ++corner)
+        {
+            Vector3 point((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+            Vector3 worldPoint = meshToWorldMatrix.TransformPoint(point);
+            if(i == 0 && corner == 0)
+            {
+                toReturn = AABB(worldPoint, worldPoint);
+            }
+            else
+            {
+                toReturn.GrowToContain(worldPoint);
+            }
+        }
+    }
+    return toReturn;
+}
+
+uint32_t MeshRenderer::GetBoundsChangeCount() const
+{
+    // Adding up the transform and mesh change counts isn't enough - after swapping meshes, the sum could come out the same as before.
+    // Instead, compare each count to what it was last time, and bump this renderer's own count if any of them changed.
+    bool changed = false;
+    uint32_t transformChangeCount = GetOwner()->GetTransform()->GetChangeCount();
+    if(transformChangeCount != mLastTransformChangeCount)
+    {
+        mLastTransformChangeCount = transformChangeCount;
+        changed = true;
+    }
+    mLastMeshChangeCounts.resize(mMeshes.size());
+    for(size_t i = 0; i < mMeshes.size(); ++i)
+    {
+        uint32_t meshChangeCount = mMeshes[i]->GetChangeCount();
+        if(meshChangeCount != mLastMeshChangeCounts[i])
+        {
+            mLastMeshChangeCounts[i] = meshChangeCount;
+            changed = true;
+        }
+    }
+    if(changed)
+    {
+        ++mBoundsChangeCount;
+    }
+    return mBoundsChangeCount;
+}
+
 void MeshRenderer::DebugDrawAABBs(const Color32& color, const Color32& meshColor)
 {
     // The local-to-world matrix for this Actor is required for all meshes.
@@ -48,6 +48,13 @@ public:
     bool Raycast(const Ray& ray, RaycastHit& hitInfo);
 
     AABB GetAABB() const;
+
+    // Unlike GetAABB, this transforms every corner of each mesh AABB, so the result fully contains rotated meshes.
+    // Better for culling, where missing part of a mesh is not OK.
+    AABB GetWorldBounds() const;
+
+    // Changes whenever the world bounds may have changed: the transform moved, the meshes animated, or the meshes were swapped out.
+    uint32_t GetBoundsChangeCount() const;
     void DebugDrawAABBs(const Color32& color = Color32::White, const Color32& meshColor = Color32(255, 255, 132));
 
 private:
@@ -73,5 +80,11 @@ private:
     static const int kMaxSubmeshes = 64;
     std::bitset<kMaxSubmeshes> mSubmeshInvisible;
 
+    // Incremented when meshes are added or removed, or when the transform or meshes have changed since the count was last checked.
+    // The transform and mesh change counts from the last check are kept to detect that.
+    mutable uint32_t mBoundsChangeCount = 0;
+    mutable uint32_t mLastTransformChangeCount = 0;
+    mutable std::vector<uint32_t> mLastMeshChangeCounts;
+
     int GetIndexFromMeshSubmeshIndexes(int meshIndex, int submeshIndex);
 };
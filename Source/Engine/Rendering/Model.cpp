@@ -5,6 +5,7 @@
 #include <bitset>
 
 #include "BinaryReader.h"
+#include "CollisionMesh.h"
 #include "Mesh.h"
 #include "ReportManager.h"
 #include "Submesh.h"
@@ -30,6 +31,7 @@ Model::~Model()
     {
         delete mesh;
     }
+    delete mCollisionMesh;
 }
 
 void Model::Load(AssetData& data)
@@ -37,6 +39,32 @@ void Model::Load(AssetData& data)
     ParseFromData(data.bytes.get(), data.length);
 }
 
+const CollisionMesh& Model::GetCollisionMesh()
+{
+    if(mCollisionMesh == nullptr)
+    {
+        mCollisionMesh = new CollisionMesh();
+        for(auto& mesh : mMeshes)
+        {
+            Matrix4 meshToLocal = mesh->GetMeshToLocalMatrix();
+            for(auto& submesh : mesh->GetSubmeshes())
+            {
+                int triangleCount = submesh->GetTriangleCount();
+                for(int i = 0; i < triangleCount; ++i)
+                {
+                    Vector3 p0, p1, p2;
+                    if(submesh->GetTriangle(i, p0, p1, p2))
+                    {
+                        mCollisionMesh->AddTriangle(meshToLocal.TransformPoint(p0), meshToLocal.TransformPoint(p1), meshToLocal.TransformPoint(p2));
+                    }
+                }
+            }
+        }
+        mCollisionMesh->Build();
+    }
+    return *mCollisionMesh;
+}
+
 void Model::WriteToObjFile(const std::string& filePath)
 {
     std::ofstream out(filePath, std::ios::out);
@@ -423,6 +451,9 @@ void Model::ParseFromData(uint8_t* data, uint32_t dataLength)
             // Save color.
             submesh->SetColor(color);
 
+            // Models are raycast against for picking, so build the raycast BVH now rather than on first hover.
+            submesh->BuildRaycastBVH();
+
             // Next comes LODK blocks for this mesh group.
             // Not totally sure what these are for, but maybe LOD groups?
             for(uint32_t k = 0; k < lodkCount; k++)
@@ -16,12 +16,15 @@
 #include <string>
 #include <vector>
 
+class CollisionMesh;
 class Mesh;
 
 class Model : public Asset
 {
     TYPEINFO_SUB(Model, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Models;
+
     Model(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~Model();
 
@@ -31,6 +34,9 @@ public:
 
     bool IsBillboard() const { return mBillboard; }
 
+    // All of the model's triangles in local space, for collision queries. Built the first time it's requested.
+    const CollisionMesh& GetCollisionMesh();
+
     void WriteToObjFile(const std::string& filePath);
 
 private:
@@ -40,5 +46,8 @@ private:
     // If true, the model should be rendered as a billboard.
     bool mBillboard = false;
 
+    // Only created for models used for collision (like camera bounds), since most models never need it.
+    CollisionMesh* mCollisionMesh = nullptr;
+
     void ParseFromData(uint8_t* data, uint32_t dataLength);
 };
\ No newline at end of file
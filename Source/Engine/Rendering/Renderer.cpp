@@ -27,36 +27,6 @@
 
 #include "OpenGL/GAPI_OpenGL.h"
 
-// Line
-float line_vertices[] = {
-    0.0f, 0.0f, 0.0f,
-    1.0f, 1.0f, 1.0f
-};
-float line_colors[] = {
-    1.0f, 1.0f, 1.0f, 1.0f,
-    1.0f, 1.0f, 1.0f, 1.0f
-};
-Mesh* line = nullptr;
-
-// Axis
-float axis_vertices[] = {
-    0.0f, 0.0f, 0.0f,
-    5.0f, 0.0f, 0.0f,
-    0.0f, 0.0f, 0.0f,
-    0.0f, 5.0f, 0.0f,
-    0.0f, 0.0f, 0.0f,
-    0.0f, 0.0f, 5.0f
-};
-float axis_colors[] = {
-    1.0f, 0.0f, 0.0f, 1.0f,
-    1.0f, 0.0f, 0.0f, 1.0f,
-    0.0f, 1.0f, 0.0f, 1.0f,
-    0.0f, 1.0f, 0.0f, 1.0f,
-    0.0f, 0.0f, 1.0f, 1.0f,
-    0.0f, 0.0f, 1.0f, 1.0f
-};
-Mesh* axes = nullptr;
-
 float quad_vertices[] = {
     -0.5f,  0.5f, 0.0f, // upper-left
      0.5f,  0.5f, 0.0f, // upper-right
@@ -141,32 +111,6 @@ bool Renderer::Initialize()
     ShaderCache::LoadShader("PointsAsCircles", "Uber", { "FEATURE_TEXTURING", "FEATURE_DRAW_POINTS_AS_CIRCLES" });
 
     // Create simple shapes (useful for debugging/visualization).
-    // Line
-    {
-        MeshDefinition meshDefinition(MeshUsage::Static, 2);
-        meshDefinition.SetVertexLayout(VertexLayout::Packed);
-
-        meshDefinition.AddVertexData(VertexAttribute::Position, line_vertices);
-        meshDefinition.AddVertexData(VertexAttribute::Color, line_colors);
-
-        line = new Mesh();
-        Submesh* lineSubmesh = line->AddSubmesh(meshDefinition);
-        lineSubmesh->SetRenderMode(RenderMode::Lines);
-    }
-
-    // Axes
-    {
-        MeshDefinition meshDefinition(MeshUsage::Static, 6);
-        meshDefinition.SetVertexLayout(VertexLayout::Packed);
-
-        meshDefinition.AddVertexData(VertexAttribute::Position, axis_vertices);
-        meshDefinition.AddVertexData(VertexAttribute::Color, axis_colors);
-
-        axes = new Mesh();
-        Submesh* axesSubmesh = axes->AddSubmesh(meshDefinition);
-        axesSubmesh->SetRenderMode(RenderMode::Lines);
-    }
-
     // Quad
     {
         MeshDefinition meshDefinition(MeshUsage::Static, 4);
@@ -81,6 +81,7 @@ void Submesh::SetVertexPosition(int index, const Vector3& position)
         mPositions[offset] = position.x;
         mPositions[offset + 1] = position.y;
         mPositions[offset + 2] = position.z;
+        mBVHNeedsRefit = true;
     }
 }
 
@@ -144,87 +145,82 @@ bool Submesh::Raycast(const Ray& ray, float& outRayT, Vector2& outUV)
         LOG_ERROR("Submesh::Raycast only supports 'Triangles' RenderMode - aborting.");
         return false;
     }
+    if(mPositions == nullptr) { return false; }
 
-    // Check whether the ray hits any triangles in this submesh.
-    // Even if hit occurs, can't early out! Must check all triangles in case a closer one (lower t value) is found.
-    int elementCount = mIndexes != nullptr ? mVertexArray.GetIndexCount() : mVertexArray.GetVertexCount();
-    Vector3 vert1;
-    Vector3 vert2;
-    Vector3 vert3;
-    for(uint32_t i = 0; i < elementCount; i += 3)
+    // Make sure the BVH is up to date with the current vertex positions.
+    if(!mBVH.IsBuilt())
     {
-        if(mIndexes != nullptr)
-        {
-            vert1 = GetVertexPosition(mIndexes[i]);
-            vert2 = GetVertexPosition(mIndexes[i + 1]);
-            vert3 = GetVertexPosition(mIndexes[i + 2]);
-        }
-        else
-        {
-            vert1 = GetVertexPosition(i);
-            vert2 = GetVertexPosition(i + 1);
-            vert3 = GetVertexPosition(i + 2);
-        }
+        BuildRaycastBVH();
+    }
+    else if(mBVHNeedsRefit)
+    {
+        mBVH.Refit(mPositions, mIndexes);
+        mBVHNeedsRefit = false;
+    }
 
-        float t = FLT_MAX;
-        float u = 0.0f;
-        float v = 0.0f;
-        if(Intersect::TestRayTriangle(ray, vert1, vert2, vert3, t, u, v))
-        {
-            if(t < outRayT)
-            {
-                outRayT = t;
-
-                // The calling code sometimes needs to know the UV coordinate where the ray hit.
-                // First, get the three UVs that correspond to these three triangle vertices.
-                //TODO: There is similar code to this here, in skybox, and in BSP. Probably they can be consolidated!
-                Vector2 uv0;
-                Vector2 uv1;
-                Vector2 uv2;
-                if(mIndexes != nullptr)
-                {
-                    uv0 = GetVertexUV(mIndexes[i]);
-                    uv1 = GetVertexUV(mIndexes[i + 1]);
-                    uv2 = GetVertexUV(mIndexes[i + 2]);
-                }
-                else
-                {
-                    uv0 = GetVertexUV(i);
-                    uv1 = GetVertexUV(i + 1);
-                    uv2 = GetVertexUV(i + 2);
-                }
-
-                // Calculate the point UV.
-                //TODO: This math doesn't totally make sense to me, and I think it needs more scrutinizing.
-                //TODO: Why do u/v/w not correlate to uv0/uv1/uv2 here? Why do we need to negate and flop the UVs?
-                Vector2 pointUV = uv1 * u + uv2 * v + uv0 * (1.0f - u - v);
-                pointUV.y *= -1.0f;
-                pointUV.y = 1.0f - pointUV.y;
-                outUV = pointUV;
-            }
-        }
+    // Find the closest triangle the ray hits, if any.
+    uint32_t triangleIndex = 0;
+    float u = 0.0f;
+    float v = 0.0f;
+    if(!mBVH.Raycast(ray, outRayT, triangleIndex, u, v))
+    {
+        return false;
+    }
+
+    // The calling code sometimes needs to know the UV coordinate where the ray hit.
+    // First, get the three UVs that correspond to these three triangle vertices.
+    //TODO: There is similar code to this here, in skybox, and in BSP. Probably they can be consolidated!
+    int i = triangleIndex * 3;
+    Vector2 uv0;
+    Vector2 uv1;
+    Vector2 uv2;
+    if(mIndexes != nullptr)
+    {
+        uv0 = GetVertexUV(mIndexes[i]);
+        uv1 = GetVertexUV(mIndexes[i + 1]);
+        uv2 = GetVertexUV(mIndexes[i + 2]);
+    }
+    else
+    {
+        uv0 = GetVertexUV(i);
+        uv1 = GetVertexUV(i + 1);
+        uv2 = GetVertexUV(i + 2);
     }
 
-    // Return whether we hit anything.
-    return outRayT < FLT_MAX;
+    // Calculate the point UV.
+    //TODO: This math doesn't totally make sense to me, and I think it needs more scrutinizing.
+    //TODO: Why do u/v/w not correlate to uv0/uv1/uv2 here? Why do we need to negate and flop the UVs?
+    Vector2 pointUV = uv1 * u + uv2 * v + uv0 * (1.0f - u - v);
+    pointUV.y *= -1.0f;
+    pointUV.y = 1.0f - pointUV.y;
+    outUV = pointUV;
+    return true;
 }
 
-void Submesh::SetPositions(float* positions)
+void Submesh::BuildRaycastBVH()
+{
+    if(mPositions == nullptr || mRenderMode != RenderMode::Triangles) { return; }
+    mBVH.Build(mPositions, mIndexes, GetTriangleCount());
+    mBVHNeedsRefit = false;
+}
+
+void Submesh::SetPositions(const float* positions)
 {
     mVertexArray.ChangeVertexData(VertexAttribute::Semantic::Position, positions);
+    mBVHNeedsRefit = true;
 }
 
-void Submesh::SetNormals(float* normals)
+void Submesh::SetNormals(const float* normals)
 {
     mVertexArray.ChangeVertexData(VertexAttribute::Semantic::Normal, normals);
 }
 
-void Submesh::SetColors(float* colors)
+void Submesh::SetColors(const float* colors)
 {
     mVertexArray.ChangeVertexData(VertexAttribute::Semantic::Color, colors);
 }
 
-void Submesh::SetUV1s(float* uvs)
+void Submesh::SetUV1s(const float* uvs)
 {
     mVertexArray.ChangeVertexData(VertexAttribute::Semantic::UV1, uvs);
 }
@@ -232,4 +228,7 @@ void Submesh::SetUV1s(float* uvs)
 void Submesh::SetIndexes(unsigned short* indexes)
 {
     mVertexArray.ChangeIndexData(indexes);
+
+    // Triangles have changed, so the BVH must be rebuilt (on next raycast).
+    mBVH = TriangleBVH();
 }
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "Color32.h"
+#include "TriangleBVH.h"
 #include "Vector3.h"
 #include "VertexArray.h"
 
@@ -45,16 +46,19 @@ public:
 
     bool Raycast(const Ray& ray, float& outRayT, Vector2& outUV);
 
-    void SetPositions(float* positions);
+    // Builds the BVH used to accelerate raycasts. Raycast builds it on demand, but it's better to do it up front (e.g. at load).
+    void BuildRaycastBVH();
+
+    void SetPositions(const float* positions);
     float* GetPositions() { return mPositions; }
 
-    void SetNormals(float* normals);
+    void SetNormals(const float* normals);
     float* GetNormals() { return mNormals; }
 
-    void SetColors(float* colors);
+    void SetColors(const float* colors);
     float* GetColors() { return mColors; }
 
-    void SetUV1s(float* uvs);
+    void SetUV1s(const float* uvs);
     float* GetUV1s() { return mUV1; }
 
     void SetIndexes(unsigned short* indexes);
@@ -82,6 +86,11 @@ private:
     float* mUV1 = nullptr;
     unsigned short* mIndexes = nullptr;
 
+    // Accelerates raycasts against this submesh's triangles.
+    // When vertex positions change (e.g. vertex animation), the BVH is refit on the next raycast rather than rebuilt.
+    TriangleBVH mBVH;
+    bool mBVHNeedsRefit = false;
+
     // Vertex array that actually renders using the underlying rendering system.
     VertexArray mVertexArray;
 
@@ -2,6 +2,12 @@
 
 #include <cstring>
 
+// SSE2 is always available on x64, but not on other platforms (e.g. ARM).
+#if defined(__SSE2__) || defined(_M_X64)
+#define USE_SSE_PIXEL_SUMS
+#include <emmintrin.h>
+#endif
+
 #include <stb_image_resize.h>
 
 #include "BinaryReader.h"
@@ -298,6 +304,90 @@ Color32 Texture::GetPixelColor(uint32_t pixelIndex) const
     return Color32::Black;
 }
 
+Color32 Texture::GetAverageColor() const
+{
+    uint32_t pixelCount = mWidth * mHeight;
+    if(pixelCount == 0) { return Color32::Black; }
+
+    // Sum each channel across all pixels, in the order they're stored.
+    uint64_t sums[4] = { 0, 0, 0, 0 };
+    if(mPixels != nullptr && mBytesPerPixel == 4)
+    {
+        uint32_t pixelIndex = 0;
+        #if defined(USE_SSE_PIXEL_SUMS)
+        // Widen four pixels at a time to 32-bit ints; each lane accumulates one channel.
+        // Flush to 64-bit sums every so often, so the 32-bit lanes can't overflow, even on huge textures.
+        __m128i zero = _mm_setzero_si128();
+        while(pixelIndex + 4 <= pixelCount)
+        {
+            __m128i laneSums = zero;
+            uint32_t batchEnd = pixelIndex + Math::Min(pixelCount - pixelIndex, 65536u) / 4 * 4;
+            for(; pixelIndex < batchEnd; pixelIndex += 4)
+            {
+                __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mPixels + pixelIndex * 4));
+                __m128i low = _mm_unpacklo_epi8(pixels, zero);
+                __m128i high = _mm_unpackhi_epi8(pixels, zero);
+                laneSums = _mm_add_epi32(laneSums, _mm_add_epi32(_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero)));
+                laneSums = _mm_add_epi32(laneSums, _mm_add_epi32(_mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)));
+            }
+
+            alignas(16) uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), laneSums);
+            for(int i = 0; i < 4; ++i)
+            {
+                sums[i] += lanes[i];
+            }
+        }
+        #endif
+        for(; pixelIndex < pixelCount; ++pixelIndex)
+        {
+            for(int i = 0; i < 4; ++i)
+            {
+                sums[i] += mPixels[pixelIndex * 4 + i];
+            }
+        }
+    }
+    else if(mPixels != nullptr)
+    {
+        for(uint32_t i = 0; i < pixelCount * mBytesPerPixel; i += mBytesPerPixel)
+        {
+            sums[0] += mPixels[i];
+            sums[1] += mPixels[i + 1];
+            sums[2] += mPixels[i + 2];
+        }
+    }
+    else if(mPalette != nullptr && mPaletteIndexes != nullptr)
+    {
+        // Count how often each palette entry is used, then each entry only needs to be summed once.
+        uint32_t counts[256] = { 0 };
+        for(uint32_t i = 0; i < pixelCount; ++i)
+        {
+            ++counts[mPaletteIndexes[i]];
+        }
+
+        // Palette data is always in BGRA format.
+        uint32_t paletteCount = Math::Min(mPaletteSize / 4, 256u);
+        for(uint32_t i = 0; i < paletteCount; ++i)
+        {
+            sums[0] += static_cast<uint64_t>(mPalette[i * 4]) * counts[i];
+            sums[1] += static_cast<uint64_t>(mPalette[i * 4 + 1]) * counts[i];
+            sums[2] += static_cast<uint64_t>(mPalette[i * 4 + 2]) * counts[i];
+        }
+        return Color32(static_cast<int>(sums[2] / pixelCount), static_cast<int>(sums[1] / pixelCount), static_cast<int>(sums[0] / pixelCount));
+    }
+    else
+    {
+        return Color32::Black;
+    }
+
+    // Map channel sums to RGB, depending on storage order.
+    bool isBGR = mFormat == Format::BGR || mFormat == Format::BGRA;
+    int r = static_cast<int>(sums[isBGR ? 2 : 0] / pixelCount);
+    int g = static_cast<int>(sums[1] / pixelCount);
+    int b = static_cast<int>(sums[isBGR ? 0 : 2] / pixelCount);
+    return Color32(r, g, b);
+}
+
 void Texture::SetPixelPaletteIndex(uint32_t x, uint32_t y, uint8_t val)
 {
     // No palette indexes means we can't get a value!
@@ -392,25 +482,30 @@ void Texture::SetTransparentColor(const Color32& color)
 
     // Find instances of the desired transparent color and
     // make sure the alpha value is zero.
-    int pixelByteCount = mWidth * mHeight * mBytesPerPixel;
-    for(int i = 0; i < pixelByteCount; i += mBytesPerPixel)
+    SetTransparentColor(mPixels, mWidth * mHeight, mFormat, color);
+
+    // Mark dirty so it uploads to GPU on next use.
+    mDirtyFlags |= DirtyFlags::Pixels;
+}
+
+/*static*/ void Texture::SetTransparentColor(uint8_t* pixels, uint32_t pixelCount, Format format, const Color32& color)
+{
+    uint32_t pixelByteCount = pixelCount * 4;
+    for(uint32_t i = 0; i < pixelByteCount; i += 4)
     {
-        if(mFormat == Format::RGBA && mPixels[i] == color.r && mPixels[i + 1] == color.g && mPixels[i + 2] == color.b)
+        if(format == Format::RGBA && pixels[i] == color.r && pixels[i + 1] == color.g && pixels[i + 2] == color.b)
         {
-            mPixels[i + 3] = 0;
+            pixels[i + 3] = 0;
         }
-        else if(mFormat == Format::BGRA && mPixels[i] == color.b && mPixels[i + 1] == color.g && mPixels[i + 2] == color.r)
+        else if(format == Format::BGRA && pixels[i] == color.b && pixels[i + 1] == color.g && pixels[i + 2] == color.r)
         {
-            mPixels[i + 3] = 0;
+            pixels[i + 3] = 0;
         }
         else
         {
-            mPixels[i + 3] = 255;
+            pixels[i + 3] = 255;
         }
     }
-
-    // Mark dirty so it uploads to GPU on next use.
-    mDirtyFlags |= DirtyFlags::Pixels;
 }
 
 void Texture::ClearTransparentColor()
@@ -755,6 +850,12 @@ void Texture::Crop(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
     }
 }
 
+void Texture::SwapPixelData(uint8_t*& pixels)
+{
+    std::swap(mPixels, pixels);
+    mDirtyFlags |= DirtyFlags::Pixels;
+}
+
 void Texture::AddDirtyFlags(DirtyFlags flags)
 {
     mDirtyFlags |= flags;
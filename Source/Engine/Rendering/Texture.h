@@ -19,6 +19,8 @@ class Texture : public Asset
 {
     TYPEINFO_SUB(Texture, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Textures;
+
     enum class RenderType
     {
         Opaque,     // Texture is fully opaque
@@ -104,6 +106,9 @@ public:
     Color32 GetPixelColor(uint32_t x, uint32_t y) const;
     Color32 GetPixelColor(uint32_t pixelIndex) const;
 
+    // Average color of all pixels in the texture. Alpha is ignored.
+    Color32 GetAverageColor() const;
+
     // Set or Get Palette Indexes
     void SetPixelPaletteIndex(uint32_t x, uint32_t y, uint8_t val);
     uint8_t GetPixelPaletteIndex(uint32_t x, uint32_t y) const;
@@ -117,6 +122,9 @@ public:
     //TODO: The idea of a "transparent color" may make more sense at the material layer? See gDiscardColor in our shaders.
     void SetTransparentColor(const Color32& color);
     void ClearTransparentColor();
+
+    // Same as above, but for a 32-bit (RGBA or BGRA) pixel buffer that isn't in a texture yet (e.g. a video frame being decoded).
+    static void SetTransparentColor(uint8_t* pixels, uint32_t pixelCount, Format format, const Color32& color);
     void ApplyAlphaChannel(const Texture& alphaTexture);
 
     // Image Modifications
@@ -129,6 +137,10 @@ public:
     void Crop(uint32_t width, uint32_t height, bool centered = false);
     void Crop(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
 
+    // Swaps pixel buffers with the passed in buffer, which MUST be allocated with new[] and match this texture's size and format.
+    // Useful for streaming textures (e.g. video), where pixels are generated elsewhere and copying them would be wasteful.
+    void SwapPixelData(uint8_t*& pixels);
+
     // GPU upload
     void AddDirtyFlags(DirtyFlags flags);
     void UploadToGPU();
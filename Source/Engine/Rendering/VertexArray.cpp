@@ -132,7 +132,7 @@ void VertexArray::Draw(GAPI::Primitive mode, uint32_t offset, uint32_t count)
     }
 }
 
-void VertexArray::ChangeVertexData(void* data)
+void VertexArray::ChangeVertexData(const void* data)
 {
     // Save data locally.
     uint32_t size = mData.vertexCount * mData.vertexDefinition.CalculateSize();
@@ -147,7 +147,7 @@ void VertexArray::ChangeVertexData(void* data)
     }
 }
 
-void VertexArray::ChangeVertexData(VertexAttribute::Semantic semantic, void* data)
+void VertexArray::ChangeVertexData(VertexAttribute::Semantic semantic, const void* data)
 {
     // We can really only update a single attribute's data if attribute data is tightly packed.
     // If data is interleaved, we'll just fall back on overwriting all data.
@@ -52,8 +52,8 @@ public:
     unsigned int GetVertexCount() const { return mData.vertexCount; }
     unsigned int GetIndexCount() const { return mData.indexCount; }
 
-    void ChangeVertexData(void* data);
-    void ChangeVertexData(VertexAttribute::Semantic semantic, void* data);
+    void ChangeVertexData(const void* data);
+    void ChangeVertexData(VertexAttribute::Semantic semantic, const void* data);
 
     void ChangeIndexData(uint16_t* indexes);
     void ChangeIndexData(uint16_t* indexes, uint32_t count);
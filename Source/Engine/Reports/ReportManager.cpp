@@ -8,6 +8,7 @@ ReportManager::ReportManager()
     ReportStream& generic = GetReportStream("Generic");
     generic.AddOutput(ReportOutput::Debugger | ReportOutput::SharedMemory | ReportOutput::Console);
     generic.AddContent(ReportContent::Content);
+    mGenericStream = &generic;
 
     // A stream for warnings.
     ReportStream& warning = GetReportStream("Warning");
@@ -17,6 +18,7 @@ ReportManager::ReportManager()
                       ReportOutput::Console);
     warning.AddContent(ReportContent::All);
     warning.SetFilePath("Errors.log");
+    mWarningStream = &warning;
 
     // A stream for errors.
     ReportStream& error = GetReportStream("Error");
@@ -26,6 +28,7 @@ ReportManager::ReportManager()
                     ReportOutput::Console);
     error.AddContent(ReportContent::All);
     error.SetFilePath("Errors.log");
+    mErrorStream = &error;
 
     // A stream for *serious* errors.
     ReportStream& seriousError = GetReportStream("SeriousError");
@@ -43,6 +46,7 @@ ReportManager::ReportManager()
     fatal.AddOutput(ReportOutput::File | ReportOutput::Debugger);
     fatal.AddContent(ReportContent::All);
     fatal.SetFilePath("Errors.log");
+    mFatalStream = &fatal;
 
     // An error stream that will display a message box to the user.
     ReportStream& messageBox = GetReportStream("MessageBox");
@@ -148,6 +152,23 @@ void ReportManager::Logf(const std::string& streamName, const char* format, ...)
     va_end(args);
 }
 
+void ReportManager::Log(ReportStream& stream, const std::string& content)
+{
+    stream.Log(content);
+}
+
+void ReportManager::Logf(ReportStream& stream, const char* format, ...)
+{
+    // Skip formatting entirely if the stream is disabled.
+    if(!stream.IsEnabled()) { return; }
+
+    // Pass va_list to stream's Logf function.
+    va_list args;
+    va_start(args, format);
+    stream.Logf(format, args);
+    va_end(args);
+}
+
 ReportStream& ReportManager::GetReportStream(const std::string& streamName)
 {
     // If we can find the stream in our map, return it.
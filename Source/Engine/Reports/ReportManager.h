@@ -36,17 +36,34 @@ public:
     void Log(const std::string& streamName, const std::string& content);
     void Logf(const std::string& streamName, const char* format, ...);
 
+    // Logging to an already looked up stream avoids a by-name lookup on every call.
+    // Streams are never removed, so a stream reference can be looked up once and kept around.
+    void Log(ReportStream& stream, const std::string& content);
+    void Logf(ReportStream& stream, const char* format, ...);
+
     ReportStream& GetReportStream(const std::string& streamName);
 
+    // Built-in streams used by the logging macros below.
+    ReportStream& GetGenericStream() { return *mGenericStream; }
+    ReportStream& GetWarningStream() { return *mWarningStream; }
+    ReportStream& GetErrorStream() { return *mErrorStream; }
+    ReportStream& GetFatalStream() { return *mFatalStream; }
+
 private:
     // All defined streams, keyed by stream name.
     std::string_map_ci<ReportStream> mStreams;
+
+    // Pre-resolved built-in streams.
+    ReportStream* mGenericStream = nullptr;
+    ReportStream* mWarningStream = nullptr;
+    ReportStream* mErrorStream = nullptr;
+    ReportStream* mFatalStream = nullptr;
 };
 
 extern ReportManager gReportManager;
 
 // Convenience macros for logging to common built-in log streams.
-#define LOG_GENERIC(x, ...) gReportManager.Logf("Generic", x, __VA_ARGS__);
-#define LOG_WARNING(x, ...) gReportManager.Logf("Warning", x, __VA_ARGS__);
-#define LOG_ERROR(x, ...) gReportManager.Logf("Error", x, __VA_ARGS__);
-#define LOG_FATAL(x, ...) gReportManager.Logf("Fatal", x, __VA_ARGS__);
\ No newline at end of file
+#define LOG_GENERIC(x, ...) gReportManager.Logf(gReportManager.GetGenericStream(), x, __VA_ARGS__);
+#define LOG_WARNING(x, ...) gReportManager.Logf(gReportManager.GetWarningStream(), x, __VA_ARGS__);
+#define LOG_ERROR(x, ...) gReportManager.Logf(gReportManager.GetErrorStream(), x, __VA_ARGS__);
+#define LOG_FATAL(x, ...) gReportManager.Logf(gReportManager.GetFatalStream(), x, __VA_ARGS__);
\ No newline at end of file
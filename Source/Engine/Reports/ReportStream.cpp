@@ -12,7 +12,6 @@
 #include "Log.h"
 #include "OSDialog.h"
 #include "Platform.h"
-#include "StreamLockGuard.h"
 #include "SystemUtil.h"
 
 ReportStream::ReportStream(const std::string& name) :
@@ -24,6 +23,12 @@ ReportStream::ReportStream(const std::string& name) :
 
 ReportStream::~ReportStream()
 {
+    // Make sure any queued writes to our file stream are done before returning it.
+    if(mFileStreamHandle != nullptr)
+    {
+        FlushLog();
+    }
+
     // Return any stream handles we've obtained.
     StreamManager::ReturnStream(mFileStreamHandle);
 }
@@ -51,9 +56,8 @@ void ReportStream::Log(const std::string& content)
             mFileStreamHandle = StreamManager::TakeFileStream(mFilePath, mFileTruncate);
         }
 
-        // Lock the file stream, write, then unlock.
-        StreamLockGuard lock(mFileStreamHandle);
-        lock.stream << output;
+        // Writing to the file happens on the logging thread, so we don't stall here on file I/O.
+        LogToStream(mFileStreamHandle, output);
     }
 
     // Handle shared memory output type (or rather...DON'T!).
@@ -84,18 +88,21 @@ void ReportStream::Log(const std::string& content)
 
         // For most platforms, outputting to standard output via printf achieves the goal - the string appears in Xcode, CLion, etc.
         // Even on Windows, this is handy to see log output in the Command Prompt window when using /subsystem:console.
-        ::Log(output.c_str());
+        ::Log(std::move(output));
     }
 
     // If this report stream has an action associated with it, take that action.
     if(mAction == ReportAction::Fatal)
     {
+        // We're about to quit, so make sure everything logged so far (including this report) is written out.
+        FlushLog();
         OSDialog::Ok(OSDIALOG_ERROR,
                      "Cannot continue after previous error (category '" + mName + "') [see error log for more information]. Aborting...");
         GEngine::Instance()->Quit();
     }
     else if(mAction == ReportAction::Prompt)
     {
+        FlushLog();
         if(!OSDialog::YesNo(OSDIALOG_ERROR,
                            "Continue Playing?",
                            "An error has occurred and we recommend that you quit and reload the game. Ignore this advice and keep playing anyway?"))
@@ -117,6 +124,9 @@ void ReportStream::Logf(const char* format, ...)
 
 void ReportStream::Logf(const char* format, va_list args)
 {
+    // Don't bother formatting if the output won't go anywhere.
+    if(!mEnabled) { return; }
+
     // Format to an std::string and pass to the basic Log function.
     Log(StringUtil::vFormatf(format, args));
 }
@@ -127,8 +137,10 @@ void ReportStream::SetFilePath(const std::string& filePath)
     if(filePath != mFilePath)
     {
         // Close the previous file stream, if any.
+        // Any queued writes to it must be done first.
         if(mFileStreamHandle != nullptr)
         {
+            FlushLog();
             StreamManager::ReturnStream(mFileStreamHandle);
             mFileStreamHandle = nullptr;
         }
@@ -88,6 +88,7 @@ public:
 
     void Enable() { mEnabled = true; }
     void Disable() { mEnabled = false; }
+    bool IsEnabled() const { return mEnabled; }
 
     void SetFilePath(const std::string& filename);
     void SetFileTruncate(bool truncate) { mFileTruncate = truncate; }
@@ -1,6 +1,11 @@
 #include "SheepAPI_Assets.h"
 
 #include "AssetManager.h"
+#include "IniReader.h"
+#include "ReportManager.h"
+#include "StringTokenizer.h"
+#include "StringUtil.h"
+#include "Timers.h"
 
 using namespace std;
 
@@ -46,4 +51,86 @@ shpvoid NeedDiscResources(int discNum)
     // This isn't needed right now, but could be implemented for completeness if we really wanted.
     return 0;
 }
-RegFunc1(NeedDiscResources, void, int, IMMEDIATE, REL_FUNC);
\ No newline at end of file
+RegFunc1(NeedDiscResources, void, int, IMMEDIATE, REL_FUNC);
+
+shpvoid BenchmarkTextParsing()
+{
+    // Read every text asset in the loaded archives into memory up front, so only parsing is timed.
+    // Most text assets are INI-style. GAS files are parsed line-by-line with a tokenizer instead.
+    struct TextAssets
+    {
+        std::vector<AssetData> assets;
+        uint64_t byteCount = 0;
+    };
+    const char* kIniExtensions[] = { ".SIF", ".SCN", ".NVC", ".ANM", ".YAK" };
+    TextAssets iniAssets;
+    TextAssets gasAssets;
+    auto addAsset = [](TextAssets& textAssets) {
+        return [&textAssets](const std::string& assetName, AssetData& assetData) {
+            textAssets.byteCount += assetData.length;
+            textAssets.assets.push_back(std::move(assetData));
+        };
+    };
+    for(const char* extension : kIniExtensions)
+    {
+        gAssetManager.ForEachArchivedAsset(extension, addAsset(iniAssets));
+    }
+    gAssetManager.ForEachArchivedAsset(".GAS", addAsset(gasAssets));
+
+    // Tokenize INI assets into sections, lines, and key/value pairs.
+    size_t keyValueCount = 0;
+    Stopwatch stopwatch;
+    for(AssetData& assetData : iniAssets.assets)
+    {
+        IniReader reader(assetData.bytes.get(), assetData.length);
+        IniSectionView section;
+        while(reader.ReadNextSection(section))
+        {
+            for(IniLineView& line : section.lines)
+            {
+                keyValueCount += line.entries.size();
+            }
+        }
+    }
+    float iniMilliseconds = stopwatch.GetMilliseconds();
+
+    // Tokenize GAS assets into lines and words.
+    size_t tokenCount = 0;
+    stopwatch.Reset();
+    for(AssetData& assetData : gasAssets.assets)
+    {
+        std::string_view text(reinterpret_cast<const char*>(assetData.bytes.get()), assetData.length);
+        std::string_view line;
+        while(StringUtil::PopLine(text, line))
+        {
+            StringUtil::SanitizeLine(line);
+            StringTokenizer tokenizer(line, { ' ', ',', '(', ')' });
+            tokenCount += tokenizer.GetTokenCount();
+        }
+    }
+    float gasMilliseconds = stopwatch.GetMilliseconds();
+
+    // Throughput in MB/s is the same as bytes per microsecond.
+    auto report = [](const char* label, const TextAssets& textAssets, size_t itemCount, const char* itemLabel, float milliseconds) {
+        float megabytesPerSecond = milliseconds > 0.0f ? textAssets.byteCount / (milliseconds * 1000.0f) : 0.0f;
+        gReportManager.Log("Dump", StringUtil::Format("%s: %zu assets, %llu bytes, %zu %s in %.3f ms (%.1f MB/s)",
+                                                      label, textAssets.assets.size(), static_cast<unsigned long long>(textAssets.byteCount),
+                                                      itemCount, itemLabel, milliseconds, megabytesPerSecond));
+    };
+    report("INI", iniAssets, keyValueCount, "key/values", iniMilliseconds);
+    report("GAS", gasAssets, tokenCount, "tokens", gasMilliseconds);
+    return 0;
+}
+RegFunc0(BenchmarkTextParsing, void, IMMEDIATE, DEV_FUNC);
+
+shpvoid DumpPrefetchStats()
+{
+    AssetPrefetchStats stats = gAssetManager.GetPrefetchStats();
+    uint32_t loadCount = stats.hits + stats.misses;
+    float hitRate = loadCount > 0 ? static_cast<float>(stats.hits) / loadCount * 100.0f : 0.0f;
+    gReportManager.Log("Dump", StringUtil::Format("Prefetch: %u hits, %u misses (%.1f%% hit rate)", stats.hits, stats.misses, hitRate));
+    gReportManager.Log("Dump", StringUtil::Format("Prefetch: %u prefetched, %u evicted unused, %u bytes cached",
+                                                  stats.prefetched, stats.evicted, stats.cachedBytes));
+    return 0;
+}
+RegFunc0(DumpPrefetchStats, void, IMMEDIATE, DEV_FUNC);
@@ -44,3 +44,6 @@ shpvoid OpenFile(const std::string& fileName); // DEV
 
 // MISC
 shpvoid NeedDiscResources(int discNum);
+
+shpvoid BenchmarkTextParsing(); // DEV
+shpvoid DumpPrefetchStats(); // DEV
@@ -2,6 +2,10 @@
 
 #include "Debug.h"
 #include "LayerManager.h"
+#include "MemoryTracker.h"
+#include "Paths.h"
+#include "ReportManager.h"
+#include "StringUtil.h"
 
 using namespace std;
 
@@ -44,4 +48,46 @@ shpvoid DumpLayerStack()
     gLayerManager.DumpLayerStack();
     return 0;
 }
-RegFunc0(DumpLayerStack, void, IMMEDIATE, DEV_FUNC);
\ No newline at end of file
+RegFunc0(DumpLayerStack, void, IMMEDIATE, DEV_FUNC);
+
+shpvoid DumpMemoryReport()
+{
+    if(!MemoryTracker::IsEnabled())
+    {
+        gReportManager.Log("Error", "Memory tracking is disabled - define MEMORY_TRACKING_ENABLED to enable it.");
+        return 0;
+    }
+
+    std::string filePath = Paths::GetUserDataPath("MemoryReport.csv");
+    if(MemoryTracker::DumpToCSV(filePath))
+    {
+        gReportManager.Log("Dump", "Memory report written to " + filePath);
+    }
+    else
+    {
+        gReportManager.Log("Error", "Failed to write memory report to " + filePath);
+    }
+    return 0;
+}
+RegFunc0(DumpMemoryReport, void, IMMEDIATE, DEV_FUNC);
+
+shpvoid ReportMemoryUsage()
+{
+    if(!MemoryTracker::IsEnabled())
+    {
+        gReportManager.Log("Error", "Memory tracking is disabled - define MEMORY_TRACKING_ENABLED to enable it.");
+        return 0;
+    }
+
+    // Log live and peak memory for each tag, followed by totals.
+    for(int i = 0; i <= static_cast<int>(MemoryTag::Count); ++i)
+    {
+        bool isTotal = i == static_cast<int>(MemoryTag::Count);
+        MemoryTracker::TagStats stats = isTotal ? MemoryTracker::GetTotalStats() : MemoryTracker::GetTagStats(static_cast<MemoryTag>(i));
+        const char* name = isTotal ? "Total" : MemoryTracker::GetTagName(static_cast<MemoryTag>(i));
+        gReportManager.Log("Dump", StringUtil::Format("%s: %zu KB live (%zu allocs), %zu KB peak",
+                                                      name, stats.liveBytes / 1024, stats.liveCount, stats.peakBytes / 1024));
+    }
+    return 0;
+}
+RegFunc0(ReportMemoryUsage, void, IMMEDIATE, DEV_FUNC);
\ No newline at end of file
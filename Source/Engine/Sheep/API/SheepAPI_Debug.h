@@ -23,6 +23,7 @@ shpvoid DumpLayerStack(); // DEV
 shpvoid DumpBuildInfo(); // DEV
 shpvoid DumpActionManager(); // DEV
 shpvoid DumpUIStates(); // DEV
+shpvoid DumpMemoryReport(); // DEV
 
 shpvoid ReportMemoryUsage();
 shpvoid ReportSurfaceMemoryUsage();
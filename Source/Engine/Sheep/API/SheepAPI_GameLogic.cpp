@@ -41,11 +41,11 @@ shpvoid ChangeScore(const std::string& scoreValue)
 }
 RegFunc1(ChangeScore, void, string, IMMEDIATE, REL_FUNC);
 
-int GetFlag(const std::string& flagName)
+int GetFlag(Symbol flag)
 {
-    return gGameProgress.GetFlag(flagName);
+    return gGameProgress.GetFlag(flag);
 }
-RegFunc1(GetFlag, int, string, IMMEDIATE, REL_FUNC);
+RegFunc1(GetFlag, int, symbol, IMMEDIATE, REL_FUNC);
 
 /*
 int GetFlagInt(int flagEnum)
@@ -57,19 +57,19 @@ int GetFlagInt(int flagEnum)
 RegFunc1(GetFlagInt, int, int, IMMEDIATE, REL_FUNC);
 */
 
-shpvoid SetFlag(const std::string& flagName)
+shpvoid SetFlag(Symbol flag)
 {
-    gGameProgress.SetFlag(flagName);
+    gGameProgress.SetFlag(flag);
     return 0;
 }
-RegFunc1(SetFlag, void, string, IMMEDIATE, REL_FUNC);
+RegFunc1(SetFlag, void, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid ClearFlag(const std::string& flagName)
+shpvoid ClearFlag(Symbol flag)
 {
-    gGameProgress.ClearFlag(flagName);
+    gGameProgress.ClearFlag(flag);
     return 0;
 }
-RegFunc1(ClearFlag, void, string, IMMEDIATE, REL_FUNC);
+RegFunc1(ClearFlag, void, symbol, IMMEDIATE, REL_FUNC);
 
 shpvoid DumpFlags()
 {
@@ -78,72 +78,77 @@ shpvoid DumpFlags()
 }
 RegFunc0(DumpFlags, void, IMMEDIATE, DEV_FUNC);
 
-int GetGameVariableInt(const std::string& varName)
+int GetGameVariableInt(Symbol var)
 {
-    return gGameProgress.GetGameVariable(varName);
+    return gGameProgress.GetGameVariable(var);
 }
-RegFunc1(GetGameVariableInt, int, string, IMMEDIATE, REL_FUNC);
+RegFunc1(GetGameVariableInt, int, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid IncGameVariableInt(const std::string& varName)
+shpvoid IncGameVariableInt(Symbol var)
 {
-    gGameProgress.IncGameVariable(varName);
+    gGameProgress.IncGameVariable(var);
     return 0;
 }
-RegFunc1(IncGameVariableInt, void, string, IMMEDIATE, REL_FUNC);
+RegFunc1(IncGameVariableInt, void, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid SetGameVariableInt(const std::string& varName, int value)
+shpvoid SetGameVariableInt(Symbol var, int value)
 {
-    gGameProgress.SetGameVariable(varName, value);
+    gGameProgress.SetGameVariable(var, value);
     return 0;
 }
-RegFunc2(SetGameVariableInt, void, string, int, IMMEDIATE, REL_FUNC);
+RegFunc2(SetGameVariableInt, void, symbol, int, IMMEDIATE, REL_FUNC);
 
-int GetNounVerbCount(const std::string& noun, const std::string& verb)
+int GetNounVerbCount(Symbol noun, Symbol verb)
 {
     return gGameProgress.GetNounVerbCount(noun, verb);
 }
-RegFunc2(GetNounVerbCount, int, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(GetNounVerbCount, int, symbol, symbol, IMMEDIATE, REL_FUNC);
 
 int GetNounVerbCountInt(int nounEnum, int verbEnum)
 {
-    return GetNounVerbCount(gActionManager.GetNoun(nounEnum),
-                            gActionManager.GetVerb(verbEnum));
+    // Noun/verb enums come from loaded actions, whose names are already interned.
+    return GetNounVerbCount(Symbol::Find(gActionManager.GetNoun(nounEnum)),
+                            Symbol::Find(gActionManager.GetVerb(verbEnum)));
 }
 RegFunc2(GetNounVerbCountInt, int, int, int, IMMEDIATE, REL_FUNC);
 
-shpvoid IncNounVerbCount(const string& noun, const string& verb)
+shpvoid IncNounVerbCount(Symbol noun, Symbol verb)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
     gGameProgress.IncNounVerbCount(noun, verb);
     return 0;
 }
-RegFunc2(IncNounVerbCount, void, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(IncNounVerbCount, void, symbol, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid IncNounVerbCountBoth(const string& noun, const string& verb)
+shpvoid IncNounVerbCountBoth(Symbol noun, Symbol verb)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
-    gGameProgress.IncNounVerbCount("Gabriel", noun, verb);
-    gGameProgress.IncNounVerbCount("Grace", noun, verb);
+    static const Symbol kGabriel("Gabriel");
+    static const Symbol kGrace("Grace");
+    gGameProgress.IncNounVerbCount(kGabriel, noun, verb);
+    gGameProgress.IncNounVerbCount(kGrace, noun, verb);
     return 0;
 }
-RegFunc2(IncNounVerbCountBoth, void, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(IncNounVerbCountBoth, void, symbol, symbol, IMMEDIATE, REL_FUNC);
 
-shpvoid SetNounVerbCount(const std::string& noun, const std::string& verb, int count)
+shpvoid SetNounVerbCount(Symbol noun, Symbol verb, int count)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
     gGameProgress.SetNounVerbCount(noun, verb, count);
     return 0;
 }
-RegFunc3(SetNounVerbCount, void, string, string, int, IMMEDIATE, REL_FUNC);
+RegFunc3(SetNounVerbCount, void, symbol, symbol, int, IMMEDIATE, REL_FUNC);
 
-shpvoid SetNounVerbCountBoth(const std::string& noun, const std::string& verb, int count)
+shpvoid SetNounVerbCountBoth(Symbol noun, Symbol verb, int count)
 {
     //TODO: Throw an error if the given noun corresponds to a "Topic".
-    gGameProgress.SetNounVerbCount("Gabriel", noun, verb, count);
-    gGameProgress.SetNounVerbCount("Grace", noun, verb, count);
+    static const Symbol kGabriel("Gabriel");
+    static const Symbol kGrace("Grace");
+    gGameProgress.SetNounVerbCount(kGabriel, noun, verb, count);
+    gGameProgress.SetNounVerbCount(kGrace, noun, verb, count);
     return 0;
 }
-RegFunc3(SetNounVerbCountBoth, void, string, string, int, IMMEDIATE, REL_FUNC);
+RegFunc3(SetNounVerbCountBoth, void, symbol, symbol, int, IMMEDIATE, REL_FUNC);
 
 shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb)
 {
@@ -158,23 +163,22 @@ shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb)
 }
 RegFunc2(TriggerNounVerb, void, string, string, IMMEDIATE, DEV_FUNC);
 
-int GetTopicCount(const std::string& noun, const std::string& verb)
+int GetTopicCount(Symbol noun, Symbol verb)
 {
     //TODO: Validate noun. Must be a valid noun. Seems to include any scene nouns, inventory nouns, actor nouns.
-    if(!gVerbManager.IsTopic(verb))
+    if(!gVerbManager.IsTopic(verb.GetName()))
     {
-        gReportManager.Log("Error", "Error: '" + verb + " is not a valid verb name.");
+        gReportManager.Log("Error", "Error: '" + verb.GetName() + " is not a valid verb name.");
         return 0;
     }
     return gGameProgress.GetTopicCount(noun, verb);
 }
-RegFunc2(GetTopicCount, int, string, string, IMMEDIATE, REL_FUNC);
+RegFunc2(GetTopicCount, int, symbol, symbol, IMMEDIATE, REL_FUNC);
 
 int GetTopicCountInt(int nounEnum, int verbEnum)
 {
-    std::string noun = gActionManager.GetNoun(nounEnum);
-    std::string verb = gActionManager.GetVerb(verbEnum);
-    return GetTopicCount(noun, verb);
+    return GetTopicCount(Symbol::Find(gActionManager.GetNoun(nounEnum)),
+                         Symbol::Find(gActionManager.GetVerb(verbEnum)));
 }
 RegFunc2(GetTopicCountInt, int, int, int, IMMEDIATE, REL_FUNC);
 
@@ -186,33 +190,33 @@ int HasTopicsLeft(const std::string& noun)
 }
 RegFunc1(HasTopicsLeft, int, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetTopicCount(std::string noun, std::string verb, int count)
+shpvoid SetTopicCount(Symbol noun, Symbol verb, int count)
 {
     //TODO: Validate noun or report error.
     //TODO: Validate verb or report error.
     gGameProgress.SetTopicCount(noun, verb, count);
     return 0;
 }
-RegFunc3(SetTopicCount, void, string, string, int, IMMEDIATE, DEV_FUNC);
+RegFunc3(SetTopicCount, void, symbol, symbol, int, IMMEDIATE, DEV_FUNC);
 
-int GetChatCount(const std::string& noun)
+int GetChatCount(Symbol noun)
 {
     return gGameProgress.GetChatCount(noun);
 }
-RegFunc1(GetChatCount, int, string, IMMEDIATE, REL_FUNC);
+RegFunc1(GetChatCount, int, symbol, IMMEDIATE, REL_FUNC);
 
 int GetChatCountInt(int nounEnum)
 {
-    return GetChatCount(gActionManager.GetNoun(nounEnum));
+    return GetChatCount(Symbol::Find(gActionManager.GetNoun(nounEnum)));
 }
 RegFunc1(GetChatCountInt, int, int, IMMEDIATE, REL_FUNC);
 
-shpvoid SetChatCount(std::string noun, int count)
+shpvoid SetChatCount(Symbol noun, int count)
 {
     gGameProgress.SetChatCount(noun, count);
     return 0;
 }
-RegFunc2(SetChatCount, void, string, int, IMMEDIATE, DEV_FUNC);
+RegFunc2(SetChatCount, void, symbol, int, IMMEDIATE, DEV_FUNC);
 
 shpvoid SetVerbModal(int modalState)
 {
@@ -14,34 +14,34 @@ shpvoid SetScore(int score); // DEV
 shpvoid ChangeScore(const std::string& scoreValue);
 
 // FLAGS
-int GetFlag(const std::string& flagName);
+int GetFlag(Symbol flag);
 int GetFlagInt(int flagEnum);
-shpvoid SetFlag(const std::string& flagName);
-shpvoid ClearFlag(const std::string& flagName);
+shpvoid SetFlag(Symbol flag);
+shpvoid ClearFlag(Symbol flag);
 shpvoid DumpFlags(); // DEV
 
 // VARIABLES
-int GetGameVariableInt(const std::string& varName);
-shpvoid IncGameVariableInt(const std::string& varName);
-shpvoid SetGameVariableInt(const std::string& varName, int value);
+int GetGameVariableInt(Symbol var);
+shpvoid IncGameVariableInt(Symbol var);
+shpvoid SetGameVariableInt(Symbol var, int value);
 
 // ACTION TRACKING
-int GetNounVerbCount(const std::string& noun, const std::string& verb);
+int GetNounVerbCount(Symbol noun, Symbol verb);
 int GetNounVerbCountInt(int nounEnum, int verbEnum);
-shpvoid IncNounVerbCount(const std::string& noun, const std::string& verb);
-shpvoid IncNounVerbCountBoth(const std::string& noun, const std::string& verb);
-shpvoid SetNounVerbCount(const std::string& noun, const std::string& verb, int count);
-shpvoid SetNounVerbCountBoth(const std::string& noun, const std::string& verb, int count);
+shpvoid IncNounVerbCount(Symbol noun, Symbol verb);
+shpvoid IncNounVerbCountBoth(Symbol noun, Symbol verb);
+shpvoid SetNounVerbCount(Symbol noun, Symbol verb, int count);
+shpvoid SetNounVerbCountBoth(Symbol noun, Symbol verb, int count);
 shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb); // DEV
 
-int GetTopicCount(const std::string& noun, const std::string& verb);
+int GetTopicCount(Symbol noun, Symbol verb);
 int GetTopicCountInt(int nounEnum, int verbEnum);
 int HasTopicsLeft(const std::string& noun);
-shpvoid SetTopicCount(std::string noun, std::string verb, int count); // DEV
+shpvoid SetTopicCount(Symbol noun, Symbol verb, int count); // DEV
 
-int GetChatCount(const std::string& noun);
+int GetChatCount(Symbol noun);
 int GetChatCountInt(int nounEnum);
-shpvoid SetChatCount(std::string noun, int count); // DEV
+shpvoid SetChatCount(Symbol noun, int count); // DEV
 
 shpvoid FullReset(); // DEV
 shpvoid ResetGameData(); // DEV
@@ -39,19 +39,21 @@ void SheepStack::PushStringOffset(int val)
 
     mStack[mStackSize - 1].type = SheepValueType::String;
     mStack[mStackSize - 1].intValue = val;
+    mStack[mStackSize - 1].symbolValue = Symbol();
 
     #ifdef SHEEP_DEBUG
     std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
     #endif
 }
 
-void SheepStack::PushString(const char* str)
+void SheepStack::PushString(const char* str, Symbol symbol)
 {
     mStackSize++;
     assert(mStackSize < kMaxStackSize);
 
     mStack[mStackSize - 1].type = SheepValueType::String;
     mStack[mStackSize - 1].stringValue = str;
+    mStack[mStackSize - 1].symbolValue = symbol;
 
     #ifdef SHEEP_DEBUG
     std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
@@ -121,6 +123,7 @@ void SheepStack::OnPersist(PersistState& ps)
                 {
                     strCache.push_back(str);
                     mStack[i].stringValue = strCache.back().c_str();
+                    mStack[i].symbolValue = Symbol();
                 }
                 break;
         }
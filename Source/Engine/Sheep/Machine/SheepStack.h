@@ -16,7 +16,7 @@ public:
     void PushInt(int val);
     void PushFloat(float val);
     void PushStringOffset(int val);
-    void PushString(const char* str);
+    void PushString(const char* str, Symbol symbol = Symbol());
 
     SheepValue& Peek() { assert(mStackSize > 0); return mStack[mStackSize - 1]; }
     SheepValue& Peek(int index) { assert(mStackSize > 0 && index < mStackSize); return mStack[mStackSize - 1 - index]; }
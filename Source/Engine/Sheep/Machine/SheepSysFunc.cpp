@@ -36,7 +36,10 @@ void AddSysFunc(const std::string& name, char retType, std::initializer_list<cha
     sysFunc.returnType = retType;
     for(auto argType : argTypes)
     {
-        sysFunc.argumentTypes.push_back(argType);
+        // To Sheep, a symbol argument is just a string.
+        bool isSymbol = argType == symbol_TYPE;
+        sysFunc.argumentTypes.push_back(isSymbol ? string_TYPE : argType);
+        sysFunc.symbolArguments.push_back(isSymbol);
     }
     sysFunc.waitable = waitable;
     sysFunc.devOnly = dev;
@@ -14,6 +14,7 @@
 #include <vector>
 #include <unordered_map>
 
+#include "Symbol.h"
 #include "Value.h"
 
 // Bare minimum data to uniquely identify a SysFunc signature in a SheepScript.
@@ -41,6 +42,10 @@ struct SysFunc : public SysFuncImport
     // If true, this function can only work in dev builds.
     bool devOnly = false;
 
+    // For each argument, whether it's a string passed to the function as a symbol.
+    // Sheep only knows about strings, so these args are still string type (3) in argumentTypes.
+    std::vector<bool> symbolArguments;
+
     // Text that's output to explain this function when using HelpCommand.
     //std::string helpText;
 
@@ -110,6 +115,11 @@ std::function<void()> AddWait();
 #define int_TYPE 1
 #define float_TYPE 2
 #define string_TYPE 3
+#define symbol_TYPE 4
+
+// A string argument that names game logic state (flag, variable, noun, verb, etc) can be declared as a "symbol".
+// String constants are interned when a script loads, so the function gets the symbol without hashing the string on every call.
+using symbol = Symbol;
 
 // When registering functions, use these for Waitable and Dev/Release options to improve readability.
 #define WAITABLE true
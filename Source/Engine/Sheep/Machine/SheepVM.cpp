@@ -3,7 +3,9 @@
 #include <iostream>
 
 #include "BinaryReader.h"
+#include "FrameAllocator.h"
 #include "GMath.h"
+#include "MemoryTracker.h"
 #include "PersistState.h"
 #include "ReportManager.h"
 #include "SheepScript.h"
@@ -13,6 +15,19 @@
 //#define SHEEP_DEBUG
 //#define SHEEP_DEBUG_SYS_CALLS
 
+namespace
+{
+    void LogSheepMachine(SheepThread* thread, const char* message)
+    {
+        // This is called for every thread start/stop/block, so look up the stream once and skip building the string if it's disabled.
+        static ReportStream& sheepMachineStream = gReportManager.GetReportStream("SheepMachine");
+        if(sheepMachineStream.IsEnabled())
+        {
+            sheepMachineStream.Log("Sheep " + thread->GetName() + message);
+        }
+    }
+}
+
 std::string SheepInstance::GetName()
 {
     if(mSheepScript != nullptr)
@@ -155,7 +170,7 @@ void SheepVM::StopExecution(const std::string& tag)
     {
         if(thread->mRunning && StringUtil::EqualsIgnoreCase(thread->mTag, tag))
         {
-            gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is exiting");
+            LogSheepMachine(thread, " is exiting");
             thread->mRunning = false;
 
             // Even though we're stopping a Sheep prematurely, we should still execute its wait callback.
@@ -300,6 +315,7 @@ SheepInstance* SheepVM::GetInstance(SheepScript* script)
 {
     // Don't create without a valid script.
     if(script == nullptr) { return nullptr; }
+    MEMORY_TAG_SCOPED(MemoryTag::Sheep);
 
     // If an instance already exists for this SheepScript, AND it is actively being used (reference count > 0), reuse that instance!
     // This is important so that function calls within the same SheepScript persist variables.
@@ -406,7 +422,9 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
     assert(argCount == sysFunc->argumentTypes.size());
 
     // Retrieve the arguments, of the expected types, from the stack.
-    std::vector<Value> args;
+    // Sys funcs are called constantly, so use frame memory for the args.
+    std::frame_vector<Value> args;
+    args.reserve(argCount);
     for(int i = 0; i < argCount; i++)
     {
         SheepValue& sheepValue = thread->mStack.Peek(argCount - 1 - i);
@@ -420,7 +438,16 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
             args.push_back(sheepValue.GetFloat());
             break;
         case 3:
-            args.push_back(sheepValue.GetString());
+            if(sysFunc->symbolArguments[i])
+            {
+                // String constants already have a symbol. Strings built at runtime are interned here.
+                args.push_back(sheepValue.type == SheepValueType::String && !sheepValue.symbolValue.IsEmpty() ?
+                               sheepValue.symbolValue : Symbol(sheepValue.GetString()));
+            }
+            else
+            {
+                args.push_back(sheepValue.GetString());
+            }
             break;
         default:
             std::cout << "Invalid arg type: " << argType << std::endl;
@@ -444,7 +471,14 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
                 std::cout << args[i].To<float>();
                 break;
             case 3:
-                std::cout << args[i].To<std::string>();
+                if(sysFunc->symbolArguments[i])
+                {
+                    std::cout << args[i].To<Symbol>().GetName();
+                }
+                else
+                {
+                    std::cout << args[i].To<std::string>();
+                }
                 break;
             }
 
@@ -501,6 +535,7 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
 SheepThread* SheepVM::CreateThread(SheepInstance* instance, int bytecodeOffset, const std::string& functionName, std::function<void()> finishCallback, const std::string& tag)
 {
     // Create a sheep thread to perform the execution.
+    MEMORY_TAG_SCOPED(MemoryTag::Sheep);
     SheepThread* thread = GetIdleThread();
     thread->mContext = instance;
     thread->mWaitCallback = finishCallback;
@@ -552,13 +587,13 @@ void SheepVM::ContinueExecution(SheepThread* thread)
     if(!thread->mRunning)
     {
         thread->mRunning = true;
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " created and starting");
+        LogSheepMachine(thread, " created and starting");
     }
     else if(thread->mInWaitBlock)
     {
         thread->mBlocked = false;
         thread->mInWaitBlock = false;
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " released at line -1");
+        LogSheepMachine(thread, " released at line -1");
     }
 
     // Get instance/script we'll be using.
@@ -810,6 +845,7 @@ void SheepVM::ContinueExecution(SheepThread* thread)
                     assert(instance->mVariables[varIndex].type == SheepValueType::String);
                     SheepValue& value = thread->mStack.Pop();
                     instance->mVariables[varIndex].stringValue = value.stringValue;
+                    instance->mVariables[varIndex].symbolValue = value.symbolValue;
                 }
                 break;
             }
@@ -851,7 +887,7 @@ void SheepVM::ContinueExecution(SheepThread* thread)
                     #endif
 
                     assert(instance->mVariables[varIndex].type == SheepValueType::String);
-                    thread->mStack.PushString(instance->mVariables[varIndex].stringValue);
+                    thread->mStack.PushString(instance->mVariables[varIndex].stringValue, instance->mVariables[varIndex].symbolValue);
                 }
                 break;
             }
@@ -885,10 +921,10 @@ void SheepVM::ContinueExecution(SheepThread* thread)
             case SheepInstruction::GetString:
             {
                 SheepValue& offsetValue = thread->mStack.Pop();
-                std::string* stringPtr = script->GetStringConst(offsetValue.intValue);
-                if(stringPtr != nullptr)
+                const SheepScript::StringConst* stringConst = script->GetStringConst(offsetValue.intValue);
+                if(stringConst != nullptr)
                 {
-                    thread->mStack.PushString(stringPtr->c_str());
+                    thread->mStack.PushString(stringConst->text.c_str(), stringConst->symbol);
                 }
                 #ifdef SHEEP_DEBUG
                 std::cout << "GetString " << thread->mStack.Peek().stringValue << std::endl;
@@ -1310,7 +1346,7 @@ void SheepVM::ContinueExecution(SheepThread* thread)
     // If we get here and the thread IS running, it means the thread was blocked due to a wait!
     if(!thread->mRunning)
     {
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is exiting");
+        LogSheepMachine(thread, " is exiting");
 
         // Thread is no longer using execution context.
         thread->mContext->mReferenceCount--;
@@ -1323,11 +1359,11 @@ void SheepVM::ContinueExecution(SheepThread* thread)
     }
     else if(thread->mInWaitBlock)
     {
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is blocked at line -1");
+        LogSheepMachine(thread, " is blocked at line -1");
     }
     else
     {
-        gReportManager.Log("SheepMachine", "Sheep " + thread->GetName() + " is in some weird unexpected state!");
+        LogSheepMachine(thread, " is in some weird unexpected state!");
     }
 
     // Restore previously executing thread.
@@ -6,6 +6,8 @@
 #pragma once
 #include <string>
 
+#include "Symbol.h"
+
 enum class SheepValueType
 {
     Void,
@@ -24,6 +26,10 @@ struct SheepValue
         const char* stringValue;
     };
 
+    // For strings, the interned symbol if one is known (e.g. for a string constant). Otherwise, empty.
+    // Lets sys funcs that take symbols skip interning the string on every call.
+    Symbol symbolValue;
+
     SheepValue() { intValue = 0; }
     explicit SheepValue(SheepValueType t) { type = t; intValue = 0; }
     explicit SheepValue(int i) { type = SheepValueType::Int; intValue = i; }
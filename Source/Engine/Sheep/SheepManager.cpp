@@ -1,6 +1,8 @@
 #include "SheepManager.h"
 
+#include "CookCache.h"
 #include "LayerManager.h"
+#include "MemoryTracker.h"
 #include "PersistState.h"
 #include "ReportManager.h"
 #include "StringUtil.h"
@@ -54,22 +56,48 @@ void SheepManager::Init()
 
 SheepScript* SheepManager::Compile(const char* filePath)
 {
+    MEMORY_TAG_SCOPED(MemoryTag::Sheep);
     SheepCompiler compiler;
     return compiler.CompileToAsset(filePath);
 }
 
 SheepScript* SheepManager::Compile(const std::string& name, const std::string& sheep)
 {
+    MEMORY_TAG_SCOPED(MemoryTag::Sheep);
     SheepCompiler compiler;
     return compiler.CompileToAsset(name, sheep);
 }
 
 SheepScript* SheepManager::Compile(const std::string& name, std::istream& stream)
 {
+    MEMORY_TAG_SCOPED(MemoryTag::Sheep);
     SheepCompiler compiler;
     return compiler.CompileToAsset(name, stream);
 }
 
+SheepScript* SheepManager::CompileAssetSheep(const std::string& name, const std::string& sheep)
+{
+    MEMORY_TAG_SCOPED(MemoryTag::Sheep);
+
+    // If this exact sheep was compiled on a previous run, use that result.
+    uint64_t cookKey = CookCache::MakeKey(name, reinterpret_cast<const uint8_t*>(sheep.data()), static_cast<uint32_t>(sheep.size()));
+    SheepScript* script = new SheepScript(name, AssetScope::Manual);
+    if(script->LoadCooked(cookKey))
+    {
+        return script;
+    }
+    delete script;
+
+    // Otherwise, compile it, and save the result for next time.
+    SheepCompiler compiler;
+    script = compiler.CompileToAsset(name, sheep);
+    if(script != nullptr)
+    {
+        script->StoreCooked(cookKey);
+    }
+    return script;
+}
+
 SheepThreadId SheepManager::Execute(SheepScript* script, std::function<void()> finishCallback, const std::string& tag)
 {
     // If no tag is provided, fall back on using the current layer's name.
@@ -90,13 +118,12 @@ SheepThreadId SheepManager::Execute(SheepScript* script, const std::string& func
 
 SheepScript* SheepManager::CompileEval(const std::string& sheep)
 {
-    // Each eval occurs within a small "husk" consisting of two vars (n/v) and a single function called X$.
-    // The passed in Sheep is the body of function X$
-    const char* kEvalHusk = "symbols { int n$ = 0; int v$ = 0; } code { X$() %s }";
-    std::string fullSheep = StringUtil::Format(kEvalHusk, sheep.c_str());
+    return Compile("Case Evaluation", MakeEvalSheep(sheep));
+}
 
-    SheepCompiler compiler;
-    return compiler.CompileToAsset("Case Evaluation", fullSheep);
+SheepScript* SheepManager::CompileAssetEval(const std::string& sheep)
+{
+    return CompileAssetSheep("Case Evaluation", MakeEvalSheep(sheep));
 }
 
 bool SheepManager::Evaluate(SheepScript* script)
@@ -120,4 +147,12 @@ void SheepManager::OnPersist(PersistState& ps)
     {
         mVirtualMachine.OnPersist(ps);
     }
-}
\ No newline at end of file
+}
+
+std::string SheepManager::MakeEvalSheep(const std::string& sheep)
+{
+    // Each eval occurs within a small "husk" consisting of two vars (n/v) and a single function called X$.
+    // The passed in Sheep is the body of function X$
+    const char* kEvalHusk = "symbols { int n$ = 0; int v$ = 0; } code { X$() %s }";
+    return StringUtil::Format(kEvalHusk, sheep.c_str());
+}
@@ -20,12 +20,17 @@ public:
     SheepScript* Compile(const std::string& name, const std::string& sheep);
     SheepScript* Compile(const std::string& name, std::istream& stream);
 
+    // Sheep embedded in assets (NVC scripts, SIF conditions, etc) is the same every run, so its compiled form is kept in the cook cache.
+    // Other sheep (e.g. typed into the console) would just fill up the cache, so it should use the functions above.
+    SheepScript* CompileAssetSheep(const std::string& name, const std::string& sheep);
+
     // Execution - execute a compiled SheepScript.
     SheepThreadId Execute(SheepScript* script, std::function<void()> finishCallback, const std::string& tag = "");
     SheepThreadId Execute(SheepScript* script, const std::string& functionName, std::function<void()> finishCallback, const std::string& tag = "");
 
     // Evaluation - special form of SheepScript; only boolean logic is allowed, must evaluate to true or false. Waiting/callbacks are not allowed.
     SheepScript* CompileEval(const std::string& sheep);
+    SheepScript* CompileAssetEval(const std::string& sheep);
     bool Evaluate(SheepScript* script);
     bool Evaluate(SheepScript* script, int n, int v);
 
@@ -43,6 +48,8 @@ public:
 private:
     // Executes binary bytecode sheep scripts.
     SheepVM mVirtualMachine;
+
+    std::string MakeEvalSheep(const std::string& sheep);
 };
 
 extern SheepManager gSheepManager;
@@ -3,8 +3,11 @@
 #include <cstring>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "CookCache.h"
 #include "mstream.h"
 #include "SheepManager.h"
 #include "SheepScriptBuilder.h"
@@ -41,12 +44,20 @@ void SheepScript::Load(AssetData& data)
         return;
     }
 
+    // If this exact script was compiled on a previous run, use that result.
+    uint64_t cookKey = CookCache::MakeKey(GetName(), data.bytes.get(), data.length);
+    if(LoadCooked(cookKey))
+    {
+        return;
+    }
+
     // If the data is in uncompiled text format, we must compile it!
     SheepCompiler compiler;
     imstream stream(reinterpret_cast<char*>(data.bytes.get()), data.length);
     if(compiler.Compile(GetNameNoExtension(), stream))
     {
         Load(compiler.GetCompiledBuilder());
+        StoreCooked(cookKey);
     }
 }
 
@@ -54,23 +65,61 @@ void SheepScript::Load(const SheepScriptBuilder& builder)
 {
     // Just copy these directly.
     mSysImports = builder.GetSysImports();
-    mStringConsts = builder.GetStringConsts();
+    for(auto& entry : builder.GetStringConsts())
+    {
+        AddStringConst(entry.first, entry.second);
+    }
     mVariables = builder.GetVariables();
     mFunctions = builder.GetFunctions();
 
     // Bytecode needs to convert from std::vector to byte array.
+    delete[] mBytecode;
     mBytecodeLength = builder.GetBytecode().size();
     mBytecode = new char[mBytecodeLength];
     std::copy(builder.GetBytecode().begin(), builder.GetBytecode().end(), mBytecode);
 }
 
+bool SheepScript::LoadCooked(uint64_t cookKey)
+{
+    const uint8_t* cookedData = nullptr;
+    uint32_t cookedLength = 0;
+    if(!gCookCache.Find(cookKey, cookedData, cookedLength))
+    {
+        return false;
+    }
+
+    // If the cooked data is somehow bad, clear out anything partially read, so the caller can compile as usual.
+    BinaryReader reader(cookedData, cookedLength);
+    if(!ReadCooked(reader))
+    {
+        mSysImports.clear();
+        mStringConsts.clear();
+        mVariables.clear();
+        mFunctions.clear();
+        return false;
+    }
+    return true;
+}
+
+void SheepScript::StoreCooked(uint64_t cookKey) const
+{
+    if(!gCookCache.IsEnabled()) { return; }
+
+    std::stringstream stream;
+    BinaryWriter writer(&stream);
+    WriteCooked(writer);
+
+    std::string cookedData = stream.str();
+    gCookCache.Store(cookKey, reinterpret_cast<const uint8_t*>(cookedData.data()), static_cast<uint32_t>(cookedData.size()));
+}
+
 SysFuncImport* SheepScript::GetSysImport(int index)
 {
     if(index < 0 || index >= mSysImports.size()) { return nullptr; }
     return &mSysImports[index];
 }
 
-std::string* SheepScript::GetStringConst(int offset)
+const SheepScript::StringConst* SheepScript::GetStringConst(int offset) const
 {
     auto it = mStringConsts.find(offset);
     if(it != mStringConsts.end())
@@ -80,6 +129,15 @@ std::string* SheepScript::GetStringConst(int offset)
     return nullptr;
 }
 
+void SheepScript::AddStringConst(int offset, const std::string& text)
+{
+    StringConst& stringConst = mStringConsts[offset];
+    stringConst.text = text;
+
+    // Compiled sheep string data includes null terminators, which aren't part of the name.
+    stringConst.symbol = Symbol(text.c_str());
+}
+
 int SheepScript::GetFunctionOffset(const std::string& functionName)
 {
     // Find it and return it, or fail with -1 offset.
@@ -237,7 +295,7 @@ void SheepScript::ParseStringConstsSection(BinaryReader& reader)
             endOffset = dataBaseOffset + contentSize;
         }
         std::string str = reader.ReadString(endOffset - startOffset);
-        mStringConsts[startOffset - dataBaseOffset] = str;
+        AddStringConst(startOffset - dataBaseOffset, str);
     }
 }
 
@@ -347,6 +405,133 @@ void SheepScript::ParseCodeSection(BinaryReader& reader)
     reader.Read(reinterpret_cast<uint8_t*>(mBytecode), mBytecodeLength);
 }
 
+bool SheepScript::ReadCooked(BinaryReader& reader)
+{
+    // The cooked format is just each piece of the compiled script, written out in order.
+    // Counts and sizes are checked against the bytes left before using them, so bad data can't cause huge allocations.
+    uint32_t length = reader.GetLength();
+    auto canRead = [&reader, length](uint64_t count, uint32_t minBytesEach) {
+        return reader.CanRead() && reader.GetPosition() + count * minBytesEach <= length;
+    };
+
+    // Each import is at least a name length, return type, and argument count.
+    uint32_t sysImportCount = reader.ReadUInt();
+    if(!canRead(sysImportCount, 4)) { return false; }
+    mSysImports.resize(sysImportCount);
+    for(SysFuncImport& import : mSysImports)
+    {
+        reader.ReadString16(import.name);
+        import.returnType = reader.ReadSByte();
+        uint8_t argumentCount = reader.ReadByte();
+        if(!canRead(argumentCount, 1)) { return false; }
+        import.argumentTypes.resize(argumentCount);
+        for(char& argumentType : import.argumentTypes)
+        {
+            argumentType = reader.ReadSByte();
+        }
+    }
+
+    // Each string const is at least an offset and a string length.
+    uint32_t stringConstCount = reader.ReadUInt();
+    if(!canRead(stringConstCount, 8)) { return false; }
+    for(uint32_t i = 0; i < stringConstCount; ++i)
+    {
+        int offset = reader.ReadInt();
+        uint32_t stringLength = reader.ReadUInt();
+        if(!canRead(stringLength, 1)) { return false; }
+        std::string str;
+        reader.ReadString(stringLength, str);
+        AddStringConst(offset, str);
+    }
+
+    // As with compiled sheep files, string variables don't store a default value.
+    uint32_t variableCount = reader.ReadUInt();
+    if(!canRead(variableCount, 1)) { return false; }
+    mVariables.resize(variableCount);
+    for(SheepValue& variable : mVariables)
+    {
+        variable.type = static_cast<SheepValueType>(reader.ReadByte());
+        if(variable.type == SheepValueType::Float)
+        {
+            variable.floatValue = reader.ReadFloat();
+        }
+        else if(variable.type == SheepValueType::String)
+        {
+            variable.stringValue = nullptr;
+        }
+        else
+        {
+            variable.intValue = reader.ReadInt();
+        }
+    }
+
+    // Each function is at least a name length and an offset.
+    uint32_t functionCount = reader.ReadUInt();
+    if(!canRead(functionCount, 6)) { return false; }
+    for(uint32_t i = 0; i < functionCount; ++i)
+    {
+        std::string name = reader.ReadString16();
+        mFunctions[name] = reader.ReadInt();
+    }
+
+    mBytecodeLength = reader.ReadInt();
+    if(mBytecodeLength < 0 || !canRead(mBytecodeLength, 1))
+    {
+        mBytecodeLength = 0;
+        return false;
+    }
+    delete[] mBytecode;
+    mBytecode = new char[mBytecodeLength];
+    reader.Read(reinterpret_cast<uint8_t*>(mBytecode), mBytecodeLength);
+    return reader.CanRead();
+}
+
+void SheepScript::WriteCooked(BinaryWriter& writer) const
+{
+    writer.WriteUInt(static_cast<uint32_t>(mSysImports.size()));
+    for(const SysFuncImport& import : mSysImports)
+    {
+        writer.WriteString16(import.name);
+        writer.WriteSByte(import.returnType);
+        writer.WriteByte(static_cast<uint8_t>(import.argumentTypes.size()));
+        for(char argumentType : import.argumentTypes)
+        {
+            writer.WriteSByte(argumentType);
+        }
+    }
+
+    writer.WriteUInt(static_cast<uint32_t>(mStringConsts.size()));
+    for(auto& entry : mStringConsts)
+    {
+        writer.WriteInt(entry.first);
+        writer.WriteString32(entry.second.text);
+    }
+
+    writer.WriteUInt(static_cast<uint32_t>(mVariables.size()));
+    for(const SheepValue& variable : mVariables)
+    {
+        writer.WriteByte(static_cast<uint8_t>(variable.type));
+        if(variable.type == SheepValueType::Float)
+        {
+            writer.WriteFloat(variable.floatValue);
+        }
+        else if(variable.type != SheepValueType::String)
+        {
+            writer.WriteInt(variable.intValue);
+        }
+    }
+
+    writer.WriteUInt(static_cast<uint32_t>(mFunctions.size()));
+    for(auto& entry : mFunctions)
+    {
+        writer.WriteString16(entry.first);
+        writer.WriteInt(entry.second);
+    }
+
+    writer.WriteInt(mBytecodeLength);
+    writer.Write(reinterpret_cast<const uint8_t*>(mBytecode), mBytecodeLength);
+}
+
 /**
  * BELOW HERE: MESSY/EXPERIMENTAL DECOMPILER CODE!
  * Converts a compiled sheepscript back to human readable form (more or less).
@@ -729,10 +914,10 @@ void SheepScript::Decompile(const std::string& filePath)
         case SheepInstruction::GetString:
         {
             SheepValue& offsetValue = stack.Pop();
-            std::string* stringPtr = GetStringConst(offsetValue.intValue);
-            if(stringPtr != nullptr)
+            const StringConst* stringConst = GetStringConst(offsetValue.intValue);
+            if(stringConst != nullptr)
             {
-                std::string fullString = "\"" + *stringPtr;
+                std::string fullString = "\"" + stringConst->text;
                 if(fullString.back() == '\0')
                 {
                     fullString.pop_back();
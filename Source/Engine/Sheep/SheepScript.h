@@ -13,14 +13,18 @@
 #include "SheepSysFunc.h"
 #include "SheepVM.h"
 #include "StringUtil.h"
+#include "Symbol.h"
 
 class BinaryReader;
+class BinaryWriter;
 class SheepScriptBuilder;
 
 class SheepScript : public Asset
 {
     TYPEINFO_SUB(SheepScript, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Sheep;
+
     static bool IsSheepDataCompiled(uint8_t* data, uint32_t dataLength);
 
     SheepScript(const std::string& name, AssetScope scope) : Asset(name, scope) { }
@@ -30,9 +34,20 @@ public:
     void Load(AssetData& data);
     void Load(const SheepScriptBuilder& builder);
 
+    // Compiling text-based sheep is slow, so compiled results can be saved in the cook cache and loaded on later runs.
+    bool LoadCooked(uint64_t cookKey);
+    void StoreCooked(uint64_t cookKey) const;
+
     SysFuncImport* GetSysImport(int index);
 
-    std::string* GetStringConst(int offset);
+    // A string constant, with its symbol interned at load.
+    // String constants are commonly flag/variable/noun/verb names passed to sys funcs, so those calls don't need to intern them.
+    struct StringConst
+    {
+        std::string text;
+        Symbol symbol;
+    };
+    const StringConst* GetStringConst(int offset) const;
 
     std::vector<SheepValue> GetVariables() { return mVariables; }
 
@@ -51,7 +66,7 @@ private:
     std::vector<SysFuncImport> mSysImports;
 
     // String constants, keyed by data offset, since that's how bytecode identifies them.
-    std::unordered_map<int, std::string> mStringConsts;
+    std::unordered_map<int, StringConst> mStringConsts;
 
     // Represents variable ordering, types, and default values.
     // Bytecode only cares about the index of the variable.
@@ -65,7 +80,11 @@ private:
     char* mBytecode = nullptr;
     int mBytecodeLength = 0;
 
+    void AddStringConst(int offset, const std::string& text);
+
     void ParseFromData(uint8_t* data, uint32_t dataLength);
+    bool ReadCooked(BinaryReader& reader);
+    void WriteCooked(BinaryWriter& writer) const;
     void ParseSysImportsSection(BinaryReader& reader);
     void ParseStringConstsSection(BinaryReader& reader);
     void ParseVariablesSection(BinaryReader& reader);
@@ -124,7 +124,7 @@ void AssetsTool::AddAssetList(const std::string& id)
     ImGui::PushID(assetId.c_str());
 
      // Get list of loaded assets of this type, so we can display them in a giant tree view.
-    const std::string_map_ci<T*>& loadedAssets = gAssetManager.GetAssets<T>(id);
+    const SymbolMap<T*>& loadedAssets = gAssetManager.GetAssets<T>(id);
 
     // For all nodes, only expand the tree if you click on the arrow.
     ImGuiTreeNodeFlags assetTypeFlags = ImGuiTreeNodeFlags_OpenOnArrow;
@@ -133,11 +133,11 @@ void AssetsTool::AddAssetList(const std::string& id)
     bool node_open;
     if(id.empty())
     {
-        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s (%zu)", typeName, loadedAssets.size());
+        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s (%zu)", typeName, loadedAssets.Size());
     }
     else
     {
-        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s %s (%zu)", id.c_str(), typeName, loadedAssets.size());
+        node_open = ImGui::TreeNodeEx(assetId.c_str(), assetTypeFlags, "%s %s (%zu)", id.c_str(), typeName, loadedAssets.Size());
     }
 
     // If open, draw all the loaded assets of this type.
@@ -75,6 +75,10 @@ void MainMenuTool::Render()
             {
                 assetsToolActive = !assetsToolActive;
             }
+            if(ImGui::MenuItem("Memory", nullptr, memoryToolActive))
+            {
+                memoryToolActive = !memoryToolActive;
+            }
             if(ImGui::MenuItem("Raycasts", nullptr, raycastToolActive))
             {
                 raycastToolActive = !raycastToolActive;
@@ -0,0 +1,112 @@
+#include "MemoryTool.h"
+
+#include <imgui.h>
+
+#include "MemoryTracker.h"
+#include "Paths.h"
+#include "ReportManager.h"
+
+namespace
+{
+    // Shows a byte count in the most readable unit.
+    void TextBytes(size_t bytes)
+    {
+        if(bytes >= 1024 * 1024)
+        {
+            ImGui::Text("%.2f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+        }
+        else if(bytes >= 1024)
+        {
+            ImGui::Text("%.2f KB", static_cast<double>(bytes) / 1024.0);
+        }
+        else
+        {
+            ImGui::Text("%zu B", bytes);
+        }
+    }
+
+    void AddStatsRow(const char* name, const MemoryTracker::TagStats& stats)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name);
+        ImGui::TableNextColumn();
+        TextBytes(stats.liveBytes);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", stats.liveCount);
+        ImGui::TableNextColumn();
+        TextBytes(stats.peakBytes);
+        ImGui::TableNextColumn();
+
+        // Growth since the baseline was set. Steady growth across timeblocks is a sign of a leak.
+        if(stats.liveBytes >= stats.baselineBytes)
+        {
+            ImGui::Text("+%.2f KB", static_cast<double>(stats.liveBytes - stats.baselineBytes) / 1024.0);
+        }
+        else
+        {
+            ImGui::Text("-%.2f KB", static_cast<double>(stats.baselineBytes - stats.liveBytes) / 1024.0);
+        }
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", stats.frameAllocCount);
+        ImGui::TableNextColumn();
+        TextBytes(stats.frameAllocBytes);
+    }
+}
+
+void MemoryTool::Render(bool& toolActive)
+{
+    if(!toolActive) { return; }
+
+    // Sets the default size of the window on first open.
+    ImGui::SetNextWindowSize(ImVec2(640, 300), ImGuiCond_FirstUseEver);
+
+    // Begin the window. Early out if collapsed.
+    if(ImGui::Begin("Memory", &toolActive))
+    {
+        if(!MemoryTracker::IsEnabled())
+        {
+            ImGui::TextWrapped("Memory tracking is disabled. Define MEMORY_TRACKING_ENABLED (in MemoryTracker.h) to enable it.");
+        }
+        else
+        {
+            if(ImGui::Button("Set Baseline"))
+            {
+                MemoryTracker::SetBaseline();
+            }
+            ImGui::SameLine();
+            if(ImGui::Button("Dump to CSV"))
+            {
+                std::string filePath = Paths::GetUserDataPath("MemoryReport.csv");
+                if(MemoryTracker::DumpToCSV(filePath))
+                {
+                    gReportManager.Log("Dump", "Memory report written to " + filePath);
+                }
+            }
+
+            ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+            if(ImGui::BeginTable("MemoryTags", 7, flags))
+            {
+                ImGui::TableSetupColumn("Tag");
+                ImGui::TableSetupColumn("Live");
+                ImGui::TableSetupColumn("Count");
+                ImGui::TableSetupColumn("Peak");
+                ImGui::TableSetupColumn("Since Baseline");
+                ImGui::TableSetupColumn("Allocs/Frame");
+                ImGui::TableSetupColumn("Bytes/Frame");
+                ImGui::TableHeadersRow();
+
+                for(int i = 0; i < static_cast<int>(MemoryTag::Count); ++i)
+                {
+                    MemoryTag tag = static_cast<MemoryTag>(i);
+                    AddStatsRow(MemoryTracker::GetTagName(tag), MemoryTracker::GetTagStats(tag));
+                }
+                AddStatsRow("Total", MemoryTracker::GetTotalStats());
+                ImGui::EndTable();
+            }
+        }
+    }
+
+    // End window.
+    ImGui::End();
+}
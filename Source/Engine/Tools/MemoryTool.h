@@ -0,0 +1,15 @@
+//
+// Clark Kromenaker
+//
+// A tool that displays memory usage per subsystem, as recorded by the memory tracker.
+//
+#pragma once
+
+class MemoryTool
+{
+public:
+    void Render(bool& toolActive);
+
+private:
+
+};
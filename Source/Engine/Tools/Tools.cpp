@@ -10,6 +10,7 @@
 #include "AssetsTool.h"
 #include "HierarchyTool.h"
 #include "MainMenuTool.h"
+#include "MemoryTool.h"
 #include "RaycastTool.h"
 #include "SettingsTool.h"
 
@@ -29,6 +30,7 @@ namespace
     MainMenuTool mainMenu;
     HierarchyTool hierarchy;
     AssetsTool assets;
+    MemoryTool memory;
     RaycastTool raycasts;
     SettingsTool settings;
 }
@@ -98,6 +100,7 @@ void Tools::Render()
         // Render specific tools based on whether they are active.
         hierarchy.Render(mainMenu.hierarchyToolActive);
         assets.Render(mainMenu.assetsToolActive);
+        memory.Render(mainMenu.memoryToolActive);
         raycasts.Render(mainMenu.raycastToolActive);
         settings.Render(mainMenu.settingsToolActive);
 
@@ -7,6 +7,7 @@
 #include "ReportManager.h"
 #include "ShaderCache.h"
 #include "StringUtil.h"
+#include "TextLayoutCache.h"
 #include "Texture.h"
 
 TYPEINFO_INIT(Font, Asset, GENERATE_TYPE_ID)
@@ -19,6 +20,12 @@ TYPEINFO_INIT(Font, Asset, GENERATE_TYPE_ID)
     TYPEINFO_VAR(Font, VariableType::Int, mGlyphHeight);
 }
 
+Font::~Font()
+{
+    // Cached text layouts reference this font's glyphs, so they must go too.
+    TextLayoutCache::Clear(this);
+}
+
 void Font::Load(AssetData& data)
 {
     ParseFromData(data.bytes.get(), data.length);
@@ -51,6 +58,7 @@ void Font::Load(AssetData& data)
     // For each char, determine UV rect within the font texture for rendering the glyph.
     uint32_t currentY = 0;
     int currentLine = 1;
+    std::array<bool, 256> hasGlyph = { };
     for(size_t i = 0; i < mFontCharacters.size(); i++)
     {
         Glyph glyph;
@@ -115,7 +123,9 @@ void Font::Load(AssetData& data)
         glyph.bottomRightUvCoord = Vector2(rightUvX, botUvY);
 
         // Save the glyph, mapped to its character.
-        mFontGlyphs[glyph.character] = glyph;
+        unsigned char glyphIndex = static_cast<unsigned char>(glyph.character);
+        mFontGlyphs[glyphIndex] = glyph;
+        hasGlyph[glyphIndex] = true;
 
         // If we reached the end of the font texture, go to the next line, if possible.
         if(currentX >= mFontTexture->GetWidth() - 1 && currentLine < mLineCount)
@@ -126,6 +136,16 @@ void Font::Load(AssetData& data)
         }
     }
 
+    // Any character without a glyph uses the default char's glyph instead.
+    // Filling these in now means GetGlyph is just an array index.
+    for(size_t i = 0; i < mFontGlyphs.size(); ++i)
+    {
+        if(!hasGlyph[i])
+        {
+            mFontGlyphs[i] = mFontGlyphs[mDefaultChar];
+        }
+    }
+
     // If font uses color replace logic, the pixel at (0, 1)
     // indicates what color should be replaced with the foreground color.
     if(mColorMode == ColorMode::ColorReplace)
@@ -138,23 +158,15 @@ void Font::Load(AssetData& data)
     std::cout << "Glyphs for font " << GetName() << std::endl;
     for(auto& glyph : mFontGlyphs)
     {
-        std::cout << glyph.second.character << ": " << glyph.second.width <<
-        ", " << glyph.second.height << std::endl;
+        std::cout << glyph.character << ": " << glyph.width <<
+        ", " << glyph.height << std::endl;
     }
     */
 }
 
 Glyph& Font::GetGlyph(char character)
 {
-    auto it = mFontGlyphs.find(character);
-    if(it != mFontGlyphs.end())
-    {
-        return it->second;
-    }
-    else
-    {
-        return mFontGlyphs[mDefaultChar];
-    }
+    return mFontGlyphs[static_cast<unsigned char>(character)];
 }
 
 Shader* Font::GetShader() const
@@ -6,7 +6,7 @@
 #pragma once
 #include "Asset.h"
 
-#include <unordered_map>
+#include <array>
 
 #include "Color32.h"
 #include "Vector2.h"
@@ -20,8 +20,8 @@ struct Glyph
     char character = 'a';
 
     // Width and height of glyph, in pixels.
-    int width;
-    int height;
+    int width = 0;
+    int height = 0;
 
     // The UVs to use on a quad to render this glyph.
     Vector2 bottomLeftUvCoord;
@@ -36,6 +36,8 @@ class Font : public Asset
     TYPEINFO_SUB(Font, Asset);
 public:
     Font(const std::string& name, AssetScope scope) : Asset(name, scope) { }
+    ~Font();
+
     void Load(AssetData& data);
 
     Texture* GetTexture() const { return mFontTexture; }
@@ -94,8 +96,9 @@ private:
     // We can use this to make some assumptions about line height.
     int mGlyphHeight = 0;
 
-    // A mapping from character to glyph.
-    std::unordered_map<char, Glyph> mFontGlyphs;
+    // A mapping from character to glyph, indexed directly by (unsigned) character value.
+    // Characters the font can't render map to a copy of the default char's glyph, so lookups never miss.
+    std::array<Glyph, 256> mFontGlyphs;
 
     void ParseFromData(uint8_t* data, uint32_t dataLength);
 };
\ No newline at end of file
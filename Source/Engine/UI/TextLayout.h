@@ -74,6 +74,14 @@ public:
     TextLayout(TextLayout&& other) = default;
     TextLayout& operator=(const TextLayout& other) = default;
 
+    // Settings
+    const Rect& GetRect() const { return mRect; }
+    Font* GetFont() const { return mFont; }
+    HorizontalAlignment GetHorizontalAlignment() const { return mHorizontalAlignment; }
+    VerticalAlignment GetVerticalAlignment() const { return mVerticalAlignment; }
+    HorizontalOverflow GetHorizontalOverflow() const { return mHorizontalOverflow; }
+    VerticalOverflow GetVerticalOverflow() const { return mVerticalOverflow; }
+
     // Lines
     void AddLine(const std::string& line);
     int GetLineCount() const { return mLineCount; }
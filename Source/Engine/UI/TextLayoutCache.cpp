@@ -0,0 +1,108 @@
+#include "TextLayoutCache.h"
+
+#include <unordered_map>
+
+#include "TextLayout.h"
+
+namespace
+{
+    // Everything that affects the result of a text layout.
+    struct LayoutKey
+    {
+        Font* font = nullptr;
+        Rect rect;
+        HorizontalAlignment horizontalAlignment = HorizontalAlignment::Left;
+        VerticalAlignment verticalAlignment = VerticalAlignment::Top;
+        HorizontalOverflow horizontalOverflow = HorizontalOverflow::Overflow;
+        VerticalOverflow verticalOverflow = VerticalOverflow::Overflow;
+        std::string text;
+
+        bool operator==(const LayoutKey& other) const
+        {
+            return font == other.font &&
+                   rect == other.rect &&
+                   horizontalAlignment == other.horizontalAlignment &&
+                   verticalAlignment == other.verticalAlignment &&
+                   horizontalOverflow == other.horizontalOverflow &&
+                   verticalOverflow == other.verticalOverflow &&
+                   text == other.text;
+        }
+    };
+
+    struct LayoutKeyHash
+    {
+        std::size_t operator()(const LayoutKey& key) const
+        {
+            std::size_t res = 17;
+            res = res * 31 + std::hash<Font*>()(key.font);
+            res = res * 31 + std::hash<float>()(key.rect.x);
+            res = res * 31 + std::hash<float>()(key.rect.y);
+            res = res * 31 + std::hash<float>()(key.rect.width);
+            res = res * 31 + std::hash<float>()(key.rect.height);
+            res = res * 31 + static_cast<std::size_t>(key.horizontalAlignment);
+            res = res * 31 + static_cast<std::size_t>(key.verticalAlignment);
+            res = res * 31 + static_cast<std::size_t>(key.horizontalOverflow);
+            res = res * 31 + static_cast<std::size_t>(key.verticalOverflow);
+            res = res * 31 + std::hash<std::string>()(key.text);
+            return res;
+        }
+    };
+
+    // The cached layouts.
+    std::unordered_map<LayoutKey, TextLayout, LayoutKeyHash> layouts;
+
+    // Once this many layouts are cached, the cache is flushed.
+    // Labels with constantly changing text (timers, scores, etc) would otherwise grow the cache forever.
+    const size_t kMaxCachedLayouts = 1024;
+}
+
+void TextLayoutCache::AddText(TextLayout& layout, const std::string& text)
+{
+    // Cached results are only valid if starting from an empty layout.
+    // Also, layouts without a font can't be cached (or laid out, for that matter).
+    if(layout.GetLineCount() > 0 || layout.GetFont() == nullptr)
+    {
+        layout.AddLine(text);
+        return;
+    }
+
+    LayoutKey key;
+    key.font = layout.GetFont();
+    key.rect = layout.GetRect();
+    key.horizontalAlignment = layout.GetHorizontalAlignment();
+    key.verticalAlignment = layout.GetVerticalAlignment();
+    key.horizontalOverflow = layout.GetHorizontalOverflow();
+    key.verticalOverflow = layout.GetVerticalOverflow();
+    key.text = text;
+
+    // If we've already laid out this text with these settings, just copy the result.
+    auto it = layouts.find(key);
+    if(it != layouts.end())
+    {
+        layout = it->second;
+        return;
+    }
+
+    // Otherwise, do the layout and save the result for next time.
+    layout.AddLine(text);
+    if(layouts.size() >= kMaxCachedLayouts)
+    {
+        layouts.clear();
+    }
+    layouts.emplace(std::move(key), layout);
+}
+
+void TextLayoutCache::Clear(Font* font)
+{
+    for(auto it = layouts.begin(); it != layouts.end();)
+    {
+        if(it->first.font == font)
+        {
+            it = layouts.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+//
+// Clark Kromenaker
+//
+// Caches the results of text layout calculations.
+//
+// Laying out text (and especially word wrapping it) isn't free, and a lot of UI
+// (captions, tooltips, Sidney pages) re-layouts the exact same text with the exact same settings over and over.
+// This cache remembers the glyph positions for a given font/text/rect/alignment combo, so a repeat layout is just a copy.
+//
+#pragma once
+#include <string>
+
+class Font;
+class TextLayout;
+
+namespace TextLayoutCache
+{
+    // Adds the given text to an empty layout, reusing a cached result if one exists for the layout's settings.
+    void AddText(TextLayout& layout, const std::string& text);
+
+    // Clears cached layouts that use the given font (e.g. because the font is being deleted).
+    void Clear(Font* font);
+}
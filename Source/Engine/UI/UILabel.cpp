@@ -7,6 +7,7 @@
 #include "Font.h"
 #include "Mesh.h"
 #include "TextLayout.h"
+#include "TextLayoutCache.h"
 #include "Texture.h"
 
 TYPEINFO_INIT(UILabel, UIWidget, 21)
@@ -174,7 +175,8 @@ Vector2 UILabel::GetCharPos(int index) const
 void UILabel::PopulateTextLayout(TextLayout& textLayout)
 {
     // Add all text to text layout to calculate glyph positions and such.
-    textLayout.AddLine(mText);
+    // Labels often regenerate with the same text and settings, so go through the layout cache.
+    TextLayoutCache::AddText(textLayout, mText);
 }
 
 void UILabel::GenerateMesh()
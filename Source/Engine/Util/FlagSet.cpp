@@ -1,28 +1,30 @@
 #include "FlagSet.h"
 
+#include "PersistState.h"
 #include "ReportManager.h"
 
 bool FlagSet::Get(const std::string& flag) const
 {
     // If the flag exists, it implies a "true" value.
     // Absence of flag implies "false" value.
-    auto it = mFlags.find(flag);
-    return it != mFlags.end();
+    // A name that was never interned can't be set, so no need to intern it here.
+    Symbol symbol = Symbol::Find(flag);
+    return !symbol.IsEmpty() && Get(symbol);
 }
 
 void FlagSet::Set(const std::string& flag)
 {
     // Doesn't matter whether we are setting an already set flag.
-    mFlags.insert(flag);
+    Set(Symbol(flag));
 }
 
 void FlagSet::Clear(const std::string& flag)
 {
     // Erase the flag from the container to "clear" it.
-    auto it = mFlags.find(flag);
-    if(it != mFlags.end())
+    Symbol symbol = Symbol::Find(flag);
+    if(!symbol.IsEmpty())
     {
-        mFlags.erase(it);
+        Clear(symbol);
     }
 }
 
@@ -52,7 +54,7 @@ void FlagSet::Dump(const std::string& label) const
     }
 
     // Extra space if we actually have flags.
-    if(!mFlags.empty())
+    if(!mFlags.Empty())
     {
         dump += "\n";
     }
@@ -63,7 +65,29 @@ void FlagSet::Dump(const std::string& label) const
     //TODO: 2) Flags aren't output if their values are false (since they won't be present in the set).
     for(auto& entry : mFlags)
     {
-        dump += StringUtil::Format("flag \"%s\" is true\n", entry.c_str());
+        dump += StringUtil::Format("flag \"%s\" is true\n", entry.first.GetName().c_str());
     }
     gReportManager.Log("Dump", dump);
-}
\ No newline at end of file
+}
+
+void FlagSet::OnPersist(PersistState& ps, const char* name)
+{
+    // Flags are saved by name, since symbol IDs aren't stable between runs.
+    std::string_set_ci flags;
+    if(ps.IsSaving())
+    {
+        for(auto& entry : mFlags)
+        {
+            flags.insert(entry.first.GetName());
+        }
+    }
+    ps.Xfer(name, flags);
+    if(ps.IsLoading())
+    {
+        mFlags.Clear();
+        for(auto& flag : flags)
+        {
+            mFlags[Symbol(flag)] = true;
+        }
+    }
+}
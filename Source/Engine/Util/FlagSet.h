@@ -3,8 +3,14 @@
 //
 // A set of flags.
 //
+// Flags are stored as symbols, so checking a flag is an integer lookup rather than a case-insensitive string lookup.
+//
 #pragma once
-#include "StringUtil.h"
+#include <string>
+
+#include "Symbol.h"
+
+class PersistState;
 
 class FlagSet
 {
@@ -14,11 +20,15 @@ public:
     void Clear(const std::string& flag);
     void Toggle(const std::string& flag);
 
+    bool Get(Symbol flag) const { return mFlags.Contains(flag); }
+    void Set(Symbol flag) { mFlags[flag] = true; }
+    void Clear(Symbol flag) { mFlags.Erase(flag); }
+
     void Dump(const std::string& label = "") const;
 
-    std::string_set_ci& GetFlags() { return mFlags; }
+    void OnPersist(PersistState& ps, const char* name);
 
 private:
-    // The flags.
-    std::string_set_ci mFlags;
-};
\ No newline at end of file
+    // The flags. A flag is "true" if present in the map.
+    SymbolMap<bool> mFlags;
+};
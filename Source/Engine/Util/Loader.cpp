@@ -5,8 +5,7 @@
 #include "Log.h"
 #include "ThreadPool.h"
 
-// Loader uses a single background thread, for now.
-ThreadedTaskQueue Loader::sLoadingTasks(1);
+JobHandle Loader::sLastLoadingTask;
 
 int Loader::sLoadingCount = 0;
 std::function<void()> Loader::sLoadingFinishedCallback;
@@ -14,7 +13,8 @@ Stopwatch Loader::sLoadingStopwatch;
 
 void Loader::Shutdown()
 {
-    sLoadingTasks.Shutdown();
+    // Any loading tasks that haven't run yet are abandoned when the thread pool shuts down.
+    sLastLoadingTask = JobHandle();
 }
 
 void Loader::Load(const std::function<void()>& loadFunc)
@@ -22,9 +22,9 @@ void Loader::Load(const std::function<void()>& loadFunc)
     if(loadFunc != nullptr)
     {
         AddLoadingTask();
-        sLoadingTasks.AddTask(loadFunc, []() {
+        sLastLoadingTask = ThreadPool::AddTask(loadFunc, []() {
             RemoveLoadingTask();
-        });
+        }, sLastLoadingTask);
     }
 }
 
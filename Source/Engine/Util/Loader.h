@@ -26,8 +26,9 @@ public:
     static bool IsLoading() { return sLoadingCount > 0; }
 
 private:
-    // Threads devoted to loading tasks.
-    static ThreadedTaskQueue sLoadingTasks;
+    // The most recently added loading task.
+    // Loading tasks aren't safe to run at the same time (e.g. they all use the asset manager), so each one depends on the one before it.
+    static JobHandle sLastLoadingTask;
 
     // Number of loading tasks.
     static int sLoadingCount;
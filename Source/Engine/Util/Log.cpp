@@ -1,71 +1,360 @@
 #include "Log.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 #include <mutex>
+#include <thread>
+
+#include "MpscQueue.h"
+#include "StreamLockGuard.h"
 
 namespace
 {
-    // Helper struct just ensures fclose gets called on the log file when application exits.
-    struct LogFile
+    struct LogMessage
+    {
+        // The stream to write to. If null, the message goes to standard output and the shared log file.
+        StreamHandle stream = nullptr;
+
+        // The text to write.
+        std::string text;
+    };
+
+    // If a single drain grabs this many messages, it writes them out before grabbing more.
+    // Keeps batches from growing without bound if producers are logging faster than we can write.
+    const int kMaxBatchSize = 512;
+
+    struct LogWriter
     {
+        // Messages waiting to be written.
+        MpscQueue<LogMessage, 4096> queue;
+
+        // Counts of messages pushed to and written from the queue. Used to know when a flush is done, and whether the writer has work.
+        // A producer counts its message before publishing it, so a flush never misses a message that is still being pushed.
+        std::atomic<uint64_t> pushedCount { 0 };
+        std::atomic<uint64_t> writtenCount { 0 };
+
+        // The writer thread sleeps when there's nothing to write. Producers wake it up.
+        // The sleeping flag and pushed count are both sequentially consistent: either the writer sees a new count before sleeping,
+        // or the producer sees the writer is sleeping and notifies it (under the mutex, so the notify can't land before the wait).
+        std::mutex mutex;
+        std::condition_variable wakeCondition;
+        std::condition_variable flushCondition;
+        std::atomic<bool> sleeping { false };
+        std::atomic<bool> stopRequested { false };
+
+        // Shared log file. Only written by whichever thread is draining the queue.
         FILE* file = nullptr;
 
-        ~LogFile()
+        // Text batched up during a drain.
+        std::string outputBatch;
+        std::string streamBatch;
+        StreamHandle batchStream = nullptr;
+
+        std::thread thread;
+    };
+
+    // Created on first use and intentionally never deleted.
+    // Code may log during static destruction, so the writer must outlive everything else.
+    std::atomic<LogWriter*> logWriter { nullptr };
+    std::mutex logWriterMutex;
+
+    // Once the log is shut down, messages are written synchronously under this mutex.
+    std::atomic<bool> logShutdown { false };
+    std::mutex syncWriteMutex;
+
+    void WriteOutputBatch(LogWriter& writer)
+    {
+        if(writer.outputBatch.empty()) { return; }
+
+        // Open log file if not yet opened.
+        if(writer.file == nullptr)
+        {
+            writer.file = fopen("GK3.log", "w");
+        }
+
+        // Log to standard output and log file.
+        fwrite(writer.outputBatch.data(), 1, writer.outputBatch.size(), stdout);
+        fflush(stdout);
+        if(writer.file != nullptr)
+        {
+            fwrite(writer.outputBatch.data(), 1, writer.outputBatch.size(), writer.file);
+            fflush(writer.file);
+        }
+        writer.outputBatch.clear();
+    }
+
+    void WriteStreamBatch(LogWriter& writer)
+    {
+        if(writer.batchStream == nullptr) { return; }
+
+        // Lock the file stream once for the whole batch, write, then unlock.
         {
-            if(file != nullptr)
+            StreamLockGuard lock(writer.batchStream);
+            lock.stream.write(writer.streamBatch.data(), writer.streamBatch.size());
+        }
+        writer.streamBatch.clear();
+        writer.batchStream = nullptr;
+    }
+
+    int DrainQueue(LogWriter& writer)
+    {
+        // Combine queued messages into as few writes as possible.
+        // Consecutive messages to the same file stream are written together.
+        int count = 0;
+        while(count < kMaxBatchSize)
+        {
+            LogMessage* message = writer.queue.PeekReadable();
+            if(message == nullptr) { break; }
+
+            if(message->stream == nullptr)
+            {
+                writer.outputBatch += message->text;
+                writer.outputBatch += '\n';
+            }
+            else
             {
-                fclose(file);
+                if(message->stream != writer.batchStream)
+                {
+                    WriteStreamBatch(writer);
+                    writer.batchStream = message->stream;
+                }
+                writer.streamBatch += message->text;
             }
+
+            // Release the message's memory now, rather than when this slot is next reused.
+            message->text = std::string();
+            writer.queue.Pop();
+            ++count;
         }
-    };
-    LogFile logFile;
 
-    // A mutex for writing to the log. Ensures logging from multiple threads gives correct output.
-    std::mutex logMutex;
+        if(count > 0)
+        {
+            WriteOutputBatch(writer);
+            WriteStreamBatch(writer);
 
-    // A buffer to contain formatted text. Starts at 1KB in size, but will expand dynamically if needed.
-    std::string formatBuffer(1024, '\0');
+            // Let anyone waiting on a flush know that more messages were written.
+            {
+                std::lock_guard<std::mutex> lock(writer.mutex);
+                writer.writtenCount.fetch_add(count, std::memory_order_release);
+            }
+            writer.flushCondition.notify_all();
+        }
+        return count;
+    }
 
-    // A mutex for writing to the format buffer.
-    std::mutex formatMutex;
-}
+    void RunLogWriter(LogWriter* writer)
+    {
+        while(true)
+        {
+            if(DrainQueue(*writer) > 0) { continue; }
 
-void Log(const char* message)
-{
-    std::lock_guard<std::mutex> lock(logMutex);
+            // Queue is empty. If we were asked to stop, it's safe to do so now.
+            // Any message that is counted but not yet published is written by its producer once it sees the log is shut down.
+            if(writer->stopRequested.load()) { break; }
+
+            // A message may be counted but not yet published. Its producer is mid-push, so give it a moment.
+            if(writer->pushedCount.load() != writer->writtenCount.load())
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Sleep until a producer counts a new message or we're asked to stop.
+            std::unique_lock<std::mutex> lock(writer->mutex);
+            writer->sleeping.store(true);
+            writer->wakeCondition.wait(lock, [writer]() {
+                return writer->stopRequested.load() || writer->pushedCount.load() != writer->writtenCount.load();
+            });
+            writer->sleeping.store(false);
+        }
+    }
+
+    void WakeLogWriter(LogWriter& writer)
+    {
+        if(writer.sleeping.load())
+        {
+            // Taking the mutex ensures the writer is either waiting (and gets the notify) or hasn't yet checked for work (and will see it).
+            { std::lock_guard<std::mutex> lock(writer.mutex); }
+            writer.wakeCondition.notify_one();
+        }
+    }
+
+    void DrainRemaining(LogWriter& writer)
+    {
+        while(DrainQueue(writer) > 0) { }
+    }
 
-    // Open log file if not yet opened.
-    if(logFile.file == nullptr)
+    LogWriter* GetLogWriter()
     {
-        logFile.file = fopen("GK3.log", "w");
+        // Fast path: writer already exists.
+        LogWriter* writer = logWriter.load(std::memory_order_acquire);
+        if(writer != nullptr) { return writer; }
+
+        // Create the writer and its thread the first time anything is logged.
+        std::lock_guard<std::mutex> lock(logWriterMutex);
+        writer = logWriter.load(std::memory_order_relaxed);
+        if(writer == nullptr && !logShutdown.load(std::memory_order_acquire))
+        {
+            writer = new LogWriter();
+            writer->thread = std::thread(RunLogWriter, writer);
+            logWriter.store(writer, std::memory_order_release);
+
+            // Make sure nothing is lost if the program exits without calling ShutdownLog.
+            std::atexit(ShutdownLog);
+        }
+        return writer;
     }
 
-    // Log to standard output, adding a line break.
-    printf("%s\n", message);
+    void WriteSynchronously(LogMessage& message)
+    {
+        std::lock_guard<std::mutex> lock(syncWriteMutex);
+        LogWriter* writer = logWriter.load(std::memory_order_acquire);
+        if(writer == nullptr)
+        {
+            // The log was never used before shutdown - there's nothing to batch with, so just print.
+            if(message.stream == nullptr)
+            {
+                printf("%s\n", message.text.c_str());
+            }
+            else
+            {
+                StreamLockGuard streamLock(message.stream);
+                streamLock.stream << message.text;
+            }
+            return;
+        }
 
-    // Log to file, adding a line break.
-    fprintf(logFile.file, "%s\n", message);
+        // The writer thread is stopped, so this thread can safely use the writer's queue and batches.
+        writer->pushedCount.fetch_add(1);
+        if(!writer->queue.TryPush(message))
+        {
+            DrainRemaining(*writer);
+            writer->queue.TryPush(message);
+        }
+        DrainRemaining(*writer);
+    }
+
+    void EnqueueMessage(StreamHandle stream, std::string&& text)
+    {
+        LogMessage message;
+        message.stream = stream;
+        message.text = std::move(text);
+
+        LogWriter* writer = logShutdown.load(std::memory_order_acquire) ? nullptr : GetLogWriter();
+        if(writer == nullptr)
+        {
+            WriteSynchronously(message);
+            return;
+        }
+
+        // Count the message before publishing it, so a concurrent flush waits for it.
+        writer->pushedCount.fetch_add(1);
+
+        // If the queue is full, wait for the writer to catch up. This should be rare!
+        while(!writer->queue.TryPush(message))
+        {
+            if(logShutdown.load())
+            {
+                // Already counted, so publish it via the synchronous path without counting it again.
+                std::lock_guard<std::mutex> lock(syncWriteMutex);
+                DrainRemaining(*writer);
+                writer->queue.TryPush(message);
+                DrainRemaining(*writer);
+                return;
+            }
+            WakeLogWriter(*writer);
+            std::this_thread::yield();
+        }
+        WakeLogWriter(*writer);
+
+        // If the log shut down while we were pushing, the shutdown drain may have already run. Write our message now.
+        // ShutdownLog holds the sync write mutex until the writer thread is joined, so this never races the writer.
+        if(logShutdown.load())
+        {
+            std::lock_guard<std::mutex> lock(syncWriteMutex);
+            DrainRemaining(*writer);
+        }
+    }
 }
 
-void Logf(const char* format, ...)
+void Log(const char* message)
+{
+    EnqueueMessage(nullptr, std::string(message));
+}
+
+void Log(std::string message)
 {
-    std::lock_guard<std::mutex> lock(formatMutex);
+    EnqueueMessage(nullptr, std::move(message));
+}
 
-    // Generate formatted string in format buffer.
+void Logf(const char* format, ...)
+{
+    // Format directly into the string that is queued, so no shared buffer or lock is needed.
     va_list args;
     va_start(args, format);
-    int writtenChars = vsnprintf(formatBuffer.data(), formatBuffer.length(), format, args);
-    va_end(args);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
 
-    // If trying to write a message too big for the format buffer, try again after increasing format buffer size.
-    // This should be rare, since the default format buffer size of 1KB is already pretty large!
-    if(writtenChars >= formatBuffer.length())
+    // 256 characters covers most messages. If more are needed, resize and format again.
+    std::string message(256, '\0');
+    int writtenChars = vsnprintf(&message[0], message.size() + 1, format, args);
+    if(writtenChars > static_cast<int>(message.size()))
     {
-        formatBuffer.resize(writtenChars);
-        vsnprintf(formatBuffer.data(), formatBuffer.length(), format, args);
+        message.resize(writtenChars);
+        vsnprintf(&message[0], message.size() + 1, format, argsCopy);
     }
+    message.resize(writtenChars > 0 ? writtenChars : 0);
+    va_end(argsCopy);
+    va_end(args);
 
     // Log the message.
-    Log(formatBuffer.c_str());
+    EnqueueMessage(nullptr, std::move(message));
+}
+
+void LogToStream(StreamHandle stream, std::string text)
+{
+    if(stream == nullptr) { return; }
+    EnqueueMessage(stream, std::move(text));
+}
+
+void FlushLog()
+{
+    LogWriter* writer = logWriter.load(std::memory_order_acquire);
+    if(writer == nullptr || logShutdown.load(std::memory_order_acquire)) { return; }
+
+    // The writer thread can't wait on itself.
+    if(std::this_thread::get_id() == writer->thread.get_id()) { return; }
+
+    // Wait until everything pushed so far has been written.
+    uint64_t target = writer->pushedCount.load();
+    std::unique_lock<std::mutex> lock(writer->mutex);
+    writer->flushCondition.wait(lock, [writer, target]() {
+        return writer->writtenCount.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void ShutdownLog()
+{
+    // Only shut down once (this is called explicitly on engine shutdown, and also at exit).
+    // The sync write mutex is held until the writer thread is joined, so no other thread drains the queue while it runs.
+    std::lock_guard<std::mutex> lock(logWriterMutex);
+    std::lock_guard<std::mutex> syncLock(syncWriteMutex);
+    if(logShutdown.exchange(true)) { return; }
+
+    LogWriter* writer = logWriter.load(std::memory_order_acquire);
+    if(writer == nullptr) { return; }
+
+    // Let the writer thread finish what's queued, then stop.
+    {
+        std::lock_guard<std::mutex> writerLock(writer->mutex);
+        writer->stopRequested.store(true);
+    }
+    writer->wakeCondition.notify_one();
+    writer->thread.join();
+
+    // A producer may have pushed just as the thread stopped. Write those too.
+    DrainRemaining(*writer);
 }
@@ -6,7 +6,24 @@
 //
 // Logging is thread-safe. Logs from different threads at the same time should display correctly.
 //
+// Logging is also asynchronous: messages are put in a lock-free queue and written by a background thread.
+// This keeps slow console/file I/O off the calling thread. Call FlushLog to wait until everything logged so far is written.
+//
 #pragma once
+#include <string>
+
+#include "StreamManager.h"
 
 void Log(const char* message);
+void Log(std::string message);
 void Logf(const char* format, ...);
+
+// Queues text to be written to a file stream (from StreamManager) on the logging thread.
+// The caller must keep the stream handle alive until the text is written (e.g. by calling FlushLog before returning it).
+void LogToStream(StreamHandle stream, std::string text);
+
+// Blocks until all messages logged before this call have been written.
+void FlushLog();
+
+// Writes any remaining messages and stops the logging thread. Any later logs are written synchronously.
+void ShutdownLog();
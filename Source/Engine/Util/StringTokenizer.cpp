@@ -2,31 +2,32 @@
 
 #include <cassert>
 
-StringTokenizer::StringTokenizer(const std::string& str, std::initializer_list<char> splitChars)
+StringTokenizer::StringTokenizer(std::string_view str, std::initializer_list<char> splitChars)
 {
-    int startIndex = 0;
-    for(int i = 0; i < str.size(); i++)
+    size_t startIndex = 0;
+    for(size_t i = 0; i < str.size(); i++)
     {
         for(auto& splitChar : splitChars)
         {
             if(str[i] == splitChar)
             {
-                if(i - startIndex >= 1)
+                if(i > startIndex)
                 {
                     mTokens.push_back(str.substr(startIndex, i - startIndex));
                 }
                 startIndex = i + 1;
+                break;
             }
         }
     }
 
-    if(str.size() - startIndex >= 1)
+    if(str.size() > startIndex)
     {
-        mTokens.push_back(str.substr(startIndex, str.size() - startIndex));
+        mTokens.push_back(str.substr(startIndex));
     }
 }
 
-const std::string& StringTokenizer::GetNext()
+std::string_view StringTokenizer::GetNext()
 {
     assert(mIndex < mTokens.size());
     return mTokens[mIndex++];
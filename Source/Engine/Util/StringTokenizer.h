@@ -3,24 +3,27 @@
 //
 // Given a string, provides a way to get pieces of it one at a time.
 //
+// Tokens are views into the original string - nothing is copied.
+// So, the string being tokenized must outlive the tokenizer (and any tokens you hold onto).
+//
 #pragma once
 #include <initializer_list>
-#include <string>
+#include <string_view>
 #include <vector>
 
 class StringTokenizer
 {
 public:
-    StringTokenizer(const std::string& str, std::initializer_list<char> splitChars);
+    StringTokenizer(std::string_view str, std::initializer_list<char> splitChars);
 
     bool HasNext() const { return mIndex < mTokens.size(); }
-    const std::string& GetNext();
+    std::string_view GetNext();
 
     size_t GetTokenCount() const { return mTokens.size(); }
 
     void SetIndex(size_t index) { mIndex = index; }
 
 private:
-    std::vector<std::string> mTokens;
+    std::vector<std::string_view> mTokens;
     size_t mIndex = 0;
 };
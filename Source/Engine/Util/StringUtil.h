@@ -11,6 +11,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -165,6 +166,81 @@ namespace StringUtil
         TrimWhitespace(str);
     }
 
+    // string_view versions of the trimming functions above.
+    // These just shrink the view, so no copying or allocation is needed.
+    inline void Trim(std::string_view& str, char trimChar)
+    {
+        size_t first = str.find_first_not_of(trimChar);
+        if(first == std::string_view::npos)
+        {
+            str = std::string_view();
+            return;
+        }
+        size_t last = str.find_last_not_of(trimChar);
+        str = str.substr(first, (last - first + 1));
+    }
+
+    inline void Trim(std::string_view& str)
+    {
+        Trim(str, ' ');
+    }
+
+    inline void TrimWhitespace(std::string_view& str)
+    {
+        size_t first = str.find_first_not_of(" \t");
+        if(first == std::string_view::npos)
+        {
+            str = std::string_view();
+            return;
+        }
+        size_t last = str.find_last_not_of(" \t");
+        str = str.substr(first, (last - first + 1));
+    }
+
+    inline void TrimComment(std::string_view& str)
+    {
+        size_t found = str.find("//");
+        if(found != std::string_view::npos)
+        {
+            str = str.substr(0, found);
+        }
+    }
+
+    inline void TrimSpecialChars(std::string_view& str)
+    {
+        while(!str.empty() && (str.back() == '\r' || str.back() == '\0'))
+        {
+            str.remove_suffix(1);
+        }
+    }
+
+    inline void SanitizeLine(std::string_view& str)
+    {
+        TrimComment(str);
+        TrimSpecialChars(str);
+        TrimWhitespace(str);
+    }
+
+    // Pops the next line (without its line break) off the front of some text.
+    // Returns false when there are no lines left.
+    inline bool PopLine(std::string_view& text, std::string_view& outLine)
+    {
+        if(text.empty()) { return false; }
+
+        size_t lineEnd = text.find('\n');
+        if(lineEnd == std::string_view::npos)
+        {
+            outLine = text;
+            text = std::string_view();
+        }
+        else
+        {
+            outLine = text.substr(0, lineEnd);
+            text.remove_prefix(lineEnd + 1);
+        }
+        return true;
+    }
+
     inline std::string Unescape(const std::string& str)
     {
         // If the text of an input file contains "Hello\n", C's getline will interpret this as "Hello\\n".
@@ -205,13 +281,13 @@ namespace StringUtil
         }
     };
 
-    inline bool EqualsIgnoreCase(const std::string& str1, const std::string& str2)
+    inline bool EqualsIgnoreCase(std::string_view str1, std::string_view str2)
     {
         if(str1.size() != str2.size()) { return false; }
         return std::equal(str1.begin(), str1.end(), str2.begin(), iequal());
     }
 
-    inline bool StartsWith(const std::string& str, const std::string& startsWith)
+    inline bool StartsWith(std::string_view str, std::string_view startsWith)
     {
         if(str.size() < startsWith.size()) { return false; }
 
@@ -220,7 +296,7 @@ namespace StringUtil
         return str.rfind(startsWith, 0) == 0;
     }
 
-    inline bool StartsWithIgnoreCase(const std::string& str, const std::string& startsWith)
+    inline bool StartsWithIgnoreCase(std::string_view str, std::string_view startsWith)
     {
         if(str.size() < startsWith.size()) { return false; }
 
@@ -230,25 +306,25 @@ namespace StringUtil
         return std::search(str.begin(), searchEndIt, startsWith.begin(), startsWith.end(), iequal()) != searchEndIt;
     }
 
-    inline bool Contains(const std::string& str, const std::string& contains)
+    inline bool Contains(std::string_view str, std::string_view contains)
     {
         if(str.size() < contains.size()) { return false; }
-        return str.find(contains) != std::string::npos;
+        return str.find(contains) != std::string_view::npos;
     }
 
-    inline bool ContainsIgnoreCase(const std::string& str, const std::string& contains)
+    inline bool ContainsIgnoreCase(std::string_view str, std::string_view contains)
     {
         if(str.size() < contains.size()) { return false; }
         return std::search(str.begin(), str.end(), contains.begin(), contains.end(), iequal()) != str.end();
     }
 
-    inline bool EndsWith(const std::string& str, const std::string& endsWith)
+    inline bool EndsWith(std::string_view str, std::string_view endsWith)
     {
         if(endsWith.size() > str.size()) { return false; }
         return std::equal(endsWith.rbegin(), endsWith.rend(), str.rbegin());
     }
 
-    inline bool EndsWithIgnoreCase(const std::string& str, const std::string& endsWith)
+    inline bool EndsWithIgnoreCase(std::string_view str, std::string_view endsWith)
     {
         if(endsWith.size() > str.size()) { return false; }
         return std::equal(endsWith.rbegin(), endsWith.rend(), str.rbegin(), iequal());
@@ -268,7 +344,7 @@ namespace StringUtil
         return std::string::npos;
     }
 
-    inline bool ToBool(const std::string& str)
+    inline bool ToBool(std::string_view str)
     {
         // True is "on" or "yes" or "true".
         // Anything is false.
@@ -276,14 +352,27 @@ namespace StringUtil
         return EqualsIgnoreCase(str, "on") || EqualsIgnoreCase(str, "yes") || EqualsIgnoreCase(str, "true");
     }
 
-    inline int ToInt(const std::string& str)
+    // Number parsing needs a null-terminated string, but most numbers are short.
+    // Copy the number text to a stack buffer, rather than requiring (or allocating) a std::string.
+    inline void CopyToNumberBuffer(std::string_view str, char* buffer, size_t bufferSize)
+    {
+        size_t length = std::min(str.size(), bufferSize - 1);
+        str.copy(buffer, length);
+        buffer[length] = '\0';
+    }
+
+    inline int ToInt(std::string_view str)
     {
-        return atoi(str.c_str());
+        char buffer[64];
+        CopyToNumberBuffer(str, buffer, sizeof(buffer));
+        return atoi(buffer);
     }
 
-    inline float ToFloat(const std::string& str)
+    inline float ToFloat(std::string_view str)
     {
-        return static_cast<float>(atof(str.c_str()));
+        char buffer[64];
+        CopyToNumberBuffer(str, buffer, sizeof(buffer));
+        return static_cast<float>(atof(buffer));
     }
 
     inline std::string vFormatf(const char* format, va_list args)
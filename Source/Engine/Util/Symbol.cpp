@@ -0,0 +1,83 @@
+#include "Symbol.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+#include "StringUtil.h"
+
+namespace
+{
+    struct SymbolTable
+    {
+        SymbolTable()
+        {
+            // ID zero is always the empty name.
+            names.emplace_back();
+            ids[""] = 0;
+        }
+
+        // Maps a name to its ID.
+        std::string_map_ci<uint32_t> ids;
+
+        // Names indexed by ID. A deque, so references to names stay valid as more are added.
+        std::deque<std::string> names;
+
+        // Many threads can look up symbols at once, but interning a new name requires exclusive access.
+        std::shared_mutex mutex;
+    };
+
+    SymbolTable& GetSymbolTable()
+    {
+        // Function static so symbols can be safely created during static initialization.
+        static SymbolTable symbolTable;
+        return symbolTable;
+    }
+
+    bool FindId(SymbolTable& symbolTable, const std::string& name, uint32_t& outId)
+    {
+        std::shared_lock<std::shared_mutex> lock(symbolTable.mutex);
+        auto it = symbolTable.ids.find(name);
+        if(it != symbolTable.ids.end())
+        {
+            outId = it->second;
+            return true;
+        }
+        return false;
+    }
+}
+
+Symbol::Symbol(const std::string& name)
+{
+    // Most of the time, the name is already interned.
+    SymbolTable& symbolTable = GetSymbolTable();
+    if(FindId(symbolTable, name, mId)) { return; }
+
+    // Add the name. Another thread may have added it since we checked, so emplace only adds if it's still missing.
+    std::unique_lock<std::shared_mutex> lock(symbolTable.mutex);
+    auto result = symbolTable.ids.emplace(name, static_cast<uint32_t>(symbolTable.names.size()));
+    if(result.second)
+    {
+        symbolTable.names.push_back(name);
+    }
+    mId = result.first->second;
+}
+
+Symbol::Symbol(const char* name) : Symbol(std::string(name))
+{
+
+}
+
+Symbol Symbol::Find(const std::string& name)
+{
+    Symbol symbol;
+    FindId(GetSymbolTable(), name, symbol.mId);
+    return symbol;
+}
+
+const std::string& Symbol::GetName() const
+{
+    SymbolTable& symbolTable = GetSymbolTable();
+    std::shared_lock<std::shared_mutex> lock(symbolTable.mutex);
+    return symbolTable.names[mId];
+}
@@ -0,0 +1,59 @@
+//
+// Clark Kromenaker
+//
+// A symbol is a case-insensitive name (noun, verb, flag, variable, asset name, etc) interned to a small integer ID.
+//
+// Game logic is keyed by case-insensitive names everywhere. Hashing and case-folding a whole string on every lookup adds up!
+// Instead, a name can be converted to a symbol once (ideally at load time), and then compared/hashed as an integer.
+//
+// Symbols are global and never removed, so a symbol's ID and name are stable for the lifetime of the program.
+// Interning and lookup are thread-safe.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "FlatMap.h"
+
+class Symbol
+{
+public:
+    // Default symbol is the empty name.
+    Symbol() = default;
+
+    // Interns the name (if not already interned) and returns its symbol.
+    // Names are case-insensitive, so "Flag" and "FLAG" give the same symbol.
+    explicit Symbol(const std::string& name);
+    explicit Symbol(const char* name);
+
+    // Returns the symbol for a name WITHOUT interning it. If the name was never interned, returns the empty symbol.
+    // Useful for lookups: a name that was never interned can't be a key in any symbol map.
+    static Symbol Find(const std::string& name);
+
+    // The name, with the casing it had when it was first interned.
+    const std::string& GetName() const;
+
+    uint32_t GetId() const { return mId; }
+    bool IsEmpty() const { return mId == 0; }
+
+    bool operator==(const Symbol& other) const { return mId == other.mId; }
+    bool operator!=(const Symbol& other) const { return mId != other.mId; }
+    bool operator<(const Symbol& other) const { return mId < other.mId; }
+
+private:
+    // Index into the global symbol table. Zero is always the empty name.
+    uint32_t mId = 0;
+};
+
+namespace std
+{
+    template<> struct hash<Symbol>
+    {
+        size_t operator()(const Symbol& symbol) const { return symbol.GetId(); }
+    };
+}
+
+// A map keyed by symbol. Lookups are just an integer hash probe.
+template<typename T>
+using SymbolMap = FlatMap<Symbol, T>;
@@ -0,0 +1,383 @@
+#include "JobSystem.h"
+
+JobSystem::Job JobSystem::sJobs[JobSystem::kMaxJobs];
+std::vector<uint32_t> JobSystem::sFreeJobs = JobSystem::CreateFreeJobList();
+std::mutex JobSystem::sFreeJobsMutex;
+
+std::vector<JobSystem::JobDeque*> JobSystem::sDeques;
+JobSystem::JobDeque JobSystem::sInjectionQueue;
+std::vector<std::thread*> JobSystem::sWorkers;
+
+std::atomic<int> JobSystem::sQueuedJobCount(0);
+std::atomic<int> JobSystem::sSleepingWorkerCount(0);
+std::mutex JobSystem::sSleepMutex;
+std::condition_variable JobSystem::sSleepCondVar;
+std::atomic<bool> JobSystem::sShutdown(false);
+
+namespace
+{
+    // Index of the current thread's deque. Only workers have a deque.
+    // Threads not owned by the job system (including the main thread) don't have one.
+    const int kNoDeque = -1;
+    thread_local int tDequeIndex = kNoDeque;
+}
+
+void JobSystem::JobDeque::PushBack(uint32_t job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Reclaim space at the front once it's all been stolen.
+    if(front == jobs.size())
+    {
+        jobs.clear();
+        front = 0;
+    }
+    jobs.push_back(job);
+}
+
+bool JobSystem::JobDeque::PopBack(uint32_t& outJob)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(front == jobs.size()) { return false; }
+    outJob = jobs.back();
+    jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::JobDeque::PopFront(uint32_t& outJob)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(front == jobs.size()) { return false; }
+    outJob = jobs[front];
+    ++front;
+    return true;
+}
+
+bool JobSystem::JobDeque::Remove(uint32_t job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(size_t i = front; i < jobs.size(); ++i)
+    {
+        if(jobs[i] == job)
+        {
+            jobs.erase(jobs.begin() + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Init(int workerCount)
+{
+    // Default to one worker per core, leaving one core for the main thread.
+    if(workerCount <= 0)
+    {
+        int coreCount = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = coreCount > 1 ? coreCount - 1 : 1;
+    }
+
+    // Create one deque for each worker.
+    // All deques must exist before any worker starts, since workers steal from each other.
+    sShutdown = false;
+    for(int i = 0; i < workerCount; ++i)
+    {
+        sDeques.push_back(new JobDeque());
+    }
+
+    // Start workers.
+    for(int i = 0; i < workerCount; ++i)
+    {
+        sWorkers.push_back(new std::thread([i]() { WorkerThread(i); }));
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    // Tell workers to exit and wake any that are sleeping.
+    {
+        std::lock_guard<std::mutex> lock(sSleepMutex);
+        sShutdown = true;
+    }
+    sSleepCondVar.notify_all();
+
+    // Wait for workers to finish their current jobs and exit.
+    for(std::thread* worker : sWorkers)
+    {
+        worker->join();
+        delete worker;
+    }
+    sWorkers.clear();
+
+    // Any jobs that never ran (queued or waiting on dependencies) are abandoned.
+    // Destroy their functions, since they may own resources.
+    for(JobDeque* deque : sDeques)
+    {
+        delete deque;
+    }
+    sDeques.clear();
+    {
+        std::lock_guard<std::mutex> lock(sInjectionQueue.mutex);
+        sInjectionQueue.jobs.clear();
+        sInjectionQueue.front = 0;
+    }
+    for(Job& job : sJobs)
+    {
+        if(job.function.IsSet())
+        {
+            job.function.Reset();
+            job.continuationCount = 0;
+            job.generation.fetch_add(1);
+        }
+    }
+    sFreeJobs = CreateFreeJobList();
+    sQueuedJobCount = 0;
+}
+
+bool JobSystem::IsDone(const JobHandle& handle)
+{
+    // Job slots are freed as soon as they complete, which bumps the generation.
+    return !handle.IsValid() || sJobs[handle.index].generation.load(std::memory_order_acquire) != handle.generation;
+}
+
+void JobSystem::Wait(const JobHandle& handle)
+{
+    // Rather than sleep, help get work done.
+    // If no worker has started the job yet, just run it here. Otherwise, workers can help with other jobs in the meantime.
+    // Other threads (e.g. the main thread) don't, since another job could be long-running background work (like loading a scene).
+    bool isWorker = GetDequeIndex() != kNoDeque;
+    while(!IsDone(handle))
+    {
+        if(!TryRunQueuedJob(handle) && !(isWorker && TryRunJob()))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::vector<uint32_t> JobSystem::CreateFreeJobList()
+{
+    // All jobs start out free. Push in reverse so low indexes are used first.
+    std::vector<uint32_t> freeJobs;
+    freeJobs.reserve(kMaxJobs);
+    for(uint32_t i = kMaxJobs; i > 0; --i)
+    {
+        freeJobs.push_back(i - 1);
+    }
+    return freeJobs;
+}
+
+uint32_t JobSystem::AllocateJob()
+{
+    while(true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sFreeJobsMutex);
+            if(!sFreeJobs.empty())
+            {
+                uint32_t job = sFreeJobs.back();
+                sFreeJobs.pop_back();
+                return job;
+            }
+        }
+
+        // All jobs are in use. Workers help finish some until one frees up. Other threads wait for the workers.
+        if(GetDequeIndex() == kNoDeque || !TryRunJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobHandle JobSystem::Schedule(uint32_t job, const JobHandle& dependency)
+{
+    JobHandle handle;
+    handle.index = job;
+    handle.generation = sJobs[job].generation.load(std::memory_order_relaxed);
+
+    // Hold one "dependency" while scheduling, so the job can't be queued by a finishing dependency until we're done here.
+    sJobs[job].pendingDependencies = 1;
+
+    // If there's a dependency that hasn't finished, add ourselves to its continuations. It'll queue us when it finishes.
+    if(dependency.IsValid())
+    {
+        Job& dependencyJob = sJobs[dependency.index];
+        bool waitForDependency = false;
+        {
+            std::lock_guard<std::mutex> lock(dependencyJob.mutex);
+            if(dependencyJob.generation.load(std::memory_order_relaxed) == dependency.generation)
+            {
+                if(dependencyJob.continuationCount < Job::kMaxContinuations)
+                {
+                    dependencyJob.continuations[dependencyJob.continuationCount] = job;
+                    ++dependencyJob.continuationCount;
+                    ++sJobs[job].pendingDependencies;
+                }
+                else
+                {
+                    waitForDependency = true;
+                }
+            }
+        }
+
+        // Rare: dependency has too many continuations to track. Just wait for it here.
+        if(waitForDependency)
+        {
+            Wait(dependency);
+        }
+    }
+
+    // Release the scheduling "dependency." If no other dependencies are pending, the job can run right away.
+    if(sJobs[job].pendingDependencies.fetch_sub(1) == 1)
+    {
+        Enqueue(job);
+    }
+    return handle;
+}
+
+void JobSystem::Enqueue(uint32_t job)
+{
+    // If the job system isn't running, there's nobody else to do the job.
+    if(sDeques.empty())
+    {
+        Execute(job);
+        return;
+    }
+
+    int dequeIndex = GetDequeIndex();
+    if(dequeIndex == kNoDeque)
+    {
+        sInjectionQueue.PushBack(job);
+    }
+    else
+    {
+        sDeques[dequeIndex]->PushBack(job);
+    }
+
+    // If any workers are sleeping, wake one up to take the job.
+    // Count is incremented BEFORE checking sleepers, and sleepers register BEFORE checking count, so a wakeup can't be missed.
+    sQueuedJobCount.fetch_add(1);
+    if(sSleepingWorkerCount.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sSleepMutex);
+        }
+        sSleepCondVar.notify_one();
+    }
+}
+
+bool JobSystem::TryRunJob()
+{
+    if(sDeques.empty()) { return false; }
+
+    // Only workers run whatever job is next.
+    int dequeIndex = GetDequeIndex();
+    if(dequeIndex == kNoDeque) { return false; }
+
+    // Take the most recently pushed job from our own deque.
+    uint32_t job = 0;
+    bool foundJob = sDeques[dequeIndex]->PopBack(job);
+
+    // Otherwise, take the oldest job scheduled by a thread outside the job system.
+    if(!foundJob)
+    {
+        foundJob = sInjectionQueue.PopFront(job);
+    }
+
+    // Otherwise, steal the oldest job from another worker's deque.
+    for(size_t i = 1; !foundJob && i < sDeques.size(); ++i)
+    {
+        foundJob = sDeques[(dequeIndex + i) % sDeques.size()]->PopFront(job);
+    }
+
+    if(foundJob)
+    {
+        sQueuedJobCount.fetch_sub(1);
+        Execute(job);
+    }
+    return foundJob;
+}
+
+bool JobSystem::TryRunQueuedJob(const JobHandle& handle)
+{
+    if(sDeques.empty() || IsDone(handle)) { return false; }
+
+    // If the job is still queued (not started, and not waiting on a dependency), take it out of its queue and run it.
+    bool foundJob = sInjectionQueue.Remove(handle.index);
+    for(size_t i = 0; !foundJob && i < sDeques.size(); ++i)
+    {
+        foundJob = sDeques[i]->Remove(handle.index);
+    }
+    if(!foundJob) { return false; }
+
+    // A queued job's generation can't change until it runs. If it doesn't match, our job already finished and its slot was reused.
+    // That's someone else's job, so put it back for the workers.
+    if(sJobs[handle.index].generation.load(std::memory_order_acquire) != handle.generation)
+    {
+        sInjectionQueue.PushBack(handle.index);
+        return false;
+    }
+
+    sQueuedJobCount.fetch_sub(1);
+    Execute(handle.index);
+    return true;
+}
+
+void JobSystem::Execute(uint32_t job)
+{
+    sJobs[job].function.Invoke();
+    sJobs[job].function.Reset();
+
+    // Grab continuations and mark the job done by bumping the generation.
+    // This is done under the job's lock, so no continuations can be added after we've grabbed them.
+    uint32_t continuations[Job::kMaxContinuations];
+    int continuationCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(sJobs[job].mutex);
+        continuationCount = sJobs[job].continuationCount;
+        for(int i = 0; i < continuationCount; ++i)
+        {
+            continuations[i] = sJobs[job].continuations[i];
+        }
+        sJobs[job].continuationCount = 0;
+        sJobs[job].generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // The job slot can now be reused.
+    {
+        std::lock_guard<std::mutex> lock(sFreeJobsMutex);
+        sFreeJobs.push_back(job);
+    }
+
+    // Queue any continuations that were only waiting on this job.
+    for(int i = 0; i < continuationCount; ++i)
+    {
+        if(sJobs[continuations[i]].pendingDependencies.fetch_sub(1) == 1)
+        {
+            Enqueue(continuations[i]);
+        }
+    }
+}
+
+int JobSystem::GetDequeIndex()
+{
+    return tDequeIndex;
+}
+
+void JobSystem::WorkerThread(int dequeIndex)
+{
+    tDequeIndex = dequeIndex;
+    while(!sShutdown)
+    {
+        // Run jobs until there aren't any.
+        if(TryRunJob()) { continue; }
+
+        // Nothing to do - sleep until a job is queued (or we're shutting down).
+        std::unique_lock<std::mutex> lock(sSleepMutex);
+        sSleepingWorkerCount.fetch_add(1);
+        while(sQueuedJobCount.load() <= 0 && !sShutdown)
+        {
+            sSleepCondVar.wait(lock);
+        }
+        sSleepingWorkerCount.fetch_sub(1);
+    }
+}
@@ -0,0 +1,223 @@
+//
+// Clark Kromenaker
+//
+// A job system runs small units of work ("jobs") across a set of worker threads.
+//
+// Each worker has its own job deque. A worker pushes and pops jobs at the back of its own deque,
+// which keeps related work on the same thread. When a worker runs out of work, it steals from the front of another worker's deque.
+// Other threads (the main thread, SDL's audio thread, etc) have no deque, so jobs they schedule go in a shared injection queue instead.
+//
+// Jobs are stored in a fixed pool and their functions are stored inline (no heap allocation) as long as they're small.
+// Running a job returns a handle, which can be waited on or used as a dependency for another job.
+// While waiting, a worker helps run any jobs. Other threads only run the job they're waiting on (if no worker has started it yet),
+// so long-running background jobs (loading, prefetching, pathfinding) never end up running on the main thread.
+//
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Identifies a job that was scheduled. Once the job completes, its handle is "done" forever (even if the job slot is reused).
+struct JobHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != UINT32_MAX; }
+};
+
+// A move-only callable with fixed inline storage. Functions larger than the inline storage fall back to the heap.
+class JobFunction
+{
+public:
+    // Big enough for lambdas capturing a handful of pointers/values, or a couple std::functions.
+    static const size_t kInlineSize = 64;
+
+    JobFunction() = default;
+    ~JobFunction() { Reset(); }
+
+    JobFunction(const JobFunction&) = delete;
+    JobFunction& operator=(const JobFunction&) = delete;
+
+    template<typename F> void Set(F&& func);
+    void Invoke() { mInvoke(mStorage); }
+    void Reset();
+    bool IsSet() const { return mInvoke != nullptr; }
+
+private:
+    alignas(std::max_align_t) unsigned char mStorage[kInlineSize];
+    void (*mInvoke)(void* storage) = nullptr;
+    void (*mDestroy)(void* storage) = nullptr;
+};
+
+class JobSystem
+{
+public:
+    // Starts worker threads. A count of zero or less creates one worker per CPU core, minus one for the main thread.
+    static void Init(int workerCount = 0);
+    static void Shutdown();
+    static int GetWorkerCount() { return static_cast<int>(sWorkers.size()); }
+
+    // Schedules a function to run on a worker thread. If a dependency is provided, the job won't start until the dependency is done.
+    template<typename F> static JobHandle Run(F&& func, const JobHandle& dependency = JobHandle());
+
+    // Returns true if the job has completed.
+    static bool IsDone(const JobHandle& handle);
+
+    // Blocks until the job completes. A worker runs other jobs while it waits; other threads may run the job itself.
+    static void Wait(const JobHandle& handle);
+
+    // Calls func(index) for every index in [0, count), split into batches of up to batchSize indexes.
+    // Blocks until all indexes have been processed. The calling thread and up to one job per worker take batches until none are left.
+    template<typename F> static void ParallelFor(uint32_t count, uint32_t batchSize, const F& func);
+
+private:
+    struct Job
+    {
+        JobFunction function;
+
+        // Incremented each time the job slot is freed. Handles with an older generation refer to a completed job.
+        std::atomic<uint32_t> generation { 0 };
+
+        // Number of unfinished dependencies (plus one while the job is being scheduled). The job is queued when this hits zero.
+        std::atomic<int> pendingDependencies { 0 };
+
+        // Jobs waiting on this job to finish. Guarded by mutex.
+        static const int kMaxContinuations = 8;
+        uint32_t continuations[kMaxContinuations];
+        int continuationCount = 0;
+        std::mutex mutex;
+    };
+
+    // All jobs come from this fixed pool. Free job indexes are kept on a stack.
+    static const uint32_t kMaxJobs = 4096;
+    static Job sJobs[kMaxJobs];
+    static std::vector<uint32_t> sFreeJobs;
+    static std::mutex sFreeJobsMutex;
+
+    // A deque of jobs that are ready to run.
+    // The owning thread uses the back, and other threads steal from the front. Contention is rare, so a simple lock is used.
+    struct JobDeque
+    {
+        std::vector<uint32_t> jobs;
+        size_t front = 0;
+        std::mutex mutex;
+
+        void PushBack(uint32_t job);
+        bool PopBack(uint32_t& outJob);
+        bool PopFront(uint32_t& outJob);
+        bool Remove(uint32_t job);
+    };
+
+    // One deque per worker.
+    // Threads that aren't workers schedule jobs in the injection queue, which workers take from once their own deque is empty.
+    static std::vector<JobDeque*> sDeques;
+    static JobDeque sInjectionQueue;
+    static std::vector<std::thread*> sWorkers;
+
+    // Number of jobs currently sitting in deques. Idle workers sleep until this is non-zero.
+    static std::atomic<int> sQueuedJobCount;
+    static std::atomic<int> sSleepingWorkerCount;
+    static std::mutex sSleepMutex;
+    static std::condition_variable sSleepCondVar;
+    static std::atomic<bool> sShutdown;
+
+    static std::vector<uint32_t> CreateFreeJobList();
+    static uint32_t AllocateJob();
+    static JobHandle Schedule(uint32_t job, const JobHandle& dependency);
+    static void Enqueue(uint32_t job);
+
+    static bool TryRunJob();
+    static bool TryRunQueuedJob(const JobHandle& handle);
+    static void Execute(uint32_t job);
+    static int GetDequeIndex();
+
+    static void WorkerThread(int dequeIndex);
+};
+
+template<typename F>
+void JobFunction::Set(F&& func)
+{
+    Reset();
+
+    typedef typename std::decay<F>::type FuncType;
+    if constexpr(sizeof(FuncType) <= kInlineSize && alignof(FuncType) <= alignof(std::max_align_t))
+    {
+        // Fits inline - construct directly in storage.
+        new(mStorage) FuncType(std::forward<F>(func));
+        mInvoke = [](void* storage) { (*static_cast<FuncType*>(storage))(); };
+        mDestroy = [](void* storage) { static_cast<FuncType*>(storage)->~FuncType(); };
+    }
+    else
+    {
+        // Too big - store a pointer to a heap copy instead.
+        *reinterpret_cast<FuncType**>(mStorage) = new FuncType(std::forward<F>(func));
+        mInvoke = [](void* storage) { (**static_cast<FuncType**>(storage))(); };
+        mDestroy = [](void* storage) { delete *static_cast<FuncType**>(storage); };
+    }
+}
+
+inline void JobFunction::Reset()
+{
+    if(mDestroy != nullptr)
+    {
+        mDestroy(mStorage);
+        mInvoke = nullptr;
+        mDestroy = nullptr;
+    }
+}
+
+template<typename F>
+JobHandle JobSystem::Run(F&& func, const JobHandle& dependency)
+{
+    uint32_t job = AllocateJob();
+    sJobs[job].function.Set(std::forward<F>(func));
+    return Schedule(job, dependency);
+}
+
+template<typename F>
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const F& func)
+{
+    if(count == 0) { return; }
+    if(batchSize == 0) { batchSize = 1; }
+
+    // Batches are claimed from a shared counter, by this thread and by helper jobs, until none are left.
+    // Since we wait for every helper job before returning, they can safely reference locals.
+    uint32_t batchCount = (count + batchSize - 1) / batchSize;
+    std::atomic<uint32_t> nextBatch(0);
+    auto runBatches = [&func, &nextBatch, batchCount, batchSize, count]() {
+        for(uint32_t batch = nextBatch.fetch_add(1); batch < batchCount; batch = nextBatch.fetch_add(1))
+        {
+            uint32_t start = batch * batchSize;
+            uint32_t end = start + batchSize < count ? start + batchSize : count;
+            for(uint32_t i = start; i < end; ++i)
+            {
+                func(i);
+            }
+        }
+    };
+
+    // One helper job per worker is enough - each keeps taking batches until they run out.
+    uint32_t helperCount = batchCount - 1 < static_cast<uint32_t>(GetWorkerCount()) ? batchCount - 1 : static_cast<uint32_t>(GetWorkerCount());
+    std::vector<JobHandle> helpers;
+    helpers.reserve(helperCount);
+    for(uint32_t i = 0; i < helperCount; ++i)
+    {
+        helpers.push_back(Run(runBatches));
+    }
+
+    // Take batches on this thread too. Once they're all taken, wait for helpers to finish theirs.
+    // A helper that hasn't started yet is run here by Wait, and finds nothing left to do.
+    runBatches();
+    for(JobHandle& helper : helpers)
+    {
+        Wait(helper);
+    }
+}
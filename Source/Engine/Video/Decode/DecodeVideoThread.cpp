@@ -5,6 +5,13 @@
 //
 #include "VideoState.h"
 
+#include "Texture.h"
+
+extern "C"
+{
+    #include <libswscale/swscale.h>
+}
+
 namespace
 {
     int GetVideoFrame(VideoState* is, AVFrame* frame)
@@ -46,6 +53,51 @@ namespace
         }
         return gotVideoFrame;
     }
+
+    bool ConvertVideoFrameToRGBA(VideoState* is, Frame* vp, SwsContext*& convertContext)
+    {
+        // Create conversion context to go from input frame format to RGBA format.
+        //TODO: There may be more efficient options for displaying a video frame. Ex: YUV420 data can be loaded into texture and rendered with special shader.
+        //TODO: But for now, just convert all formats to RGBA for simplicity.
+        AVFrame* avFrame = vp->frame;
+        convertContext = sws_getCachedContext(convertContext,
+            avFrame->width, avFrame->height, (AVPixelFormat)avFrame->format,    // from format
+            avFrame->width, avFrame->height, AV_PIX_FMT_RGBA,                   // to format
+            SWS_BICUBIC, nullptr, nullptr, nullptr);
+        if(convertContext == nullptr)
+        {
+            av_log(NULL, AV_LOG_FATAL, "Cannot initialize the conversion context\n");
+            return false;
+        }
+
+        // Make sure this frame's RGBA buffer is the right size.
+        // Frames are reused by the queue, so this only allocates when the first frame is decoded, or if the video size changes.
+        int rgbaPixelsSize = avFrame->width * avFrame->height * 4;
+        if(vp->rgbaPixels == nullptr || vp->rgbaPixelsSize != rgbaPixelsSize)
+        {
+            delete[] vp->rgbaPixels;
+            vp->rgbaPixels = new uint8_t[rgbaPixelsSize];
+            vp->rgbaPixelsSize = rgbaPixelsSize;
+        }
+
+        // Convert from source format to RGBA.
+        uint8_t* dest[4] { vp->rgbaPixels, nullptr, nullptr, nullptr };
+        int dest_linesize[4] = { avFrame->width * 4, 0, 0, 0 };
+        sws_scale(convertContext,
+                  avFrame->data, avFrame->linesize, 0, avFrame->height, // source
+                  dest, dest_linesize); // dest
+
+        // After pixels are converted, apply transparent color if any.
+        is->videoFrames.LockMutex();
+        bool hasTransparentColor = is->hasTransparentColor;
+        Color32 transparentColor = is->transparentColor;
+        is->videoFrames.UnlockMutex();
+        if(hasTransparentColor)
+        {
+            Texture::SetTransparentColor(vp->rgbaPixels, avFrame->width * avFrame->height, Texture::Format::RGBA, transparentColor);
+        }
+        return true;
+    }
 }
 
 int DecodeVideoThread(void* arg)
@@ -67,6 +119,10 @@ int DecodeVideoThread(void* arg)
     avRational.num = frame_rate.num;
     double duration = (frame_rate.num && frame_rate.den ? av_q2d(avRational) : 0);
 
+    // Context for converting decoded frames to RGBA.
+    // Doing this on the decode thread means the main thread only needs to upload the result.
+    SwsContext* rgbaConvertContext = nullptr;
+
     // Loop, decoding frames and putting them in the frame queue.
     while(true)
     {
@@ -109,12 +165,21 @@ int DecodeVideoThread(void* arg)
             // Store AVFrame.
             av_frame_move_ref(vp->frame, avFrame);
 
+            // Convert to a displayable format. On failure, drop the RGBA buffer so playback knows not to display it.
+            if(!ConvertVideoFrameToRGBA(is, vp, rgbaConvertContext))
+            {
+                delete[] vp->rgbaPixels;
+                vp->rgbaPixels = nullptr;
+                vp->rgbaPixelsSize = 0;
+            }
+
             // Enqueue peeked frame to queue (makes it available for playback).
             is->videoFrames.Enqueue();
         }
     }
 
 the_end:
+    sws_freeContext(rgbaConvertContext);
     av_frame_free(&avFrame);
     return 0;
 }
@@ -1,21 +1,11 @@
 #include "VideoPlayback.h"
 
-extern "C"
-{
-    #include <libswscale/swscale.h>
-    #include <libswresample/swresample.h>
-}
-
 #include "FrameQueue.h"
 #include "Texture.h"
 #include "VideoState.h"
 
 VideoPlayback::~VideoPlayback()
 {
-    // Free conversion contexts.
-    sws_freeContext(mRGBAConvertContext);
-    //sws_freeContext(sub_convert_ctx);
-
     // Free video texture.
     if(mOwnsVideoTexture && mVideoTexture != nullptr)
     {
@@ -174,66 +164,37 @@ retry:
 
 void VideoPlayback::SetTransparentColor(const Color32& color)
 {
-    // Save transparent color to apply to future generated video pixels.
-    mHasTransparentColor = true;
-    mTransparentColor = color;
-
-    // If a texture already exists, also update its existing video pixels.
+    // Future video frames are keyed by the decode thread, but if a texture already exists, update its existing video pixels.
     if(mVideoTexture != nullptr)
     {
         mVideoTexture->SetTransparentColor(color);
+        mVideoTexture->UploadToGPU();
     }
 }
 
-void VideoPlayback::ClearTransparentColor()
-{
-    mHasTransparentColor = false;
-}
-
 bool VideoPlayback::UpdateVideoTexture(Frame* videoFrame)
 {
     // Already uploaded video texture to GPU - don't do it again.
     if(videoFrame->uploaded) { return true; }
 
+    // The decode thread converts frames to RGBA. If that failed, there's nothing to show.
+    if(videoFrame->rgbaPixels == nullptr) { return false; }
+
     // Make sure we have a properly sized video texture.
-    AVFrame* avFrame = videoFrame->frame;
     if(mVideoTexture == nullptr)
     {
-        mVideoTexture = new Texture(avFrame->width, avFrame->height);
-    }
-    else if(mVideoTexture->GetWidth() != avFrame->width || mVideoTexture->GetHeight() != avFrame->height)
-    {
-        mVideoTexture->Resize(avFrame->width, avFrame->height);
+        mVideoTexture = new Texture(videoFrame->width, videoFrame->height);
     }
-
-    // Create conversion context to go from input frame format to BGRA format.
-    //TODO: There may be more efficient options for displaying a video frame. Ex: YUV420 data can be loaded into texture and rendered with special shader.
-    //TODO: But for now, just convert all formats to RGBA for simplicity.
-    mRGBAConvertContext = sws_getCachedContext(mRGBAConvertContext,
-        avFrame->width, avFrame->height, (AVPixelFormat)avFrame->format,    // from format
-        avFrame->width, avFrame->height, AV_PIX_FMT_RGBA,                   // to format
-        SWS_BICUBIC, nullptr, nullptr, nullptr);
-    if(mRGBAConvertContext == nullptr)
+    else if(mVideoTexture->GetWidth() != videoFrame->width || mVideoTexture->GetHeight() != videoFrame->height)
     {
-        av_log(NULL, AV_LOG_FATAL, "Cannot initialize the conversion context\n");
-        return false;
+        mVideoTexture->Resize(videoFrame->width, videoFrame->height);
     }
 
-    // Convert from source format to RGBA, copying RGBA data directly to Texture buffer.
-    uint8_t* dest[4] { mVideoTexture->GetPixelData(), nullptr, nullptr, nullptr };
-    int dest_linesize[4] = { static_cast<int>(mVideoTexture->GetWidth() * 4), 0, 0, 0 };
-    sws_scale(mRGBAConvertContext,
-              avFrame->data, avFrame->linesize, 0, avFrame->height, // source
-              dest, dest_linesize); // dest
-
-    // After pixels are updated in texture, apply transparent color if any.
-    if(mHasTransparentColor)
-    {
-        mVideoTexture->SetTransparentColor(mTransparentColor);
-    }
+    // The frame's RGBA buffer is the same size as the texture's pixel buffer, so just swap them.
+    // The frame gets the texture's old buffer, which the decode thread will reuse when it writes to this frame again.
+    mVideoTexture->SwapPixelData(videoFrame->rgbaPixels);
 
     // Upload texture data to GPU.
-    mVideoTexture->AddDirtyFlags(Texture::DirtyFlags::Pixels);
     mVideoTexture->UploadToGPU();
 
     // Yep, we are uploaded.
@@ -9,9 +9,7 @@
 #pragma once
 #include "Color32.h"
 
-struct AVFrame;
 struct Frame;
-struct SwsContext;
 class Texture;
 struct VideoState;
 
@@ -37,13 +35,8 @@ public:
     void RelenquishVideoTextureOwnership() { mOwnsVideoTexture = false; }
 
     void SetTransparentColor(const Color32& color);
-    void ClearTransparentColor();
 
 private:
-    // ffmpeg provides a helper library for converting between formats.
-    // For ease of use, all formats are converted to RGBA for display.
-    SwsContext* mRGBAConvertContext = nullptr;
-
     // If true, playback is in "step" mode, where each frame is viewed one at a time.
     bool mStep = false;
 
@@ -54,10 +47,6 @@ private:
     // If false, someone else has signaled that they will take care of deleting the video texture.
     bool mOwnsVideoTexture = true;
 
-    // If set, this color in the video file will be considered transparent.
-    bool mHasTransparentColor = false;
-    Color32 mTransparentColor;
-
     bool UpdateVideoTexture(Frame* videoFrame);
     void UpdateSubtitles(VideoState* is);
 
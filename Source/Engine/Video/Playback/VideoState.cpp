@@ -253,6 +253,13 @@ double VideoState::GetMasterClock()
 
 void VideoState::SetTransparentColor(const Color32& color)
 {
+    // Future frames are keyed on the decode thread.
+    videoFrames.LockMutex();
+    hasTransparentColor = true;
+    transparentColor = color;
+    videoFrames.UnlockMutex();
+
+    // The currently displayed frame must be updated directly.
     if(videoPlayback != nullptr)
     {
         videoPlayback->SetTransparentColor(color);
@@ -261,10 +268,9 @@ void VideoState::SetTransparentColor(const Color32& color)
 
 void VideoState::ClearTransparentColor()
 {
-    if(videoPlayback != nullptr)
-    {
-        videoPlayback->ClearTransparentColor();
-    }
+    videoFrames.LockMutex();
+    hasTransparentColor = false;
+    videoFrames.UnlockMutex();
 }
 
 void VideoState::RelenquishVideoTextureOwnership()
@@ -319,6 +325,14 @@ int VideoState::OpenStream(int streamIndex)
     }
     avctx->codec_id = codec->id;
 
+    // Let the codec decode on multiple threads, if it supports it (thread count of zero means "auto").
+    // This matters most for full-screen cutscenes, where a single decode thread may not keep up.
+    if(avctx->codec_type == AVMEDIA_TYPE_VIDEO)
+    {
+        avctx->thread_count = 0;
+        avctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    }
+
     // Init codec context to use provided codec.
     // Must be done before decoding can occur.
     ret = avcodec_open2(avctx, codec, nullptr);
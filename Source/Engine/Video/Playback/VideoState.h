@@ -11,13 +11,13 @@ extern "C"
     #include <libavformat/avformat.h>
 }
 
+#include "Color32.h"
 #include "Decoder.h"
 #include "FrameQueue.h"
 #include "PacketQueue.h"
 #include "PtsClock.h"
 
 class AudioPlaybackSDL;
-class Color32;
 class Texture;
 class VideoPlayback;
 
@@ -76,6 +76,11 @@ struct VideoState
     VideoPlayback* videoPlayback = nullptr;
     double frameTimer = 0.0;
 
+    // If set, this color in decoded video frames is made transparent.
+    // Applied on the decode thread; guarded by the video frame queue mutex.
+    bool hasTransparentColor = false;
+    Color32 transparentColor;
+
     VideoState(const char* filename);
     ~VideoState();
 
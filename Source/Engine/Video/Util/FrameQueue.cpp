@@ -19,6 +19,7 @@ Frame::~Frame()
 {
     Unref();
     av_frame_free(&frame);
+    delete[] rgbaPixels;
 }
 
 void Frame::Unref()
@@ -66,11 +67,9 @@ void FrameQueue::Enqueue()
         mWriteIndex = 0;
     }
 
-    // Increment size and signal to anyone waiting in Peek functons that they should try again.
-    SDL_LockMutex(mMutex);
+    // Increment size and wake up the reader if it's waiting in a Peek function.
     mSize++;
-    SDL_CondSignal(mSizeChangedCondition);
-    SDL_UnlockMutex(mMutex);
+    Wake(mReaderWaiting);
 }
 
 void FrameQueue::Dequeue()
@@ -94,22 +93,18 @@ void FrameQueue::Dequeue()
         mReadIndex = 0;
     }
 
-    // Decrement size and signal to anyone waiting in peek functions to try again.
-    SDL_LockMutex(mMutex);
+    // Decrement size and wake up the writer if it's waiting in a Peek function.
     mSize--;
-    SDL_CondSignal(mSizeChangedCondition);
-    SDL_UnlockMutex(mMutex);
+    Wake(mWriterWaiting);
 }
 
 Frame* FrameQueue::PeekWritable()
 {
     // Wait until we have space to put a new frame.
-    SDL_LockMutex(mMutex);
     while(mSize >= mMaxSize && !mPacketQueue->Aborted())
     {
-        SDL_CondWait(mSizeChangedCondition, mMutex);
+        Wait(mWriterWaiting, false);
     }
-    SDL_UnlockMutex(mMutex);
 
     // Null if packet queue was aborted.
     if(mPacketQueue->Aborted())
@@ -123,13 +118,11 @@ Frame* FrameQueue::PeekWritable()
 
 Frame* FrameQueue::PeekReadable()
 {
-    // Wait until we have space to put a new frame.
-    SDL_LockMutex(mMutex);
+    // Wait until we have a frame to read.
     while(mSize - mReadIndexOffset <= 0 && !mPacketQueue->Aborted())
     {
-        SDL_CondWait(mSizeChangedCondition, mMutex);
+        Wait(mReaderWaiting, true);
     }
-    SDL_UnlockMutex(mMutex);
 
     // Null if packet queue was aborted.
     if(mPacketQueue->Aborted())
@@ -143,6 +136,37 @@ Frame* FrameQueue::PeekReadable()
 void FrameQueue::Signal()
 {
     SDL_LockMutex(mMutex);
-    SDL_CondSignal(mSizeChangedCondition);
+    SDL_CondBroadcast(mSizeChangedCondition);
     SDL_UnlockMutex(mMutex);
 }
+
+void FrameQueue::Wait(std::atomic<bool>& waitingFlag, bool waitForReadable)
+{
+    SDL_LockMutex(mMutex);
+
+    // Set the flag BEFORE checking size one last time. Enqueue/Dequeue change size BEFORE checking the flag.
+    // So either we see the new size, or they see the flag and signal us - a wakeup can't be missed.
+    waitingFlag = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool ready = waitForReadable ? mSize - mReadIndexOffset > 0 : mSize < mMaxSize;
+    if(!ready && !mPacketQueue->Aborted())
+    {
+        SDL_CondWait(mSizeChangedCondition, mMutex);
+    }
+
+    waitingFlag = false;
+    SDL_UnlockMutex(mMutex);
+}
+
+void FrameQueue::Wake(std::atomic<bool>& waitingFlag)
+{
+    // Only take the lock if the other thread is actually waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(waitingFlag)
+    {
+        SDL_LockMutex(mMutex);
+        SDL_CondSignal(mSizeChangedCondition);
+        SDL_UnlockMutex(mMutex);
+    }
+}
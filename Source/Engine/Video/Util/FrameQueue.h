@@ -14,6 +14,8 @@ extern "C"
 }
 #include <SDL.h>
 
+#include <atomic>
+
 struct PacketQueue;
 
 #define VIDEO_PICTURE_QUEUE_SIZE 3
@@ -55,6 +57,11 @@ struct Frame
     // True if the image needs to be flipped vertically to display correctly.
     bool flipVertical = false;
 
+    // Video frames are converted to RGBA on the decode thread, and the result is stored here.
+    // The buffer is allocated once per queue slot and reused (or swapped with the video texture's buffer), so decoding doesn't allocate per frame.
+    uint8_t* rgbaPixels = nullptr;
+    int rgbaPixelsSize = 0;
+
     Frame();
     ~Frame();
 
@@ -93,7 +100,10 @@ private:
 
     // Current size and max size of the queue.
     // Often "max size" will equal FRAME_QUEUE_SIZE, but it's possible to force a smaller max size too.
-    int mSize = 0;
+    // Size is the only value shared between the writer (decode thread) and reader (playback), so it's atomic and needs no lock.
+    // This is already a single-producer/single-consumer ring, but it isn't an SpscQueue: the max size is chosen at runtime (and isn't a power of two),
+    // and with "keep last," the reader keeps using a frame after dequeueing it, so the writer can't be handed that slot yet.
+    std::atomic<int> mSize { 0 };
     int mMaxSize = 0;
 
     // Decoder will first write frames to the queue, and then the playback system will read frames.
@@ -108,10 +118,16 @@ private:
 
     // PeekReadable/PeekWritable may block if there's no readable frame or no space to write.
     // This condition is signaled if queue size changes so they can unblock.
+    // To avoid locking on every enqueue/dequeue, the condition is only signaled if a waiting flag is set.
     SDL_cond* mSizeChangedCondition = nullptr;
     SDL_mutex* mMutex = nullptr;
+    std::atomic<bool> mReaderWaiting { false };
+    std::atomic<bool> mWriterWaiting { false };
 
     // The packet queue for this data stream.
     // Mainly needed to detect if an abort occurs.
     PacketQueue* mPacketQueue = nullptr;
+
+    void Wait(std::atomic<bool>& waitingFlag, bool waitForReadable);
+    void Wake(std::atomic<bool>& waitingFlag);
 };
@@ -1,10 +1,9 @@
 #include "PacketQueue.h"
 
+#include <algorithm>
+
 int PacketQueue::Init()
 {
-    // Clear all fields.
-    memset(this, 0, sizeof(PacketQueue));
-
     // Create mutex or fail.
     mMutex = SDL_CreateMutex();
     if(!mMutex)
@@ -14,8 +13,8 @@ int PacketQueue::Init()
     }
 
     // Create condition variable or fail.
-    mNewPacketCondition = SDL_CreateCond();
-    if(!mNewPacketCondition)
+    mCondition = SDL_CreateCond();
+    if(!mCondition)
     {
         av_log(NULL, AV_LOG_FATAL, "SDL_CreateCond(): %s\n", SDL_GetError());
         return AVERROR(ENOMEM);
@@ -25,9 +24,17 @@ int PacketQueue::Init()
 
 void PacketQueue::Destroy()
 {
-    Clear();
+    // Producer and consumer threads have stopped by this point, so we can drain the queue directly.
+    // This also takes care of any packets that were cleared, but never discarded by the consumer.
+    Packet* packet = nullptr;
+    while((packet = mPackets.PeekReadable()) != nullptr)
+    {
+        av_packet_unref(&packet->pkt);
+        PopPacket();
+    }
+
     SDL_DestroyMutex(mMutex);
-    SDL_DestroyCond(mNewPacketCondition);
+    SDL_DestroyCond(mCondition);
 }
 
 void PacketQueue::Start()
@@ -38,25 +45,53 @@ void PacketQueue::Start()
 
 void PacketQueue::Abort()
 {
-    SDL_LockMutex(mMutex);
+    // Set flag, then wake up any thread waiting on a full/empty queue so it sees the abort.
     mAborted = true;
-    SDL_CondSignal(mNewPacketCondition);
+    SDL_LockMutex(mMutex);
+    SDL_CondBroadcast(mCondition);
     SDL_UnlockMutex(mMutex);
 }
 
 int PacketQueue::Enqueue(AVPacket* avPacket)
 {
-    SDL_LockMutex(mMutex);
-    int ret = PutInternal(avPacket);
-    SDL_UnlockMutex(mMutex);
+    // Get a free packet slot. If the queue is full, wait for the consumer to free one up.
+    Packet* packet = mAborted ? nullptr : mPackets.PeekWritable();
+    while(packet == nullptr)
+    {
+        // Failed to put this packet in the queue (due to abort).
+        // Unref it right away because we are discarding it.
+        if(!Wait(mProducerWaiting, false))
+        {
+            av_packet_unref(avPacket);
+            return -1;
+        }
+        packet = mPackets.PeekWritable();
+    }
+
+    // Store AVPacket inside of packet.
+    packet->pkt = *avPacket;
 
-    // Failed to put this packet in the queue.
-    // Unref it right away because we are discarding it.
-    if(ret < 0)
+    // If it is the flush packet, increment serial.
+    // The flush packet indicates that a skip/discontinuity has occurred in playback.
+    // So, following packets are from a different segment than previous packets.
+    if(IsFlushPacket(avPacket))
     {
-        av_packet_unref(avPacket);
+        serial++;
     }
-    return ret;
+
+    // Save packet's serial.
+    packet->serial = serial;
+
+    // Increase count/size/duration.
+    // Do this before pushing, so the consumer never sees a packet that isn't yet counted.
+    mEnqueued.sizeBytes += packet->pkt.size + sizeof(*packet);
+    mEnqueued.duration += packet->pkt.duration;
+    mEnqueued.count++;
+
+    // Make the packet visible to the consumer, and wake it up if it's waiting for one.
+    mPackets.Push();
+    Wake(mConsumerWaiting);
+    return 0;
 }
 
 int PacketQueue::EnqueueEof(int streamIndex)
@@ -81,129 +116,124 @@ int PacketQueue::EnqueueFlush()
 
 int PacketQueue::Dequeue(bool block, AVPacket* avPacket, int* avPacketSerial)
 {
-    SDL_LockMutex(mMutex);
-
-    int ret = 0;
     while(true)
     {
         // Abort if requested.
         if(mAborted)
         {
-            ret = -1;
-            break;
+            return -1;
         }
 
+        // Get rid of any packets that were cleared by the producer.
+        DiscardClearedPackets();
+
         // If there's a packet, remove it from the queue and set out variables.
-        if(mFirstPacket != nullptr)
+        Packet* packet = mPackets.PeekReadable();
+        if(packet != nullptr)
         {
-            // Remove first packet from queue.
-            Packet* firstPacket = mFirstPacket;
-            mFirstPacket = firstPacket->next;
-            if(mFirstPacket == nullptr)
-            {
-                mLastPacket = nullptr;
-            }
-
-            // Queue packet count, size, duration all decrease.
-            mPacketCount--;
-            mSizeBytes -= firstPacket->pkt.size + sizeof(*firstPacket);
-            mDuration -= firstPacket->pkt.duration;
-
-            // Set out vars.
-            *avPacket = firstPacket->pkt;
+            *avPacket = packet->pkt;
             if(avPacketSerial)
             {
-                *avPacketSerial = firstPacket->serial;
+                *avPacketSerial = packet->serial;
             }
-
-            delete firstPacket;
-            ret = 1;
-            break;
+            PopPacket();
+            return 1;
         }
-        else if(!block)
-        {
-            // No packet, but don't want to block.
-            ret = 0;
-            break;
-        }
-        else
+
+        // No packet, but don't want to block.
+        if(!block)
         {
-            // No packet and want to block until a packet becomes available.
-            SDL_CondWait(mNewPacketCondition, mMutex);
+            return 0;
         }
-    }
 
-    SDL_UnlockMutex(mMutex);
-    return ret;
+        // No packet and want to block until a packet becomes available.
+        Wait(mConsumerWaiting, true);
+    }
 }
 
 void PacketQueue::Clear()
 {
-    SDL_LockMutex(mMutex);
+    // Everything enqueued up to this point is considered cleared.
+    // Count is stored last, since the consumer uses it to decide what to discard.
+    mCleared.sizeBytes = mEnqueued.sizeBytes.load();
+    mCleared.duration = mEnqueued.duration.load();
+    mCleared.count = mEnqueued.count.load();
+}
 
-    // Clean up all packets in queue.
-    Packet* pkt = mFirstPacket;
-    while(pkt != nullptr)
-    {
-        Packet* temp = pkt;
-        pkt = temp->next;
+int PacketQueue::GetPacketCount() const
+{
+    // Cleared packets may not be discarded yet, but shouldn't be counted.
+    uint32_t enqueued = mEnqueued.count;
+    uint32_t dequeued = mDequeued.count;
+    uint32_t cleared = mCleared.count;
+    return static_cast<int>(enqueued - (static_cast<int32_t>(cleared - dequeued) > 0 ? cleared : dequeued));
+}
 
-        // Unref packet - we're discarding it.
-        av_packet_unref(&temp->pkt);
-        delete temp; // av_freep(&temp);
-    }
+int PacketQueue::GetByteSize() const
+{
+    return static_cast<int>(mEnqueued.sizeBytes - std::max(mDequeued.sizeBytes.load(), mCleared.sizeBytes.load()));
+}
 
-    // Queue is now empty.
-    mLastPacket = nullptr;
-    mFirstPacket = nullptr;
-    mPacketCount = 0;
-    mSizeBytes = 0;
-    mDuration = 0;
+int64_t PacketQueue::GetDuration() const
+{
+    return mEnqueued.duration - std::max(mDequeued.duration.load(), mCleared.duration.load());
+}
 
-    SDL_UnlockMutex(mMutex);
+void PacketQueue::PopPacket()
+{
+    // Queue packet count, size, duration all decrease.
+    Packet* packet = mPackets.PeekReadable();
+    mDequeued.sizeBytes += packet->pkt.size + sizeof(*packet);
+    mDequeued.duration += packet->pkt.duration;
+    mDequeued.count++;
+
+    // Give the slot back to the producer, and wake it up if it's waiting for one.
+    mPackets.Pop();
+    Wake(mProducerWaiting);
 }
 
-int PacketQueue::PutInternal(AVPacket* avPacket)
+void PacketQueue::DiscardClearedPackets()
 {
-    // Don't put anything if aborting.
-    if(mAborted) { return -1; }
+    // Counts wrap, so compare the difference rather than the values directly.
+    while(static_cast<int32_t>(mCleared.count - mDequeued.count) > 0)
+    {
+        Packet* packet = mPackets.PeekReadable();
+        if(packet == nullptr) { break; }
 
-    // Create packet or fail.
-    Packet* packet = new Packet(); //static_cast<Packet*>(av_malloc(sizeof(Packet)));
-    if(packet == nullptr) { return -1; }
+        // Unref packet - we're discarding it.
+        av_packet_unref(&packet->pkt);
+        PopPacket();
+    }
+}
 
-    // Store AVPacket inside of packet.
-    packet->pkt = *avPacket;
+bool PacketQueue::Wait(std::atomic<bool>& waitingFlag, bool waitForPacket)
+{
+    SDL_LockMutex(mMutex);
 
-    // If it is the flush packet, increment serial.
-    // The flush packet indicates that a skip/discontinuity has occurred in playback.
-    // So, following packets are from a different segment than previous packets.
-    if(avPacket->data == nullptr && avPacket->stream_index < 0)
+    // Announce that we're waiting BEFORE checking the queue one last time.
+    // The other thread updates the queue BEFORE checking this flag, so one of us is guaranteed to see the other's change.
+    waitingFlag = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool ready = waitForPacket ? !mPackets.Empty() : !mPackets.Full();
+    if(!ready && !mAborted)
     {
-        serial++;
+        SDL_CondWait(mCondition, mMutex);
     }
 
-    // Save packet's serial.
-    packet->serial = serial;
+    waitingFlag = false;
+    SDL_UnlockMutex(mMutex);
+    return !mAborted;
+}
 
-    // Add to end of queue.
-    if(mLastPacket == nullptr)
-    {
-        mFirstPacket = packet;
-    }
-    else
+void PacketQueue::Wake(std::atomic<bool>& waitingFlag)
+{
+    // Only take the lock if the other thread is actually waiting - normally, it isn't.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(waitingFlag)
     {
-        mLastPacket->next = packet;
+        SDL_LockMutex(mMutex);
+        SDL_CondBroadcast(mCondition);
+        SDL_UnlockMutex(mMutex);
     }
-    mLastPacket = packet;
-
-    // Increase count/size/duration.
-    mPacketCount++;
-    mSizeBytes += packet->pkt.size + sizeof(*packet);
-    mDuration += packet->pkt.duration;
-    /* XXX: should duplicate packet data in DV case */
-
-    // If anybody's waiting on the "more packets" condition, let them know we have more packets.
-    SDL_CondSignal(mNewPacketCondition);
-    return 0;
 }
@@ -14,6 +14,10 @@ extern "C"
 }
 #include <SDL.h>
 
+#include <atomic>
+
+#include "SpscQueue.h"
+
 struct PacketQueue
 {
     // Incremented each time a flush packet is encountered (currently only Start and Seek).
@@ -27,52 +31,73 @@ struct PacketQueue
     void Abort();
     bool Aborted() const { return mAborted; }
 
+    // Called from the producer (read) thread.
     // Return 0 on success, -1 on failure.
     int Enqueue(AVPacket* avPacket);
     int EnqueueEof(int streamIndex);
     int EnqueueFlush();
 
+    // Called from the consumer (decode) thread.
     // Return < 0 if aborted, 0 if no packet and > 0 if packet.
     int Dequeue(bool block, AVPacket* avPacket, int* serial);
+
+    // Discards all packets enqueued so far. Can be called from the producer thread.
+    // The consumer does the actual discarding the next time it dequeues (or on Destroy, if the consumer has stopped).
     void Clear();
 
-    int GetPacketCount() const { return mPacketCount; }
-    int GetByteSize() const { return mSizeBytes; }
-    int64_t GetDuration() const { return mDuration; }
+    int GetPacketCount() const;
+    int GetByteSize() const;
+    int64_t GetDuration() const;
 
     static bool IsEofPacket(AVPacket* avPacket) { return avPacket->data == nullptr && avPacket->stream_index >= 0; }
     static bool IsFlushPacket(AVPacket* avPacket) { return avPacket->data == nullptr && avPacket->stream_index < 0; }
 
 private:
-    // Helper to form a linked list of packets.
+    // A queued packet, along with the serial it was queued under.
     struct Packet
     {
         AVPacket pkt;
         int serial = 0;
-        Packet* next = nullptr;
     };
 
-    // Front and end of queue.
-    Packet* mFirstPacket = nullptr;
-    Packet* mLastPacket = nullptr;
+    // Max number of packets that can be queued. If full, Enqueue blocks until the consumer catches up.
+    // The read thread normally stops well short of this (see MAX_QUEUE_SIZE/MIN_FRAMES in VideoState), so this is just a backstop.
+    static const uint32_t kMaxPackets = 1024;
 
-    // Number of packets in the queue.
-    int mPacketCount = 0;
+    // The packets. Only the read thread enqueues, and only one decode thread dequeues, so this can be lock-free.
+    // Packet slots are allocated once and reused, so queueing a packet doesn't allocate.
+    SpscQueue<Packet, kMaxPackets> mPackets;
 
-    // Size (in bytes) of all data in this queue.
-    // Includes each packet's footprint + the size of the AVPacket contained.
-    int mSizeBytes = 0;
+    // Running totals of everything ever enqueued (written only by producer) and dequeued (written only by consumer).
+    // Queue size/duration are the difference between the two, so neither side needs to modify the other's counters.
+    // Size (in bytes) includes each packet's footprint + the size of the AVPacket contained.
+    struct Totals
+    {
+        std::atomic<uint32_t> count { 0 };
+        std::atomic<int64_t> sizeBytes { 0 };
+        std::atomic<int64_t> duration { 0 };
+    };
+    Totals mEnqueued;
+    Totals mDequeued;
 
-    // Each packet has a duration for how long it will show - this is the sum of all in queue.
-    int64_t mDuration = 0L;
+    // Clear is called from the producer thread, but only the consumer can remove packets.
+    // So, Clear records the enqueued totals at the time of the clear, and the consumer discards packets up to that point.
+    // Until then, size/duration are reported as if those packets were already gone.
+    Totals mCleared;
 
-    // Mutex handles multithread data modification.
-    // Condition allows "Get" to block (if queue is empty) until a new packet is inserted.
-    SDL_cond* mNewPacketCondition = nullptr;
+    // The queue itself doesn't need locks, but blocking when empty (consumer) or full (producer) does.
+    // A thread sets its "waiting" flag before sleeping on the condition, so the other thread only needs to lock/signal when someone is actually waiting.
+    SDL_cond* mCondition = nullptr;
     SDL_mutex* mMutex = nullptr;
+    std::atomic<bool> mConsumerWaiting { false };
+    std::atomic<bool> mProducerWaiting { false };
 
     // If true, queue is aborted.
-    bool mAborted = true;
+    std::atomic<bool> mAborted { true };
+
+    void PopPacket();
+    void DiscardClearedPackets();
 
-    int PutInternal(AVPacket* avPacket);
+    bool Wait(std::atomic<bool>& waitingFlag, bool waitForPacket);
+    void Wake(std::atomic<bool>& waitingFlag);
 };
@@ -1,6 +1,8 @@
 #include "ActionManager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 
 #include "ActionBar.h"
 #include "AssetManager.h"
@@ -19,6 +21,12 @@
 
 namespace
 {
+    ReportStream& GetActionsStream()
+    {
+        static ReportStream& actionsStream = gReportManager.GetReportStream("Actions");
+        return actionsStream;
+    }
+
     void OutputActions(const std::vector<const Action*>& actions)
     {
         for(auto& action : actions)
@@ -27,13 +35,14 @@ namespace
         }
     }
 
-    int GetNounVerbCount(const std::string& noun, const std::string& verb, VerbType verbType)
+    int GetNounVerbCount(Symbol noun, Symbol verb, VerbType verbType)
     {
+        static const Symbol kChatVerb("Z_CHAT");
         if(verbType == VerbType::Topic)
         {
             return gGameProgress.GetTopicCount(noun, verb);
         }
-        else if(StringUtil::EqualsIgnoreCase(verb, "Z_CHAT"))
+        else if(verb == kChatVerb)
         {
             return gGameProgress.GetChatCount(noun);
         }
@@ -42,6 +51,137 @@ namespace
             return gGameProgress.GetNounVerbCount(noun, verb);
         }
     }
+
+    // Custom case logic has this priority. See GetCasePriority.
+    const int kCustomCasePriority = 7;
+
+    bool IsCaseLabelAlphabeticallyFirst(const std::string& caseLabel, const std::string& otherCaseLabel)
+    {
+        // We can't just use strcmp because the sorting logic is a bit more complex.
+        // Basically, numbers sort before underscores, and underscores sort before letters.
+        std::string upperCase = StringUtil::ToUpperCopy(caseLabel);
+        std::string otherUpperCase = StringUtil::ToUpperCopy(otherCaseLabel);
+        size_t length = Math::Min(upperCase.length(), otherUpperCase.length());
+        for(size_t i = 0; i < length; ++i)
+        {
+            if(upperCase[i] != otherUpperCase[i])
+            {
+                // When the characters don't match, we use the one that comes first in an alphabetical sorting.
+                // However, the sorting used does have some special logic.
+                // A number 0-9 takes priority over a non-number.
+                // If both are numbers, the smaller number takes priority.
+                // Underscore takes priority over non-underscore.
+                // If both are letters, an earlier letter in alphabet takes priority.
+                bool isDigit = std::isdigit(upperCase[i]) != 0;
+                bool otherIsDigit = std::isdigit(otherUpperCase[i]) != 0;
+                if(isDigit != otherIsDigit)
+                {
+                    return isDigit;
+                }
+                if(!isDigit && (upperCase[i] == '_' || otherUpperCase[i] == '_'))
+                {
+                    return upperCase[i] == '_';
+                }
+                return upperCase[i] < otherUpperCase[i];
+            }
+        }
+
+        // The two have identical prefixes, but one is longer than the other.
+        // In this case, the shorter one is used.
+        return upperCase.length() < otherUpperCase.length();
+    }
+
+    void GetMatchingNouns(const std::string& noun, std::vector<std::string>& nouns)
+    {
+        // "ANY_OBJECT" is a wildcard. Any action with a noun of "ANY_OBJECT" can be valid for any noun passed in.
+        // These are lowest-priority, so we do them first (they might be overwritten later).
+        nouns.push_back("ANY_OBJECT");
+
+        // Next, specific actions for this particular noun.
+        nouns.push_back(noun);
+
+        // SO...in GK3, the nouns LADY_HOWARD & ESTELLE both mysteriously also match the noun LADY_H_ESTELLE.
+        // I haven't found any data-driven spot where this equivalence is defined. It *may* be hard-coded in the original game?
+        // Anyway, either of these nouns should also match LADY_H_ESTELLE noun.
+        if(StringUtil::EqualsIgnoreCase(noun, "LADY_HOWARD") || StringUtil::EqualsIgnoreCase(noun, "ESTELLE"))
+        {
+            nouns.push_back("LADY_H_ESTELLE");
+        }
+
+        // Also GRACE and MOSELY both matching GRACE_N_MOSE...
+        if(StringUtil::EqualsIgnoreCase(noun, "GRACE") || StringUtil::EqualsIgnoreCase(noun, "MOSELY"))
+        {
+            nouns.push_back("GRACE_N_MOSE");
+        }
+
+        // Also GABRIEL and MOSELY both matching GABE_N_MOSE...
+        if(StringUtil::EqualsIgnoreCase(noun, "GABRIEL") || StringUtil::EqualsIgnoreCase(noun, "MOSELY"))
+        {
+            nouns.push_back("GABE_N_MOSE");
+        }
+
+        // Also WILKES and BUCHELLI both matching WILKES_N_BUCHELLI...
+        if(StringUtil::EqualsIgnoreCase(noun, "WILKES") || StringUtil::EqualsIgnoreCase(noun, "BUCHELLI"))
+        {
+            nouns.push_back("WILKES_N_BUCHELLI");
+        }
+
+        // Also MALLORY and MACDOUGALL both matching TWO_MEN...
+        if(StringUtil::EqualsIgnoreCase(noun, "MALLORY") || StringUtil::EqualsIgnoreCase(noun, "MACDOUGALL"))
+        {
+            nouns.push_back("TWO_MEN");
+        }
+
+        // Also MOSELY, BUTHANE, and BUCHELLI match BUTHANE_MOSE_BUCHELLI...
+        if(StringUtil::EqualsIgnoreCase(noun, "MOSELY") ||
+           StringUtil::EqualsIgnoreCase(noun, "BUTHANE") ||
+           StringUtil::EqualsIgnoreCase(noun, "BUCHELLI"))
+        {
+            nouns.push_back("BUTHANE_MOSE_BUCHELLI");
+        }
+
+        // Also a boat load of exceptions at Day 2, 2PM, Devil's Armchair...
+        if(StringUtil::EqualsIgnoreCase(noun, "DEAD_CLOTHES_HE1") || StringUtil::EqualsIgnoreCase(noun, "DEAD_CLOTHES_HE2"))
+        {
+            nouns.push_back("DEAD_CLOTHES");
+        }
+        if(StringUtil::EqualsIgnoreCase(noun, "DEAD_THROAT_HE1") || StringUtil::EqualsIgnoreCase(noun, "DEAD_THROAT_HE2"))
+        {
+            nouns.push_back("DEAD_THROATS");
+        }
+        if(StringUtil::EqualsIgnoreCase(noun, "DEAD_FACES_HE1") || StringUtil::EqualsIgnoreCase(noun, "DEAD_FACES_HE2"))
+        {
+            nouns.push_back("DEAD_FACES");
+        }
+
+        // Same thing for the angles in the Church.
+        if(StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS1") || StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS2") ||
+           StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS3") || StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS4"))
+        {
+            nouns.push_back("FOUR_ANGELS");
+        }
+
+        // When clicking on an LSR passage (e.g. "LSR_VIRGO"), we also show the actions for LSR as a whole.
+        if(StringUtil::StartsWithIgnoreCase(noun, "LSR_"))
+        {
+            nouns.push_back("LSR");
+        }
+
+        // There's exactly one spot in the entire game (Wine Tasting Room in Day 2, 12PM) where the noun BUTHANE is expected to correlate to MADELINE. Geez.
+        if(StringUtil::StartsWithIgnoreCase(noun, "BUTHANE"))
+        {
+            nouns.push_back("MADELINE");
+        }
+
+        // And another instance (Dining Room in Day 2, 5PM) where the noun BRIDGE_PLAYERS corresponds to four character nouns.
+        if(StringUtil::StartsWithIgnoreCase(noun, "LADY_HOWARD") ||
+           StringUtil::EqualsIgnoreCase(noun, "ESTELLE") ||
+           StringUtil::EqualsIgnoreCase(noun, "EMILIO") ||
+           StringUtil::EqualsIgnoreCase(noun, "BUCHELLI"))
+        {
+            nouns.push_back("BRIDGE_PLAYERS");
+        }
+    }
 }
 
 ActionManager gActionManager;
@@ -115,6 +255,9 @@ void ActionManager::AddActionSet(const std::string& assetName)
     // Also build custom case logic map.
     const std::string_map_ci<SheepScriptAndText>& caseLogic = actionSet->GetCases();
     mCaseLogic.insert(caseLogic.begin(), caseLogic.end());
+
+    // Actions changed, so which action to use for a noun/verb needs to be figured out again.
+    mActionIndexDirty = true;
 }
 
 void ActionManager::AddActionSetIfForTimeblock(const std::string& assetName, const Timeblock& timeblock)
@@ -149,6 +292,7 @@ void ActionManager::ClearActionSets()
     mNouns.clear();
     mVerbToEnum.clear();
     mVerbs.clear();
+    mActionIndexDirty = true;
 }
 
 bool ActionManager::ExecuteAction(const std::string& noun, const std::string& verb, std::function<void(const Action*)> finishCallback)
@@ -198,7 +342,7 @@ void ActionManager::ExecuteCustomAction(const std::string& noun, const std::stri
         tempAction.verb = verb;
         tempAction.caseLabel = caseLabel;
         tempAction.script.text = sheepScriptText;
-        gReportManager.Log("Actions", StringUtil::Format("Skipping NVC %s - another action is in progress", tempAction.ToString().c_str()));
+        gReportManager.Logf(GetActionsStream(), "Skipping NVC %s - another action is in progress", tempAction.ToString().c_str());
         return;
     }
 
@@ -213,6 +357,7 @@ void ActionManager::ExecuteCustomAction(const std::string& noun, const std::stri
     mCustomAction.noun = noun;
     mCustomAction.verb = verb;
     mCustomAction.caseLabel = caseLabel;
+    mCustomAction.InternSymbols();
 
     // Compile script.
     mCustomAction.script.text = sheepScriptText;
@@ -291,19 +436,23 @@ void ActionManager::PerformPendingActionSkip()
 const Action* ActionManager::GetAction(const std::string& noun, const std::string& verb) const
 {
     // For any noun/verb pair, there is only ONE possible action that can be performed at any given time.
-    // Keep track of the candidate as we iterate from most general/broad to most specific.
-    // The most specific valid action will be our candidate.
-    const Action* candidate = nullptr;
+    // Check from most specific to most general/broad. The most specific valid action is the one to use.
 
-    // If the verb is an inventory item, handle ANY_OBJECT/ANY_INV_ITEM wildcards for noun/verb.
-    Action* action = nullptr;
+    // First, check for any exact noun/verb matches.
+    Action* action = GetHighestPriorityAction(noun, verb, VerbType::Normal);
+    if(action != nullptr)
+    {
+        return action;
+    }
+
+    // If the verb is an inventory item, handle noun/ANY_INV_ITEM combo.
     bool verbIsInventoryItem = gVerbManager.IsInventoryItem(verb);
     if(verbIsInventoryItem)
     {
-        action = GetHighestPriorityAction("ANY_OBJECT", "ANY_INV_ITEM", VerbType::Normal);
+        action = GetHighestPriorityAction(noun, "ANY_INV_ITEM", VerbType::Normal);
         if(action != nullptr)
         {
-            candidate = action;
+            return action;
         }
     }
 
@@ -311,210 +460,49 @@ const Action* ActionManager::GetAction(const std::string& noun, const std::strin
     action = GetHighestPriorityAction("ANY_OBJECT", verb, VerbType::Normal);
     if(action != nullptr)
     {
-        candidate = action;
+        return action;
     }
 
-    // If the verb is an inventory item, handle noun/ANY_INV_ITEM combo.
+    // If the verb is an inventory item, handle ANY_OBJECT/ANY_INV_ITEM wildcards for noun/verb.
     if(verbIsInventoryItem)
     {
-        action = GetHighestPriorityAction(noun, "ANY_INV_ITEM", VerbType::Normal);
-        if(action != nullptr)
-        {
-            candidate = action;
-        }
-    }
-
-    // Finally, check for any exact noun/verb matches.
-    action = GetHighestPriorityAction(noun, verb, VerbType::Normal);
-    if(action != nullptr)
-    {
-        candidate = action;
+        action = GetHighestPriorityAction("ANY_OBJECT", "ANY_INV_ITEM", VerbType::Normal);
     }
-    return candidate;
+    return action;
 }
 
 std::vector<const Action*> ActionManager::GetActions(const std::string& noun, VerbType verbType) const
 {
-    // "ANY_OBJECT" is a wildcard. Any action with a noun of "ANY_OBJECT" can be valid for any noun passed in.
-    // These are lowest-priority, so we do them first (they might be overwritten later).
-    std::unordered_map<std::string, const Action*> verbToAction;
-    AddActionsToMap("ANY_OBJECT", verbType, verbToAction);
-
-    // Next, get specific actions for this particular noun.
-    std::unordered_map<std::string, const Action*> verbToActionSpecific;
-    AddActionsToMap(noun, verbType, verbToActionSpecific);
-
-    // Combine the two maps.
-    // If a verb exists in both maps, the specific version overwrites the more general ANY_OBJECT version.
-    for(auto& entry : verbToActionSpecific)
-    {
-        verbToAction[entry.first] = entry.second;
-    }
-
-    // SO...in GK3, the nouns LADY_HOWARD & ESTELLE both mysteriously also match the noun LADY_H_ESTELLE.
-    // I haven't found any data-driven spot where this equivalence is defined. It *may* be hard-coded in the original game?
-    // Anyway, either of these nouns should also match LADY_H_ESTELLE noun.
-    if(StringUtil::EqualsIgnoreCase(noun, "LADY_HOWARD") || StringUtil::EqualsIgnoreCase(noun, "ESTELLE"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("LADY_H_ESTELLE", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Also GRACE and MOSELY both matching GRACE_N_MOSE...
-    if(StringUtil::EqualsIgnoreCase(noun, "GRACE") || StringUtil::EqualsIgnoreCase(noun, "MOSELY"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("GRACE_N_MOSE", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Also GABRIEL and MOSELY both matching GABE_N_MOSE...
-    if(StringUtil::EqualsIgnoreCase(noun, "GABRIEL") || StringUtil::EqualsIgnoreCase(noun, "MOSELY"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("GABE_N_MOSE", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Also WILKES and BUCHELLI both matching WILKES_N_BUCHELLI...
-    if(StringUtil::EqualsIgnoreCase(noun, "WILKES") || StringUtil::EqualsIgnoreCase(noun, "BUCHELLI"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("WILKES_N_BUCHELLI", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Also MALLORY and MACDOUGALL both matching TWO_MEN...
-    if(StringUtil::EqualsIgnoreCase(noun, "MALLORY") || StringUtil::EqualsIgnoreCase(noun, "MACDOUGALL"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("TWO_MEN", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Also MOSELY, BUTHANE, and BUCHELLI match BUTHANE_MOSE_BUCHELLI...
-    if(StringUtil::EqualsIgnoreCase(noun, "MOSELY") ||
-       StringUtil::EqualsIgnoreCase(noun, "BUTHANE") ||
-       StringUtil::EqualsIgnoreCase(noun, "BUCHELLI"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("BUTHANE_MOSE_BUCHELLI", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Also a boat load of exceptions at Day 2, 2PM, Devil's Armchair...
-    if(StringUtil::EqualsIgnoreCase(noun, "DEAD_CLOTHES_HE1") || StringUtil::EqualsIgnoreCase(noun, "DEAD_CLOTHES_HE2"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("DEAD_CLOTHES", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-    if(StringUtil::EqualsIgnoreCase(noun, "DEAD_THROAT_HE1") || StringUtil::EqualsIgnoreCase(noun, "DEAD_THROAT_HE2"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("DEAD_THROATS", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-    if(StringUtil::EqualsIgnoreCase(noun, "DEAD_FACES_HE1") || StringUtil::EqualsIgnoreCase(noun, "DEAD_FACES_HE2"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("DEAD_FACES", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // Same thing for the angles in the Church.
-    if(StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS1") || StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS2") ||
-       StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS3") || StringUtil::EqualsIgnoreCase(noun, "FOUR_ANGELS4"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("FOUR_ANGELS", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // When clicking on an LSR passage (e.g. "LSR_VIRGO"), we also show the actions for LSR as a whole.
-    if(StringUtil::StartsWithIgnoreCase(noun, "LSR_"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("LSR", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
-        {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
+    static const Symbol kTalkVerb("TALK");
+    static const Symbol kChatVerb("Z_CHAT");
 
-    // There's exactly one spot in the entire game (Wine Tasting Room in Day 2, 12PM) where the noun BUTHANE is expected to correlate to MADELINE. Geez.
-    if(StringUtil::StartsWithIgnoreCase(noun, "BUTHANE"))
+    // For each verb that might be used with this noun, find the most specific valid action.
+    std::vector<const Action*> viableActions;
+    const Action* chatAction = nullptr;
+    bool hasTalkAction = false;
+    for(const ResolvedVerb& resolvedVerb : GetResolvedVerbs(noun, verbType))
     {
-        verbToActionSpecific.clear();
-        AddActionsToMap("MADELINE", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
+        const Action* action = nullptr;
+        for(int candidate : resolvedVerb.candidates)
         {
-            verbToAction[entry.first] = entry.second;
+            action = GetHighestPriorityAction(mPrioritizedActions[candidate], verbType);
+            if(action != nullptr) { break; }
         }
-    }
+        if(action == nullptr) { continue; }
 
-    // And another instance (Dining Room in Day 2, 5PM) where the noun BRIDGE_PLAYERS corresponds to four character nouns.
-    if(StringUtil::StartsWithIgnoreCase(noun, "LADY_HOWARD") ||
-       StringUtil::EqualsIgnoreCase(noun, "ESTELLE") ||
-       StringUtil::EqualsIgnoreCase(noun, "EMILIO") ||
-       StringUtil::EqualsIgnoreCase(noun, "BUCHELLI"))
-    {
-        verbToActionSpecific.clear();
-        AddActionsToMap("BRIDGE_PLAYERS", verbType, verbToActionSpecific);
-        for(auto& entry : verbToActionSpecific)
+        // The "Chat" action is only valid if the "Talk" option is not present, so hold onto it until we know.
+        // Not sure where else to check that - this seems like an OK spot.
+        if(resolvedVerb.verb == kChatVerb)
         {
-            verbToAction[entry.first] = entry.second;
-        }
-    }
-
-    // The "Chat" action is only valid if the "Talk" option is not present. Remove "Chat" if "Talk" is present.
-    // Not sure where else to check that - this seems like an OK spot.
-    auto talkIt = verbToAction.find("TALK");
-    if(talkIt != verbToAction.end())
-    {
-        auto chatIt = verbToAction.find("Z_CHAT");
-        if(chatIt != verbToAction.end())
-        {
-            verbToAction.erase(chatIt);
+            chatAction = action;
+            continue;
         }
+        hasTalkAction |= resolvedVerb.verb == kTalkVerb;
+        viableActions.push_back(action);
     }
-
-    // Finally, convert our map to a vector to return.
-    std::vector<const Action*> viableActions;
-    for(auto entry : verbToAction)
+    if(chatAction != nullptr && !hasTalkAction)
     {
-        viableActions.push_back(entry.second);
+        viableActions.push_back(chatAction);
     }
     //OutputActions(viableActions);
     return viableActions;
@@ -522,12 +510,31 @@ std::vector<const Action*> ActionManager::GetActions(const std::string& noun, Ve
 
 bool ActionManager::HasTopicsLeft(const std::string &noun) const
 {
-    return GetActions(noun, VerbType::Topic).size() > 0;
+    // Same as checking GetActions for topics, but we can stop at the first valid one.
+    for(const ResolvedVerb& resolvedVerb : GetResolvedVerbs(noun, VerbType::Topic))
+    {
+        for(int candidate : resolvedVerb.candidates)
+        {
+            if(GetHighestPriorityAction(mPrioritizedActions[candidate], VerbType::Topic) != nullptr)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 bool ActionManager::IsActionAllowed(const std::string& noun, const std::string& verb, const std::string& caseLabel)
 {
-    return IsCaseMet(noun, verb, caseLabel);
+    // This is a query, so only look up the names. Names that were never interned have no counts anyway.
+    Action action;
+    action.noun = noun;
+    action.verb = verb;
+    action.caseLabel = caseLabel;
+    action.nounSymbol = Symbol::Find(noun);
+    action.verbSymbol = Symbol::Find(verb);
+    action.caseSymbol = Symbol::Find(caseLabel);
+    return IsCaseMet(action);
 }
 
 std::string& ActionManager::GetNoun(int nounEnum)
@@ -596,8 +603,29 @@ bool ActionManager::IsActionSetForTimeblock(const std::string& assetName, const
     return start <= timeblock && timeblock <= end;
 }
 
-bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb, const std::string& caseLabel, VerbType verbType) const
+bool ActionManager::IsCaseMet(const Action& action, VerbType verbType) const
 {
+    static const Symbol kAllCase("ALL");
+    static const Symbol kGabeAllCase("GABE_ALL");
+    static const Symbol kGraceAllCase("GRACE_ALL");
+    static const Symbol k1stTimeCase("1ST_TIME");
+    static const Symbol k2cdTimeCase("2CD_TIME");
+    static const Symbol k2ndTimeCase("2ND_TIME");
+    static const Symbol k3rdTimeCase("3RD_TIME");
+    static const Symbol kOtrTimeCase("OTR_TIME");
+    static const Symbol kTopicsLeftCase("DIALOGUE_TOPICS_LEFT");
+    static const Symbol kNotTopicsLeftCase("NOT_DIALOGUE_TOPICS_LEFT");
+    static const Symbol kTimeblockCase("TIME_BLOCK");
+    static const Symbol kTimeblockOverrideCase("TIME_BLOCK_OVERRIDE");
+    static const Symbol kEggCase("EGG");
+    static const Symbol kGabriel("Gabriel");
+    static const Symbol kGrace("Grace");
+
+    const std::string& noun = action.noun;
+    const std::string& verb = action.verb;
+    const std::string& caseLabel = action.caseLabel;
+    const Symbol caseSymbol = action.caseSymbol;
+
     // Empty condition is automatically met.
     if(caseLabel.empty()) { return true; }
 
@@ -649,9 +677,7 @@ bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb,
     }
 
     // Check global case conditions.
-    if(StringUtil::EqualsIgnoreCase(caseLabel, "ALL") ||
-       StringUtil::EqualsIgnoreCase(caseLabel, "GABE_ALL") ||
-       StringUtil::EqualsIgnoreCase(caseLabel, "GRACE_ALL"))
+    if(caseSymbol == kAllCase || caseSymbol == kGabeAllCase || caseSymbol == kGraceAllCase)
     {
         // For topics, "ALL" has some strange behavior. Despite appearances, it is not ALWAYS available! It is the last thing to be said about a topic.
         // For example, take JEAN:T_TWO_MEN in Lobby on Day 1, 10AM. If you don't do this special logic, the last dialogue can be played forever.
@@ -668,64 +694,64 @@ bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb,
                     topicCount = it3->second.size();
                 }
             }
-            return gGameProgress.GetTopicCount(noun, verb) == (topicCount - 1);
+            return gGameProgress.GetTopicCount(action.nounSymbol, action.verbSymbol) == (topicCount - 1);
         }
 
         // "ALL" is always met!
-        if(StringUtil::EqualsIgnoreCase(caseLabel, "GABE_ALL"))
+        if(caseSymbol == kGabeAllCase)
         {
-            return StringUtil::EqualsIgnoreCase(Scene::GetEgoName(), "Gabriel");
+            return Scene::GetEgoSymbol() == kGabriel;
         }
-        else if(StringUtil::EqualsIgnoreCase(caseLabel, "GRACE_ALL"))
+        else if(caseSymbol == kGraceAllCase)
         {
-            return StringUtil::EqualsIgnoreCase(Scene::GetEgoName(), "Grace");
+            return Scene::GetEgoSymbol() == kGrace;
         }
         return true;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "1ST_TIME"))
+    else if(caseSymbol == k1stTimeCase)
     {
         // Condition is met if this is the first time we've executed this action (noun/verb combo).
-        return GetNounVerbCount(noun, verb, verbType) == 0;
+        return GetNounVerbCount(action.nounSymbol, action.verbSymbol, verbType) == 0;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "2CD_TIME") || StringUtil::EqualsIgnoreCase(caseLabel, "2ND_TIME"))
+    else if(caseSymbol == k2cdTimeCase || caseSymbol == k2ndTimeCase)
     {
         // A surprising way to abbreviate "2nd time"...
         // Condition is met if this is the 2nd time we did the action.
-        return GetNounVerbCount(noun, verb, verbType) == 1;
+        return GetNounVerbCount(action.nounSymbol, action.verbSymbol, verbType) == 1;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "3RD_TIME"))
+    else if(caseSymbol == k3rdTimeCase)
     {
         // And again for good measure. True if this is the 3rd time we did the action.
-        return GetNounVerbCount(noun, verb, verbType) == 2;
+        return GetNounVerbCount(action.nounSymbol, action.verbSymbol, verbType) == 2;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "OTR_TIME"))
+    else if(caseSymbol == kOtrTimeCase)
     {
         // Condition is met if this IS NOT the first time we've executed this action (noun/verb combo).
         // However, if 2nd/3rd time actions exist, they will have higher priority than this one.
-        return GetNounVerbCount(noun, verb, verbType) > 0;
+        return GetNounVerbCount(action.nounSymbol, action.verbSymbol, verbType) > 0;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "DIALOGUE_TOPICS_LEFT"))
+    else if(caseSymbol == kTopicsLeftCase)
     {
         // Condition is met if there are any "topic" type actions available for this noun.
         return HasTopicsLeft(noun);
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "NOT_DIALOGUE_TOPICS_LEFT"))
+    else if(caseSymbol == kNotTopicsLeftCase)
     {
         // Condition is met if there are no more "topic" type actions available for this noun.
         return !HasTopicsLeft(noun);
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "TIME_BLOCK"))
+    else if(caseSymbol == kTimeblockCase)
     {
         // This condition always returns true.
         // In an NVC file, it typically signifies a variant action for the specific timeblock that overrides one of the general SIF actions.
         return true;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "TIME_BLOCK_OVERRIDE"))
+    else if(caseSymbol == kTimeblockOverrideCase)
     {
         // This condition is identical to TIME_BLOCK, but it has higher priority when multiple actions can be used.
         return true;
     }
-    else if(StringUtil::EqualsIgnoreCase(caseLabel, "EGG"))
+    else if(caseSymbol == kEggCase)
     {
         //TODO: Return true if easter eggs are enabled.
         return false;
@@ -737,183 +763,199 @@ bool ActionManager::IsCaseMet(const std::string& noun, const std::string& verb,
     return false;
 }
 
-Action* ActionManager::GetHighestPriorityAction(const std::string& noun, const std::string& verb, VerbType verbType) const
+void ActionManager::UpdateActionIndex() const
 {
-    // The action to return - we'll figure this out as we iterate.
-    Action* action = nullptr;
+    if(!mActionIndexDirty) { return; }
+    mActionIndexDirty = false;
+
+    // Throw out the old index, including any resolved nouns, which point into it.
+    mPrioritizedActions.clear();
+    mNounToPrioritizedActions.Clear();
+    mResolvedVerbs.clear();
+    for(auto& nounToResolvedVerbs : mNounToResolvedVerbs)
+    {
+        nounToResolvedVerbs.Clear();
+    }
 
-    // Find the maps for this noun/verb. If they don't exist, we return nullptr.
-    auto nounEntry = mActions.find(noun);
-    if(nounEntry != mActions.end())
+    for(auto& nounEntry : mActions)
     {
-        auto verbEntry = nounEntry->second.find(verb);
-        if(verbEntry != nounEntry->second.end())
+        std::vector<int>& nounIndexes = mNounToPrioritizedActions[Symbol(nounEntry.first)];
+        for(auto& verbEntry : nounEntry.second)
         {
-            // For a single noun/verb combo, we only want to return a *single* action.
+            // For a single noun/verb combo, we only want to use a *single* action.
             // HOWEVER, there may be multiple Actions whose cases are met under current game conditions.
-            // To resolve this, we must assign different cases different priorities, and return the highest priority valid one at this time!
-            int highestScore = 0;
-            for(auto& entry : verbEntry->second)
+            // To resolve this, different cases have different priorities, and we use the highest priority valid one.
+            // Priorities only depend on the case labels, so we can sort by them now. At query time, the first action whose case is met wins.
+            std::vector<std::pair<int, Action*>> scoredActions;
+            for(auto& caseEntry : verbEntry.second)
             {
-                // The case must be met, for one.
-                bool caseMet = IsCaseMet(noun, verb, entry.first, verbType);
-                if(!caseMet) { continue; }
-
-                // OK, this Action is totally valid!
-                // The only reason we wouldn't use it is if a higher-priority case is met.
-
-                // Determine a "score" value for this action's CASE label. A higher score means the CASE has higher priority.
-                // CASE Priority (Lowest to Highest):
-                // ALL
-                // GABE_ALL / GRACE_ALL
-                // TIME_BLOCK
-                // OTR_TIME
-                // DIALOGUE_TOPICS_LEFT / NOT_DIALOGUE_TOPICS_LEFT
-                // TIME_BLOCK_OVERRIDE
-                // Custom Logic - action type, and then alphabetical order
-                // 1ST_TIME / 2CD_TIME / 2ND_TIME / 3RD_TIME
-                int caseScore = 0;
-                auto caseLogicIt = mCaseLogic.find(entry.first);
-                if(StringUtil::EqualsIgnoreCase(entry.first, "ALL") ||
-                   StringUtil::EqualsIgnoreCase(entry.first, "ALL_INV"))
-                {
-                    caseScore = 1;
-                }
-                else if(StringUtil::EqualsIgnoreCase(entry.first, "GABE_ALL") ||
-                        StringUtil::EqualsIgnoreCase(entry.first, "GRACE_ALL") ||
-                        StringUtil::EqualsIgnoreCase(entry.first, "GABE_ALL_INV") ||
-                        StringUtil::EqualsIgnoreCase(entry.first, "GRACE_ALL_INV"))
+                int casePriority = GetCasePriority(caseEntry.first);
+                if(casePriority == 0)
                 {
-                    caseScore = 2;
+                    LOG_ERROR("Unaccounted for case label %s!", caseEntry.first.c_str());
+                    continue;
                 }
-                else if(StringUtil::EqualsIgnoreCase(entry.first, "TIME_BLOCK"))
-                {
-                    caseScore = 3;
-                }
-                else if(StringUtil::EqualsIgnoreCase(entry.first, "OTR_TIME"))
-                {
-                    caseScore = 4;
-                }
-                else if(StringUtil::EqualsIgnoreCase(entry.first, "DIALOGUE_TOPICS_LEFT") ||
-                        StringUtil::EqualsIgnoreCase(entry.first, "NOT_DIALOGUE_TOPICS_LEFT"))
-                {
-                    caseScore = 5;
-                }
-                else if(StringUtil::EqualsIgnoreCase(entry.first, "TIME_BLOCK_OVERRIDE"))
-                {
-                    caseScore = 6;
-                }
-                else if(StringUtil::StartsWithIgnoreCase(entry.first, "1ST_TIME") ||
-                        StringUtil::StartsWithIgnoreCase(entry.first, "2CD_TIME") ||
-                        StringUtil::StartsWithIgnoreCase(entry.first, "2ND_TIME") ||
-                        StringUtil::StartsWithIgnoreCase(entry.first, "3RD_TIME"))
+                scoredActions.emplace_back(casePriority, caseEntry.second);
+            }
+            std::stable_sort(scoredActions.begin(), scoredActions.end(), [](const std::pair<int, Action*>& a, const std::pair<int, Action*>& b) {
+                if(a.first != b.first)
                 {
-                    caseScore = 8;
+                    return a.first > b.first;
                 }
-                else if(caseLogicIt != mCaseLogic.end())
+
+                // What if we have two valid custom cases? Each action has a type - more specific types (e.g. timeblock vs global) win out.
+                // If they are the same type, incredibly, the game seems to just do an alphabetical check.
+                if(a.first == kCustomCasePriority)
                 {
-                    // Custom case logic is only overridden by 1st/2nd/3rd time cases.
-                    caseScore = 7;
-
-                    // If we already encountered a valid custom case, AND this custom case is also valid, we have a tie.
-                    // Each action has a type - more specific types (e.g. timeblock vs global) win out.
-                    //
-                    // But what if we have two valid custom actions, same type?
-                    // Incredibly, the game seems to just do an alphabetical check at that point (with some customizations).
-                    if(action != nullptr && highestScore == 7)
+                    if(a.second->type != b.second->type)
                     {
-                        if(entry.second->type > action->type)
-                        {
-                            action = entry.second;
-                        }
-                        else if(entry.second->type == action->type)
-                        {
-                            if(StringUtil::EqualsIgnoreCase(action->caseLabel, entry.first))
-                            {
-                                // This would be a weird edge case (two actions with the exact same noun/verb/case?).
-                                // In that scenario, I guess just use the new action.
-                                action = entry.second;
-                            }
-                            else
-                            {
-                                // Cases differ, so we need to compare them alphabetically.
-                                // We can't just use strcmp because the sorting logic is a bit more complex.
-                                // Basically, numbers sort before underscores, and underscores sort before letters.
-                                std::string prevCase = StringUtil::ToUpperCopy(action->caseLabel);
-                                std::string newCase = StringUtil::ToUpperCopy(entry.first);
-                                size_t prevCaseLength = prevCase.length();
-                                size_t newCaseLength = newCase.length();
-
-                                int length = prevCaseLength > newCaseLength ? prevCaseLength : newCaseLength;
-                                for(int i = 0; i < length; ++i)
-                                {
-                                    // The two have identical prefixes, but one is longer than the other.
-                                    // In this case, the shorter action is used.
-                                    if(i >= prevCaseLength)
-                                    {
-                                        break;
-                                    }
-                                    else if(i >= newCaseLength)
-                                    {
-                                        action = entry.second;
-                                        break;
-                                    }
-                                    else if(prevCase[i] != newCase[i])
-                                    {
-                                        // When the characters don't match, we use the one that comes first in an alphabetical sorting.
-                                        // However, the sorting used does have some special logic.
-                                        // A number 0-9 takes priority over a non-number.
-                                        // If both are numbers, the smaller number takes priority.
-                                        // Underscore takes priority over non-underscore.
-                                        // If both are letters, an earlier letter in alphabet takes priority.
-                                        bool prevIsDigit = std::isdigit(prevCase[i]) != 0;
-                                        bool newIsDigit = std::isdigit(newCase[i]) != 0;
-
-                                        bool useNewCase = (newIsDigit && !prevIsDigit) ||
-                                            (newIsDigit && prevIsDigit && newCase[i] < prevCase[i]) ||
-                                            (newCase[i] == '_' && prevCase[i] != '_' && !prevIsDigit) ||
-                                            (newCase[i] < prevCase[i] && prevCase[i] != '_' && !prevIsDigit);
-                                        if(useNewCase)
-                                        {
-                                            action = entry.second;
-                                        }
-                                        break;
-                                    }
-                                }
-                            }
-                        }
+                        return a.second->type > b.second->type;
                     }
+                    return IsCaseLabelAlphabeticallyFirst(a.second->caseLabel, b.second->caseLabel);
                 }
-                else
-                {
-                    LOG_ERROR("Unaccounted for case label %s!", entry.first.c_str());
-                }
+                return false;
+            });
+
+            PrioritizedActions prioritizedActions;
+            prioritizedActions.noun = nounEntry.first;
+            prioritizedActions.verb = verbEntry.first;
+            prioritizedActions.verbSymbol = Symbol(verbEntry.first);
+            for(auto& scoredAction : scoredActions)
+            {
+                prioritizedActions.actions.push_back(scoredAction.second);
+            }
+            nounIndexes.push_back(static_cast<int>(mPrioritizedActions.size()));
+            mPrioritizedActions.push_back(std::move(prioritizedActions));
+        }
+    }
+}
 
-                // If we found a case with a higher score, we'll use that instead.
-                if(caseScore > highestScore)
-                {
-                    highestScore = caseScore;
-                    action = entry.second;
-                }
+int ActionManager::GetCasePriority(const std::string& caseLabel) const
+{
+    // Determine a priority value for a CASE label. A higher value means the CASE has higher priority.
+    // CASE Priority (Lowest to Highest):
+    // ALL
+    // GABE_ALL / GRACE_ALL
+    // TIME_BLOCK
+    // OTR_TIME
+    // DIALOGUE_TOPICS_LEFT / NOT_DIALOGUE_TOPICS_LEFT
+    // TIME_BLOCK_OVERRIDE
+    // Custom Logic - action type, and then alphabetical order
+    // 1ST_TIME / 2CD_TIME / 2ND_TIME / 3RD_TIME
+    if(StringUtil::EqualsIgnoreCase(caseLabel, "ALL") ||
+       StringUtil::EqualsIgnoreCase(caseLabel, "ALL_INV"))
+    {
+        return 1;
+    }
+    else if(StringUtil::EqualsIgnoreCase(caseLabel, "GABE_ALL") ||
+            StringUtil::EqualsIgnoreCase(caseLabel, "GRACE_ALL") ||
+            StringUtil::EqualsIgnoreCase(caseLabel, "GABE_ALL_INV") ||
+            StringUtil::EqualsIgnoreCase(caseLabel, "GRACE_ALL_INV"))
+    {
+        return 2;
+    }
+    else if(StringUtil::EqualsIgnoreCase(caseLabel, "TIME_BLOCK"))
+    {
+        return 3;
+    }
+    else if(StringUtil::EqualsIgnoreCase(caseLabel, "OTR_TIME"))
+    {
+        return 4;
+    }
+    else if(StringUtil::EqualsIgnoreCase(caseLabel, "DIALOGUE_TOPICS_LEFT") ||
+            StringUtil::EqualsIgnoreCase(caseLabel, "NOT_DIALOGUE_TOPICS_LEFT"))
+    {
+        return 5;
+    }
+    else if(StringUtil::EqualsIgnoreCase(caseLabel, "TIME_BLOCK_OVERRIDE"))
+    {
+        return 6;
+    }
+    else if(StringUtil::StartsWithIgnoreCase(caseLabel, "1ST_TIME") ||
+            StringUtil::StartsWithIgnoreCase(caseLabel, "2CD_TIME") ||
+            StringUtil::StartsWithIgnoreCase(caseLabel, "2ND_TIME") ||
+            StringUtil::StartsWithIgnoreCase(caseLabel, "3RD_TIME"))
+    {
+        return 8;
+    }
+    else if(mCaseLogic.find(caseLabel) != mCaseLogic.end())
+    {
+        // Custom case logic is only overridden by 1st/2nd/3rd time cases.
+        return kCustomCasePriority;
+    }
+    return 0;
+}
+
+Action* ActionManager::GetHighestPriorityAction(const std::string& noun, const std::string& verb, VerbType verbType) const
+{
+    UpdateActionIndex();
+
+    // Find the actions for this noun/verb. If they don't exist, we return nullptr.
+    // If the noun or verb was never interned, it can't be in the index either.
+    Symbol nounSymbol = Symbol::Find(noun);
+    Symbol verbSymbol = Symbol::Find(verb);
+    if(nounSymbol.IsEmpty() || verbSymbol.IsEmpty()) { return nullptr; }
+
+    const std::vector<int>* nounIndexes = mNounToPrioritizedActions.Find(nounSymbol);
+    if(nounIndexes != nullptr)
+    {
+        for(int index : *nounIndexes)
+        {
+            if(mPrioritizedActions[index].verbSymbol == verbSymbol)
+            {
+                return GetHighestPriorityAction(mPrioritizedActions[index], verbType);
             }
         }
     }
-    return action;
+    return nullptr;
 }
 
-void ActionManager::AddActionsToMap(const std::string& noun, VerbType verbType, std::unordered_map<std::string, const Action*>& map) const
+Action* ActionManager::GetHighestPriorityAction(const PrioritizedActions& prioritizedActions, VerbType verbType) const
 {
-    // Find this noun in the action map.
-    auto nounEntry = mActions.find(noun);
-    if(nounEntry != mActions.end())
+    // Actions are already sorted by priority, so the first one whose case is met is the one to use.
+    for(Action* action : prioritizedActions.actions)
     {
-        // Iterate over each verb entry, and try to find ONE valid action per verb.
-        // In the situation a verb has multiple valid actions, some tie-breaking logic is used.
-        for(auto& verbEntry : nounEntry->second)
+        if(IsCaseMet(*action, verbType))
         {
+            return action;
+        }
+    }
+    return nullptr;
+}
+
+const std::vector<ActionManager::ResolvedVerb>& ActionManager::GetResolvedVerbs(const std::string& noun, VerbType verbType) const
+{
+    UpdateActionIndex();
+
+    // If we've already resolved verbs for this noun, use those.
+    // Scene nouns are interned when the SIF loads, so this is normally just a lookup.
+    // A noun from elsewhere is interned the first time it's queried, so its verbs can be cached too.
+    Symbol nounSymbol(noun);
+    SymbolMap<const std::vector<ResolvedVerb>*>& nounToResolvedVerbs = mNounToResolvedVerbs[static_cast<int>(verbType)];
+    const std::vector<ResolvedVerb>** cachedVerbs = nounToResolvedVerbs.Find(nounSymbol);
+    if(cachedVerbs != nullptr)
+    {
+        return **cachedVerbs;
+    }
+
+    // Get all nouns whose actions can be used for this noun, from lowest to highest precedence.
+    std::vector<std::string> nouns;
+    GetMatchingNouns(noun, nouns);
+
+    // Add candidate actions for each verb, highest precedence first.
+    std::vector<ResolvedVerb>& resolvedVerbs = mResolvedVerbs.emplace_back();
+    for(auto it = nouns.rbegin(); it != nouns.rend(); ++it)
+    {
+        const std::vector<int>* nounIndexes = mNounToPrioritizedActions.Find(Symbol::Find(*it));
+        if(nounIndexes == nullptr) { continue; }
+
+        for(int index : *nounIndexes)
+        {
+            const PrioritizedActions& prioritizedActions = mPrioritizedActions[index];
+
             // The "ANY_INV_ITEM" wildcard verb only matches if a specific verb was provided.
-            // This function doesn't let you specify a verb, so this should never match.
-            bool isWildcardInvItem = StringUtil::EqualsIgnoreCase(verbEntry.first, "ANY_INV_ITEM");
+            // GetActions doesn't let you specify a verb, so this should never match.
+            bool isWildcardInvItem = StringUtil::EqualsIgnoreCase(prioritizedActions.verb, "ANY_INV_ITEM");
             if(isWildcardInvItem) { continue; }
 
             // The verb must be of the correct type for us to use it.
@@ -921,28 +963,37 @@ void ActionManager::AddActionsToMap(const std::string& noun, VerbType verbType,
             switch(verbType)
             {
             case VerbType::Normal:
-                validType = gVerbManager.IsVerb(verbEntry.first);
+                validType = gVerbManager.IsVerb(prioritizedActions.verb);
                 break;
             case VerbType::Inventory:
-                validType = gVerbManager.IsInventoryItem(verbEntry.first);
+                validType = gVerbManager.IsInventoryItem(prioritizedActions.verb);
                 break;
             case VerbType::Topic:
-                validType = gVerbManager.IsTopic(verbEntry.first);
+                validType = gVerbManager.IsTopic(prioritizedActions.verb);
                 break;
             }
             if(!validType) { continue; }
 
-            // OK, this noun/verb combo seems fine.
-            // Now, iterate all possible *cases* for this noun/verb combo, and settle on a single one that we'll use.
-            Action* action = GetHighestPriorityAction(noun, verbEntry.first, verbType);
-
-            // Map verb to action.
-            if(action != nullptr)
+            // OK, this noun/verb combo seems fine. Add it as a candidate for this verb.
+            ResolvedVerb* resolvedVerb = nullptr;
+            for(ResolvedVerb& existingVerb : resolvedVerbs)
+            {
+                if(existingVerb.verb == prioritizedActions.verbSymbol)
+                {
+                    resolvedVerb = &existingVerb;
+                    break;
+                }
+            }
+            if(resolvedVerb == nullptr)
             {
-                map[verbEntry.first] = action;
+                resolvedVerb = &resolvedVerbs.emplace_back();
+                resolvedVerb->verb = prioritizedActions.verbSymbol;
             }
+            resolvedVerb->candidates.push_back(index);
         }
     }
+    nounToResolvedVerbs[nounSymbol] = &resolvedVerbs;
+    return resolvedVerbs;
 }
 
 void ActionManager::OnActionBarCanceled()
@@ -967,7 +1018,7 @@ void ActionManager::ExecuteActionInternal(const Action* action, std::function<vo
     // We should only execute one action at a time.
     if(mCurrentAction != nullptr)
     {
-        gReportManager.Log("Actions", StringUtil::Format("Skipping NVC %s - another action is in progress", action->ToString().c_str()));
+        gReportManager.Logf(GetActionsStream(), "Skipping NVC %s - another action is in progress", action->ToString().c_str());
         return;
     }
     mCurrentAction = action;
@@ -978,7 +1029,7 @@ void ActionManager::ExecuteActionInternal(const Action* action, std::function<vo
     // This is conditional b/c scene actions are actually logged earlier (before the approach finishes).
     if(log)
     {
-        gReportManager.Log("Actions", StringUtil::Format("Playing NVC %s", action->ToString().c_str()));
+        gReportManager.Logf(GetActionsStream(), "Playing NVC %s", action->ToString().c_str());
     }
 
     // Increment action ID.
@@ -1021,16 +1072,17 @@ void ActionManager::OnActionExecuteFinished()
     if(gVerbManager.IsTopic(mLastAction->verb))
     {
         // Increment topic count automatically.
-        gGameProgress.IncTopicCount(mLastAction->noun, mLastAction->verb);
+        gGameProgress.IncTopicCount(mLastAction->nounSymbol, mLastAction->verbSymbol);
 
         // Make a record that this topic action was performed.
         mPlayedTopics[mLastAction->noun][mLastAction->verb].insert(mLastAction->caseLabel);
     }
 
     // If this is a chat, automatically increment chat counts.
-    if(StringUtil::EqualsIgnoreCase(mLastAction->verb, "Z_CHAT"))
+    static const Symbol kChatVerb("Z_CHAT");
+    if(mLastAction->verbSymbol == kChatVerb)
     {
-        gGameProgress.IncChatCount(mLastAction->noun);
+        gGameProgress.IncChatCount(mLastAction->nounSymbol);
     }
 
     // Execute finish callback if specified.
@@ -6,6 +6,7 @@
 // Also provides an API for showing the action bar and executing actions.
 //
 #pragma once
+#include <deque>
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -14,6 +15,7 @@
 #include "NVC.h"
 #include "PersistState.h"
 #include "StringUtil.h"
+#include "Symbol.h"
 
 class ActionBar;
 class GKActor;
@@ -122,6 +124,37 @@ private:
     // Think of this like a lookup - map[noun] gives you all the actions for that noun, map[noun][verb] gives all actions for that noun/verb, etc.
     std::string_map_ci<std::string_map_ci<std::string_map_ci<Action*>>> mActions;
 
+    // Resolving which action to use is done VERY often (hovering the mouse over objects, opening the action bar, checking for topics).
+    // Much of that work depends only on what action sets are loaded, so it's done once (and cached) rather than on every query.
+    // The index is rebuilt on the next query after action sets change.
+    mutable bool mActionIndexDirty = false;
+
+    // A noun/verb combo's actions, sorted by case priority. The first action whose case is met is the one to use.
+    struct PrioritizedActions
+    {
+        std::string noun;
+        std::string verb;
+        Symbol verbSymbol;
+        std::vector<Action*> actions;
+    };
+    mutable std::vector<PrioritizedActions> mPrioritizedActions;
+
+    // For each noun, indexes of its noun/verb combos in the prioritized actions list.
+    mutable SymbolMap<std::vector<int>> mNounToPrioritizedActions;
+
+    // For a noun passed to GetActions, a verb that may be shown, and the noun/verb combos that could supply its action.
+    // A noun may also match wildcard (ANY_OBJECT) or group nouns, so there can be several candidates. Highest precedence comes first.
+    struct ResolvedVerb
+    {
+        Symbol verb;
+        std::vector<int> candidates;
+    };
+
+    // Resolved verbs for each queried noun, one map per verb type. Built the first time a noun is queried.
+    // The verb lists are stored in a deque, so they stay put if a query causes another noun to be resolved.
+    mutable std::deque<std::vector<ResolvedVerb>> mResolvedVerbs;
+    mutable SymbolMap<const std::vector<ResolvedVerb>*> mNounToResolvedVerbs[3];
+
     // An action may specify a "case" under which it is valid.
     // A case label corresponds to a bit of SheepScript that evaluates to either true or false.
     // Cases must be stored here (rather than in Action Sets) because cases can be shared (especially global/inventory ones).
@@ -189,11 +222,18 @@ private:
     bool IsActionSetForTimeblock(const std::string& assetName, const Timeblock& timeblock);
 
     // Returns true if the case for an action is met. A case can be a global condition, or some user-defined script to evaluate.
-    bool IsCaseMet(const std::string& noun, const std::string& verb, const std::string& caseLabel, VerbType verbType = VerbType::Normal) const;
+    bool IsCaseMet(const Action& action, VerbType verbType = VerbType::Normal) const;
 
-    // Populates provided map with actions that are valid for the given noun.
+    // Builds the prioritized actions for loaded action sets, if they've changed since the last query.
+    void UpdateActionIndex() const;
+    int GetCasePriority(const std::string& caseLabel) const;
+
+    // Finds the highest priority action whose case is met for a noun/verb combo.
     Action* GetHighestPriorityAction(const std::string& noun, const std::string& verb, VerbType verbType) const;
-    void AddActionsToMap(const std::string& noun, VerbType verbType, std::unordered_map<std::string, const Action*>& map) const;
+    Action* GetHighestPriorityAction(const PrioritizedActions& prioritizedActions, VerbType verbType) const;
+
+    // Gets each verb that may be used with the given noun, along with candidate actions for that verb.
+    const std::vector<ResolvedVerb>& GetResolvedVerbs(const std::string& noun, VerbType verbType) const;
 
     // Called when action bar is canceled (press cancel button).
     void OnActionBarCanceled();
@@ -102,35 +102,31 @@ void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
     }
 
     // Main section contains all the Noun/Verb/Cases on individual lines.
-    IniSection mainSection = parser.GetSection("");
+    IniSectionView mainSection = parser.GetSectionView("");
     for(auto& line : mainSection.lines)
     {
         Action action;
         action.type = type;
 
         // The first entry is the noun.
-        IniKeyValue& first = line.entries.front();
+        const IniKeyValueView& first = line.entries.front();
         action.noun = first.key;
 
         // Second entry is the verb.
-        IniKeyValue& second = line.entries[1];
+        const IniKeyValueView& second = line.entries[1];
         action.verb = second.key;
 
         // Third entry is always the case (requires a bit of trimming/conditioning sometimes).
-        IniKeyValue& third = line.entries[2];
-        std::string caseLabel = third.key;
-        StringUtil::RemoveAll(caseLabel, '\t'); //TODO: Still needed? We also do this in IniParser layer now.
-        StringUtil::Trim(caseLabel);
+        std::string_view caseLabel = line.entries[2].key;
+        StringUtil::TrimWhitespace(caseLabel);
         action.caseLabel = caseLabel;
+        action.InternSymbols();
 
         // From here, we have some optional stuff.
         for(size_t i = 3; i < line.entries.size(); ++i)
         {
-            IniKeyValue& keyValue = line.entries[i];
-
-            //TODO: Still needed? We also do this in IniParser layer now.
-            StringUtil::RemoveAll(keyValue.key, '\t');
-            StringUtil::Trim(keyValue.key);
+            IniKeyValueView keyValue = line.entries[i];
+            StringUtil::TrimWhitespace(keyValue.key);
 
             if(StringUtil::EqualsIgnoreCase(keyValue.key, "Approach"))
             {
@@ -172,7 +168,7 @@ void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
                 else
                 {
-                    LOG_WARNING("In NVC %s, invalid approach: %s", mName.c_str(), keyValue.value.c_str());
+                    LOG_WARNING("In NVC %s, invalid approach: %s", mName.c_str(), std::string(keyValue.value).c_str());
                 }
             }
             else if(StringUtil::StartsWithIgnoreCase(keyValue.key, "Targe")) // accommodates typo in at least one NVC file
@@ -198,7 +194,7 @@ void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
 
                 // Compile and save script.
-                action.script.script = gSheepManager.Compile("Case Evaluation", action.script.text);
+                action.script.script = gSheepManager.CompileAssetSheep("Case Evaluation", action.script.text);
             }
         }
 
@@ -232,16 +228,12 @@ void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
     // Some "CASE" values are special, and handled by the system (like ALL, GABE_ALL, GRACE_ALL)
     // But an NVC item can also specify a custom case value. In that case,
     // this section maps the case value to a sheep expression to evaluate, to see whether the case is met.
-    IniSection logicSection = parser.GetSection("LOGIC");
+    IniSectionView logicSection = parser.GetSectionView("LOGIC");
     for(auto& line : logicSection.lines)
     {
         // Only add this case entry if it isn't a duplicate entry.
-        IniKeyValue& first = line.entries.front();
-        std::string caseLabel = first.key;
-
-        // We need to trim the case label to get the right label value.
-        // These are often formatted as "CASE    = blah" (note the extra whitespaces after the case label).
-        StringUtil::Trim(caseLabel); //TODO: Still needed?
+        const IniKeyValueView& first = line.entries.front();
+        std::string caseLabel(first.key);
 
         // Add case to dictionary, if not already in there.
         // Multiple cases are considered an error - only the first is kept.
@@ -250,7 +242,7 @@ void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
         {
             SheepScriptAndText caseLogic;
             caseLogic.text = first.value;
-            caseLogic.script = gSheepManager.CompileEval(first.value);
+            caseLogic.script = gSheepManager.CompileAssetEval(caseLogic.text);
             mCaseLogic[caseLabel] = caseLogic;
         }
         else
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "StringUtil.h"
+#include "Symbol.h"
 
 class GKActor;
 class SheepScript;
@@ -47,6 +48,12 @@ struct Action
     // Or, it can refer to a hard-coded global condition (e.g. ALL, GABE_ALL, GRACE_ALL).
     std::string caseLabel;
 
+    // Noun, verb, and case as symbols, interned when the action is created.
+    // Noun/verb counts and global case checks use these, so they don't need to look up the names on every query.
+    Symbol nounSymbol;
+    Symbol verbSymbol;
+    Symbol caseSymbol;
+
     // If desired, an approach can be specified. Ego will "approach" the target
     // before executing the associated script.
     enum class Approach
@@ -76,6 +83,13 @@ struct Action
     // In some cases, this is relevant to resolve conflicts between actions. A more specific action overrides a global action for example.
     ActionType type = ActionType::Global;
 
+    void InternSymbols()
+    {
+        nounSymbol = Symbol(noun);
+        verbSymbol = Symbol(verb);
+        caseSymbol = Symbol(caseLabel);
+    }
+
     std::string ToString() const { return "'" + noun + ":" + verb + ":" + caseLabel + "': " + script.text; }
 };
 
@@ -1,5 +1,7 @@
 #include "Walker.h"
 
+#include <cfloat>
+
 #include "ActionManager.h"
 #include "Actor.h"
 #include "Animation.h"
@@ -39,6 +41,9 @@ Walker::Walker(Actor* owner) : Component(owner),
 
 Walker::~Walker()
 {
+    // Any path still being found is no longer needed.
+    CancelPendingWalk();
+
     // To remove this walker from the walker boundary.
     SetWalkerBoundary(nullptr);
 }
@@ -99,6 +104,8 @@ void Walker::WalkToGas(const Vector3& position, const Heading& heading, const st
 
 void Walker::WalkToSee(GKObject* target, const std::function<void()>& finishCallback)
 {
+    // This walk replaces any walk that's still waiting for a path.
+    CancelPendingWalk();
     mWalkToSeeTarget = target;
 
     // Be sure to save finish callback in this case - it usually happens in walk to.
@@ -188,6 +195,13 @@ void Walker::SkipToEnd(bool alsoSkipWalkEndAnim)
 {
     if(!mAllowWalkSkip) { return; }
 
+    // Can't skip to the end of a path we don't have yet! Wait for the path, so we know where the walk ends.
+    if(mPendingWalk.pathRequest != nullptr)
+    {
+        WalkerBoundary::WaitForPath(*mPendingWalk.pathRequest);
+        StartPendingWalk();
+    }
+
     // If not walking, or at the end of the walk, nothing to skip.
     WalkOp currentWalkOp = GetCurrentWalkOp();
     if(currentWalkOp == WalkOp::None)
@@ -274,6 +288,9 @@ void Walker::StopWalk()
     mWalkActions.clear();
     mPrevWalkOp = WalkOp::None;
 
+    // Nor do we need a path for any pending walk.
+    CancelPendingWalk();
+
     // No more finish callback needed
     mFinishedPathCallback = nullptr;
 
@@ -357,15 +374,27 @@ void Walker::OnUpdate(float deltaTime)
         }
     }
 
+    // If the path for a pending walk has been found, the walk can begin.
+    if(mPendingWalk.pathRequest != nullptr && mPendingWalk.pathRequest->IsDone())
+    {
+        StartPendingWalk();
+    }
+
     // Process outstanding walk actions.
     WalkOp currentWalkOp = GetCurrentWalkOp();
-    if(currentWalkOp != WalkOp::None)
+    if(currentWalkOp != WalkOp::None || mPendingWalk.pathRequest != nullptr)
     {
         // Kind of a HACK: if we're walking, and action manager is skipping, move to end of movement ASAP.
         // Without this, walks during fast-forwards can get stuck and cause the game to freeze.
         //TODO: *Probably* a better way to handle this, with a substantial refactor...
         if(gActionManager.IsSkippingCurrentAction() && mAllowWalkSkip)
         {
+            // A pending walk skips straight to the destination once the path is found.
+            if(mPendingWalk.pathRequest != nullptr)
+            {
+                WalkerBoundary::WaitForPath(*mPendingWalk.pathRequest);
+                StartPendingWalk();
+            }
             SkipToEnd(true);
             return;
         }
@@ -377,7 +406,11 @@ void Walker::OnUpdate(float deltaTime)
         mGKOwner->SnapToFloor();
 
         // Handle the current walk action.
-        if(currentWalkOp == WalkOp::FollowPathStart)
+        if(mPath.empty() && mPendingWalk.pathRequest != nullptr)
+        {
+            // Still waiting on a path to follow (though the walk start anim may be playing in the meantime).
+        }
+        else if(currentWalkOp == WalkOp::FollowPathStart)
         {
             // Possible to finish path while still in the start phase, for very short paths.
             if(AdvancePath())
@@ -485,70 +518,135 @@ void Walker::WalkToInternal(const Vector3& position, const Heading& heading, con
     // Save if from autoscript.
     mFromAutoscript = fromAutoscript;
 
-    // Save finish callback.
-    mFinishedPathCallback = finishCallback;
-
-    // Time to create a new walk plan.
-    WalkOp currentWalkOp = GetCurrentWalkOp();
-    mWalkActions.clear();
+    // A new walk replaces any walk that's still waiting for a path.
+    CancelPendingWalk();
 
     // Make sure the passed in position is *actually* the position we will walk to.
     // Sometimes the position given is under the floor or floating in the air - ground it.
     Vector3 walkPosition = position;
     walkPosition.y = gSceneManager.GetScene()->GetFloorY(position);
 
+    // Save everything needed to create the walk plan once a path is found.
+    mPendingWalk.walkPosition = walkPosition;
+    mPendingWalk.heading = heading;
+    mPendingWalk.finishCallback = finishCallback;
+    mPendingWalk.mustReachDestination = mustReachDestination;
+    mPendingWalk.needsToWalk = !AtPosition(walkPosition);
+    mPendingWalk.startPos = GetOwner()->GetPosition();
+    mPendingWalk.endPos = walkPosition;
+
+    // If we have a walk-to-see target, apply a slight bias towards walking to be "in front" of the thing.
+    // This helps in scenarios where the character should be looking at a surface, such as a painting or panel in the Museum.
+    if(mWalkToSeeTarget != nullptr)
+    {
+        mPendingWalk.endPos = walkPosition + mWalkToSeeTarget->GetForward() * 5.0f;
+    }
+
+    // If we need to walk, find a path. On a big walker boundary, this can take long enough to cause a hitch, so it's done on a background thread.
+    // No need if action skipping though - in that case, the walker goes directly to the destination.
+    bool skipping = gActionManager.IsSkippingCurrentAction() && mAllowWalkSkip;
+    if(mPendingWalk.needsToWalk && mWalkerBoundary != nullptr && !skipping)
+    {
+        // The walker boundary leaves us out of the path calculation, so we don't try to path around ourselves.
+        mPendingWalk.pathRequest = mWalkerBoundary->FindPathAsync(mPendingWalk.startPos, mPendingWalk.endPos, this);
+
+        // Until the new walk begins, the callback for any walk in progress is no longer valid.
+        mFinishedPathCallback = nullptr;
+
+        // The path is usually found on a later frame (Update checks for it). Without worker threads though, it's already done.
+        if(!mPendingWalk.pathRequest->IsDone())
+        {
+            // Any walk already in progress just keeps going until the path is found.
+            // But if we're standing still, start the walk now (with the walk start anim), so the walker reacts to the click right away.
+            WalkOp currentWalkOp = GetCurrentWalkOp();
+            if(currentWalkOp == WalkOp::None || currentWalkOp == WalkOp::TurnToFace)
+            {
+                mWalkActions.clear();
+                mWalkActions.push_back(WalkOp::FollowPathEnd);
+                mWalkActions.push_back(WalkOp::FollowPath);
+                mWalkActions.push_back(ChooseWalkStartOp(mPendingWalk.endPos));
+                OutputWalkerPlan();
+                NextAction();
+            }
+            return;
+        }
+    }
+    StartPendingWalk();
+}
+
+void Walker::StartPendingWalk()
+{
+    // This walk is no longer pending.
+    PendingWalk walk = std::move(mPendingWalk);
+    mPendingWalk = PendingWalk();
+
+    // Save finish callback.
+    mFinishedPathCallback = walk.finishCallback;
+
+    // Time to create a new walk plan.
+    WalkOp currentWalkOp = GetCurrentWalkOp();
+    mWalkActions.clear();
+
     // If action skipping, we don't need to find a path or do anything - just put the walker directly at the desired position/heading!
     if(gActionManager.IsSkippingCurrentAction() && mAllowWalkSkip)
     {
         StopAllWalkAnimations();
-        mGKOwner->SetPosition(walkPosition);
-        if(heading.IsValid())
+        mPath.clear();
+        mGKOwner->SetPosition(walk.walkPosition);
+        if(walk.heading.IsValid())
         {
-            mGKOwner->SetHeading(heading);
+            mGKOwner->SetHeading(walk.heading);
         }
-        if(finishCallback != nullptr)
+        if(walk.finishCallback != nullptr)
         {
-            finishCallback();
+            walk.finishCallback();
         }
         return;
     }
 
     // If heading is specified, save "turn to face" action.
-    if(heading.IsValid())
+    if(walk.heading.IsValid())
     {
-        mTurnToFaceDir = heading.ToDirection();
+        mTurnToFaceDir = walk.heading.ToDirection();
         mWalkActions.push_back(WalkOp::TurnToFace);
     }
 
     // Do we need to walk?
-    if(!AtPosition(walkPosition))
+    if(walk.needsToWalk)
     {
+        // Use the path that was found, if any.
         mPath.clear();
-
-        // Attempt to find a path between current position and walk position.
-        Vector3 startPos = GetOwner()->GetPosition();
-        Vector3 endPos = walkPosition;
-
-        // If we have a walk-to-see target, apply a slight bias towards walking to be "in front" of the thing.
-        // This helps in scenarios where the character should be looking at a surface, such as a painting or panel in the Museum.
-        if(mWalkToSeeTarget != nullptr)
+        if(walk.pathRequest != nullptr)
         {
-            endPos = walkPosition + mWalkToSeeTarget->GetForward() * 5.0f;
+            mPath = std::move(walk.pathRequest->path);
         }
 
-        // Actually do the pathfinding!
-        if(mWalkerBoundary != nullptr)
+        // The path starts where the walker was when the walk was requested.
+        // But if the path took a while, the walker may have moved since then (continuing a previous walk, or playing the walk start anim).
+        // In that case, join the path at the node nearest to where the walker is now, rather than walking back to the old start position.
+        Vector3 startPos = GetOwner()->GetPosition();
+        if(!mPath.empty() && !AtPosition(walk.startPos))
         {
-            // Remove ourselves from the walker boundary temporarily so we don't try to path around ourselves.
-            // This seems like a HACK, but it might be a fine solution. Alternative is to pass "this" as an argument to FindPath.
-            mWalkerBoundary->RemoveWalker(this);
-
-            // Find the path.
-            mWalkerBoundary->FindPath(startPos, endPos, mPath);
+            size_t nearestIndex = mPath.size() - 1;
+            float nearestDistSq = FLT_MAX;
+            for(size_t i = 0; i < mPath.size(); ++i)
+            {
+                Vector3 toNode = mPath[i] - startPos;
+                toNode.y = 0.0f;
+                float distSq = toNode.GetLengthSq();
+                if(distSq < nearestDistSq)
+                {
+                    nearestIndex = i;
+                    nearestDistSq = distSq;
+                }
+            }
 
-            // Add ourselves back to the walker boundary.
-            mWalkerBoundary->AddWalker(this);
+            // Path is stored end-to-start, so nodes after the nearest one are the part we no longer need to walk.
+            mPath.erase(mPath.begin() + nearestIndex + 1, mPath.end());
+            mPath.push_back(startPos);
         }
+        Vector3 endPos = walk.endPos;
+        bool mustReachDestination = walk.mustReachDestination;
 
         // Whether a path was found or not actually isn't that important here - even when a path isn't found, mPath contains a "best effort" to get close to the goal.
         // What IS important is whether we MUST reach the goal or if "best effort" is good enough.
@@ -658,33 +756,7 @@ void Walker::WalkToInternal(const Vector3& position, const Heading& heading, con
             if(!skippedStartPathNodes)
             {
                 // Need to decide which start anim to play.
-                WalkOp startOp = WalkOp::FollowPathStart;
-                bool hasTurnToStartAnims = mWalkStartTurnLeftAnim != nullptr && mWalkStartTurnRightAnim != nullptr;
-                if(hasTurnToStartAnims)
-                {
-                    Vector3 currToGoal = (mPath.front() - GetOwner()->GetPosition());
-                    if(currToGoal.GetLengthSq() > 30.0f * 30.0f)
-                    {
-                        Vector3 toGoal = currToGoal.Normalize();
-                        if(Vector3::Dot(GetOwner()->GetForward(), toGoal) <= 0.0f)
-                        {
-                            // For initial direction to turn, let's use the goal node direction.
-                            // Just thinking about the real world...you usually turn towards your goal, right?
-                            Vector3 cross = Vector3::Cross(GetOwner()->GetForward(), toGoal);
-                            if(cross.y > 0)
-                            {
-                                startOp = WalkOp::FollowPathStartTurnRight;
-                            }
-                            else
-                            {
-                                startOp = WalkOp::FollowPathStartTurnLeft;
-                            }
-                        }
-                    }
-                }
-
-                // Ok, we chose a start walk op.
-                mWalkActions.push_back(startOp);
+                mWalkActions.push_back(ChooseWalkStartOp(mPath.front()));
             }
         }
     }
@@ -697,7 +769,23 @@ void Walker::WalkToInternal(const Vector3& position, const Heading& heading, con
         // When the current walk start anim finishes, it will continue the walk with the new path.
         if(currentWalkOp >= WalkOp::FollowPathStart && currentWalkOp <= WalkOp::FollowPathStartTurnRight)
         {
-            doNextAction = false;
+            WalkOp newWalkOp = GetCurrentWalkOp();
+            bool newWalkHasStart = newWalkOp >= WalkOp::FollowPathStart && newWalkOp <= WalkOp::FollowPathStartTurnRight;
+            if(newWalkHasStart && !walk.startAnimFinished)
+            {
+                doNextAction = false;
+            }
+            else if(newWalkHasStart)
+            {
+                // The start anim already finished while waiting for the path, so go right to following the path.
+                mWalkActions.pop_back();
+            }
+            else
+            {
+                // The new walk doesn't start with a start anim (e.g. no walk needed after all), so the one playing must stop.
+                StopAllWalkAnimations();
+                gSceneManager.GetScene()->GetAnimator()->Sample(mWalkStartAnim, 0);
+            }
         }
 
         // We are already walking.
@@ -765,12 +853,7 @@ void Walker::NextAction()
         animParams.allowMove = true;
         animParams.parent = mGKOwner->GetMeshRenderer()->GetOwner();
         animParams.fromAutoScript = mFromAutoscript;
-        gSceneManager.GetScene()->GetAnimator()->Start(animParams, [this](){
-            if(!mWalkActions.empty() && mWalkActions.back() <= WalkOp::FollowPathStartTurnRight)
-            {
-                PopAndNextAction();
-            }
-        });
+        gSceneManager.GetScene()->GetAnimator()->Start(animParams, std::bind(&Walker::OnWalkStartAnimFinished, this));
     }
     else if(currentWalkOp == WalkOp::FollowPathStartTurnLeft)
     {
@@ -783,12 +866,7 @@ void Walker::NextAction()
         animParams.allowMove = true;
         animParams.parent = mGKOwner->GetMeshRenderer()->GetOwner();
         animParams.fromAutoScript = mFromAutoscript;
-        gSceneManager.GetScene()->GetAnimator()->Start(animParams, [this](){
-            if(!mWalkActions.empty() && mWalkActions.back() <= WalkOp::FollowPathStartTurnRight)
-            {
-                PopAndNextAction();
-            }
-        });
+        gSceneManager.GetScene()->GetAnimator()->Start(animParams, std::bind(&Walker::OnWalkStartAnimFinished, this));
     }
     else if(currentWalkOp == WalkOp::FollowPathStartTurnRight)
     {
@@ -801,12 +879,7 @@ void Walker::NextAction()
         animParams.allowMove = true;
         animParams.parent = mGKOwner->GetMeshRenderer()->GetOwner();
         animParams.fromAutoScript = mFromAutoscript;
-        gSceneManager.GetScene()->GetAnimator()->Start(animParams, [this](){
-            if(!mWalkActions.empty() && mWalkActions.back() <= WalkOp::FollowPathStartTurnRight)
-            {
-                PopAndNextAction();
-            }
-        });
+        gSceneManager.GetScene()->GetAnimator()->Start(animParams, std::bind(&Walker::OnWalkStartAnimFinished, this));
     }
     else if(currentWalkOp == WalkOp::FollowPath)
     {
@@ -863,6 +936,62 @@ void Walker::NextAction()
     }
 }
 
+void Walker::OnWalkStartAnimFinished()
+{
+    // Ignore if the walk plan has since moved on from the walk start.
+    if(mWalkActions.empty() || mWalkActions.back() > WalkOp::FollowPathStartTurnRight) { return; }
+
+    // If we're still waiting for the path, the walk can't continue yet. Remember that the start anim is done, so the walk picks up from here when it arrives.
+    if(mPath.empty() && mPendingWalk.pathRequest != nullptr)
+    {
+        mPendingWalk.startAnimFinished = true;
+        return;
+    }
+    PopAndNextAction();
+}
+
+void Walker::CancelPendingWalk()
+{
+    if(mPendingWalk.pathRequest != nullptr)
+    {
+        mPendingWalk.pathRequest->canceled = true;
+    }
+
+    // If a walk start anim finished while waiting, remember that - a replacement walk will continue from it.
+    WalkOp currentWalkOp = GetCurrentWalkOp();
+    bool startAnimFinished = mPendingWalk.startAnimFinished && currentWalkOp >= WalkOp::FollowPathStart && currentWalkOp <= WalkOp::FollowPathStartTurnRight;
+    mPendingWalk = PendingWalk();
+    mPendingWalk.startAnimFinished = startAnimFinished;
+}
+
+Walker::WalkOp Walker::ChooseWalkStartOp(const Vector3& goal) const
+{
+    bool hasTurnToStartAnims = mWalkStartTurnLeftAnim != nullptr && mWalkStartTurnRightAnim != nullptr;
+    if(hasTurnToStartAnims)
+    {
+        Vector3 currToGoal = (goal - GetOwner()->GetPosition());
+        if(currToGoal.GetLengthSq() > 30.0f * 30.0f)
+        {
+            Vector3 toGoal = currToGoal.Normalize();
+            if(Vector3::Dot(GetOwner()->GetForward(), toGoal) <= 0.0f)
+            {
+                // For initial direction to turn, let's use the goal node direction.
+                // Just thinking about the real world...you usually turn towards your goal, right?
+                Vector3 cross = Vector3::Cross(GetOwner()->GetForward(), toGoal);
+                if(cross.y > 0)
+                {
+                    return WalkOp::FollowPathStartTurnRight;
+                }
+                else
+                {
+                    return WalkOp::FollowPathStartTurnLeft;
+                }
+            }
+        }
+    }
+    return WalkOp::FollowPathStart;
+}
+
 void Walker::OnWalkToFinished()
 {
     #if defined(DEBUG_WALKER)
@@ -872,6 +1001,9 @@ void Walker::OnWalkToFinished()
     // No more path.
     mPath.clear();
 
+    // If a new walk is waiting for a path, it isn't finished yet - the callback is for when that walk is done.
+    if(mPendingWalk.pathRequest != nullptr) { return; }
+
     // No more target.
     mWalkToSeeTarget = nullptr;
 
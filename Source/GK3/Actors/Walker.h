@@ -10,8 +10,10 @@
 #include "Component.h"
 
 #include <functional>
+#include <memory>
 #include <vector>
 
+#include "Heading.h"
 #include "Vector3.h"
 
 class Animation;
@@ -19,11 +21,11 @@ struct CharacterConfig;
 class GKActor;
 class GKObject;
 class GKProp;
-class Heading;
 class PersistState;
 class Texture;
 class VertexAnimation;
 class WalkerBoundary;
+struct WalkerPathRequest;
 
 class Walker : public Component
 {
@@ -49,8 +51,8 @@ public:
     void StopWalk();
 
     bool AtPosition(const Vector3& position, float maxDistance = kAtNodeDist);
-    bool IsWalking() const { return !mWalkActions.empty(); }
-    bool IsWalkingExceptTurn() const { return IsWalking() && mWalkActions.back() != WalkOp::TurnToFace; }
+    bool IsWalking() const { return !mWalkActions.empty() || mPendingWalk.pathRequest != nullptr; }
+    bool IsWalkingExceptTurn() const { return IsWalking() && GetCurrentWalkOp() != WalkOp::TurnToFace; }
     Vector3 GetDestination() const { return !mPath.empty() ? mPath.front() : Vector3::Zero; }
 
     bool IsWalkAnimation(VertexAnimation* vertexAnim) const;
@@ -140,17 +142,43 @@ private:
     // Only use case is the demon in the final fight so far.
     bool mAllowWalkSkip = true;
 
+    // PATHFINDING
+    // Paths are found on a background thread. Until the path arrives, the new walk is "pending."
+    // Meanwhile, any walk already in progress continues, or the walk start anim plays if we were standing still.
+    struct PendingWalk
+    {
+        // The path being found. Null if no walk is pending.
+        std::shared_ptr<WalkerPathRequest> pathRequest;
+
+        // The walk parameters, used to create the walk plan once the path is found.
+        Vector3 walkPosition;
+        Heading heading = Heading::None;
+        std::function<void()> finishCallback;
+        bool mustReachDestination = false;
+        bool needsToWalk = false;
+        Vector3 startPos;
+        Vector3 endPos;
+
+        // True if the walk start anim finished before the path was found.
+        bool startAnimFinished = false;
+    };
+    PendingWalk mPendingWalk;
+
     // REGION SUPPORT
     // A callback for exiting a region.
     int mExitRegionIndex = -1;
     std::function<void()> mExitRegionCallback = nullptr;
 
     void WalkToInternal(const Vector3& position, const Heading& heading, const std::function<void()>& finishCallback, bool fromAutoscript, bool mustReachDestination);
+    void StartPendingWalk();
+    void CancelPendingWalk();
+    WalkOp ChooseWalkStartOp(const Vector3& goal) const;
 
     void PopAndNextAction();
     void NextAction();
 
     WalkOp GetCurrentWalkOp() const { return mWalkActions.empty() ? WalkOp::None : mWalkActions.back(); }
+    void OnWalkStartAnimFinished();
     void OnWalkToFinished();
 
     bool IsWalkToSeeTargetInView(Vector3& outTurnToFaceDir) const;
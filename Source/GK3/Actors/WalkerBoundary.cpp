@@ -1,9 +1,12 @@
 #include "WalkerBoundary.h"
 
+#include <algorithm>
+#include <cmath>
 #include <queue>
 
 #include "Actor.h"
 #include "Debug.h"
+#include "DistanceTransform.h"
 #include "GMath.h"
 #include "PersistState.h"
 #include "ResizableQueue.h"
@@ -12,6 +15,17 @@
 
 namespace
 {
+    // Path nodes are moved away from walls until they're at least this far (in pixels) from one, if possible.
+    const float kWallClearance = 4.0f;
+
+    // When straightening paths, a straight line isn't used if it passes closer than this (in pixels) to a wall.
+    const float kShortcutClearance = 2.0f;
+
+    bool IsCanceled(const std::atomic<bool>* canceled)
+    {
+        return canceled != nullptr && canceled->load(std::memory_order_relaxed);
+    }
+
     void MoveToward(Vector2& current, const Vector2& end)
     {
         // Move current toward end, one unit at a time.
@@ -32,9 +46,77 @@ namespace
             current.y -= 1;
         }
     }
+
+    Vector2 WorldPosToTexturePos(const Vector3& worldPos, const Vector2& size, const Vector2& offset, uint32_t width, uint32_t height)
+    {
+        // Add walker boundary's world position offset.
+        // This causes the position to be relative to the texture's origin (lower left) instead of the world origin.
+        Vector2 texturePos;
+        texturePos.x = worldPos.x + offset.x;
+        texturePos.y = worldPos.z + offset.y;
+        //std::cout << "Offset Pos: " << position << std::endl;
+
+        // Divide position by walkable area size to get a normalized position within that area.
+        // Hopefully 0-1, but could be outside those bounds. If so, not walkable.
+        texturePos.x = texturePos.x / size.x;
+        texturePos.y = texturePos.y / size.y;
+        //std::cout << "Normalized Pos: " << position << std::endl;
+
+        // Multiply by texture width/height to determine the pixel within the texture.
+        texturePos.x = texturePos.x * width;
+        texturePos.y = texturePos.y * height;
+        //std::cout << "Pixel Pos: " << position << std::endl;
+
+        // Need to flip Y because the calculated value is from lower-left of the walkable area.
+        // But texture sample X/Y are from upper-left.
+        texturePos.y = height - texturePos.y;
+
+        // Texture positions are integers.
+        texturePos.x = (int)texturePos.x;
+        texturePos.y = (int)texturePos.y;
+        return texturePos;
+    }
+
+    Vector3 TexturePosToWorldPos(Vector2 texturePos, const Vector2& size, const Vector2& offset, uint32_t width, uint32_t height)
+    {
+        // A texture pos actually correlates to the bottom-left corner of the pixel.
+        // But we want center of pixel...so let's offset before the conversion!
+        texturePos.x = texturePos.x + 0.5f;
+        texturePos.y = texturePos.y + 0.5f;
+
+        // Flip y because texture pos is from top-left, but we need lower-left for world pos conversion.
+        texturePos.y = height - texturePos.y;
+
+        // Divide by texture width/height to get normalized position within the texture (0-1).
+        Vector3 worldPos;
+        worldPos.x = texturePos.x / width;
+        worldPos.z = texturePos.y / height;
+
+        // Multiply by size to get unit in world space.
+        worldPos.x = worldPos.x * size.x;
+        worldPos.z = worldPos.z * size.y;
+
+        // Subtract offset to go from "texture space" to "world space".
+        worldPos.x = worldPos.x - offset.x;
+        worldPos.z = worldPos.z - offset.y;
+        return worldPos;
+    }
+
+    bool IsNearWalker(const Vector3& worldPos, const Vector3& walkerPos)
+    {
+        // Make y-pos equal so that we only consider distance on the x/z plane.
+        Vector3 toWalker = walkerPos - worldPos;
+        toWalker.y = 0.0f;
+
+        // Each walker's radius is about 10 units. There are outliers (like Chicken or Demon), but this mostly works.
+        // BUT we need to factor in the radius of this walker AND myself - so we actually use 20 here!
+        //TODO: If the radius differed per walker, we'd want to query the walkers and sum the radii.
+        const float kCombinedRadiiSq = 20.0f * 20.0f;
+        return toWalker.GetLengthSq() <= kCombinedRadiiSq;
+    }
 }
 
-bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath)
+bool WalkerBoundarySnapshot::FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath, int& nodeSkip, const std::atomic<bool>* canceled) const
 {
     // Make sure path vector is empty.
     outPath.clear();
@@ -72,16 +154,23 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
     // The loop here is to try using sparser graphs (and save a lot of time) if we can.
     // In a complex scene with a large walker boundary texture, the number of grid nodes is very large (170k in one case).
     // Usually, the system can successfully find a path when skipping a lot of those nodes. But worst case, we can use all nodes.
+    // The texture-space path is only needed until it's converted to world positions below, so use frame memory for it.
     bool foundPath = false;
-    std::vector<Vector2> path;
+    std::frame_vector<Vector2> path;
     while(!foundPath)
     {
-        foundPath = FindPathBFS(start, goal, path, mPathfindingNodeSkip);
+        foundPath = FindPathBFS(start, goal, path, nodeSkip, canceled);
+        if(IsCanceled(canceled))
+        {
+            // Nobody wants this path anymore, so don't bother finishing it.
+            outPath.clear();
+            return false;
+        }
         if(!foundPath)
         {
-            if(mPathfindingNodeSkip > 1)
+            if(nodeSkip > 1)
             {
-                mPathfindingNodeSkip /= 2;
+                nodeSkip /= 2;
             }
             else
             {
@@ -105,78 +194,37 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
             if(i >= path.size() - kFuzzyIgnore) { continue; }
             if(i < kFuzzyIgnore) { break; }
 
-            // Palette indexes on walker boundary textures provide some indication of how "walkable" the current position is.
-            // Palette index 255 (black) is completely unwalkable, and should already have been discarded by the BFS.
-            // Palette indexes 127 or less are walkable, but a lower index is preferrable if available.
-            // Palette indexes 128 or greater are conditionally walkable (the game can turn them on or off). But if walkable, they should be considered walkable as-is (BFS figures that out).
-
-            // ANYWAY, here's the idea: if the current index is less than 128, see if a neighbor is a lower palette index.
-            // If so, we will want to walk there instead. If no, this is a less than ideal place to walk, but at least it is walkable.
-            int index = mTexture->GetPixelPaletteIndex(path[i].x, path[i].y);
-            if(index < 128)
+            // Walking right along walls looks odd, so push the node away from walls until it's a comfortable distance away.
+            // The distance field increases away from walls, so just keep moving to the neighbor farthest from a wall.
+            // This stops when far enough away, or when no neighbor is any farther (e.g. in the middle of a narrow corridor).
+            // Nodes in special regions (palette index 128 or greater) are left alone, since being in the region may be the point.
+            if(mField == nullptr || !IsInBounds(path[i].x, path[i].y) || GetPaletteIndex(path[i].x, path[i].y) >= 128) { continue; }
+            float distance = mField->GetSignedDistance(path[i].x, path[i].y);
+            while(distance < kWallClearance)
             {
-                while(true)
+                Vector2 farthest = path[i];
+                float farthestDistance = distance;
+                for(int y = -1; y <= 1; ++y)
                 {
-                    // If any up/down/left/right has a lower palette index, go there!
-                    if(mTexture->GetPixelPaletteIndex(path[i].x + 1, path[i].y) < index &&
-                       IsTexturePosWalkable(Vector2(path[i].x + 1, path[i].y)))
-                    {
-                        path[i].x += 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x - 1, path[i].y) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x - 1, path[i].y)))
-                    {
-                        path[i].x -= 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x, path[i].y + 1) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x, path[i].y + 1)))
-                    {
-                        path[i].y += 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x, path[i].y - 1) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x, path[i].y - 1)))
+                    for(int x = -1; x <= 1; ++x)
                     {
-                        path[i].y -= 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x + 1, path[i].y + 1) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x + 1, path[i].y + 1)))
-                    {
-                        path[i].x += 1;
-                        path[i].y += 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x + 1, path[i].y - 1) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x + 1, path[i].y - 1)))
-                    {
-                        path[i].x += 1;
-                        path[i].y -= 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x - 1, path[i].y - 1) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x - 1, path[i].y - 1)))
-                    {
-                        path[i].x -= 1;
-                        path[i].y -= 1;
-                    }
-                    else if(mTexture->GetPixelPaletteIndex(path[i].x - 1, path[i].y + 1) < index &&
-                            IsTexturePosWalkable(Vector2(path[i].x - 1, path[i].y + 1)))
-                    {
-                        path[i].x -= 1;
-                        path[i].y += 1;
-                    }
-                    else
-                    {
-                        // No neighbor is more walkable, so break out of this loop.
-                        break;
-                    }
+                        Vector2 neighbor(path[i].x + x, path[i].y + y);
+                        if(!IsInBounds(neighbor.x, neighbor.y)) { continue; }
 
-                    // Update index being considered for next run through loop.
-                    index = mTexture->GetPixelPaletteIndex(path[i].x, path[i].y);
-
-                    // If the palette index is below some threshold, we're in an "acceptably walkable" zone, so we can stop iterating.
-                    if(index < 4)
-                    {
-                        break;
+                        float neighborDistance = mField->GetSignedDistance(neighbor.x, neighbor.y);
+                        if(neighborDistance > farthestDistance && IsTexturePosWalkable(neighbor))
+                        {
+                            farthest = neighbor;
+                            farthestDistance = neighborDistance;
+                        }
                     }
                 }
+                if(farthestDistance <= distance)
+                {
+                    break;
+                }
+                path[i] = farthest;
+                distance = farthestDistance;
             }
         }
 
@@ -203,14 +251,12 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
                         canWalk = false;
                         break;
                     }
-                    else
+                    else if(mField != nullptr && IsInBounds(current.x, current.y) && GetPaletteIndex(current.x, current.y) < 128 &&
+                            mField->GetSignedDistance(current.x, current.y) < kShortcutClearance)
                     {
-                        int paletteIndex = mTexture->GetPixelPaletteIndex(current.x, current.y);
-                        if(paletteIndex > 6 && paletteIndex < 128)
-                        {
-                            canWalk = false;
-                            break;
-                        }
+                        // Also don't cut corners right along walls - it looks like the walker is scraping along them.
+                        canWalk = false;
+                        break;
                     }
                 }
 
@@ -250,7 +296,7 @@ bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorl
     return foundPath;
 }
 
-Vector3 WalkerBoundary::FindNearestWalkablePosition(const Vector3& worldPos) const
+Vector3 WalkerBoundarySnapshot::FindNearestWalkablePosition(const Vector3& worldPos) const
 {
     // Easy case: the position provided is already walkable.
     if(IsWorldPosWalkable(worldPos)) { return worldPos; }
@@ -260,6 +306,140 @@ Vector3 WalkerBoundary::FindNearestWalkablePosition(const Vector3& worldPos) con
     return TexturePosToWorldPos(walkableTexturePos);
 }
 
+int WalkerBoundarySnapshot::GetRegionIndex(const Vector3& worldPos) const
+{
+    return GetRegionForTexturePos(WorldPosToTexturePos(worldPos));
+}
+
+WalkerBoundaryField::WalkerBoundaryField(std::shared_ptr<const std::vector<uint8_t>> paletteIndexes, uint32_t width, uint32_t height,
+                                         const std::bitset<256>& unwalkableRegions, const std::vector<Rect>& unwalkableRects) :
+    mPaletteIndexes(paletteIndexes),
+    mWidth(width),
+    mHeight(height),
+    mUnwalkableRegions(unwalkableRegions),
+    mUnwalkableRects(unwalkableRects)
+{
+    Build();
+}
+
+bool WalkerBoundaryField::Matches(const std::bitset<256>& unwalkableRegions, const std::vector<Rect>& unwalkableRects) const
+{
+    return mUnwalkableRegions == unwalkableRegions && mUnwalkableRects == unwalkableRects;
+}
+
+float WalkerBoundaryField::GetSignedDistance(uint32_t x, uint32_t y) const
+{
+    return mSignedDistances[y * mWidth + x];
+}
+
+bool WalkerBoundaryField::GetNearestWalkable(uint32_t x, uint32_t y, Vector2& outTexturePos) const
+{
+    uint32_t nearest = mNearestWalkable[y * mWidth + x];
+    if(nearest == DistanceTransform::kNoFeature) { return false; }
+    outTexturePos = Vector2(nearest % mWidth, nearest / mWidth);
+    return true;
+}
+
+void WalkerBoundaryField::Build()
+{
+    // Figure out which pixels are walkable.
+    uint32_t pixelCount = mWidth * mHeight;
+    std::vector<uint8_t> walkable(pixelCount);
+    std::vector<uint8_t> unwalkable(pixelCount);
+    for(uint32_t y = 0; y < mHeight; ++y)
+    {
+        for(uint32_t x = 0; x < mWidth; ++x)
+        {
+            uint32_t index = y * mWidth + x;
+            bool isWalkable = !mUnwalkableRegions[(*mPaletteIndexes)[index]];
+            for(size_t i = 0; i < mUnwalkableRects.size() && isWalkable; ++i)
+            {
+                isWalkable = !mUnwalkableRects[i].Contains(Vector2(x, y));
+            }
+            walkable[index] = isWalkable ? 1 : 0;
+            unwalkable[index] = isWalkable ? 0 : 1;
+        }
+    }
+
+    // For walkable pixels, find the distance to the nearest unwalkable pixel.
+    // Anything outside the texture is unwalkable too, so the texture's edge counts as well.
+    mSignedDistances.resize(pixelCount);
+    mNearestWalkable.resize(pixelCount);
+    std::vector<float> distancesSq(pixelCount);
+    DistanceTransform::Compute(unwalkable.data(), mWidth, mHeight, distancesSq.data(), mNearestWalkable.data());
+    for(uint32_t y = 0; y < mHeight; ++y)
+    {
+        for(uint32_t x = 0; x < mWidth; ++x)
+        {
+            uint32_t index = y * mWidth + x;
+            float edgeDistance = static_cast<float>(std::min(std::min(x + 1, mWidth - x), std::min(y + 1, mHeight - y)));
+            mSignedDistances[index] = std::min(std::sqrt(distancesSq[index]), edgeDistance);
+        }
+    }
+
+    // For unwalkable pixels, find the nearest walkable pixel (and distance to it).
+    DistanceTransform::Compute(walkable.data(), mWidth, mHeight, distancesSq.data(), mNearestWalkable.data());
+    for(uint32_t index = 0; index < pixelCount; ++index)
+    {
+        if(unwalkable[index] != 0)
+        {
+            mSignedDistances[index] = -std::sqrt(distancesSq[index]);
+        }
+    }
+}
+
+WalkerBoundary::WalkerBoundary() :
+    mPathfindingNodeSkip(std::make_shared<std::atomic<int>>(4))
+{
+
+}
+
+std::shared_ptr<WalkerPathRequest> WalkerBoundary::FindPathAsync(const Vector3& fromWorldPos, const Vector3& toWorldPos, const Walker* ignoreWalker)
+{
+    // The search runs against a snapshot, so it doesn't matter what happens to this boundary (or the walkers on it) in the meantime.
+    std::shared_ptr<WalkerPathRequest> request = std::make_shared<WalkerPathRequest>();
+    std::shared_ptr<const WalkerBoundarySnapshot> snapshot = std::make_shared<WalkerBoundarySnapshot>(CreateSnapshot(ignoreWalker));
+    std::shared_ptr<std::atomic<int>> nodeSkip = mPathfindingNodeSkip;
+    auto findPath = [request, snapshot, nodeSkip, fromWorldPos, toWorldPos]() {
+        // A lower node skip found by this search is remembered for later searches.
+        int requestNodeSkip = nodeSkip->load();
+        request->foundPath = snapshot->FindPath(fromWorldPos, toWorldPos, request->path, requestNodeSkip, &request->canceled);
+        if(requestNodeSkip < nodeSkip->load())
+        {
+            nodeSkip->store(requestNodeSkip);
+        }
+        request->done.store(true, std::memory_order_release);
+    };
+
+    // Without any worker threads, there's no choice but to find the path right now.
+    if(JobSystem::GetWorkerCount() == 0)
+    {
+        findPath();
+    }
+    else
+    {
+        request->job = JobSystem::Run(findPath);
+    }
+    return request;
+}
+
+/*static*/ void WalkerBoundary::WaitForPath(const WalkerPathRequest& request)
+{
+    if(request.IsDone()) { return; }
+
+    // If no worker has started on the path yet, this runs it right here.
+    JobSystem::Wait(request.job);
+}
+
+Vector3 WalkerBoundary::FindNearestWalkablePosition(const Vector3& worldPos) const
+{
+    // Usually, the position is already walkable, and that can be checked directly.
+    if(IsWorldPosWalkable(worldPos)) { return worldPos; }
+
+    // Otherwise, a search is needed, which uses the precomputed walkability in a snapshot.
+    return CreateSnapshot().FindNearestWalkablePosition(worldPos);
+}
+
 void WalkerBoundary::SetRegionBlocked(int regionIndex, int regionBoundaryIndex, bool blocked)
 {
     if(blocked)
@@ -274,9 +454,18 @@ void WalkerBoundary::SetRegionBlocked(int regionIndex, int regionBoundaryIndex,
     }
 }
 
-int WalkerBoundary::GetRegionIndex(const Vector3& worldPos)
+int WalkerBoundary::GetRegionIndex(const Vector3& worldPos) const
 {
-    return GetRegionForTexturePos(WorldPosToTexturePos(worldPos));
+    // If no walker texture, return zero, which is always a walkable region.
+    if(mTexture == nullptr) { return 0; }
+
+    // It position is out of bounds, use unwalkable index 255.
+    Vector2 texturePos = WorldPosToTexturePos(worldPos);
+    if(texturePos.x < 0 || texturePos.x >= mTexture->GetWidth()) { return 255; }
+    if(texturePos.y < 0 || texturePos.y >= mTexture->GetHeight()) { return 255; }
+
+    // The region is just the palette index.
+    return mTexture->GetPixelPaletteIndex(texturePos.x, texturePos.y);
 }
 
 void WalkerBoundary::SetUnwalkableRect(const std::string& name, const Rect& worldRect)
@@ -364,117 +553,192 @@ void WalkerBoundary::OnPersist(PersistState& ps)
     ps.Xfer(PERSIST_VAR(mUnwalkableRects));
 }
 
-bool WalkerBoundary::IsWorldPosWalkable(const Vector3& worldPos) const
+WalkerBoundarySnapshot WalkerBoundary::CreateSnapshot(const Walker* ignoreWalker) const
 {
-    // Convert to texture position and check that.
-    return IsTexturePosWalkable(WorldPosToTexturePos(worldPos));
+    WalkerBoundarySnapshot snapshot;
+    if(mTexture != nullptr)
+    {
+        // The texture's palette indexes are by far the biggest part of a snapshot.
+        // They don't change when the texture doesn't, so all snapshots share one copy.
+        if(mPaletteIndexes == nullptr)
+        {
+            std::shared_ptr<std::vector<uint8_t>> paletteIndexes = std::make_shared<std::vector<uint8_t>>(mTexture->GetWidth() * mTexture->GetHeight());
+            for(uint32_t y = 0; y < mTexture->GetHeight(); ++y)
+            {
+                for(uint32_t x = 0; x < mTexture->GetWidth(); ++x)
+                {
+                    (*paletteIndexes)[y * mTexture->GetWidth() + x] = mTexture->GetPixelPaletteIndex(x, y);
+                }
+            }
+            mPaletteIndexes = paletteIndexes;
+        }
+        snapshot.mPaletteIndexes = mPaletteIndexes;
+        snapshot.mWidth = mTexture->GetWidth();
+        snapshot.mHeight = mTexture->GetHeight();
+    }
+    snapshot.mSize = mSize;
+    snapshot.mOffset = mOffset;
+
+    // Only palette indexes (0-255) can ever be checked against these, so anything else can be ignored.
+    for(int region : mUnwalkableRegions)
+    {
+        if(region >= 0 && region < 256)
+        {
+            snapshot.mUnwalkableRegions[region] = true;
+        }
+    }
+    for(auto& entry : mUnwalkableRects)
+    {
+        snapshot.mUnwalkableRects.push_back(entry.second);
+    }
+    for(Walker* walker : mWalkers)
+    {
+        if(walker != ignoreWalker)
+        {
+            snapshot.mWalkerPositions.push_back(walker->GetOwner()->GetPosition());
+        }
+    }
+
+    // Use the walkability field for these regions/rects, if one exists. Otherwise, build a new one now.
+    // Building here (rather than on a path job) means no job ever has to wait on another job's build.
+    if(snapshot.mPaletteIndexes != nullptr)
+    {
+        auto it = std::find_if(mFields.begin(), mFields.end(), [&snapshot](const std::shared_ptr<const WalkerBoundaryField>& field) {
+            return field->Matches(snapshot.mUnwalkableRegions, snapshot.mUnwalkableRects);
+        });
+        if(it != mFields.end())
+        {
+            std::rotate(mFields.begin(), it, it + 1);
+        }
+        else
+        {
+            mFields.insert(mFields.begin(), std::make_shared<WalkerBoundaryField>(snapshot.mPaletteIndexes, snapshot.mWidth, snapshot.mHeight,
+                                                                                   snapshot.mUnwalkableRegions, snapshot.mUnwalkableRects));
+            if(mFields.size() > kMaxCachedFields)
+            {
+                mFields.pop_back();
+            }
+        }
+        snapshot.mField = mFields.front();
+    }
+    return snapshot;
 }
 
-bool WalkerBoundary::IsTexturePosWalkable(const Vector2& texturePos) const
+Vector2 WalkerBoundary::WorldPosToTexturePos(const Vector3& worldPos) const
 {
-    // Unwalkable if region associated with this texture pos is in the unwalkable regions set.
-    if(mUnwalkableRegions.count(GetRegionForTexturePos(texturePos)) > 0)
+    // If no texture, the end result is going to be zero.
+    if(mTexture == nullptr) { return Vector2::Zero; }
+    return ::WorldPosToTexturePos(worldPos, mSize, mOffset, mTexture->GetWidth(), mTexture->GetHeight());
+}
+
+Vector3 WalkerBoundary::TexturePosToWorldPos(const Vector2& texturePos) const
+{
+    // If no texture, the end result is going to be zero.
+    if(mTexture == nullptr) { return Vector3::Zero; }
+    return ::TexturePosToWorldPos(texturePos, mSize, mOffset, mTexture->GetWidth(), mTexture->GetHeight());
+}
+
+bool WalkerBoundary::IsWorldPosWalkable(const Vector3& worldPos) const
+{
+    // Same as a snapshot's check, but against the current state, so nothing needs to be copied.
+    if(mUnwalkableRegions.count(GetRegionIndex(worldPos)) > 0)
     {
         return false;
     }
 
-    // Also unwalkable if this position is inside an unwalkable rect.
-    for(auto& unwalkableRect : mUnwalkableRects)
+    Vector2 texturePos = WorldPosToTexturePos(worldPos);
+    for(auto& entry : mUnwalkableRects)
     {
-        if(unwalkableRect.second.Contains(texturePos))
+        if(entry.second.Contains(texturePos))
         {
             return false;
         }
     }
 
-    // Also unwalkable if this position is too close to a walker in the scene.
-    Vector3 worldPos = TexturePosToWorldPos(texturePos);
+    Vector3 pixelWorldPos = TexturePosToWorldPos(texturePos);
     for(Walker* walker : mWalkers)
     {
-        // Make y-pos equal so that we only consider distance on the x/z plane.
-        Vector3 walkerPos = walker->GetOwner()->GetPosition();
-        walkerPos.y = worldPos.y;
-        float distSq = (worldPos - walkerPos).GetLengthSq();
-
-        // Each walker's radius is about 10 units. There are outliers (like Chicken or Demon), but this mostly works.
-        // BUT we need to factor in the radius of this walker AND myself - so we actually use 20 here!
-        //TODO: If the radius differed per walker, we'd want to query the walkers and sum the radii.
-        const float kCombinedRadiiSq = 20.0f * 20.0f;
-        if(distSq <= kCombinedRadiiSq)
+        if(IsNearWalker(pixelWorldPos, walker->GetOwner()->GetPosition()))
         {
             return false;
         }
     }
-
-    // Looks like it's walkable!
     return true;
 }
 
-Vector2 WalkerBoundary::WorldPosToTexturePos(const Vector3& worldPos) const
+uint8_t WalkerBoundarySnapshot::GetPaletteIndex(int x, int y) const
 {
-    // If no texture, the end result is going to be zero.
-    if(mTexture == nullptr) { return Vector2::Zero; }
+    // Like a texture, out of bounds positions have palette index zero.
+    if(mPaletteIndexes == nullptr || x < 0 || y < 0 || x >= static_cast<int>(mWidth) || y >= static_cast<int>(mHeight)) { return 0; }
+    return (*mPaletteIndexes)[y * mWidth + x];
+}
 
-    // Add walker boundary's world position offset.
-    // This causes the position to be relative to the texture's origin (lower left) instead of the world origin.
-    Vector2 texturePos;
-    texturePos.x = worldPos.x + mOffset.x;
-    texturePos.y = worldPos.z + mOffset.y;
-    //std::cout << "Offset Pos: " << position << std::endl;
+bool WalkerBoundarySnapshot::IsWorldPosWalkable(const Vector3& worldPos) const
+{
+    // Convert to texture position and check that.
+    return IsTexturePosWalkable(WorldPosToTexturePos(worldPos));
+}
 
-    // Divide position by walkable area size to get a normalized position within that area.
-    // Hopefully 0-1, but could be outside those bounds. If so, not walkable.
-    texturePos.x = texturePos.x / mSize.x;
-    texturePos.y = texturePos.y / mSize.y;
-    //std::cout << "Normalized Pos: " << position << std::endl;
+bool WalkerBoundarySnapshot::IsTexturePosWalkable(const Vector2& texturePos) const
+{
+    // Unwalkable regions and rects rarely change, so whether each pixel is in one is precomputed.
+    if(mField != nullptr && IsInBounds(texturePos.x, texturePos.y))
+    {
+        if(!mField->IsWalkable(texturePos.x, texturePos.y))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // Unwalkable if region associated with this texture pos is in the unwalkable regions set.
+        if(mUnwalkableRegions[GetRegionForTexturePos(texturePos)])
+        {
+            return false;
+        }
 
-    // Multiply by texture width/height to determine the pixel within the texture.
-    texturePos.x = texturePos.x * mTexture->GetWidth();
-    texturePos.y = texturePos.y * mTexture->GetHeight();
-    //std::cout << "Pixel Pos: " << position << std::endl;
+        // Also unwalkable if this position is inside an unwalkable rect.
+        for(const Rect& unwalkableRect : mUnwalkableRects)
+        {
+            if(unwalkableRect.Contains(texturePos))
+            {
+                return false;
+            }
+        }
+    }
 
-    // Need to flip Y because the calculated value is from lower-left of the walkable area.
-    // But texture sample X/Y are from upper-left.
-    texturePos.y = mTexture->GetHeight() - texturePos.y;
+    // Also unwalkable if this position is too close to a walker in the scene.
+    Vector3 worldPos = TexturePosToWorldPos(texturePos);
+    for(const Vector3& walkerPos : mWalkerPositions)
+    {
+        if(IsNearWalker(worldPos, walkerPos))
+        {
+            return false;
+        }
+    }
 
-    // Texture positions are integers.
-    texturePos.x = (int)texturePos.x;
-    texturePos.y = (int)texturePos.y;
-    return texturePos;
+    // Looks like it's walkable!
+    return true;
 }
 
-Vector3 WalkerBoundary::TexturePosToWorldPos(Vector2 texturePos) const
+Vector2 WalkerBoundarySnapshot::WorldPosToTexturePos(const Vector3& worldPos) const
 {
     // If no texture, the end result is going to be zero.
-    if(mTexture == nullptr) { return Vector3::Zero; }
-
-    // A texture pos actually correlates to the bottom-left corner of the pixel.
-    // But we want center of pixel...so let's offset before the conversion!
-    texturePos.x = texturePos.x + 0.5f;
-    texturePos.y = texturePos.y + 0.5f;
-
-    // Flip y because texture pos is from top-left, but we need lower-left for world pos conversion.
-    texturePos.y = mTexture->GetHeight() - texturePos.y;
-
-    // Divide by texture width/height to get normalized position within the texture (0-1).
-    Vector3 worldPos;
-    worldPos.x = texturePos.x / mTexture->GetWidth();
-    worldPos.z = texturePos.y / mTexture->GetHeight();
-
-    // Multiply by size to get unit in world space.
-    worldPos.x = worldPos.x * mSize.x;
-    worldPos.z = worldPos.z * mSize.y;
+    if(mPaletteIndexes == nullptr) { return Vector2::Zero; }
+    return ::WorldPosToTexturePos(worldPos, mSize, mOffset, mWidth, mHeight);
+}
 
-    // Subtract offset to go from "texture space" to "world space".
-    worldPos.x = worldPos.x - mOffset.x;
-    worldPos.z = worldPos.z - mOffset.y;
-    return worldPos;
+Vector3 WalkerBoundarySnapshot::TexturePosToWorldPos(Vector2 texturePos) const
+{
+    // If no texture, the end result is going to be zero.
+    if(mPaletteIndexes == nullptr) { return Vector3::Zero; }
+    return ::TexturePosToWorldPos(texturePos, mSize, mOffset, mWidth, mHeight);
 }
 
-Vector2 WalkerBoundary::FindNearestWalkableTexturePosToWorldPos(const Vector3& worldPos) const
+Vector2 WalkerBoundarySnapshot::FindNearestWalkableTexturePosToWorldPos(const Vector3& worldPos) const
 {
     // We need a texture.
-    if(mTexture == nullptr) { return Vector2::Zero; }
+    if(mPaletteIndexes == nullptr) { return Vector2::Zero; }
 
     // If the passed in position is already walkable, just return that position in texture space.
     if(IsWorldPosWalkable(worldPos))
@@ -485,14 +749,22 @@ Vector2 WalkerBoundary::FindNearestWalkableTexturePosToWorldPos(const Vector3& w
     // Convert target position to texture position.
     Vector2 targetTexturePos = WorldPosToTexturePos(worldPos);
 
-    // Let's just brute force this for now - search O(n^2) for the nearest walkable position.
+    // Within the texture, the nearest walkable pixel is already known. Use it, unless a walker is standing there.
+    Vector2 nearestWalkableTexturePos;
+    if(mField != nullptr && IsInBounds(targetTexturePos.x, targetTexturePos.y) &&
+       mField->GetNearestWalkable(targetTexturePos.x, targetTexturePos.y, nearestWalkableTexturePos) &&
+       IsTexturePosWalkable(nearestWalkableTexturePos))
+    {
+        return nearestWalkableTexturePos;
+    }
+
+    // Otherwise (outside the texture, or blocked by a walker), brute force it - search O(n^2) for the nearest walkable position.
     // This can probably be more efficient based on whether target is to left/right/above/below/inside the texture.
     // But these walker boundary textures are really small, and this doesn't get called often, so this might work fine.
-    Vector2 nearestWalkableTexturePos;
     float nearestDistanceSq = 9999.0f;
-    for(int x = 0; x < mTexture->GetWidth(); ++x)
+    for(int x = 0; x < mWidth; ++x)
     {
-        for(int y = 0; y < mTexture->GetHeight(); ++y)
+        for(int y = 0; y < mHeight; ++y)
         {
             Vector2 pos(x, y);
             if(IsTexturePosWalkable(pos))
@@ -509,20 +781,20 @@ Vector2 WalkerBoundary::FindNearestWalkableTexturePosToWorldPos(const Vector3& w
     return nearestWalkableTexturePos;
 }
 
-int WalkerBoundary::GetRegionForTexturePos(const Vector2& texturePos) const
+int WalkerBoundarySnapshot::GetRegionForTexturePos(const Vector2& texturePos) const
 {
     // If no walker texture, return zero, which is always a walkable region.
-    if(mTexture == nullptr) { return 0; }
+    if(mPaletteIndexes == nullptr) { return 0; }
 
     // It position is out of bounds, use unwalkable index 255.
-    if(texturePos.x < 0 || texturePos.x >= mTexture->GetWidth()) { return 255; }
-    if(texturePos.y < 0 || texturePos.y >= mTexture->GetHeight()) { return 255; }
+    if(texturePos.x < 0 || texturePos.x >= mWidth) { return 255; }
+    if(texturePos.y < 0 || texturePos.y >= mHeight) { return 255; }
 
     // The region is just the palette index.
     // Palette index 0 is walkable, with indexes 1-9 indicating less and less walkable areas.
     // Palette index 255 is "unwalkable" area.
     // Palette indexes 128-254 are for special regions.
-    return mTexture->GetPixelPaletteIndex(texturePos.x, texturePos.y);
+    return GetPaletteIndex(texturePos.x, texturePos.y);
 }
 
 namespace
@@ -536,21 +808,21 @@ namespace
         // Is this node closed/explored in the current search?
         bool closed = false;
     };
-    std::vector<Node> nodes;
+    thread_local std::vector<Node> nodes;
 
     // The open set when doing a pathfinding search.
     // Each element is an index into the nodes array.
-    ResizableQueue<size_t> openSet;
+    thread_local ResizableQueue<size_t> openSet;
 }
 
-bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath, int nodeSkipInterval) const
+bool WalkerBoundarySnapshot::FindPathBFS(const Vector2& start, const Vector2& goal, std::frame_vector<Vector2>& outPath, int nodeSkipInterval, const std::atomic<bool>* canceled) const
 {
     //TIMER_SCOPED("BFS");
 
     // Figure out how many nodes we need for the current walker boundary texture.
-    if(mTexture == nullptr) { return false; }
-    uint32_t width = mTexture->GetWidth();
-    uint32_t height = mTexture->GetHeight();
+    if(mPaletteIndexes == nullptr) { return false; }
+    uint32_t width = mWidth;
+    uint32_t height = mHeight;
     uint32_t nodeCount = width * height;
     if(nodeCount == 0) { return false; }
 
@@ -620,6 +892,9 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
     Vector2 neighbors[8];
     while(!openSet.Empty())
     {
+        // Searches can take a while on big textures, so stop early if the path is no longer needed.
+        if(IsCanceled(canceled)) { return false; }
+
         // If we find the goal, we purposely don't pop the node off the open set.
         // This is used after the while-loop to check success/failure of the search.
         size_t currentIndex = openSet.Front();
@@ -742,23 +1017,23 @@ namespace
             this->c.clear();
         }
     };
-    AStarPriorityQueue openSetAS;
+    thread_local AStarPriorityQueue openSetAS;
 
     // Maps each node index to its parent.
-    std::vector<size_t> parents;
+    thread_local std::vector<size_t> parents;
 
     // The g(x) cost to each node, and the f(x) priority for each node.
-    std::vector<uint32_t> g;
-    std::vector<uint32_t> f;
+    thread_local std::vector<uint32_t> g;
+    thread_local std::vector<uint32_t> f;
 }
 
-bool WalkerBoundary::FindPathAStar(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath) const
+bool WalkerBoundarySnapshot::FindPathAStar(const Vector2& start, const Vector2& goal, std::frame_vector<Vector2>& outPath) const
 {
     //TIMER_SCOPED("A*");
 
     // Figure out how many nodes we need for the current walker boundary texture.
-    uint32_t width = mTexture->GetWidth();
-    uint32_t height = mTexture->GetHeight();
+    uint32_t width = mWidth;
+    uint32_t height = mHeight;
     uint32_t nodeCount = width * height;
     if(nodeCount == 0) { return false; }
 
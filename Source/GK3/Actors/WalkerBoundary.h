@@ -5,9 +5,15 @@
 // the path it should take, and any debug/rendering helpers.
 //
 #pragma once
-#include <vector>
+#include <atomic>
+#include <bitset>
+#include <memory>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
+#include "FrameAllocator.h"
+#include "JobSystem.h"
 #include "Rect.h"
 #include "Vector2.h"
 #include "Vector3.h"
@@ -16,13 +22,122 @@ class PersistState;
 class Texture;
 class Walker;
 
+// Precomputed walkability of each pixel in a walker boundary texture, given some unwalkable regions and rects.
+// Walkers aren't included, since they move around all the time - only things that rarely change.
+//
+// Along with whether each pixel is walkable, this stores how far each pixel is from a wall (or, for unwalkable pixels, how far to walkable ground),
+// and the nearest walkable pixel to each pixel. These are found with a linear-time distance transform, the first time they're needed.
+class WalkerBoundaryField
+{
+public:
+    WalkerBoundaryField(std::shared_ptr<const std::vector<uint8_t>> paletteIndexes, uint32_t width, uint32_t height,
+                        const std::bitset<256>& unwalkableRegions, const std::vector<Rect>& unwalkableRects);
+
+    bool Matches(const std::bitset<256>& unwalkableRegions, const std::vector<Rect>& unwalkableRects) const;
+
+    // For walkable pixels, the distance to the nearest unwalkable pixel (or the texture's edge). Always at least one.
+    // For unwalkable pixels, this is negative - the distance to the nearest walkable pixel.
+    float GetSignedDistance(uint32_t x, uint32_t y) const;
+    bool IsWalkable(uint32_t x, uint32_t y) const { return GetSignedDistance(x, y) > 0.0f; }
+
+    // Returns false if nothing is walkable.
+    bool GetNearestWalkable(uint32_t x, uint32_t y, Vector2& outTexturePos) const;
+
+private:
+    // What this field is built from.
+    std::shared_ptr<const std::vector<uint8_t>> mPaletteIndexes;
+    uint32_t mWidth = 0;
+    uint32_t mHeight = 0;
+    std::bitset<256> mUnwalkableRegions;
+    std::vector<Rect> mUnwalkableRects;
+
+    // Built when the field is created, so it's never modified while path jobs are reading it.
+    // Building lazily (e.g. with a once flag) could deadlock: the build helps run jobs while it waits, and those jobs may need the same field.
+    std::vector<float> mSignedDistances;
+    std::vector<uint32_t> mNearestWalkable;
+
+    void Build();
+};
+
+// A copy of everything needed to find paths through a walker boundary, taken at a moment in time.
+// Snapshots are never modified once created, so they can safely be used on background threads while the game carries on.
+class WalkerBoundarySnapshot
+{
+public:
+    // Node skip is where the search starts; if a path can't be found, it's lowered (and the lowered value is passed back).
+    // If the canceled flag gets set while searching, the search stops early and no path is returned.
+    bool FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath, int& nodeSkip, const std::atomic<bool>* canceled = nullptr) const;
+    Vector3 FindNearestWalkablePosition(const Vector3& worldPos) const;
+    int GetRegionIndex(const Vector3& worldPos) const;
+
+    Vector2 WorldPosToTexturePos(const Vector3& worldPos) const;
+    Vector3 TexturePosToWorldPos(Vector2 texturePos) const;
+
+private:
+    friend class WalkerBoundary;
+
+    // Palette index of each pixel in the walker boundary texture. Null if there's no texture.
+    std::shared_ptr<const std::vector<uint8_t>> mPaletteIndexes;
+    uint32_t mWidth = 0;
+    uint32_t mHeight = 0;
+
+    // Size/offset of the walker boundary in the 3D scene.
+    Vector2 mSize;
+    Vector2 mOffset;
+
+    // Unwalkable regions (palette indexes), unwalkable rects (in texture space), and positions of walkers to path around.
+    std::bitset<256> mUnwalkableRegions;
+    std::vector<Rect> mUnwalkableRects;
+    std::vector<Vector3> mWalkerPositions;
+
+    // Walkability for the regions/rects above. Null if there's no texture.
+    std::shared_ptr<const WalkerBoundaryField> mField;
+
+    uint8_t GetPaletteIndex(int x, int y) const;
+    bool IsInBounds(int x, int y) const { return x >= 0 && y >= 0 && x < static_cast<int>(mWidth) && y < static_cast<int>(mHeight); }
+
+    bool IsWorldPosWalkable(const Vector3& worldPos) const;
+    bool IsTexturePosWalkable(const Vector2& texturePos) const;
+
+    int GetRegionForTexturePos(const Vector2& texturePos) const;
+
+    Vector2 FindNearestWalkableTexturePosToWorldPos(const Vector3& worldPos) const;
+
+    bool FindPathBFS(const Vector2& start, const Vector2& goal, std::frame_vector<Vector2>& outPath, int nodeSkipInterval = 1, const std::atomic<bool>* canceled = nullptr) const;
+    bool FindPathAStar(const Vector2& start, const Vector2& goal, std::frame_vector<Vector2>& outPath) const;
+};
+
+// A path being found on a background thread.
+// The requester holds onto this and checks back on later frames. Set "canceled" if the path is no longer needed.
+struct WalkerPathRequest
+{
+    std::atomic<bool> canceled { false };
+    std::atomic<bool> done { false };
+
+    // Only valid once done. Like FindPath, the path is backwards, and may be a "best effort" path even if no path was found.
+    bool foundPath = false;
+    std::vector<Vector3> path;
+
+    // The job finding the path.
+    JobHandle job;
+
+    bool IsDone() const { return done.load(std::memory_order_acquire); }
+};
+
 class WalkerBoundary
 {
 public:
-    bool FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath);
+    WalkerBoundary();
+
+    // Starts finding a path on a background thread. Walkers are pathed around, other than the ignored one (usually the one walking).
+    std::shared_ptr<WalkerPathRequest> FindPathAsync(const Vector3& fromWorldPos, const Vector3& toWorldPos, const Walker* ignoreWalker);
+
+    // Waits for a path request to finish. Only for when the path is needed right away - usually, just check IsDone on later frames.
+    static void WaitForPath(const WalkerPathRequest& request);
+
     Vector3 FindNearestWalkablePosition(const Vector3& worldPos) const;
 
-    void SetTexture(Texture* texture) { mTexture = texture; }
+    void SetTexture(Texture* texture) { mTexture = texture; mPaletteIndexes = nullptr; mFields.clear(); }
     Texture* GetTexture() const { return mTexture; }
 
     void SetSize(const Vector2& size) { mSize = size; }
@@ -32,7 +147,7 @@ public:
     Vector2 GetOffset() const { return mOffset; }
 
     void SetRegionBlocked(int regionIndex, int regionBoundaryIndex, bool blocked);
-    int GetRegionIndex(const Vector3& worldPos);
+    int GetRegionIndex(const Vector3& worldPos) const;
 
     void SetUnwalkableRect(const std::string& name, const Rect& worldRect);
     void ClearUnwalkableRect(const std::string& name);
@@ -43,6 +158,8 @@ public:
 
     void OnPersist(PersistState& ps);
 
+    WalkerBoundarySnapshot CreateSnapshot(const Walker* ignoreWalker = nullptr) const;
+
 private:
     // The texture provides vital data about walkable areas.
     // Each pixel correlates to a spot in the scene.
@@ -68,18 +185,19 @@ private:
 
     // The pathfinding grids are quite dense, and we can save some time by skipping over some nodes in the grid.
     // This value starts higher, but is cut in half when we can't find a path.
-    int mPathfindingNodeSkip = 4;
-
-    bool IsWorldPosWalkable(const Vector3& worldPos) const;
-    bool IsTexturePosWalkable(const Vector2& texturePos) const;
-
-    Vector2 WorldPosToTexturePos(const Vector3& worldPos) const;
-    Vector3 TexturePosToWorldPos(Vector2 texturePos) const;
+    // Shared with in-progress background searches, which may lower it.
+    std::shared_ptr<std::atomic<int>> mPathfindingNodeSkip;
 
-    int GetRegionForTexturePos(const Vector2& texturePos) const;
+    // Palette indexes from the texture, shared by all snapshots. Created when first needed.
+    mutable std::shared_ptr<const std::vector<uint8_t>> mPaletteIndexes;
 
-    Vector2 FindNearestWalkableTexturePosToWorldPos(const Vector3& worldPos) const;
+    // Walkability fields for recently used combinations of unwalkable regions/rects, most recent first.
+    // Blocking a region and later unblocking it (e.g. a door closing and opening) then reuses the earlier field, rather than building it again.
+    static const size_t kMaxCachedFields = 4;
+    mutable std::vector<std::shared_ptr<const WalkerBoundaryField>> mFields;
 
-    bool FindPathBFS(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath, int nodeSkipInterval = 1) const;
-    bool FindPathAStar(const Vector2& start, const Vector2& goal, std::vector<Vector2>& outPath) const;
-};
+    // Main-thread queries use these directly, rather than creating a snapshot each time.
+    Vector2 WorldPosToTexturePos(const Vector3& worldPos) const;
+    Vector3 TexturePosToWorldPos(const Vector2& texturePos) const;
+    bool IsWorldPosWalkable(const Vector3& worldPos) const;
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Animation.h"
 
 #include <cctype>
+#include <map>
 
 #include "Audio.h"
 #include "AnimationNodes.h"
@@ -19,13 +20,10 @@ TYPEINFO_INIT(Animation, Asset, GENERATE_TYPE_ID)
 
 Animation::~Animation()
 {
-    // Be sure to delete dynamically allocated memory.
-    for(auto& frameEntry : mFrames)
+    // Nodes were constructed in the node blocks, so they must be destructed manually. The blocks themselves are freed automatically.
+    for(AnimNode* node : mNodes)
     {
-        for(auto& frameAnimNode : frameEntry.second)
-        {
-            delete frameAnimNode;
-        }
+        node->~AnimNode();
     }
 }
 
@@ -34,13 +32,10 @@ void Animation::Load(AssetData& data)
     ParseFromData(data.bytes.get(), data.length);
 }
 
-std::vector<AnimNode*>* Animation::GetFrame(int frameNumber)
+AnimFrame Animation::GetFrame(int frameNumber) const
 {
-    if(mFrames.find(frameNumber) != mFrames.end())
-    {
-        return &mFrames[frameNumber];
-    }
-    return nullptr;
+    if(frameNumber < 0 || frameNumber + 1 >= static_cast<int>(mFrameOffsets.size())) { return AnimFrame(); }
+    return AnimFrame(mNodes.data() + mFrameOffsets[frameNumber], mNodes.data() + mFrameOffsets[frameNumber + 1]);
 }
 
 bool Animation::ContainsVertexAnimation(VertexAnimation* vertexAnim) const
@@ -55,42 +50,47 @@ bool Animation::ContainsVertexAnimation(VertexAnimation* vertexAnim) const
     return false;
 }
 
-VertexAnimNode* Animation::GetVertexAnimationOnFrameForModel(int frameNumber, const std::string& modelName)
+int Animation::GetModelIndex(const std::string& modelName) const
 {
-    for(auto& node : mVertexAnimNodes)
+    for(size_t i = 0; i < mModels.size(); ++i)
     {
-        if(node->frameNumber == frameNumber &&
-           node->vertexAnimation != nullptr &&
-           StringUtil::EqualsIgnoreCase(node->vertexAnimation->GetModelName(), modelName))
+        if(StringUtil::EqualsIgnoreCase(mModels[i].modelName, modelName))
         {
-            return node;
+            return static_cast<int>(i);
         }
     }
-    return nullptr;
+    return -1;
 }
 
-VertexAnimNode* Animation::GetFirstVertexAnimationForModel(const std::string& modelName)
+VertexAnimNode* Animation::GetVertexAnimationOnFrameForModel(int frameNumber, const std::string& modelName) const
 {
-    int earliestFrameNumber = GetFrameCount();
-    VertexAnimNode* vertexAnimNode = nullptr;
-    for(auto& node : mVertexAnimNodes)
+    int modelIndex = GetModelIndex(modelName);
+    if(modelIndex < 0 || modelIndex >= static_cast<int>(mModels.size())) { return nullptr; }
+    for(VertexAnimNode* node : mModels[modelIndex].vertexAnimNodes)
     {
-        if(node->vertexAnimation != nullptr && StringUtil::EqualsIgnoreCase(node->vertexAnimation->GetModelName(), modelName))
+        if(node->frameNumber == frameNumber)
         {
-            if(vertexAnimNode == nullptr || node->frameNumber < earliestFrameNumber)
-            {
-                earliestFrameNumber = node->frameNumber;
-                vertexAnimNode = node;
-            }
+            return node;
         }
     }
-    return vertexAnimNode;
+    return nullptr;
+}
+
+VertexAnimNode* Animation::GetFirstVertexAnimationForModel(const std::string& modelName) const
+{
+    // Each model's nodes are sorted by frame, so the first is the earliest.
+    int modelIndex = GetModelIndex(modelName);
+    if(modelIndex < 0 || modelIndex >= static_cast<int>(mModels.size())) { return nullptr; }
+    return mModels[modelIndex].vertexAnimNodes.front();
 }
 
 void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
 {
+    // While parsing, collect nodes per frame. Once done, these are packed into one array.
+    std::map<int, std::vector<AnimNode*>> frames;
+
     IniReader parser(data, dataLength);
-    IniSection section;
+    IniSectionView section;
     while(parser.ReadNextSection(section))
     {
         // Header section has only one value: number of frames.
@@ -108,7 +108,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // Read in 2+ lines as actions.
             for(size_t i = 1; i < section.lines.size(); ++i)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // Each line has up to 10 (!!!) fields. Most are optional, but they must be in a certain order.
 
@@ -118,15 +118,15 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Vertex animation must be specified.
-                VertexAnimation* vertexAnim = gAssetManager.LoadAsset<VertexAnimation>(line.entries[1].key, GetScope());
+                VertexAnimation* vertexAnim = gAssetManager.LoadAsset<VertexAnimation>(std::string(line.entries[1].key), GetScope());
                 if(vertexAnim == nullptr)
                 {
-                    LOG_WARNING("Failed to load vertex animation %s!", line.entries[1].key.c_str());
+                    LOG_WARNING("Failed to load vertex animation %s!", std::string(line.entries[1].key).c_str());
                     continue;
                 }
 
                 // Create and push back the animation node. Remaining fields are optional.
-                VertexAnimNode* node = new VertexAnimNode();
+                VertexAnimNode* node = CreateNode<VertexAnimNode>();
                 node->frameNumber = frameNumber;
                 node->vertexAnimation = vertexAnim;
 
@@ -135,12 +135,12 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 bool isDor = StringUtil::StartsWithIgnoreCase(vertexAnim->GetName(), "DOR_");
                 if(isDor)
                 {
-                    mFrames[frameNumber].insert(mFrames[frameNumber].begin(), node);
+                    frames[frameNumber].insert(frames[frameNumber].begin(), node);
                     mVertexAnimNodes.insert(mVertexAnimNodes.begin(), node);
                 }
                 else
                 {
-                    mFrames[frameNumber].push_back(node);
+                    frames[frameNumber].push_back(node);
                     mVertexAnimNodes.push_back(node);
                 }
 
@@ -187,27 +187,27 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // First line is number of entries...but we can just determine that from the number of lines!
             for(size_t i = 1; i < section.lines.size(); ++i)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // <frame_num>, <scn_name>, <scn_model_name>, <texture_name>
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read the scene name.
-                std::string sceneName = line.entries[1].key;
+                std::string sceneName(line.entries[1].key);
 
                 // Read the scene model name.
-                std::string sceneModelName = line.entries[2].key;
+                std::string sceneModelName(line.entries[2].key);
 
                 // Read the texture name.
-                std::string textureName = line.entries[3].key;
+                std::string textureName(line.entries[3].key);
 
                 // Create and add the anim node.
-                SceneTextureAnimNode* node = new SceneTextureAnimNode();
+                SceneTextureAnimNode* node = CreateNode<SceneTextureAnimNode>();
                 node->frameNumber = frameNumber;
                 node->sceneName = sceneName;
                 node->sceneModelName = sceneModelName;
                 node->textureName = textureName;
-                mFrames[frameNumber].push_back(node);
+                frames[frameNumber].push_back(node);
             }
         }
         // "SVisibility" changes the visibility of a scene (BSP) model.
@@ -217,26 +217,26 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // Read in 2+ lines as actions.
             for(size_t i = 1; i < section.lines.size(); i++)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // <frame_num>, <scn_name>, <scn_model_name>, <on/off>
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read the scene name.
-                std::string sceneName = line.entries[1].key;
+                std::string sceneName(line.entries[1].key);
 
                 // Read the scene model name.
-                std::string sceneModelName = line.entries[2].key;
+                std::string sceneModelName(line.entries[2].key);
 
                 // Read the on/off value.
                 bool visible = line.entries[3].GetValueAsBool();
 
                 // Create and add the anim node.
-                SceneModelVisibilityAnimNode* node = new SceneModelVisibilityAnimNode();
+                SceneModelVisibilityAnimNode* node = CreateNode<SceneModelVisibilityAnimNode>();
                 node->sceneName = sceneName;
                 node->sceneModelName = sceneModelName;
                 node->visible = visible;
-                mFrames[frameNumber].push_back(node);
+                frames[frameNumber].push_back(node);
             }
         }
         // "MTextures" changes textures on a model or actor.
@@ -246,13 +246,13 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // Read in 2+ lines as actions.
             for(size_t i = 1; i < section.lines.size(); i++)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // <frame_num>, <model_name>, <mesh_index>, <group_index>, <texture_name>
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read the model name.
-                std::string modelName = line.entries[1].key;
+                std::string modelName(line.entries[1].key);
 
                 // Read the model mesh index.
                 int meshIndex = line.entries[2].GetValueAsInt();
@@ -261,15 +261,15 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 int submeshIndex = line.entries[3].GetValueAsInt();
 
                 // Read the texture name.
-                std::string textureName = line.entries[4].key;
+                std::string textureName(line.entries[4].key);
 
                 // Create and add node.
-                ModelTextureAnimNode* node = new ModelTextureAnimNode();
+                ModelTextureAnimNode* node = CreateNode<ModelTextureAnimNode>();
                 node->modelName = modelName;
                 node->meshIndex = static_cast<unsigned char>(meshIndex);
                 node->submeshIndex = static_cast<unsigned char>(submeshIndex);
                 node->textureName = textureName;
-                mFrames[frameNumber].push_back(node);
+                frames[frameNumber].push_back(node);
             }
         }
         // "MVisibility" changes visibility on a model or actor.
@@ -279,7 +279,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // Read in 2+ lines as actions.
             for(size_t i = 1; i < section.lines.size(); ++i)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // Two possible formats:
                 // <frame_num>, <model_name>, <on/off>
@@ -287,12 +287,12 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read the model name.
-                std::string modelName = line.entries[1].key;
+                std::string modelName(line.entries[1].key);
 
                 // Create and add node.
-                ModelVisibilityAnimNode* node = new ModelVisibilityAnimNode();
+                ModelVisibilityAnimNode* node = CreateNode<ModelVisibilityAnimNode>();
                 node->modelName = modelName;
-                mFrames[frameNumber].push_back(node);
+                frames[frameNumber].push_back(node);
 
                 // Read specific mesh/submesh visibility version vs. whole model version.
                 if(line.entries.size() > 3)
@@ -314,7 +314,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // Read in lines 2+ as sounds.
             for(size_t i = 1; i < section.lines.size(); i++)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // Possible versions of these lines:
                 // <frame_num>, <sound_name>, <volume> (2D sound)
@@ -326,13 +326,13 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read the sound name.
-                std::string soundName = line.entries[1].key;
+                std::string soundName(line.entries[1].key);
 
                 // Read the volume.
                 int volume = line.entries[2].GetValueAsInt();
 
                 // Create node.
-                SoundAnimNode* node = new SoundAnimNode();
+                SoundAnimNode* node = CreateNode<SoundAnimNode>();
                 node->frameNumber = frameNumber;
                 node->audio = gAssetManager.LoadAsset<Audio>(soundName, GetScope());
                 node->volume = volume;
@@ -375,7 +375,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
 
                 // Put node in frames map.
-                mFrames[frameNumber].push_back(node);
+                frames[frameNumber].push_back(node);
             }
         }
         // Allows specifying of additional options that affect the entire animation.
@@ -384,7 +384,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
             // First line is number of entries...but we can just determine that from the number of lines!
             for(size_t i = 1; i < section.lines.size(); i++)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // <frame_num>, <option>, <value>
 
@@ -392,7 +392,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 //int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read in the option.
-                std::string option = line.entries[1].key;
+                std::string_view option = line.entries[1].key;
                 if(StringUtil::EqualsIgnoreCase(option, "SIMPLE"))
                 {
                     //int simpleValue = entry->GetValueAsInt();
@@ -412,7 +412,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
                 else
                 {
-                    LOG_WARNING("In animation %s, unexpected option: %s.", mName.c_str(), option.c_str());
+                    LOG_WARNING("In animation %s, unexpected option: %s.", mName.c_str(), std::string(option).c_str());
                 }
             }
         }
@@ -423,25 +423,25 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
         {
             for(size_t i = 1; i < section.lines.size(); i++)
             {
-                IniLine& line = section.lines[i];
+                IniLineView& line = section.lines[i];
 
                 // Read frame number.
                 int frameNumber = line.entries[0].GetValueAsInt();
 
                 // Read in the option.
-                std::string keyword = line.entries[1].key;
+                std::string_view keyword = line.entries[1].key;
                 if(StringUtil::EqualsIgnoreCase(keyword, "FOOTSTEP"))
                 {
                     // [FRAME] FOOTSTEP [NOUN]
                     if(line.entries.size() >= 3)
                     {
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // Create and add node.
-                        FootstepAnimNode* node = new FootstepAnimNode();
+                        FootstepAnimNode* node = CreateNode<FootstepAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "FOOTSCUFF"))
@@ -449,13 +449,13 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     // [FRAME] FOOTSCUFF [NOUN]
                     if(line.entries.size() >= 3)
                     {
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // Create and add node.
-                        FootscuffAnimNode* node = new FootscuffAnimNode();
+                        FootscuffAnimNode* node = CreateNode<FootscuffAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "STOPSOUNDTRACK"))
@@ -463,13 +463,13 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     // [FRAME] STOPSOUNDTRACK [STK_NAME]
                     if(line.entries.size() >= 3)
                     {
-                        std::string soundtrackName = line.entries[2].key;
+                        std::string soundtrackName(line.entries[2].key);
 
                         // Create and add node.
-                        StopSoundtrackAnimNode* node = new StopSoundtrackAnimNode();
+                        StopSoundtrackAnimNode* node = CreateNode<StopSoundtrackAnimNode>();
                         node->frameNumber = frameNumber;
                         node->soundtrackName = soundtrackName;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "PLAYSOUNDTRACK"))
@@ -478,10 +478,10 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 3)
                     {
                         // Create and add node.
-                        PlaySoundtrackAnimNode* node = new PlaySoundtrackAnimNode();
+                        PlaySoundtrackAnimNode* node = CreateNode<PlaySoundtrackAnimNode>();
                         node->frameNumber = frameNumber;
                         node->soundtrackName = line.entries[2].key;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "PLAYSOUNDTRACKTBS"))
@@ -490,19 +490,19 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 3)
                     {
                         // Create and add node.
-                        PlaySoundtrackAnimNode* node = new PlaySoundtrackAnimNode();
+                        PlaySoundtrackAnimNode* node = CreateNode<PlaySoundtrackAnimNode>();
                         node->frameNumber = frameNumber;
                         node->soundtrackName = line.entries[2].key;
                         node->nonLooping = true;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "STOPALLSOUNDTRACKS"))
                 {
                     // Create and add node.
-                    StopSoundtrackAnimNode* node = new StopSoundtrackAnimNode();
+                    StopSoundtrackAnimNode* node = CreateNode<StopSoundtrackAnimNode>();
                     node->frameNumber = frameNumber;
-                    mFrames[frameNumber].push_back(node);
+                    frames[frameNumber].push_back(node);
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "CAMERA"))
                 {
@@ -510,7 +510,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 3)
                     {
                         // Create and add node.
-                        CameraAnimNode* node = new CameraAnimNode();
+                        CameraAnimNode* node = CreateNode<CameraAnimNode>();
                         node->frameNumber = frameNumber;
                         node->cameraPositionName = line.entries[2].key;
 
@@ -524,7 +524,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                             }
                         }
 
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "LIPSYNCH"))
@@ -532,15 +532,15 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     // [FRAME] LIPSYNCH [NOUN] [TEXTURE]
                     if(line.entries.size() >= 4)
                     {
-                        std::string actorNoun = line.entries[2].key;
-                        std::string mouthTexName = line.entries[3].key;
+                        std::string actorNoun(line.entries[2].key);
+                        std::string mouthTexName(line.entries[3].key);
 
                         // Create and add node.
-                        LipSyncAnimNode* node = new LipSyncAnimNode();
+                        LipSyncAnimNode* node = CreateNode<LipSyncAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
                         node->mouthTextureName = mouthTexName;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "FACETEX"))
@@ -549,18 +549,18 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 5)
                     {
                         // Read the actor name.
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // Read texture name.
                         // This sometimes has a forward slash in it, which
                         // indicates "tex"/"alpha_tex".
-                        std::string textureName = line.entries[3].key;
+                        std::string textureName(line.entries[3].key);
 
                         // A value indicating what part of the face is changed. Always H, E, M.
                         // M = mouth
                         // E = eye
                         // H = head/forehead
-                        std::string facePart = line.entries[4].key;
+                        std::string facePart(line.entries[4].key);
                         StringUtil::ToLower(facePart);
                         FaceElement faceElement = FaceElement::Mouth;
                         switch(facePart[0])
@@ -583,12 +583,12 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                         }
 
                         // Create and add node.
-                        FaceTexAnimNode* node = new FaceTexAnimNode();
+                        FaceTexAnimNode* node = CreateNode<FaceTexAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
                         node->textureName = textureName;
                         node->faceElement = faceElement;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "UNFACETEX"))
@@ -597,13 +597,13 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 4)
                     {
                         // Read the actor name.
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // A value indicating what part of the face is changed. Always H, E, M.
                         // M = mouth
                         // E = eye
                         // H = head/forehead
-                        std::string facePart = line.entries[3].key;
+                        std::string facePart(line.entries[3].key);
                         StringUtil::ToLower(facePart);
                         FaceElement faceElement = FaceElement::Mouth;
                         switch(facePart[0])
@@ -620,11 +620,11 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                         }
 
                         // Create and add node.
-                        UnFaceTexAnimNode* node = new UnFaceTexAnimNode();
+                        UnFaceTexAnimNode* node = CreateNode<UnFaceTexAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
                         node->faceElement = faceElement;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "GLANCE"))
@@ -633,7 +633,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 6)
                     {
                         // Read the actor name.
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // X/Y/Z position.
                         float x = line.entries[3].GetValueAsFloat();
@@ -641,11 +641,11 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                         float z = line.entries[5].GetValueAsFloat();
 
                         // Create and add node.
-                        GlanceAnimNode* node = new GlanceAnimNode();
+                        GlanceAnimNode* node = CreateNode<GlanceAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
                         node->position = Vector3(x, y, z);
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "MOOD"))
@@ -654,17 +654,17 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 4)
                     {
                         // Read the actor name.
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // Read the mood name.
-                        std::string moodName = line.entries[3].key;
+                        std::string moodName(line.entries[3].key);
 
                         // Create and add node.
-                        MoodAnimNode* node = new MoodAnimNode();
+                        MoodAnimNode* node = CreateNode<MoodAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
                         node->moodName = moodName;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "EXPRESSION"))
@@ -673,17 +673,17 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 4)
                     {
                         // Read the actor name.
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // Read the expression name.
-                        std::string expressionName = line.entries[3].key;
+                        std::string expressionName(line.entries[3].key);
 
                         // Create and add node.
-                        ExpressionAnimNode* node = new ExpressionAnimNode();
+                        ExpressionAnimNode* node = CreateNode<ExpressionAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
                         node->expressionName = expressionName;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "SPEAKER"))
@@ -692,16 +692,16 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 3)
                     {
                         // Read actor name.
-                        std::string actorNoun = line.entries[2].key;
+                        std::string actorNoun(line.entries[2].key);
 
                         // Create and add node.
-                        SpeakerAnimNode* node = new SpeakerAnimNode();
+                        SpeakerAnimNode* node = CreateNode<SpeakerAnimNode>();
                         node->frameNumber = frameNumber;
                         node->actorNoun = actorNoun;
 
                         // When CAPTION and SPEAKER nodes exist on the same frame, it's important the SPEAKER nodes are processed first.
                         // To help with that, we'll always put SPEAKER nodes at the beginning of the node list.
-                        mFrames[frameNumber].insert(mFrames[frameNumber].begin(), node);
+                        frames[frameNumber].insert(frames[frameNumber].begin(), node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "CAPTION"))
@@ -711,7 +711,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     {
                         // Read caption.
                         // Unfortunately, the caption *may* contain commas, which interfers with the INI parser. Need to loop to populate.
-                        std::string caption = line.entries[2].key;
+                        std::string caption(line.entries[2].key);
                         for(size_t j = 3; j < line.entries.size(); ++j)
                         {
                             caption += ", ";
@@ -719,10 +719,10 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                         }
 
                         // Create and add node.
-                        CaptionAnimNode* node = new CaptionAnimNode();
+                        CaptionAnimNode* node = CreateNode<CaptionAnimNode>();
                         node->frameNumber = frameNumber;
                         node->caption = caption;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "SPEAKERCAPTION"))
@@ -734,23 +734,23 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                         int endFrame = line.entries[2].GetValueAsInt();
 
                         // Read actor who is doing the caption.
-                        std::string actorNoun = line.entries[3].key;
+                        std::string actorNoun(line.entries[3].key);
 
                         // Read caption.
                         // Unfortunately, the caption *may* contain commas, which interfers with the INI parser. Need to loop to populate.
-                        std::string caption = line.entries[4].key;
+                        std::string caption(line.entries[4].key);
                         for(size_t j = 5; j < line.entries.size(); ++j)
                         {
                             caption += ", ";
                             caption += line.entries[j].key;
                         }
 
-                        SpeakerCaptionAnimNode* node = new SpeakerCaptionAnimNode();
+                        SpeakerCaptionAnimNode* node = CreateNode<SpeakerCaptionAnimNode>();
                         node->frameNumber = frameNumber;
                         node->endFrameNumber = endFrame;
                         node->speaker = actorNoun;
                         node->caption = caption;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
                     }
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "DIALOGUECUE"))
@@ -758,9 +758,9 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     // No options for this one.
 
                     // Create and add node.
-                    DialogueCueAnimNode* node = new DialogueCueAnimNode();
+                    DialogueCueAnimNode* node = CreateNode<DialogueCueAnimNode>();
                     node->frameNumber = frameNumber;
-                    mFrames[frameNumber].push_back(node);
+                    frames[frameNumber].push_back(node);
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyword, "DIALOGUE"))
                 {
@@ -768,9 +768,9 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                     if(line.entries.size() >= 3)
                     {
                         // Create and add node.
-                        DialogueAnimNode* node = new DialogueAnimNode();
+                        DialogueAnimNode* node = CreateNode<DialogueAnimNode>();
                         node->frameNumber = frameNumber;
-                        mFrames[frameNumber].push_back(node);
+                        frames[frameNumber].push_back(node);
 
                         // The YAK name is *almost* always prefixed with the language code (E). *Almost* always.
                         // We want to store the name *without* the language code, so detect and remove it if it's there.
@@ -787,7 +787,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
                 else
                 {
-                    LOG_ERROR("In animation %s, unexpected GK3 animation keyword: %s.", mName.c_str(), keyword.c_str());
+                    LOG_ERROR("In animation %s, unexpected GK3 animation keyword: %s.", mName.c_str(), std::string(keyword).c_str());
                 }
             }
         }
@@ -798,7 +798,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
         else
         {
-            LOG_ERROR("In animation %s, unexpected animation header: %s.", mName.c_str(), section.name.c_str());
+            LOG_ERROR("In animation %s, unexpected animation header: %s.", mName.c_str(), std::string(section.name).c_str());
         }
     }
 
@@ -806,7 +806,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
     // To fix this, first find nodes with out of bounds frame number.
     // We need to do this in two loops, since we can't modify a map while iterating it.
     std::vector<AnimNode*> problemNodes;
-    for(auto& entry : mFrames)
+    for(auto& entry : frames)
     {
         for(auto& animNode : entry.second)
         {
@@ -821,7 +821,7 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
     for(AnimNode* node : problemNodes)
     {
         // We need to remove the node from its previous spot, to avoid double-deleting it when the Animation is destroyed.
-        auto& nodesOnFrame = mFrames[node->frameNumber];
+        auto& nodesOnFrame = frames[node->frameNumber];
         auto it = std::find(nodesOnFrame.begin(), nodesOnFrame.end(), node);
         if(it != nodesOnFrame.end())
         {
@@ -830,6 +830,53 @@ void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
 
         // Clamp frame number, insert it in frames list.
         node->frameNumber = Math::Clamp(node->frameNumber, 0, mFrameCount - 1);
-        mFrames[node->frameNumber].push_back(node);
+        frames[node->frameNumber].push_back(node);
+    }
+
+    // Pack the nodes into one array, sorted by frame, so each frame's nodes are a range in that array.
+    // Nodes on frames that don't exist (e.g. negative frame numbers) go first, before any frame's range, so they're kept but never played.
+    size_t nodeCount = 0;
+    for(auto& entry : frames)
+    {
+        nodeCount += entry.second.size();
+    }
+    mNodes.reserve(nodeCount);
+    int frameCount = std::max(mFrameCount, 0);
+    for(auto& entry : frames)
+    {
+        if(entry.first < 0 || entry.first >= frameCount)
+        {
+            mNodes.insert(mNodes.end(), entry.second.begin(), entry.second.end());
+        }
+    }
+    mFrameOffsets.resize(frameCount + 1);
+    for(int frameNumber = 0; frameNumber < frameCount; ++frameNumber)
+    {
+        mFrameOffsets[frameNumber] = static_cast<uint32_t>(mNodes.size());
+        auto it = frames.find(frameNumber);
+        if(it != frames.end())
+        {
+            mNodes.insert(mNodes.end(), it->second.begin(), it->second.end());
+        }
     }
-}
\ No newline at end of file
+    mFrameOffsets[frameCount] = static_cast<uint32_t>(mNodes.size());
+
+    // Group vertex anim nodes by the model they animate, so lookups by model don't need to compare names against every node.
+    for(VertexAnimNode* node : mVertexAnimNodes)
+    {
+        int modelIndex = GetModelIndex(node->vertexAnimation->GetModelName());
+        if(modelIndex < 0)
+        {
+            modelIndex = static_cast<int>(mModels.size());
+            mModels.emplace_back();
+            mModels.back().modelName = node->vertexAnimation->GetModelName();
+        }
+        mModels[modelIndex].vertexAnimNodes.push_back(node);
+    }
+    for(ModelEntry& model : mModels)
+    {
+        std::stable_sort(model.vertexAnimNodes.begin(), model.vertexAnimNodes.end(), [](VertexAnimNode* a, VertexAnimNode* b) {
+            return a->frameNumber < b->frameNumber;
+        });
+    }
+}
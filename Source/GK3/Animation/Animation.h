@@ -6,29 +6,54 @@
 //
 // Contains animation metadata, plus pointer to the animation data itself.
 //
+// Anim nodes are stored in one array, sorted by frame, so each frame's nodes are a range in that array (found via a table of frame offsets).
+// The nodes themselves are allocated from a few big blocks, rather than separately.
+//
 #pragma once
 #include "Asset.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <memory>
+#include <new>
 #include <vector>
 
+#include "LinearAllocator.h"
+
 struct AnimNode;
 class VertexAnimation;
 struct VertexAnimNode;
 
+// The anim nodes that start on one frame of an animation.
+class AnimFrame
+{
+public:
+    AnimFrame() = default;
+    AnimFrame(AnimNode* const* begin, AnimNode* const* end) : mBegin(begin), mEnd(end) { }
+
+    AnimNode* const* begin() const { return mBegin; }
+    AnimNode* const* end() const { return mEnd; }
+    bool empty() const { return mBegin == mEnd; }
+
+private:
+    AnimNode* const* mBegin = nullptr;
+    AnimNode* const* mEnd = nullptr;
+};
+
 class Animation : public Asset
 {
     TYPEINFO_SUB(Animation, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Animation;
+
     Animation(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~Animation();
 
     void Load(AssetData& data);
 
-    // Gets all anim nodes associated with a particular frame number. Null may be returned!
+    // Gets all anim nodes associated with a particular frame number. May be empty!
     // Mainly used by Animator to get frame data as needed and play/sample.
     //TODO: Might be better to move code from Animator that uses this into Animation directly.
-    std::vector<AnimNode*>* GetFrame(int frameNumber);
+    AnimFrame GetFrame(int frameNumber) const;
 
     // Just returns all vertex anim nodes! Used for stopping an animation.
     //TODO: Again, might make sense to move code from Animator into this class.
@@ -38,8 +63,8 @@ public:
 
     // Finds a vertex animation, if any, that starts on the given frame for the given model.
     // Mainly used to support "anim" approach type - allows us to query what a model's position/facing will be when an animation starts.
-    VertexAnimNode* GetVertexAnimationOnFrameForModel(int frameNumber, const std::string& modelName);
-    VertexAnimNode* GetFirstVertexAnimationForModel(const std::string& modelName);
+    VertexAnimNode* GetVertexAnimationOnFrameForModel(int frameNumber, const std::string& modelName) const;
+    VertexAnimNode* GetFirstVertexAnimationForModel(const std::string& modelName) const;
 
     // Length and duration.
     int GetFrameCount() const { return mFrameCount; }
@@ -56,13 +81,49 @@ private:
     // Default value "15" is taken from the defaults written to registry file.
     int mFramesPerSecond = 15;
 
-    // Mapping of frame number to animation nodes. Each frame can have zero, one,
+    // All anim nodes, sorted by frame. Each frame can have zero, one,
     // or many anim nodes representing animation events that should start on that frame.
-    std::unordered_map<int, std::vector<AnimNode*>> mFrames;
+    std::vector<AnimNode*> mNodes;
+
+    // For each frame, the index of the frame's first node in mNodes. Has one extra entry at the end, so a frame's nodes are [offset[i], offset[i + 1]).
+    // Any nodes before the first frame's offset aren't on a valid frame - they never play.
+    std::vector<uint32_t> mFrameOffsets;
 
     // All vertex anim nodes in the animation.
     // Kept separately because we sometimes need to iterate only over these.
     std::vector<VertexAnimNode*> mVertexAnimNodes;
 
+    // Each model animated by vertex anims in this animation, with its vertex anim nodes (sorted by frame).
+    struct ModelEntry
+    {
+        std::string modelName;
+        std::vector<VertexAnimNode*> vertexAnimNodes;
+    };
+    std::vector<ModelEntry> mModels;
+
+    // Memory for anim nodes. Nodes are allocated from the current block until it's full, and then a new block is started.
+    static const size_t kNodeBlockSize = 4096;
+    std::vector<std::unique_ptr<uint8_t[]>> mNodeBlocks;
+    LinearAllocator mNodeAllocator { nullptr, 0 };
+
     void ParseFromData(uint8_t* data, uint32_t dataLength);
-};
\ No newline at end of file
+
+    // Returns the index of a model in mModels, or -1 if this animation doesn't animate the model.
+    int GetModelIndex(const std::string& modelName) const;
+
+    template<typename T> T* CreateNode();
+};
+
+template<typename T>
+T* Animation::CreateNode()
+{
+    void* memory = mNodeAllocator.Allocate(sizeof(T), alignof(T));
+    if(memory == nullptr)
+    {
+        size_t blockSize = std::max(kNodeBlockSize, sizeof(T) + alignof(T));
+        mNodeBlocks.emplace_back(new uint8_t[blockSize]);
+        mNodeAllocator = LinearAllocator(mNodeBlocks.back().get(), blockSize);
+        memory = mNodeAllocator.Allocate(sizeof(T), alignof(T));
+    }
+    return new(memory) T();
+}
\ No newline at end of file
@@ -89,13 +89,9 @@ void Animator::Sample(Animation* animation, int frame)
     if(animation == nullptr) { return; }
 
     // Sample any anim nodes for the desired frame.
-    std::vector<AnimNode*>* frameData = animation->GetFrame(frame);
-    if(frameData != nullptr)
+    for(AnimNode* node : animation->GetFrame(frame))
     {
-        for(auto& node : *frameData)
-        {
-            node->Sample(frame);
-        }
+        node->Sample(frame);
     }
 }
 
@@ -104,15 +100,11 @@ void Animator::Sample(Animation* animation, int frame, const std::string& modelN
     if(animation == nullptr) { return; }
 
     // Similar to above, but ONLY sample nodes that are relevant to this model.
-    std::vector<AnimNode*>* frameData = animation->GetFrame(frame);
-    if(frameData != nullptr)
+    for(AnimNode* node : animation->GetFrame(frame))
     {
-        for(auto& node : *frameData)
+        if(node->AppliesToModel(modelName))
         {
-            if(node->AppliesToModel(modelName))
-            {
-                node->Sample(frame);
-            }
+            node->Sample(frame);
         }
     }
 }
@@ -215,21 +207,18 @@ void Animator::ExecuteFrame(int animIndex, int frameNumber)
     mActiveAnimations[animIndex].executingFrame = frameNumber;
 
     // Get all anim nodes that begin on this frame and start them.
-    std::vector<AnimNode*>* animNodes = mActiveAnimations[animIndex].params.animation->GetFrame(frameNumber);
-    if(animNodes != nullptr)
+    AnimFrame animNodes = mActiveAnimations[animIndex].params.animation->GetFrame(frameNumber);
+    for(AnimNode* node : animNodes)
     {
-        for(auto& node : *animNodes)
+        // If current frame != executing frame, we are "fast forwarding" - executing this frame to catch up.
+        // Most nodes don't support this (mostly just vertex anim nodes). So, skip unsupported nodes during catchup.
+        if(mActiveAnimations[animIndex].currentFrame != mActiveAnimations[animIndex].executingFrame && !node->PlayDuringCatchup())
         {
-            // If current frame != executing frame, we are "fast forwarding" - executing this frame to catch up.
-            // Most nodes don't support this (mostly just vertex anim nodes). So, skip unsupported nodes during catchup.
-            if(mActiveAnimations[animIndex].currentFrame != mActiveAnimations[animIndex].executingFrame && !node->PlayDuringCatchup())
-            {
-                continue;
-            }
-
-            // Play the node!
-            node->Play(&mActiveAnimations[animIndex]);
+            continue;
         }
+
+        // Play the node!
+        node->Play(&mActiveAnimations[animIndex]);
     }
 }
 
@@ -15,7 +15,6 @@
 #include "ReportManager.h"
 #include "StringTokenizer.h"
 #include "StringUtil.h"
-#include "TextReader.h"
 
 TYPEINFO_INIT(GAS, Asset, GENERATE_TYPE_ID)
 {
@@ -32,7 +31,8 @@ GAS::~GAS()
 
 void GAS::Load(AssetData& data)
 {
-    TextReader textReader(data.bytes.get(), data.length);
+    // Tokenize in place, directly from the asset data.
+    std::string_view text(reinterpret_cast<const char*>(data.bytes.get()), data.length);
 
     // Store any created "ONEOF" node, since they are generated over several lines.
     OneOfGasNode* oneOfNode = nullptr;
@@ -47,14 +47,12 @@ void GAS::Load(AssetData& data)
     std::vector<std::pair<std::string, WhenNearGasNode*>> whenNoLongerNearNodePairs;
 
     // Read in the GAS file contents one line at a time.
-    std::string line;
-    while(textReader.ReadLine(line))
+    std::string_view line;
+    while(StringUtil::PopLine(text, line))
     {
+        // SanitizeLine also trims off any comments (// format).
         StringUtil::SanitizeLine(line);
 
-        // Ignore commented out lines (// format)
-        if(line[0] == '/' && line[1] == '/') { continue; }
-
         // Split line into tokens based on spaces, commas, and parenthesis.
         StringTokenizer tokenizer(line, { ' ', ',', '(', ')' });
 
@@ -62,7 +60,7 @@ void GAS::Load(AssetData& data)
         if(!tokenizer.HasNext()) { continue; }
 
         // The first word will be the main command.
-        std::string command = tokenizer.GetNext();
+        std::string_view command = tokenizer.GetNext();
 
         // We keep adding to the same "one of" node as long as they are appearing in a row.
         // But as soon as we reach a line that isn't a "ONEOF" line, we no longer want to add to that one anymore.
@@ -83,7 +81,7 @@ void GAS::Load(AssetData& data)
 
             // Read in the required field (anim name).
             AnimGasNode* node = new AnimGasNode();
-            node->animation = gAssetManager.LoadAsset<Animation>(tokenizer.GetNext(), GetScope());
+            node->animation = gAssetManager.LoadAsset<Animation>(std::string(tokenizer.GetNext()), GetScope());
 
             // Read in optional fields.
             if(tokenizer.HasNext())
@@ -116,7 +114,7 @@ void GAS::Load(AssetData& data)
 
             // Read in the required field (anim name).
             AnimGasNode* node = new AnimGasNode();
-            node->animation = gAssetManager.LoadAsset<Animation>(tokenizer.GetNext(), GetScope());
+            node->animation = gAssetManager.LoadAsset<Animation>(std::string(tokenizer.GetNext()), GetScope());
 
             // Read in optional fields.
             if(tokenizer.HasNext())
@@ -178,7 +176,7 @@ void GAS::Load(AssetData& data)
 
             // Note that this label points to the next node added to the vector.
             // At the end of parsing, we'll hook up any GOTO or IF nodes.
-            labelToIndexMap[tokenizer.GetNext()] = mNodes.size();
+            labelToIndexMap[std::string(tokenizer.GetNext())] = mNodes.size();
         }
         else if(StringUtil::EqualsIgnoreCase(command, "GOTO"))
         {
@@ -193,7 +191,7 @@ void GAS::Load(AssetData& data)
             mNodes.push_back(node);
 
             // Remember that we need to come back and hook up the label index later.
-            gotoNodePairs.push_back(std::make_pair(tokenizer.GetNext(), node));
+            gotoNodePairs.push_back(std::make_pair(std::string(tokenizer.GetNext()), node));
         }
         else if(StringUtil::EqualsIgnoreCase(command, "LOOP"))
         {
@@ -209,7 +207,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing SET var name in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string varName = tokenizer.GetNext();
+            std::string_view varName = tokenizer.GetNext();
 
             if(!tokenizer.HasNext())
             {
@@ -231,7 +229,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing INC var name in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string varName = tokenizer.GetNext();
+            std::string_view varName = tokenizer.GetNext();
 
             // Create node.
             IncGasNode* node = new IncGasNode();
@@ -245,7 +243,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing DEC var name in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string varName = tokenizer.GetNext();
+            std::string_view varName = tokenizer.GetNext();
 
             // Create node.
             DecGasNode* node = new DecGasNode();
@@ -259,14 +257,14 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing IF var name in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string varName = tokenizer.GetNext();
+            std::string_view varName = tokenizer.GetNext();
 
             if(!tokenizer.HasNext())
             {
                 LOG_WARNING("Missing IF comparison operator in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string opString = tokenizer.GetNext();
+            std::string_view opString = tokenizer.GetNext();
 
             if(!tokenizer.HasNext())
             {
@@ -280,7 +278,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing IF label name in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string label = tokenizer.GetNext();
+            std::string label(tokenizer.GetNext());
 
             // Make sure the operator is valid.
             IfGasNode::Operation operation;
@@ -319,7 +317,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing WALKTO position in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string position = tokenizer.GetNext();
+            std::string_view position = tokenizer.GetNext();
 
             // The position can be either the name of a position (from SIF file) or an X/Y/Z position.
             // If more tokens are present, this is an X/Y/Z position.
@@ -355,7 +353,7 @@ void GAS::Load(AssetData& data)
             ChooseWalkGasNode* node = new ChooseWalkGasNode();
             while(tokenizer.HasNext())
             {
-                node->positionNames.push_back(tokenizer.GetNext());
+                node->positionNames.emplace_back(tokenizer.GetNext());
             }
             mNodes.push_back(node);
         }
@@ -370,7 +368,7 @@ void GAS::Load(AssetData& data)
                 continue;
             }
 
-            std::string subcommand = tokenizer.GetNext();
+            std::string_view subcommand = tokenizer.GetNext();
             if(StringUtil::EqualsIgnoreCase(subcommand, "IPOS"))
             {
                 if(!tokenizer.HasNext())
@@ -384,7 +382,7 @@ void GAS::Load(AssetData& data)
                 node->forTalk = isUseTalk;
                 if(tokenizer.HasNext())
                 {
-                    node->animation = gAssetManager.LoadAsset<Animation>(tokenizer.GetNext(), GetScope());
+                    node->animation = gAssetManager.LoadAsset<Animation>(std::string(tokenizer.GetNext()), GetScope());
                 }
                 mNodes.push_back(node);
             }
@@ -395,14 +393,14 @@ void GAS::Load(AssetData& data)
                     LOG_WARNING("Missing USE CLEANUP animation name in GAS file %s!", mName.c_str());
                     continue;
                 }
-                std::string animNeedingCleanupName = tokenizer.GetNext();
+                std::string animNeedingCleanupName(tokenizer.GetNext());
 
                 if(!tokenizer.HasNext())
                 {
                     LOG_WARNING("Missing USE CLEANUP animation name in GAS file %s!", mName.c_str());
                     continue;
                 }
-                std::string animDoingCleanupName = tokenizer.GetNext();
+                std::string animDoingCleanupName(tokenizer.GetNext());
 
                 //TODO: I'm not sure if nodes are actually needed for defining cleanups like this...
                 //TODO: Mayyybe the cleanup mappings could just be defined in the GAS asset as static data.
@@ -422,7 +420,7 @@ void GAS::Load(AssetData& data)
                 }
 
                 UseNewIdleGasNode* node = new UseNewIdleGasNode();
-                node->newGas = gAssetManager.LoadAsset<GAS>(tokenizer.GetNext(), GetScope());
+                node->newGas = gAssetManager.LoadAsset<GAS>(std::string(tokenizer.GetNext()), GetScope());
                 node->forTalk = isUseTalk;
                 mNodes.push_back(node);
             }
@@ -449,7 +447,7 @@ void GAS::Load(AssetData& data)
             }
 
             NewIdleGasNode* node = new NewIdleGasNode();
-            node->newGas = gAssetManager.LoadAsset<GAS>(tokenizer.GetNext(), GetScope());
+            node->newGas = gAssetManager.LoadAsset<GAS>(std::string(tokenizer.GetNext()), GetScope());
             mNodes.push_back(node);
         }
         else if(StringUtil::EqualsIgnoreCase(command, "WHENNEAR") ||
@@ -461,7 +459,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing WHENNEAR/WHENNOLONGERNEAR noun in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string noun = tokenizer.GetNext();
+            std::string noun(tokenizer.GetNext());
 
             if(!tokenizer.HasNext())
             {
@@ -475,7 +473,7 @@ void GAS::Load(AssetData& data)
                 LOG_WARNING("Missing WHENNEAR/WHENNOLONGERNEAR label in GAS file %s!", mName.c_str());
                 continue;
             }
-            std::string label = tokenizer.GetNext();
+            std::string label(tokenizer.GetNext());
 
             // The last parameter (the other noun to measure distance from) is optional.
             // If not specified, distance is from GAS actor to noun.
@@ -504,7 +502,7 @@ void GAS::Load(AssetData& data)
             }
 
             // Attempt to load YAK using current language.
-            std::string yakName = tokenizer.GetNext();
+            std::string yakName(tokenizer.GetNext());
             Animation* yakAnimation = Localizer::LoadLocalizedAsset<Animation>(yakName, GetScope(), "yak");
             if(yakAnimation == nullptr)
             {
@@ -530,7 +528,7 @@ void GAS::Load(AssetData& data)
         }
         else
         {
-            LOG_WARNING("Unrecognized GAS command %s in GAS file %s!", line.c_str(), mName.c_str());
+            LOG_WARNING("Unrecognized GAS command %s in GAS file %s!", std::string(line).c_str(), mName.c_str());
         }
     }
 
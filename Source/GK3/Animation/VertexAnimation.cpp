@@ -249,7 +249,7 @@ VertexAnimationAABBPose VertexAnimation::SampleAABBPose(float time, int framesPe
     return invalidPose;
 }
 
-VertexAnimationVertexPose VertexAnimation::SampleVertexPose(int frame, int meshIndex, int submeshIndex)
+const Vector3* VertexAnimation::SampleVertexPose(int frame, int meshIndex, int submeshIndex)
 {
     // Find the first vertex pose defined for this mesh/submesh.
     VertexAnimationVertexPose* firstVertexPose = nullptr;
@@ -269,17 +269,15 @@ VertexAnimationVertexPose VertexAnimation::SampleVertexPose(int frame, int meshI
         VertexAnimationPose* pose = firstVertexPose->GetForFrame(frame);
         if(pose != nullptr)
         {
-            return *static_cast<VertexAnimationVertexPose*>(pose);
+            return static_cast<VertexAnimationVertexPose*>(pose)->vertexPositions.data();
         }
     }
 
-    // Error case: return something invalid.
-    VertexAnimationVertexPose invalidPose;
-    invalidPose.frameNumber = -1;
-    return invalidPose;
+    // Error case: no pose.
+    return nullptr;
 }
 
-VertexAnimationVertexPose VertexAnimation::SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex)
+const Vector3* VertexAnimation::SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex, std::frame_vector<Vector3>& scratch)
 {
     // Find the first vertex pose defined for this mesh/submesh.
     VertexAnimationVertexPose* firstVertexPose = nullptr;
@@ -315,27 +313,26 @@ VertexAnimationVertexPose VertexAnimation::SampleVertexPose(float time, int fram
         if(current != nullptr)
         {
             // If no next pose, we can just use the current pose directly.
+            VertexAnimationVertexPose* currentVertPose = static_cast<VertexAnimationVertexPose*>(current);
             if(next == nullptr)
             {
-                return *static_cast<VertexAnimationVertexPose*>(current);
+                return currentVertPose->vertexPositions.data();
             }
 
             // Now calculate interpolated positions between current and next poses for this time t.
-            VertexAnimationVertexPose* currentVertPose = static_cast<VertexAnimationVertexPose*>(current);
             VertexAnimationVertexPose* nextVertPose = static_cast<VertexAnimationVertexPose*>(next);
-            VertexAnimationVertexPose pose;
-            for(int i = 0; i < currentVertPose->vertexPositions.size(); i++)
+            size_t vertexCount = currentVertPose->vertexPositions.size();
+            scratch.resize(vertexCount);
+            for(size_t i = 0; i < vertexCount; i++)
             {
-                pose.vertexPositions.push_back(Vector3::Lerp(currentVertPose->vertexPositions[i], nextVertPose->vertexPositions[i], t));
+                scratch[i] = Vector3::Lerp(currentVertPose->vertexPositions[i], nextVertPose->vertexPositions[i], t);
             }
-            return pose;
+            return scratch.data();
         }
     }
 
-    // Error case: return something invalid.
-    VertexAnimationVertexPose invalidPose;
-    invalidPose.frameNumber = -1;
-    return invalidPose;
+    // Error case: no pose.
+    return nullptr;
 }
 
 Vector3 VertexAnimation::SampleVertexPosition(int frame, int meshIndex, int submeshIndex, int vertexIndex)
@@ -13,6 +13,7 @@
 #include <unordered_map>
 
 #include "AABB.h"
+#include "FrameAllocator.h"
 #include "Matrix4.h"
 #include "Vector3.h"
 
@@ -45,6 +46,8 @@ class VertexAnimation : public Asset
 {
     TYPEINFO_SUB(VertexAnimation, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Animation;
+
     VertexAnimation(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~VertexAnimation();
 
@@ -57,9 +60,10 @@ public:
     VertexAnimationAABBPose SampleAABBPose(int frame, int meshIndex);
     VertexAnimationAABBPose SampleAABBPose(float time, int framesPerSecond, int meshIndex);
 
-    // Queries ALL vertices for a submesh at a frame/time.
-    VertexAnimationVertexPose SampleVertexPose(int frame, int meshIndex, int submeshIndex);
-    VertexAnimationVertexPose SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex);
+    // Queries ALL vertices for a submesh at a frame/time. Returns null if there's no pose for the submesh.
+    // The result either points into the animation's own data, or (if interpolation is needed) into the provided scratch vector.
+    const Vector3* SampleVertexPose(int frame, int meshIndex, int submeshIndex);
+    const Vector3* SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex, std::frame_vector<Vector3>& scratch);
 
     // Queries single vertex for a submesh at a frame/time.
     Vector3 SampleVertexPosition(int frame, int meshIndex, int submeshIndex, int vertexIndex);
@@ -113,10 +113,10 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, int frame)
         const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
         for(size_t j = 0; j < submeshes.size(); j++)
         {
-            VertexAnimationVertexPose sample = animation->SampleVertexPose(frame, i, j);
-            if(sample.frameNumber >= 0)
+            const Vector3* positions = animation->SampleVertexPose(frame, i, j);
+            if(positions != nullptr)
             {
-                submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.vertexPositions.data()));
+                submeshes[j]->SetPositions(reinterpret_cast<const float*>(positions));
             }
         }
 
@@ -138,16 +138,18 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
 {
     // Iterate through each mesh and sample it in the vertex animation.
     // We need to sample both vertex poses and transform poses to get the right result.
+    // Interpolated vertex positions are written to a scratch buffer, which is reused for each submesh.
+    std::frame_vector<Vector3> scratch;
     const std::vector<Mesh*> meshes = mMeshRenderer->GetMeshes();
     for(size_t i = 0; i < meshes.size(); i++)
     {
         const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
         for(size_t j = 0; j < submeshes.size(); j++)
         {
-            VertexAnimationVertexPose sample = animation->SampleVertexPose(time, mCurrentParams.framesPerSecond, i, j);
-            if(sample.frameNumber >= 0)
+            const Vector3* positions = animation->SampleVertexPose(time, mCurrentParams.framesPerSecond, i, j, scratch);
+            if(positions != nullptr)
             {
-                submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.vertexPositions.data()));
+                submeshes[j]->SetPositions(reinterpret_cast<const float*>(positions));
             }
         }
 
@@ -114,6 +114,8 @@ class Soundtrack : public Asset
 {
     TYPEINFO_SUB(Soundtrack, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Audio;
+
     Soundtrack(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~Soundtrack();
 
@@ -4,6 +4,7 @@
 #include "ActionManager.h"
 #include "AudioListener.h"
 #include "Camera.h"
+#include "CollisionMesh.h"
 #include "Collisions.h"
 #include "CursorManager.h"
 #include "Debug.h"
@@ -12,7 +13,6 @@
 #include "GKObject.h"
 #include "InputManager.h"
 #include "InventoryManager.h"
-#include "Mesh.h"
 #include "Model.h"
 #include "OptionBar.h"
 #include "PersistState.h"
@@ -65,6 +65,13 @@ GameCamera::~GameCamera()
     gGK3UI.GetVideoPlayer()->AllowSkip(true);
 }
 
+void GameCamera::AddBounds(Model* model)
+{
+    // Build the collision mesh now, rather than on the first frame the camera moves.
+    model->GetCollisionMesh();
+    mBoundsModels.push_back(model);
+}
+
 void GameCamera::RemoveBounds(Model* model)
 {
     auto it = std::find(mBoundsModels.begin(), mBoundsModels.end(), model);
@@ -774,55 +781,19 @@ Vector3 GameCamera::ResolveCollisions(const Vector3& startPosition, const Vector
         }
         */
 
-        // Check collision against each individual triangle of each bounds model.
+        // Check collision against the triangles of each bounds model.
+        // Bounds models are positioned at (0,0,0) in world space, so their local space collision meshes are already in world space.
         for(auto& model : mBoundsModels)
         {
-            auto& meshes = model->GetMeshes();
-            for(auto& mesh : meshes)
+            float sphereT = 0.0f;
+            Vector3 normal;
+            Triangle triangle;
+            if(model->GetCollisionMesh().SweepSphere(sphere, currentMoveOffset, smallestT, sphereT, normal, triangle))
             {
-                // Bounds model is positioned at (0,0,0) in world space (so no need to multiply local to world...it's identity).
-                Matrix4 meshToWorld = mesh->GetMeshToLocalMatrix();
-
-                auto submeshes = mesh->GetSubmeshes();
-                for(auto& submesh : submeshes)
-                {
-                    int triangleCount = submesh->GetTriangleCount();
-                    for(int i = 0; i < triangleCount; ++i)
-                    {
-                        Vector3 p0, p1, p2;
-                        if(submesh->GetTriangle(i, p0, p1, p2))
-                        {
-                            // Transform triangle to world space.
-                            p0 = meshToWorld.TransformPoint(p0);
-                            p1 = meshToWorld.TransformPoint(p1);
-                            p2 = meshToWorld.TransformPoint(p2);
-                            Triangle triangle(p0, p1, p2);
-
-                            // Check collision and record the t/normal if it's smaller than any previously discovered one.
-                            float sphereT = 0.0f;
-                            Vector3 normal;
-                            if(Collide::SphereTriangle(sphere, triangle, currentMoveOffset, sphereT, normal))
-                            {
-                                // If a triangle reports a negative-t collision, it means we are already intersecting it.
-                                // We better be actively intersecting in this case.
-                                //TODO: Probably Collide::SphereTriangle should handle this internally?
-                                Vector3 intersectPoint;
-                                if(sphereT < 0.0f && !Intersect::TestSphereTriangle(sphere, triangle, intersectPoint))
-                                {
-                                    continue;
-                                }
-
-                                if(sphereT < smallestT)
-                                {
-                                    collided = true;
-                                    smallestT = sphereT;
-                                    collisionNormal = normal;
-                                    collideTriangle = triangle;
-                                }
-                            }
-                        }
-                    }
-                }
+                collided = true;
+                smallestT = sphereT;
+                collisionNormal = normal;
+                collideTriangle = triangle;
             }
         }
 
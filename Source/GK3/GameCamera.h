@@ -32,7 +32,7 @@ public:
     GameCamera();
     ~GameCamera();
 
-    void AddBounds(Model* model) { mBoundsModels.push_back(model); }
+    void AddBounds(Model* model);
     void RemoveBounds(Model* model);
     void SetBoundsEnabled(bool enabled) { mBoundsEnabled = enabled; }
 
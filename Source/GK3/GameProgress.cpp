@@ -93,7 +93,7 @@ void GameProgress::SetTimeblock(const Timeblock& timeblock)
     mTimeblock = timeblock;
 
     // Chat counts are reset on time block change.
-    mChatCounts.clear();
+    mChatCounts.Clear();
 }
 
 std::string GameProgress::GetTimeblockDisplayName() const
@@ -162,116 +162,131 @@ void GameProgress::StartTimeblock(const Timeblock& timeblock, bool loadingSave,
     });
 }
 
-int GameProgress::GetGameVariable(const std::string& varName) const
+int GameProgress::GetGameVariable(Symbol var) const
 {
-    auto it = mGameVariables.find(varName);
-    if(it != mGameVariables.end())
-    {
-        return it->second;
-    }
-    return 0;
+    const int* value = mGameVariables.Find(var);
+    return value != nullptr ? *value : 0;
 }
 
-void GameProgress::SetGameVariable(const std::string& varName, int value)
+int GameProgress::GetChatCount(Symbol noun) const
 {
-    mGameVariables[varName] = value;
+    const int* count = mChatCounts.Find(noun);
+    return count != nullptr ? *count : 0;
 }
 
-void GameProgress::IncGameVariable(const std::string& varName)
+int GameProgress::GetTopicCount(const std::string& noun, const std::string& topic) const
 {
-    ++mGameVariables[varName];
+    return GetTopicCount(Scene::GetEgoSymbol(), Symbol::Find(noun), Symbol::Find(topic));
 }
 
-int GameProgress::GetChatCount(const std::string& noun) const
+int GameProgress::GetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic) const
 {
-    auto it = mChatCounts.find(noun);
-    if(it != mChatCounts.end())
-    {
-        return it->second;
-    }
-    return 0;
+    return GetTopicCount(Symbol::Find(actor), Symbol::Find(noun), Symbol::Find(topic));
 }
 
-void GameProgress::SetChatCount(const std::string& noun, int count)
+int GameProgress::GetTopicCount(Symbol noun, Symbol topic) const
 {
-    mChatCounts[noun] = count;
+    return GetTopicCount(Scene::GetEgoSymbol(), noun, topic);
 }
 
-void GameProgress::IncChatCount(const std::string& noun)
+int GameProgress::GetTopicCount(Symbol actor, Symbol noun, Symbol topic) const
 {
-    ++mChatCounts[noun];
+    return GetCount(mTopicCounts, mLegacyTopicCounts, { actor, noun, topic });
 }
 
-int GameProgress::GetTopicCount(const std::string& noun, const std::string& topic) const
+void GameProgress::SetTopicCount(const std::string& noun, const std::string& topic, int count)
 {
-    return GetTopicCount(Scene::GetEgoName(), noun, topic);
+    SetTopicCount(Symbol(noun), Symbol(topic), count);
 }
 
-int GameProgress::GetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic) const
+void GameProgress::SetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic, int count)
 {
-    // Find and return, or return default.
-    auto it = mTopicCounts.find(actor + noun + topic);
-    if(it != mTopicCounts.end())
-    {
-        return it->second;
-    }
-    return 0;
+    GetCountForWrite(mTopicCounts, mLegacyTopicCounts, { Symbol(actor), Symbol(noun), Symbol(topic) }) = count;
 }
 
-void GameProgress::SetTopicCount(const std::string& noun, const std::string& topic, int count)
+void GameProgress::SetTopicCount(Symbol noun, Symbol topic, int count)
 {
-    SetTopicCount(Scene::GetEgoName(), noun, topic, count);
+    GetCountForWrite(mTopicCounts, mLegacyTopicCounts, { Scene::GetEgoSymbol(), noun, topic }) = count;
 }
 
-void GameProgress::SetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic, int count)
+void GameProgress::IncTopicCount(const std::string& noun, const std::string& topic)
 {
-    mTopicCounts[actor + noun + topic] = count;
+    IncTopicCount(Scene::GetEgoSymbol(), Symbol(noun), Symbol(topic));
 }
 
-void GameProgress::IncTopicCount(const std::string& noun, const std::string& topic)
+void GameProgress::IncTopicCount(const std::string& actor, const std::string& noun, const std::string& topic)
 {
-    IncTopicCount(Scene::GetEgoName(), noun, topic);
+    IncTopicCount(Symbol(actor), Symbol(noun), Symbol(topic));
 }
 
-void GameProgress::IncTopicCount(const std::string& actor, const std::string& noun, const std::string& topic)
+void GameProgress::IncTopicCount(Symbol noun, Symbol topic)
+{
+    IncTopicCount(Scene::GetEgoSymbol(), noun, topic);
+}
+
+void GameProgress::IncTopicCount(Symbol actor, Symbol noun, Symbol topic)
 {
-    ++mTopicCounts[actor + noun + topic];
+    ++GetCountForWrite(mTopicCounts, mLegacyTopicCounts, { actor, noun, topic });
 }
 
 int GameProgress::GetNounVerbCount(const std::string& noun, const std::string& verb) const
 {
-    return GetNounVerbCount(Scene::GetEgoName(), noun, verb);
+    return GetNounVerbCount(Scene::GetEgoSymbol(), Symbol::Find(noun), Symbol::Find(verb));
 }
 
 int GameProgress::GetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb) const
 {
-    // Find and return, or return default.
-    auto it = mNounVerbCounts.find(actor + noun + verb);
-    if(it != mNounVerbCounts.end())
-    {
-        return it->second;
-    }
-    return 0;
+    return GetNounVerbCount(Symbol::Find(actor), Symbol::Find(noun), Symbol::Find(verb));
+}
+
+int GameProgress::GetNounVerbCount(Symbol noun, Symbol verb) const
+{
+    return GetNounVerbCount(Scene::GetEgoSymbol(), noun, verb);
+}
+
+int GameProgress::GetNounVerbCount(Symbol actor, Symbol noun, Symbol verb) const
+{
+    return GetCount(mNounVerbCounts, mLegacyNounVerbCounts, { actor, noun, verb });
 }
 
 void GameProgress::SetNounVerbCount(const std::string& noun, const std::string& verb, int count)
 {
-    SetNounVerbCount(Scene::GetEgoName(), noun, verb, count);
+    SetNounVerbCount(Scene::GetEgoSymbol(), Symbol(noun), Symbol(verb), count);
 }
 
 void GameProgress::SetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb, int count)
 {
-    mNounVerbCounts[actor + noun + verb] = count;
+    SetNounVerbCount(Symbol(actor), Symbol(noun), Symbol(verb), count);
+}
+
+void GameProgress::SetNounVerbCount(Symbol noun, Symbol verb, int count)
+{
+    SetNounVerbCount(Scene::GetEgoSymbol(), noun, verb, count);
+}
+
+void GameProgress::SetNounVerbCount(Symbol actor, Symbol noun, Symbol verb, int count)
+{
+    GetCountForWrite(mNounVerbCounts, mLegacyNounVerbCounts, { actor, noun, verb }) = count;
 }
 
 void GameProgress::IncNounVerbCount(const std::string& noun, const std::string& verb)
 {
-    IncNounVerbCount(Scene::GetEgoName(), noun, verb);
+    IncNounVerbCount(Scene::GetEgoSymbol(), Symbol(noun), Symbol(verb));
 }
 
 void GameProgress::IncNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb)
 {
-    ++mNounVerbCounts[actor + noun + verb];
+    IncNounVerbCount(Symbol(actor), Symbol(noun), Symbol(verb));
+}
+
+void GameProgress::IncNounVerbCount(Symbol noun, Symbol verb)
+{
+    IncNounVerbCount(Scene::GetEgoSymbol(), noun, verb);
+}
+
+void GameProgress::IncNounVerbCount(Symbol actor, Symbol noun, Symbol verb)
+{
+    ++GetCountForWrite(mNounVerbCounts, mLegacyNounVerbCounts, { actor, noun, verb });
 }
 
 void GameProgress::OnPersist(PersistState& ps)
@@ -286,12 +301,90 @@ void GameProgress::OnPersist(PersistState& ps)
 
     ps.Xfer(PERSIST_VAR(mChangingTimeblock));
 
-    // Because I'm grabbing the flags from inside the FlagSet, auto-generating the variable name doesn't look right...
-    // Maybe should just put OnPersist in FlagSet?
-    ps.Xfer("mGameFlags", mGameFlags.GetFlags());
+    mGameFlags.OnPersist(ps, "mGameFlags");
 
     ps.Xfer(PERSIST_VAR(mChatCounts));
-    ps.Xfer(PERSIST_VAR(mTopicCounts));
-    ps.Xfer(PERSIST_VAR(mNounVerbCounts));
+    PersistCounts(ps, "mTopicCounts", mTopicCounts, mLegacyTopicCounts);
+    PersistCounts(ps, "mNounVerbCounts", mNounVerbCounts, mLegacyNounVerbCounts);
     ps.Xfer(PERSIST_VAR(mGameVariables));
+}
+
+int GameProgress::GetCount(const CountMap& counts, const std::string_map_ci<int>& legacyCounts, const CountKey& key) const
+{
+    // Find and return, or return default.
+    const int* count = counts.Find(key);
+    if(count != nullptr)
+    {
+        return *count;
+    }
+
+    // Only if an older save was loaded do we need to fall back on the concatenated key.
+    if(!legacyCounts.empty())
+    {
+        auto it = legacyCounts.find(key.actor.GetName() + key.noun.GetName() + key.verb.GetName());
+        if(it != legacyCounts.end())
+        {
+            return it->second;
+        }
+    }
+    return 0;
+}
+
+int& GameProgress::GetCountForWrite(CountMap& counts, std::string_map_ci<int>& legacyCounts, const CountKey& key)
+{
+    // If this count only exists in the legacy data, move it over, so the legacy entry doesn't shadow future changes.
+    if(!legacyCounts.empty() && !counts.Contains(key))
+    {
+        auto it = legacyCounts.find(key.actor.GetName() + key.noun.GetName() + key.verb.GetName());
+        if(it != legacyCounts.end())
+        {
+            counts[key] = it->second;
+            legacyCounts.erase(it);
+        }
+    }
+    return counts[key];
+}
+
+void GameProgress::PersistCounts(PersistState& ps, const char* name, CountMap& counts, std::string_map_ci<int>& legacyCounts)
+{
+    // Save versions 1-4 keyed counts by a single concatenated string.
+    if(ps.GetFormatVersionNumber() < 5)
+    {
+        if(ps.IsLoading())
+        {
+            counts.Clear();
+        }
+        ps.Xfer(name, legacyCounts);
+        return;
+    }
+
+    // Newer versions save each key's names separately, so they can be converted back to symbols on load.
+    BinaryReader* reader = ps.GetBinaryReader();
+    BinaryWriter* writer = ps.GetBinaryWriter();
+    if(reader != nullptr)
+    {
+        counts.Clear();
+        uint64_t size = reader->ReadULong();
+        counts.Reserve(static_cast<size_t>(size));
+        for(uint64_t i = 0; i < size; ++i)
+        {
+            CountKey key;
+            key.actor = Symbol(reader->ReadString32());
+            key.noun = Symbol(reader->ReadString32());
+            key.verb = Symbol(reader->ReadString32());
+            counts[key] = reader->ReadInt();
+        }
+    }
+    else if(writer != nullptr)
+    {
+        writer->WriteULong(counts.Size());
+        for(auto& entry : counts)
+        {
+            writer->WriteString32(entry.first.actor.GetName());
+            writer->WriteString32(entry.first.noun.GetName());
+            writer->WriteString32(entry.first.verb.GetName());
+            writer->WriteInt(entry.second);
+        }
+    }
+    ps.Xfer(name, legacyCounts);
 }
\ No newline at end of file
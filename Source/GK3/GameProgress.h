@@ -12,6 +12,7 @@
 #include "FlagSet.h"
 #include "PersistState.h"
 #include "StringUtil.h"
+#include "Symbol.h"
 #include "Timeblock.h"
 
 class GameProgress
@@ -38,37 +39,62 @@ public:
     void StartTimeblock(const Timeblock& timeblock, bool loadingSave, const std::function<void()>& callback);
     bool IsChangingTimeblock() const { return mChangingTimeblock; }
 
+    // All game logic state is keyed by symbol. Names used by game data (NVC, SIF, Sheep) are interned when loaded, so those callers pass symbols.
+    // Functions that take names are for code-driven logic: getters only look the name up (a never-interned name can't have a value), setters intern it.
+
     // Flags
     bool GetFlag(const std::string& flagName) const { return mGameFlags.Get(flagName); }
     void SetFlag(const std::string& flagName) { mGameFlags.Set(flagName); }
     void ClearFlag(const std::string& flagName) { mGameFlags.Clear(flagName); }
+    bool GetFlag(Symbol flag) const { return mGameFlags.Get(flag); }
+    void SetFlag(Symbol flag) { mGameFlags.Set(flag); }
+    void ClearFlag(Symbol flag) { mGameFlags.Clear(flag); }
     void DumpFlags() const { mGameFlags.Dump("game"); }
 
     // Game Variables
-    int GetGameVariable(const std::string& varName) const;
-    void SetGameVariable(const std::string& varName, int value);
-    void IncGameVariable(const std::string& varName);
+    int GetGameVariable(const std::string& varName) const { return GetGameVariable(Symbol::Find(varName)); }
+    void SetGameVariable(const std::string& varName, int value) { SetGameVariable(Symbol(varName), value); }
+    void IncGameVariable(const std::string& varName) { IncGameVariable(Symbol(varName)); }
+    int GetGameVariable(Symbol var) const;
+    void SetGameVariable(Symbol var, int value) { mGameVariables[var] = value; }
+    void IncGameVariable(Symbol var) { ++mGameVariables[var]; }
 
     // Chat Counts
-    int GetChatCount(const std::string& noun) const;
-    void SetChatCount(const std::string&, int count);
-    void IncChatCount(const std::string& noun);
+    int GetChatCount(const std::string& noun) const { return GetChatCount(Symbol::Find(noun)); }
+    void SetChatCount(const std::string& noun, int count) { SetChatCount(Symbol(noun), count); }
+    void IncChatCount(const std::string& noun) { IncChatCount(Symbol(noun)); }
+    int GetChatCount(Symbol noun) const;
+    void SetChatCount(Symbol noun, int count) { mChatCounts[noun] = count; }
+    void IncChatCount(Symbol noun) { ++mChatCounts[noun]; }
 
     // Topic Counts
+    // Versions without an actor use the current ego.
     int GetTopicCount(const std::string& noun, const std::string& topic) const;
     int GetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic) const;
     void SetTopicCount(const std::string& noun, const std::string& topic, int count);
     void SetTopicCount(const std::string& actor, const std::string& noun, const std::string& topic, int count);
     void IncTopicCount(const std::string& noun, const std::string& topic);
     void IncTopicCount(const std::string& actor, const std::string& noun, const std::string& topic);
+    int GetTopicCount(Symbol noun, Symbol topic) const;
+    int GetTopicCount(Symbol actor, Symbol noun, Symbol topic) const;
+    void SetTopicCount(Symbol noun, Symbol topic, int count);
+    void IncTopicCount(Symbol noun, Symbol topic);
+    void IncTopicCount(Symbol actor, Symbol noun, Symbol topic);
 
     // Noun/Verb Counts
+    // Versions without an actor use the current ego.
     int GetNounVerbCount(const std::string& noun, const std::string& verb) const;
     int GetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb) const;
     void SetNounVerbCount(const std::string& noun, const std::string& verb, int count);
     void SetNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb, int count);
     void IncNounVerbCount(const std::string& noun, const std::string& verb);
     void IncNounVerbCount(const std::string& actor, const std::string& noun, const std::string& verb);
+    int GetNounVerbCount(Symbol noun, Symbol verb) const;
+    int GetNounVerbCount(Symbol actor, Symbol noun, Symbol verb) const;
+    void SetNounVerbCount(Symbol noun, Symbol verb, int count);
+    void SetNounVerbCount(Symbol actor, Symbol noun, Symbol verb, int count);
+    void IncNounVerbCount(Symbol noun, Symbol verb);
+    void IncNounVerbCount(Symbol actor, Symbol noun, Symbol verb);
 
     void OnPersist(PersistState& ps);
 
@@ -94,19 +120,46 @@ private:
     FlagSet mGameFlags;
 
     // Tracks the number of times the player has chatted with a noun.
-    std::string_map_ci<int> mChatCounts;
-
-    // Maps noun/topic combos to a count value.
+    SymbolMap<int> mChatCounts;
+
+    // Topic and noun/verb counts are tracked separately for each ego (actor).
+    struct CountKey
+    {
+        Symbol actor;
+        Symbol noun;
+        Symbol verb;
+
+        bool operator==(const CountKey& other) const { return actor == other.actor && noun == other.noun && verb == other.verb; }
+    };
+    struct CountKeyHash
+    {
+        size_t operator()(const CountKey& key) const
+        {
+            return (static_cast<size_t>(key.actor.GetId()) * 31 + key.noun.GetId()) * 31 + key.verb.GetId();
+        }
+    };
+    using CountMap = FlatMap<CountKey, int, CountKeyHash>;
+
+    // Maps actor/noun/topic combos to a count value.
     // Tracks the number of times we've talked to a noun about a topic.
-    std::string_map_ci<int> mTopicCounts;
+    CountMap mTopicCounts;
 
-    // Maps noun/verb to a count value.
+    // Maps actor/noun/verb to a count value.
     // Tracks the number of times we've triggered a verb on a noun.
-    std::string_map_ci<int> mNounVerbCounts;
+    CountMap mNounVerbCounts;
+
+    // Counts loaded from older save files, which keyed counts by a concatenated "actor+noun+verb" string.
+    // These can't be split back into symbols, so they're checked as a fallback until overwritten.
+    std::string_map_ci<int> mLegacyTopicCounts;
+    std::string_map_ci<int> mLegacyNounVerbCounts;
 
     // Maps a variable name to an integer value.
     // For general game logic variables.
-    std::string_map_ci<int> mGameVariables;
+    SymbolMap<int> mGameVariables;
+
+    int GetCount(const CountMap& counts, const std::string_map_ci<int>& legacyCounts, const CountKey& key) const;
+    int& GetCountForWrite(CountMap& counts, std::string_map_ci<int>& legacyCounts, const CountKey& key);
+    void PersistCounts(PersistState& ps, const char* name, CountMap& counts, std::string_map_ci<int>& legacyCounts);
 };
 
 extern GameProgress gGameProgress;
\ No newline at end of file
@@ -40,6 +40,7 @@
 #include "WalkerBoundary.h"
 
 std::string Scene::mEgoName;
+Symbol Scene::mEgoSymbol;
 
 /*static*/ const char* Scene::GetEgoName()
 {
@@ -131,6 +132,7 @@ void Scene::Load()
     if(mEgoSceneActor != nullptr)
     {
         mEgoName = mEgoSceneActor->noun;
+        mEgoSymbol = Symbol(mEgoName);
     }
 
     // Based on location, timeblock, and game progress, resolve what data we will load into the current scene.
@@ -425,44 +427,52 @@ namespace
 
 SceneCastResult Scene::Raycast(const Ray& ray, bool interactiveOnly, GKObject** ignore, int ignoreCount) const
 {
-    // First, iterate all Props and Actors to find the closest one that was hit by the ray and meets our criteria (if any).
+    // First, find the closest Prop or Actor that was hit by the ray and meets our criteria (if any).
+    // The raycast tree gives us only objects whose bounds the ray passes through, closest first.
+    UpdateRaycastTree();
     SceneCastResult result;
-    for(GKObject* object : mAllGKObjects)
-    {
-        // Ignore inactive objects.
-        if(!object->IsActive()) { continue; }
 
-        // Completely ignore anything in the ignore list. It doesn't exist to us.
-        if(IsInIgnoreList(ignore, ignoreCount, object)) { continue; }
+    // The tree works in units of the ray's direction, but hit distances are in world units.
+    float rayDirectionLength = ray.direction.GetLength();
+    mRaycastTree.Raycast(ray, FLT_MAX, [&](int proxyId) {
+        GKObject* object = static_cast<GKObject*>(mRaycastTree.GetUserData(proxyId));
 
-        // See if the ray hits this object's 3D model.
-        RaycastHit hitInfo;
-        MeshRenderer* meshRenderer = object->GetMeshRenderer();
-        if(meshRenderer != nullptr && meshRenderer->Raycast(ray, hitInfo))
+        // Ignore inactive objects.
+        // Completely ignore anything in the ignore list. It doesn't exist to us.
+        if(object->IsActive() && !IsInIgnoreList(ignore, ignoreCount, object))
         {
-            hitInfo.name = object->GetNoun();
-            RaycastTool::LogRaycastHit(hitInfo);
-
-            // We did hit the 3D model, but is it closer than anything else we've hit thus far?
-            if(hitInfo.t < result.hitInfo.t)
+            // See if the ray hits this object's 3D model.
+            RaycastHit hitInfo;
+            MeshRenderer* meshRenderer = object->GetMeshRenderer();
+            if(meshRenderer->Raycast(ray, hitInfo))
             {
-                // It is the closest thing we've hit so far! Update the hit info struct.
-                //printf("Raycast hit prop/actor %s, noun=%s t=%f\n", object->GetName().c_str(), object->GetNoun().c_str(), hitInfo.t);
-                result.hitInfo = hitInfo;
+                hitInfo.name = object->GetNoun();
+                RaycastTool::LogRaycastHit(hitInfo);
 
-                // BUT what if the closest thing we hit is non-interactive, and we only care about interactive things?
-                // In this case, the non-interactive thing OBSCURES any previous interactive thing. Null out the hit object pointer!
-                if(interactiveOnly && !object->CanInteract())
-                {
-                    result.hitObject = nullptr;
-                }
-                else
+                // We did hit the 3D model, but is it closer than anything else we've hit thus far?
+                if(hitInfo.t < result.hitInfo.t)
                 {
-                    result.hitObject = object;
+                    // It is the closest thing we've hit so far! Update the hit info struct.
+                    //printf("Raycast hit prop/actor %s, noun=%s t=%f\n", object->GetName().c_str(), object->GetNoun().c_str(), hitInfo.t);
+                    result.hitInfo = hitInfo;
+
+                    // BUT what if the closest thing we hit is non-interactive, and we only care about interactive things?
+                    // In this case, the non-interactive thing OBSCURES any previous interactive thing. Null out the hit object pointer!
+                    if(interactiveOnly && !object->CanInteract())
+                    {
+                        result.hitObject = nullptr;
+                    }
+                    else
+                    {
+                        result.hitObject = object;
+                    }
                 }
             }
         }
-    }
+
+        // Anything farther away than the closest hit so far can't be the result, so don't bother testing it.
+        return result.hitInfo.t < FLT_MAX ? result.hitInfo.t / rayDirectionLength : FLT_MAX;
+    });
 
     // The raycast logic for Actors/Props doesn't automatically fill in the HitInfo name field.
     // So, if something was hit, do that now.
@@ -1362,14 +1372,29 @@ GKActor* Scene::CreateSceneActor(const SceneActor* sceneActor)
 void Scene::ApplyAmbientLightColorToActors()
 {
     // Apply ambient light to actors.
-    for(GKActor* actor : mActors)
+    BSP* bsp = GetBSP();
+    mAmbientLightCache.resize(mActors.size());
+    for(size_t i = 0; i < mActors.size(); ++i)
     {
+        GKActor* actor = mActors[i];
+
         // Use the "model position" rather than the "actor position" for more accurate lighting.
         // For example, in RC1, Buthane's actor position is way outside the map (dark color), but her model is near the van.
-        Color32 ambientColor = GetBSP()->CalculateAmbientLightColor(actor->GetFloorPosition());
+        // Most actors stand still most of the time, so only recalculate the color if the actor moved.
+        Vector3 floorPosition = actor->GetFloorPosition();
+        AmbientLightCache& cache = mAmbientLightCache[i];
+        if(cache.bsp != bsp || cache.lightChangeCount != bsp->GetAmbientLightChangeCount() || cache.floorPosition != floorPosition)
+        {
+            cache.bsp = bsp;
+            cache.lightChangeCount = bsp->GetAmbientLightChangeCount();
+            cache.floorPosition = floorPosition;
+            cache.color = bsp->CalculateAmbientLightColor(floorPosition);
+        }
+
+        // Materials can be swapped out at any time (e.g. when the model changes), so always apply the color.
         for(Material& material : actor->GetMeshRenderer()->GetMaterials())
         {
-            material.SetColor("uAmbientColor", ambientColor);
+            material.SetColor("uAmbientColor", cache.color);
         }
     }
 
@@ -1382,6 +1407,40 @@ BSP* Scene::GetBSP() const
     return mSceneData != nullptr ? mSceneData->GetBSP() : nullptr;
 }
 
+void Scene::UpdateRaycastTree() const
+{
+    mRaycastProxies.resize(mAllGKObjects.size());
+    for(size_t i = 0; i < mAllGKObjects.size(); ++i)
+    {
+        GKObject* object = mAllGKObjects[i];
+        RaycastProxy& proxy = mRaycastProxies[i];
+
+        // Only objects with 3D models can be hit by raycasts.
+        MeshRenderer* meshRenderer = object->GetMeshRenderer();
+        if(meshRenderer == nullptr || meshRenderer->GetMeshes().empty())
+        {
+            if(proxy.proxyId != AABBTree::kNullProxy)
+            {
+                mRaycastTree.Remove(proxy.proxyId);
+                proxy.proxyId = AABBTree::kNullProxy;
+            }
+            continue;
+        }
+
+        // Only recalculate bounds if something changed since last time.
+        uint32_t boundsChangeCount = meshRenderer->GetBoundsChangeCount();
+        if(proxy.proxyId == AABBTree::kNullProxy)
+        {
+            proxy.proxyId = mRaycastTree.Insert(meshRenderer->GetWorldBounds(), object);
+        }
+        else if(proxy.boundsChangeCount != boundsChangeCount)
+        {
+            mRaycastTree.Move(proxy.proxyId, meshRenderer->GetWorldBounds());
+        }
+        proxy.boundsChangeCount = boundsChangeCount;
+    }
+}
+
 void Scene::ExecuteAction(const Action* action)
 {
     // Ignore nulls.
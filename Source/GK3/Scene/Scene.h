@@ -15,10 +15,13 @@
 #include <string>
 #include <vector>
 
+#include "AABBTree.h"
 #include "Collisions.h"
+#include "Color32.h"
 #include "SceneConstruction.h"
 #include "SceneData.h"
 #include "SceneLayer.h"
+#include "Symbol.h"
 #include "Timeblock.h"
 
 class ActionBar;
@@ -48,6 +51,7 @@ class Scene
 {
 public:
     static const char* GetEgoName();
+    static Symbol GetEgoSymbol() { return mEgoSymbol; }
 
     static Animator* GetGlobalAnimator();
     static Animator* GetActiveAnimator();
@@ -153,9 +157,30 @@ private:
     // That includes: GKActors, GKProps, and all BSPActors (including hit tests). EVERYTHING!
     std::vector<GKObject*> mAllGKObjects;
 
+    // A broadphase for raycasts against objects' 3D models, so a raycast only tests the few objects it could possibly hit.
+    // Proxies are parallel to mAllGKObjects, and are brought up to date at the start of each raycast (only for objects whose bounds changed).
+    struct RaycastProxy
+    {
+        int proxyId = AABBTree::kNullProxy;
+        uint32_t boundsChangeCount = 0;
+    };
+    mutable AABBTree mRaycastTree;
+    mutable std::vector<RaycastProxy> mRaycastProxies;
+
     // All the GKActors spawned into the scene - basically all human or animal objects.
     std::vector<GKActor*> mActors;
 
+    // The ambient light color last calculated for each actor (parallel to mActors).
+    // Ambient color only depends on floor position, so it's only recalculated when an actor moves (or the BSP's lights change).
+    struct AmbientLightCache
+    {
+        const BSP* bsp = nullptr;
+        uint32_t lightChangeCount = 0;
+        Vector3 floorPosition;
+        Color32 color;
+    };
+    std::vector<AmbientLightCache> mAmbientLightCache;
+
     // All the GKProps spawned into the scene - usually simple objects that can animate or move.
     std::vector<GKProp*> mProps;
 
@@ -176,6 +201,7 @@ private:
     // The name of the last Ego the player was controlling, including the current scene.
     // This is static so we can query who was the last Ego even if a scene is not loaded (e.g. on the Map).
     static std::string mEgoName;
+    static Symbol mEgoSymbol;
 
     // The most recently "active" object.
     // In other words, the last object the action bar was shown for.
@@ -199,6 +225,7 @@ private:
 
     void ApplyAmbientLightColorToActors();
     BSP* GetBSP() const;
+    void UpdateRaycastTree() const;
     void ExecuteAction(const Action* action);
 };
 
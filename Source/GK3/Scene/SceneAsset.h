@@ -46,6 +46,8 @@ class SceneAsset : public Asset
 {
     TYPEINFO_SUB(SceneAsset, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Scene;
+
     static void FixGK3SkyboxTextures(SkyboxTextures& skyboxTextures);
 
     SceneAsset(const std::string& name, AssetScope scope) : Asset(name, scope) { }
@@ -78,6 +78,9 @@ public:
     // CONVERSATIONS
     std::vector<const SceneConversation*> GetConversationSettings(const std::string& conversationName) const;
 
+    // ACTIONS
+    const std::vector<NVC*>& GetActionSets() const { return mActionSets; }
+
     const SceneModel* FindSceneModelForLoad(const std::string& modelName);
     const SceneActor* FindSceneActorForLoad(const std::string& modelName);
 
@@ -202,7 +202,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
     parser.ReadAll();
 
     // Read in general section.
-    std::vector<IniSection> generals = parser.GetSections("GENERAL");
+    std::vector<IniSectionView> generals = parser.GetSectionViews("GENERAL");
     for(auto& section : generals)
     {
         mGeneralBlocks.emplace_back();
@@ -213,13 +213,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         {
             // Why is this called "Int Evaluation"? Not sure - but testing in GK3 seems to suggest it is...
             general.conditionText = section.condition;
-            general.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            general.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Handle all key/value pairs in this block.
         for(auto& line : section.lines)
         {
-            IniKeyValue& first = line.entries.front();
+            IniKeyValueView& first = line.entries.front();
             if(StringUtil::EqualsIgnoreCase(first.key, "scene"))
             {
                 general.sceneAssetName = first.value;
@@ -237,7 +237,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 // This is used as a 2D overlay on the X/Z plane to determine walkable area.
                 for(size_t i = 1; i < line.entries.size(); ++i)
                 {
-                    IniKeyValue& keyValue = line.entries[i];
+                    IniKeyValueView& keyValue = line.entries[i];
                     if(StringUtil::EqualsIgnoreCase(keyValue.key, "size"))
                     {
                         general.walkerBoundarySize = keyValue.GetValueAsVector2();
@@ -251,12 +251,12 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             else if(StringUtil::EqualsIgnoreCase(first.key, "cameraBounds"))
             {
                 // Add to bounds model names.
-                general.cameraBoundsModelNames.push_back(first.value);
+                general.cameraBoundsModelNames.emplace_back(first.value);
 
                 // One possible option: a type.
                 if(line.entries.size() > 1)
                 {
-                    IniKeyValue& keyValue = line.entries[1];
+                    IniKeyValueView& keyValue = line.entries[1];
 
                     //TODO: Based on search of assets, this behavior seems never to be used (even though it is documented). So...get rid of it?
                     if(StringUtil::EqualsIgnoreCase(keyValue.key, "type"))
@@ -269,7 +269,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             {
                 for(size_t i = 1; i < line.entries.size(); ++i)
                 {
-                    IniKeyValue& keyValue = line.entries[i];
+                    IniKeyValueView& keyValue = line.entries[i];
                     if(StringUtil::EqualsIgnoreCase(keyValue.key, "pos"))
                     {
                         general.globalLightPosition = keyValue.GetValueAsVector3();
@@ -285,7 +285,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             {
                 for(size_t i = 1; i < line.entries.size(); ++i)
                 {
-                    IniKeyValue& keyValue = line.entries[i];
+                    IniKeyValueView& keyValue = line.entries[i];
                     if(StringUtil::EqualsIgnoreCase(keyValue.key, "left"))
                     {
                         general.skyboxLeftTextureName = keyValue.value;
@@ -316,7 +316,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
     }
 
     // Read in cameras.
-    std::vector<IniSection> inspectCameras = parser.GetSections("INSPECT_CAMERAS");
+    std::vector<IniSectionView> inspectCameras = parser.GetSectionViews("INSPECT_CAMERAS");
     for(auto& section : inspectCameras)
     {
         mInspectCameras.emplace_back();
@@ -326,7 +326,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             cameraBlock.conditionText = section.condition;
-            cameraBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            cameraBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Handle creation of each camera in this block.
@@ -360,7 +360,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
-    std::vector<IniSection> roomCameras = parser.GetSections("ROOM_CAMERAS");
+    std::vector<IniSectionView> roomCameras = parser.GetSectionViews("ROOM_CAMERAS");
     for(auto& section : roomCameras)
     {
         mRoomCameras.emplace_back();
@@ -370,7 +370,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             cameraBlock.conditionText = section.condition;
-            cameraBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            cameraBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Handle creation of each camera in this block.
@@ -380,13 +380,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             RoomSceneCamera& camera = cameraBlock.items.back();
 
             // First keyword for room cameras is always the camera name.
-            IniKeyValue& first = line.entries.front();
+            IniKeyValueView& first = line.entries.front();
             camera.label = first.key;
 
             // Followed by one or more optional attributes.
             for(size_t i = 1; i < line.entries.size(); ++i)
             {
-                IniKeyValue& keyValue = line.entries[i];
+                IniKeyValueView& keyValue = line.entries[i];
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "pos"))
                 {
                     camera.position = keyValue.GetValueAsVector3();
@@ -412,7 +412,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
-    std::vector<IniSection> cinematicCameras = parser.GetSections("CINEMATIC_CAMERAS");
+    std::vector<IniSectionView> cinematicCameras = parser.GetSectionViews("CINEMATIC_CAMERAS");
     for(auto& section : cinematicCameras)
     {
         mCinematicCameras.emplace_back();
@@ -422,7 +422,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             cameraBlock.conditionText = section.condition;
-            cameraBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            cameraBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Handle creation of each camera in this block.
@@ -432,13 +432,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             SceneCamera& camera = cameraBlock.items.back();
 
             // First keyword for cinematic cameras is always the camera name.
-            IniKeyValue& first = line.entries.front();
+            IniKeyValueView& first = line.entries.front();
             camera.label = first.key;
 
             // Followed by one or more optional attributes.
             for(size_t i = 1; i < line.entries.size(); ++i)
             {
-                IniKeyValue& keyValue = line.entries[i];
+                IniKeyValueView& keyValue = line.entries[i];
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "pos"))
                 {
                     camera.position = keyValue.GetValueAsVector3();
@@ -458,7 +458,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
-    std::vector<IniSection> DialogueSceneCameras = parser.GetSections("DIALOGUE_CAMERAS");
+    std::vector<IniSectionView> DialogueSceneCameras = parser.GetSectionViews("DIALOGUE_CAMERAS");
     for(auto& section : DialogueSceneCameras)
     {
         mDialogueCameras.emplace_back();
@@ -468,7 +468,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             cameraBlock.conditionText = section.condition;
-            cameraBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            cameraBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Create each camera in this block.
@@ -478,13 +478,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             DialogueSceneCamera& camera = cameraBlock.items.back();
 
             // First keyword for dialogue cameras is always the camera name.
-            IniKeyValue& first = line.entries.front();
+            IniKeyValueView& first = line.entries.front();
             camera.label = first.key;
 
             // Followed by one or more optional attributes.
             for(size_t i = 1; i < line.entries.size(); ++i)
             {
-                IniKeyValue& keyValue = line.entries[i];
+                IniKeyValueView& keyValue = line.entries[i];
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "pos"))
                 {
                     camera.position = keyValue.GetValueAsVector3();
@@ -526,7 +526,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
     }
 
     // Read in positions.
-    std::vector<IniSection> positionSections = parser.GetSections("POSITIONS");
+    std::vector<IniSectionView> positionSections = parser.GetSectionViews("POSITIONS");
     for(auto& section : positionSections)
     {
         mPositions.emplace_back();
@@ -536,7 +536,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             positionBlock.conditionText = section.condition;
-            positionBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            positionBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Create each scene position.
@@ -546,13 +546,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             ScenePosition& position = positionBlock.items.back();
 
             // First pair is always the identifier.
-            IniKeyValue& first = line.entries.front();
+            IniKeyValueView& first = line.entries.front();
             position.label = first.key;
 
             // Followed by one or more optional attributes.
             for(size_t i = 1; i < line.entries.size(); ++i)
             {
-                IniKeyValue& keyValue = line.entries[i];
+                IniKeyValueView& keyValue = line.entries[i];
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "pos"))
                 {
                     position.position = keyValue.GetValueAsVector3();
@@ -570,7 +570,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
     }
 
     // Read in actors.
-    std::vector<IniSection> actorSections = parser.GetSections("ACTORS");
+    std::vector<IniSectionView> actorSections = parser.GetSectionViews("ACTORS");
     for(auto& section : actorSections)
     {
         mActors.emplace_back();
@@ -580,7 +580,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             actorBlock.conditionText = section.condition;
-            actorBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            actorBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Create each actor defined in the block.
@@ -593,12 +593,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             {
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "model"))
                 {
-                    actor.model = gAssetManager.LoadAsset<Model>(keyValue.value, GetScope());
+                    actor.model = gAssetManager.LoadAsset<Model>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "noun"))
                 {
                     actor.noun = keyValue.value;
                     StringUtil::ToUpper(actor.noun);
+                    actor.nounSymbol = Symbol(actor.noun);
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "pos"))
                 {
@@ -606,19 +607,19 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "idle"))
                 {
-                    actor.idleGas = gAssetManager.LoadAsset<GAS>(keyValue.value, GetScope());
+                    actor.idleGas = gAssetManager.LoadAsset<GAS>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "talk"))
                 {
-                    actor.talkGas = gAssetManager.LoadAsset<GAS>(keyValue.value, GetScope());
+                    actor.talkGas = gAssetManager.LoadAsset<GAS>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "listen"))
                 {
-                    actor.listenGas = gAssetManager.LoadAsset<GAS>(keyValue.value, GetScope());
+                    actor.listenGas = gAssetManager.LoadAsset<GAS>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "initAnim"))
                 {
-                    actor.initAnim = gAssetManager.LoadAsset<Animation>(keyValue.value, GetScope());
+                    actor.initAnim = gAssetManager.LoadAsset<Animation>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "hidden"))
                 {
@@ -633,7 +634,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
     }
 
     // Read in models.
-    std::vector<IniSection> modelSections = parser.GetSections("MODELS");
+    std::vector<IniSectionView> modelSections = parser.GetSectionViews("MODELS");
     for(auto& section : modelSections)
     {
         mModels.emplace_back();
@@ -643,7 +644,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             modelBlock.conditionText = section.condition;
-            modelBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            modelBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Create each model defined in block.
@@ -662,6 +663,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 {
                     model.noun = keyValue.value;
                     StringUtil::ToUpper(model.noun);
+                    model.nounSymbol = Symbol(model.noun);
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "type"))
                 {
@@ -685,10 +687,11 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "verb"))
                 {
                     model.verb = keyValue.value;
+                    model.verbSymbol = Symbol(model.verb);
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "initanim"))
                 {
-                    model.initAnim = gAssetManager.LoadAsset<Animation>(keyValue.value, GetScope());
+                    model.initAnim = gAssetManager.LoadAsset<Animation>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "hidden"))
                 {
@@ -696,7 +699,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "gas"))
                 {
-                    model.gas = gAssetManager.LoadAsset<GAS>(keyValue.value, GetScope());
+                    model.gas = gAssetManager.LoadAsset<GAS>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "fullColor"))
                 {
@@ -727,7 +730,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
     }
 
     // Read in regions and triggers.
-    std::vector<IniSection> regionSections = parser.GetSections("REGIONS");
+    std::vector<IniSectionView> regionSections = parser.GetSectionViews("REGIONS");
     for(auto& section : regionSections)
     {
         mRegions.emplace_back();
@@ -737,7 +740,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             regionBlock.conditionText = section.condition;
-            regionBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            regionBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Create each region.
@@ -747,13 +750,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
             SceneRegionOrTrigger& region = regionBlock.items.back();
 
             // First pair is always the identifier.
-            IniKeyValue& first = line.entries.front();
+            IniKeyValueView& first = line.entries.front();
             region.label = first.key;
 
             // Followed by one or more optional attributes.
             for(size_t i = 1; i < line.entries.size(); ++i)
             {
-                IniKeyValue& keyValue = line.entries[i];
+                IniKeyValueView& keyValue = line.entries[i];
                 if(StringUtil::EqualsIgnoreCase(keyValue.key, "rect"))
                 {
                     region.rect = keyValue.GetValueAsRect();
@@ -762,7 +765,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
-    std::vector<IniSection> triggerSections = parser.GetSections("TRIGGERS");
+    std::vector<IniSectionView> triggerSections = parser.GetSectionViews("TRIGGERS");
     for(auto& section : triggerSections)
     {
         mTriggers.emplace_back();
@@ -772,7 +775,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             triggerBlock.conditionText = section.condition;
-            triggerBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            triggerBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Create each trigger defined.
@@ -795,7 +798,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
-    std::vector<IniSection> ambientSections = parser.GetSections("AMBIENT");
+    std::vector<IniSectionView> ambientSections = parser.GetSectionViews("AMBIENT");
     for(auto& section : ambientSections)
     {
         mSoundtracks.emplace_back();
@@ -805,13 +808,13 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             soundtrackBlock.conditionText = section.condition;
-            soundtrackBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            soundtrackBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Add soundtracks.
         for(auto& line : section.lines)
         {
-            Soundtrack* soundtrack = gAssetManager.LoadAsset<Soundtrack>(line.entries[0].key, GetScope());
+            Soundtrack* soundtrack = gAssetManager.LoadAsset<Soundtrack>(std::string(line.entries[0].key), GetScope());
             if(soundtrack != nullptr)
             {
                 soundtrackBlock.items.push_back(soundtrack);
@@ -819,7 +822,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
-    std::vector<IniSection> conversationSections = parser.GetSections("LISTENERS");
+    std::vector<IniSectionView> conversationSections = parser.GetSectionViews("LISTENERS");
     for(auto& section : conversationSections)
     {
         mConversations.emplace_back();
@@ -829,7 +832,7 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             conversationBlock.conditionText = section.condition;
-            conversationBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            conversationBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         // Add conversation settings.
@@ -850,25 +853,25 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "talk"))
                 {
-                    convo.talkGas = gAssetManager.LoadAsset<GAS>(keyValue.value, GetScope());
+                    convo.talkGas = gAssetManager.LoadAsset<GAS>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "listen"))
                 {
-                    convo.listenGas = gAssetManager.LoadAsset<GAS>(keyValue.value, GetScope());
+                    convo.listenGas = gAssetManager.LoadAsset<GAS>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "enter"))
                 {
-                    convo.enterAnim = gAssetManager.LoadAsset<Animation>(keyValue.value, GetScope());
+                    convo.enterAnim = gAssetManager.LoadAsset<Animation>(std::string(keyValue.value), GetScope());
                 }
                 else if(StringUtil::EqualsIgnoreCase(keyValue.key, "exit"))
                 {
-                    convo.exitAnim = gAssetManager.LoadAsset<Animation>(keyValue.value, GetScope());
+                    convo.exitAnim = gAssetManager.LoadAsset<Animation>(std::string(keyValue.value), GetScope());
                 }
             }
         }
     }
 
-    std::vector<IniSection> actionSections = parser.GetSections("ACTIONS");
+    std::vector<IniSectionView> actionSections = parser.GetSectionViews("ACTIONS");
     for(auto& section : actionSections)
     {
         mActions.emplace_back();
@@ -878,12 +881,12 @@ void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
         if(!section.condition.empty())
         {
             actionBlock.conditionText = section.condition;
-            actionBlock.condition = gSheepManager.Compile("Int Evaluation", section.condition);
+            actionBlock.condition = gSheepManager.CompileAssetSheep("Int Evaluation", std::string(section.condition));
         }
 
         for(auto& line : section.lines)
         {
-            NVC* nvc = gAssetManager.LoadAsset<NVC>(line.entries[0].key, GetScope());
+            NVC* nvc = gAssetManager.LoadAsset<NVC>(std::string(line.entries[0].key), GetScope());
             if(nvc != nullptr)
             {
                 actionBlock.items.push_back(nvc);
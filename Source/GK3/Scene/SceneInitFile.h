@@ -17,6 +17,7 @@
 #include "Color32.h"
 #include "Heading.h"
 #include "Rect.h"
+#include "Symbol.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
@@ -133,7 +134,9 @@ struct SceneActor
     Model* model = nullptr; //TODO: Should we just store the name until Scene load?
 
     // The noun associated with this actor, for interactions.
+    // Interned at load, so action and count queries for this noun only need to look it up.
     std::string noun;
+    Symbol nounSymbol;
 
     // Initial position of the actor in the scene.
     // We'll place the actor here, but this might be overwritten
@@ -183,11 +186,14 @@ struct SceneModel
     Type type = Type::Scene;
 
     // Noun associated with this object, for interactivity.
+    // Interned at load, like actor nouns.
     std::string noun;
+    Symbol nounSymbol;
 
     // Usually, verbs are specified in the NVC file.
     // But it can be specified here if only a single verb is possible.
     std::string verb;
+    Symbol verbSymbol;
 
     // An animation played on init. Only first frame will be applied.
     // Only applies to Props. Others will ignore this.
@@ -238,6 +244,8 @@ class SceneInitFile : public Asset
 {
     TYPEINFO_SUB(SceneInitFile, Asset);
 public:
+    static constexpr MemoryTag kMemoryTag = MemoryTag::Scene;
+
     SceneInitFile(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~SceneInitFile();
 
@@ -3,6 +3,7 @@
 #include "Actor.h"
 #include "AssetManager.h"
 #include "Loader.h"
+#include "MemoryTracker.h"
 #include "Profiler.h"
 
 SceneManager gSceneManager;
@@ -80,14 +81,18 @@ void SceneManager::LoadScene(const std::string& name, const std::function<void()
     mCallEnterOnSceneLoad = callEnterOnSceneLoad;
 }
 
-void SceneManager::UnloadScene(const std::function<void()>& callback)
+void SceneManager::UnloadScene(const std::function<void()>& callback, bool retainSceneAssets)
 {
     mUnloadScene = true;
     mSceneUnloadedCallback = callback;
+    mRetainSceneAssets = retainSceneAssets;
 }
 
 void SceneManager::LoadSceneInternal()
 {
+    // Memory allocated while loading the scene is tracked as scene memory (unless more specific, such as assets).
+    MEMORY_TAG_SCOPED(MemoryTag::Scene);
+
     // Create the new scene.
     mScene = new Scene(mSceneToLoad);
 
@@ -95,6 +100,7 @@ void SceneManager::LoadSceneInternal()
     mSceneLoading = true;
     Loader::Load([this](){
         TIMER_SCOPED("GEngine::LoadSceneInternal::Load");
+        MEMORY_TAG_SCOPED(MemoryTag::Scene);
         mScene->Load();
     });
 
@@ -103,6 +109,7 @@ void SceneManager::LoadSceneInternal()
 
         // Init the scene.
         // This is basically a continuation of the scene "Load", but with stuff to do on the main thread.
+        MEMORY_TAG_SCOPED(MemoryTag::Scene);
         mScene->Init();
 
         // If desired (usually yes), call the scene "Enter" function.
@@ -121,6 +128,9 @@ void SceneManager::LoadSceneInternal()
             mSceneLoadedCallback();
             mSceneLoadedCallback = nullptr;
         }
+
+        // Any assets retained from the previous scene that weren't used by this one can be unloaded now.
+        gAssetManager.UnloadAssets(AssetScope::Retained);
     });
 }
 
@@ -145,8 +155,22 @@ void SceneManager::UnloadSceneInternal()
     // After destroy pass, delete destroyed actors.
     DeleteDestroyedActors();
 
+    // Many actors and components were just freed, so give unused pool memory back.
+    Actor::ReleaseUnusedPoolMemory();
+    Component::ReleaseUnusedPoolMemory();
+
     // Unload any assets scoped to just the current scene.
-    gAssetManager.UnloadAssets(AssetScope::Scene);
+    // If the next scene will likely use the same assets, retain them instead, so they don't need to be loaded again.
+    if(mRetainSceneAssets)
+    {
+        gAssetManager.RetainAssets(AssetScope::Scene);
+        mRetainSceneAssets = false;
+    }
+    else
+    {
+        gAssetManager.UnloadAssets(AssetScope::Scene);
+        gAssetManager.UnloadAssets(AssetScope::Retained);
+    }
 
     // Do callback if any.
     if(mSceneUnloadedCallback != nullptr)
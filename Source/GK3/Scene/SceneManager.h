@@ -21,7 +21,7 @@ public:
     void UpdateLoading();
 
     void LoadScene(const std::string& name, const std::function<void()>& callback = nullptr, bool callEnterOnSceneLoad = true);
-    void UnloadScene(const std::function<void()>& callback = nullptr);
+    void UnloadScene(const std::function<void()>& callback = nullptr, bool retainSceneAssets = false);
     bool IsSceneLoading() const { return mSceneLoading; }
 
     Scene* GetScene() const { return mScene; }
@@ -40,6 +40,10 @@ private:
     // If set, we explicitly want to unload the current scene without loading a new scene.
     bool mUnloadScene = false;
 
+    // If set, the unloading scene's assets are retained rather than unloaded, because the next scene will likely use them (e.g. loading a save in the same location).
+    // Any the next scene doesn't use are unloaded after it loads.
+    bool mRetainSceneAssets = false;
+
     // If true, we are actively loading a scene.
     bool mSceneLoading = false;
 
@@ -0,0 +1,45 @@
+#include "ScenePrediction.h"
+
+#include "StringUtil.h"
+
+void ScenePrediction::FindSetLocationCalls(const std::string& text, std::vector<std::pair<std::string, std::string>>& outLocations)
+{
+    size_t pos = StringUtil::FindIgnoreCase(text, "SetLocation");
+    while(pos != std::string::npos)
+    {
+        pos += 11;
+        bool hasTimeblock = StringUtil::FindIgnoreCase(text, "Time", pos) == pos;
+        if(hasTimeblock)
+        {
+            pos += 4;
+        }
+
+        // Only calls with string literal arguments can be predicted.
+        std::string location;
+        std::string timeblock;
+        size_t openQuote = text.find('"', pos);
+        size_t closeQuote = openQuote != std::string::npos ? text.find('"', openQuote + 1) : std::string::npos;
+        if(closeQuote != std::string::npos && text.find_first_not_of(" \t(", pos) == openQuote)
+        {
+            location = text.substr(openQuote + 1, closeQuote - openQuote - 1);
+            pos = closeQuote + 1;
+            if(hasTimeblock)
+            {
+                openQuote = text.find('"', pos);
+                closeQuote = openQuote != std::string::npos ? text.find('"', openQuote + 1) : std::string::npos;
+                if(closeQuote != std::string::npos && text.find_first_not_of(" \t,", pos) == openQuote)
+                {
+                    timeblock = text.substr(openQuote + 1, closeQuote - openQuote - 1);
+                    pos = closeQuote + 1;
+                }
+            }
+        }
+
+        // All location codes are exactly 3 characters.
+        if(location.length() == 3)
+        {
+            outLocations.emplace_back(location, timeblock);
+        }
+        pos = StringUtil::FindIgnoreCase(text, "SetLocation", pos);
+    }
+}
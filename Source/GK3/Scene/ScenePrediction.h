@@ -0,0 +1,17 @@
+//
+// Clark Kromenaker
+//
+// Helpers for predicting which scenes the player is likely to go to next.
+//
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ScenePrediction
+{
+    // Finds locations in calls like SetLocation("LBY") or SetLocationTime("LBY", "110A") in a sheep script's text.
+    // Each location is output with its timeblock, which is empty if the call doesn't specify one (or it isn't a string literal).
+    // Calls whose location isn't a string literal can't be predicted, so they're skipped.
+    void FindSetLocationCalls(const std::string& text, std::vector<std::pair<std::string, std::string>>& outLocations);
+}
@@ -0,0 +1,342 @@
+#include "ScenePrefetcher.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "ActionManager.h"
+#include "Animation.h"
+#include "AssetManager.h"
+#include "BSP.h"
+#include "BSPLightmap.h"
+#include "GameProgress.h"
+#include "GAS.h"
+#include "IniReader.h"
+#include "Loader.h"
+#include "LocationManager.h"
+#include "Model.h"
+#include "NVC.h"
+#include "Scene.h"
+#include "SceneAsset.h"
+#include "SceneData.h"
+#include "SceneInitFile.h"
+#include "SceneManager.h"
+#include "ScenePrediction.h"
+#include "Soundtrack.h"
+#include "StringUtil.h"
+#include "Texture.h"
+
+ScenePrefetcher gScenePrefetcher;
+
+namespace
+{
+    // Previous location is the most likely next location (e.g. leaving a room you just entered).
+    // After that, locations the current scene's actions can send the player to.
+    const int kPreviousLocationPriority = 0;
+    const int kActionLocationPriority = 1;
+}
+
+void ScenePrefetcher::Update()
+{
+    // Prefetching competes with loading for disk and CPU time, so only do it while the game is idle.
+    if(Loader::IsLoading() || gSceneManager.IsSceneLoading() || gActionManager.IsActionPlaying()) { return; }
+    Scene* scene = gSceneManager.GetScene();
+    if(scene == nullptr || scene->GetSceneData() == nullptr) { return; }
+
+    // Without worker threads, a job would only ever run on the main thread.
+    if(JobSystem::GetWorkerCount() == 0) { return; }
+
+    // When the location or timeblock changes, the likely next locations change too.
+    const std::string& location = gLocationManager.GetLocation();
+    std::string timeblock = gGameProgress.GetTimeblock().ToString();
+    if(!StringUtil::EqualsIgnoreCase(location, mPredictedLocation) || !StringUtil::EqualsIgnoreCase(timeblock, mPredictedTimeblock))
+    {
+        Predict(location, timeblock);
+    }
+
+    // Prefetch one asset at a time. Once the prefetch cache is full of data for these predictions, more prefetching would just evict what's already prefetched.
+    if(!JobSystem::IsDone(mJob) || gAssetManager.IsPrefetchCacheFull()) { return; }
+    Request request;
+    if(PopRequest(request))
+    {
+        mJob = JobSystem::Run([this, request]() {
+            Prefetch(request);
+        });
+    }
+}
+
+void ScenePrefetcher::Shutdown()
+{
+    // A prefetch job may still be running, and it uses this object.
+    JobSystem::Wait(mJob);
+    mJob = JobHandle();
+}
+
+void ScenePrefetcher::Predict(const std::string& location, const std::string& timeblock)
+{
+    mPredictedLocation = location;
+    mPredictedTimeblock = timeblock;
+
+    // Any requests for old predictions are no longer useful.
+    {
+        std::lock_guard<std::mutex> lock(mRequestsMutex);
+        mRequests.clear();
+        mRequestedNames.clear();
+        ++mPrediction;
+    }
+
+    // Data prefetched for old predictions may still be used, but it shouldn't stop prefetching for the new ones.
+    // Anything the new predictions want again is kept - the rest makes room as needed.
+    gAssetManager.MarkPrefetchesEvictable();
+
+    // Gather likely next locations, most likely first.
+    std::vector<std::pair<std::string, std::string>> locations;
+    if(!gLocationManager.GetLastLocation().empty())
+    {
+        locations.emplace_back(gLocationManager.GetLastLocation(), "");
+    }
+    size_t actionLocationsStart = locations.size();
+    for(NVC* nvc : gSceneManager.GetScene()->GetSceneData()->GetActionSets())
+    {
+        for(Action* action : nvc->GetActions())
+        {
+            ScenePrediction::FindSetLocationCalls(action->script.text, locations);
+        }
+    }
+
+    // Request each location's SIFs. When read, those request the rest of the location's assets.
+    for(size_t i = 0; i < locations.size(); ++i)
+    {
+        const std::string& nextLocation = locations[i].first;
+        if(StringUtil::EqualsIgnoreCase(nextLocation, location)) { continue; }
+
+        // If no timeblock is specified, the location is changed without changing the timeblock.
+        const std::string& nextTimeblock = locations[i].second.empty() ? timeblock : locations[i].second;
+        int priority = i < actionLocationsStart ? kPreviousLocationPriority : kActionLocationPriority;
+        AddRequest(AssetType::SceneInitFile, nextLocation, priority, mPrediction);
+        AddRequest(AssetType::SceneInitFile, nextLocation + nextTimeblock, priority, mPrediction);
+    }
+}
+
+void ScenePrefetcher::AddRequest(AssetType type, const std::string& name, int priority, uint32_t prediction)
+{
+    if(name.empty()) { return; }
+
+    // Ignore requests made for an old prediction (e.g. by a job that was running when the prediction changed).
+    std::lock_guard<std::mutex> lock(mRequestsMutex);
+    if(prediction != mPrediction) { return; }
+
+    // Many locations share assets (e.g. the ego's model), so the same asset is often requested more than once.
+    // Assets of different types can share a name (e.g. a scene asset and its lightmap), so the type is part of the key.
+    std::string key = std::to_string(static_cast<int>(type)) + ":" + StringUtil::ToUpperCopy(name);
+    if(!mRequestedNames.insert(key).second) { return; }
+
+    Request& request = mRequests.emplace_back();
+    request.type = type;
+    request.name = name;
+    request.priority = priority;
+    request.prediction = prediction;
+}
+
+bool ScenePrefetcher::PopRequest(Request& outRequest)
+{
+    std::lock_guard<std::mutex> lock(mRequestsMutex);
+    if(mRequests.empty()) { return false; }
+
+    // Take the most important request. For equal priorities, take the oldest request.
+    auto it = std::min_element(mRequests.begin(), mRequests.end(), [](const Request& a, const Request& b) {
+        return a.priority < b.priority;
+    });
+    outRequest = std::move(*it);
+    mRequests.erase(it);
+    return true;
+}
+
+void ScenePrefetcher::Prefetch(const Request& request)
+{
+    switch(request.type)
+    {
+    case AssetType::SceneInitFile:
+        gAssetManager.PrefetchAsset<SceneInitFile>(request.name, [this, &request](const AssetData& assetData) {
+            FindSceneInitFileAssets(assetData, request);
+        });
+        break;
+    case AssetType::SceneAsset:
+        gAssetManager.PrefetchAsset<SceneAsset>(request.name, [this, &request](const AssetData& assetData) {
+            FindSceneAssetAssets(assetData, request);
+        });
+        break;
+    case AssetType::BSP:
+        gAssetManager.PrefetchAsset<BSP>(request.name);
+        break;
+    case AssetType::BSPLightmap:
+        gAssetManager.PrefetchAsset<BSPLightmap>(request.name);
+        break;
+    case AssetType::Model:
+        gAssetManager.PrefetchAsset<Model>(request.name);
+        break;
+    case AssetType::Texture:
+        gAssetManager.PrefetchAsset<Texture>(request.name);
+        break;
+    case AssetType::GAS:
+        gAssetManager.PrefetchAsset<GAS>(request.name);
+        break;
+    case AssetType::Animation:
+        gAssetManager.PrefetchAsset<Animation>(request.name);
+        break;
+    case AssetType::NVC:
+        gAssetManager.PrefetchAsset<NVC>(request.name);
+        break;
+    case AssetType::Soundtrack:
+        gAssetManager.PrefetchAsset<Soundtrack>(request.name);
+        break;
+    }
+}
+
+void ScenePrefetcher::FindSceneInitFileAssets(const AssetData& assetData, const Request& request)
+{
+    // This only finds asset names - section conditions aren't evaluated, so assets are requested for every condition.
+    // That's a bit more than the scene will actually load, but conditions mostly just pick between a handful of actors and props.
+    IniReader reader(assetData.bytes.get(), assetData.length);
+    reader.ReadAll();
+    auto add = [this, &request](AssetType type, std::string_view name) {
+        AddRequest(type, std::string(name), request.priority, request.prediction);
+    };
+
+    for(IniSectionView& section : reader.GetSectionViews("GENERAL"))
+    {
+        for(IniLineView& line : section.lines)
+        {
+            IniKeyValueView& first = line.entries.front();
+            if(StringUtil::EqualsIgnoreCase(first.key, "scene"))
+            {
+                // The lightmap has the same name as the scene asset.
+                add(AssetType::SceneAsset, first.value);
+                add(AssetType::BSPLightmap, first.value);
+            }
+            else if(StringUtil::EqualsIgnoreCase(first.key, "boundary"))
+            {
+                add(AssetType::Texture, first.value);
+            }
+        }
+    }
+
+    for(IniSectionView& section : reader.GetSectionViews("ACTORS"))
+    {
+        for(IniLineView& line : section.lines)
+        {
+            for(IniKeyValueView& keyValue : line.entries)
+            {
+                if(StringUtil::EqualsIgnoreCase(keyValue.key, "model"))
+                {
+                    add(AssetType::Model, keyValue.value);
+                }
+                else if(StringUtil::EqualsIgnoreCase(keyValue.key, "idle") ||
+                        StringUtil::EqualsIgnoreCase(keyValue.key, "talk") ||
+                        StringUtil::EqualsIgnoreCase(keyValue.key, "listen"))
+                {
+                    add(AssetType::GAS, keyValue.value);
+                }
+                else if(StringUtil::EqualsIgnoreCase(keyValue.key, "initAnim"))
+                {
+                    add(AssetType::Animation, keyValue.value);
+                }
+            }
+        }
+    }
+
+    for(IniSectionView& section : reader.GetSectionViews("MODELS"))
+    {
+        for(IniLineView& line : section.lines)
+        {
+            // Only props have their own model - other models are baked into the BSP.
+            std::string_view modelName;
+            bool isProp = false;
+            for(IniKeyValueView& keyValue : line.entries)
+            {
+                if(StringUtil::EqualsIgnoreCase(keyValue.key, "model"))
+                {
+                    modelName = keyValue.value;
+                }
+                else if(StringUtil::EqualsIgnoreCase(keyValue.key, "type"))
+                {
+                    isProp = StringUtil::EqualsIgnoreCase(keyValue.value, "prop") || StringUtil::EqualsIgnoreCase(keyValue.value, "gasprop");
+                }
+                else if(StringUtil::EqualsIgnoreCase(keyValue.key, "initanim"))
+                {
+                    add(AssetType::Animation, keyValue.value);
+                }
+                else if(StringUtil::EqualsIgnoreCase(keyValue.key, "gas"))
+                {
+                    add(AssetType::GAS, keyValue.value);
+                }
+            }
+            if(isProp)
+            {
+                add(AssetType::Model, modelName);
+            }
+        }
+    }
+
+    for(IniSectionView& section : reader.GetSectionViews("LISTENERS"))
+    {
+        for(IniLineView& line : section.lines)
+        {
+            for(IniKeyValueView& keyValue : line.entries)
+            {
+                if(StringUtil::EqualsIgnoreCase(keyValue.key, "talk") || StringUtil::EqualsIgnoreCase(keyValue.key, "listen"))
+                {
+                    add(AssetType::GAS, keyValue.value);
+                }
+                else if(StringUtil::EqualsIgnoreCase(keyValue.key, "enter") || StringUtil::EqualsIgnoreCase(keyValue.key, "exit"))
+                {
+                    add(AssetType::Animation, keyValue.value);
+                }
+            }
+        }
+    }
+
+    for(IniSectionView& section : reader.GetSectionViews("AMBIENT"))
+    {
+        for(IniLineView& line : section.lines)
+        {
+            add(AssetType::Soundtrack, line.entries[0].key);
+        }
+    }
+
+    for(IniSectionView& section : reader.GetSectionViews("ACTIONS"))
+    {
+        for(IniLineView& line : section.lines)
+        {
+            add(AssetType::NVC, line.entries[0].key);
+        }
+    }
+}
+
+void ScenePrefetcher::FindSceneAssetAssets(const AssetData& assetData, const Request& request)
+{
+    IniReader reader(assetData.bytes.get(), assetData.length);
+    reader.SetMultipleKeyValuePairsPerLine(false);
+
+    IniSectionView section;
+    while(reader.ReadNextSection(section))
+    {
+        // The BSP name is in the unnamed section at the top of the file. Skybox textures are in their own section.
+        bool isSkybox = StringUtil::EqualsIgnoreCase(section.name, "Skybox");
+        if(!section.name.empty() && !isSkybox) { continue; }
+        for(IniLineView& line : section.lines)
+        {
+            IniKeyValueView& entry = line.entries.front();
+            if(isSkybox)
+            {
+                if(!StringUtil::EqualsIgnoreCase(entry.key, "azimuth"))
+                {
+                    AddRequest(AssetType::Texture, std::string(entry.value), request.priority, request.prediction);
+                }
+            }
+            else if(StringUtil::EqualsIgnoreCase(entry.key, "bsp"))
+            {
+                AddRequest(AssetType::BSP, std::string(entry.value), request.priority, request.prediction);
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+//
+// Clark Kromenaker
+//
+// Prefetches assets for the locations the player is likely to go to next, so changing scenes doesn't have to wait on reading them from disk.
+//
+// Likely next locations are the previous location, and any location the current scene's actions can send the player to.
+// For each, the location's SIFs are read to find the assets its scene will load (scene asset, BSP, lightmap, models, actions, etc).
+//
+// This is low priority work: assets are prefetched one at a time on a worker thread, and only while the game is idle.
+// Prefetched data goes in the asset manager's prefetch cache, which is bounded - once it's full, prefetching stops until the predictions change.
+//
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "JobSystem.h"
+
+struct AssetData;
+
+class ScenePrefetcher
+{
+public:
+    void Update();
+    void Shutdown();
+
+private:
+    // The asset types that are prefetched. The type is needed to figure out an asset's extension.
+    enum class AssetType
+    {
+        SceneInitFile,
+        SceneAsset,
+        BSP,
+        BSPLightmap,
+        Model,
+        Texture,
+        GAS,
+        Animation,
+        NVC,
+        Soundtrack
+    };
+
+    struct Request
+    {
+        AssetType type = AssetType::SceneInitFile;
+        std::string name;
+
+        // Lower is more important. Requests for the most likely location come first.
+        int priority = 0;
+
+        // The prediction this request was made for.
+        uint32_t prediction = 0;
+    };
+
+    // The location and timeblock that predictions were made for. When either changes, new predictions are made.
+    std::string mPredictedLocation;
+    std::string mPredictedTimeblock;
+
+    // Assets waiting to be prefetched, and all assets requested for the current predictions (to avoid requesting the same asset twice).
+    // Requested assets are keyed by type and name, since assets of different types can have the same name.
+    // Prefetch jobs add to these as they find more assets (e.g. a SIF's models), so they're guarded by a mutex.
+    std::vector<Request> mRequests;
+    std::unordered_set<std::string> mRequestedNames;
+    std::mutex mRequestsMutex;
+
+    // Incremented each time new predictions are made.
+    uint32_t mPrediction = 0;
+
+    // The job prefetching an asset right now, if any.
+    JobHandle mJob;
+
+    void Predict(const std::string& location, const std::string& timeblock);
+    void AddRequest(AssetType type, const std::string& name, int priority, uint32_t prediction);
+    bool PopRequest(Request& outRequest);
+
+    void Prefetch(const Request& request);
+    void FindSceneInitFileAssets(const AssetData& assetData, const Request& request);
+    void FindSceneAssetAssets(const AssetData& assetData, const Request& request);
+};
+
+extern ScenePrefetcher gScenePrefetcher;
@@ -13,6 +13,7 @@
 #include "SoundtrackPlayer.h"
 #include "StringTokenizer.h"
 #include "TextAsset.h"
+#include "TextReader.h"
 #include "Texture.h"
 #include "UIButton.h"
 #include "UICanvas.h"
@@ -383,7 +384,7 @@ void DrivingScreen::LoadPaths()
             StringTokenizer tokenizer(line, { ' ' });
             if(!tokenizer.HasNext()) { continue; }
 
-            const std::string& token = tokenizer.GetNext();
+            std::string_view token = tokenizer.GetNext();
             if(StringUtil::EqualsIgnoreCase(token, "NodeBegin"))
             {
                 assert(tokenizer.HasNext());
@@ -393,7 +394,7 @@ void DrivingScreen::LoadPaths()
             else if(StringUtil::EqualsIgnoreCase(token, "Location"))
             {
                 assert(tokenizer.HasNext());
-                mPathData.nodes.back().point = Vector2::Parse(tokenizer.GetNext());
+                mPathData.nodes.back().point = Vector2::Parse(std::string(tokenizer.GetNext()));
             }
             else if(StringUtil::EqualsIgnoreCase(token, "SegmentBegin"))
             {
@@ -404,7 +405,7 @@ void DrivingScreen::LoadPaths()
             else if(StringUtil::EqualsIgnoreCase(token, "Point"))
             {
                 assert(tokenizer.HasNext());
-                mPathData.segments.back().points.emplace_back(Vector2::Parse(tokenizer.GetNext()));
+                mPathData.segments.back().points.emplace_back(Vector2::Parse(std::string(tokenizer.GetNext())));
             }
         }
     }
@@ -421,7 +422,7 @@ void DrivingScreen::LoadPaths()
             StringTokenizer tokenizer(line, { ' ' });
             if(!tokenizer.HasNext()) { continue; }
 
-            const std::string& token = tokenizer.GetNext();
+            std::string_view token = tokenizer.GetNext();
             if(StringUtil::EqualsIgnoreCase(token, "LinksBegin"))
             {
                 inLinks = true;
@@ -444,7 +445,7 @@ void DrivingScreen::LoadPaths()
                 }
 
                 assert(tokenizer.HasNext());
-                const std::string& segmentName = tokenizer.GetNext();
+                std::string_view segmentName = tokenizer.GetNext();
                 for(auto& segment : mPathData.segments)
                 {
                     if(segment.name == segmentName)
@@ -13,6 +13,7 @@
 #include "SidneyPopup.h"
 #include "SidneyUtil.h"
 #include "TextAsset.h"
+#include "TextLayoutCache.h"
 #include "Texture.h"
 #include "UIButton.h"
 #include "UICanvas.h"
@@ -783,7 +784,7 @@ void SidneySearch::ShowWebPage(const std::string& pageName)
                         // First, based on the space available in the last line, see if we can fit it all in there.
                         Rect r(0, 0, kWebpageContentsWidth - resultsPos.x, 1000.0f);
                         TextLayout layout(r, font, HorizontalAlignment::Left, VerticalAlignment::Top, HorizontalOverflow::Wrap, VerticalOverflow::Overflow);
-                        layout.AddLine(element.tagOrData);
+                        TextLayoutCache::AddText(layout, element.tagOrData);
 
                         // Best case, we can fit this all in the space on the remaining line.
                         if(layout.GetLineCount() == 1)
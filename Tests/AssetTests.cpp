@@ -0,0 +1,67 @@
+//
+// Clark Kromenaker
+//
+// Tests for asset caching and scopes.
+//
+#include "catch.hh"
+
+#include "AssetCache.h"
+#include "TextAsset.h"
+
+TEST_CASE("Retained assets are reclaimed when requested again")
+{
+    AssetCache<TextAsset> cache("RetainTest");
+
+    // A scene asset that depends on another scene asset (e.g. a model and its texture).
+    TextAsset* model = new TextAsset("MODEL.TXT", AssetScope::Scene);
+    TextAsset* texture = new TextAsset("TEXTURE.TXT", AssetScope::Scene);
+    model->AddDependency(texture);
+    cache.SetAsset(model->GetName(), model);
+    cache.SetAsset(texture->GetName(), texture);
+
+    // Retaining moves all scene assets to retained scope.
+    cache.ChangeScope(AssetScope::Scene, AssetScope::Retained);
+    REQUIRE(model->GetScope() == AssetScope::Retained);
+    REQUIRE(texture->GetScope() == AssetScope::Retained);
+
+    // Requesting the model again reclaims it and its dependency, so the same instances are still cached.
+    REQUIRE(cache.GetAsset("MODEL.TXT") == model);
+    model->Reclaim(AssetScope::Scene);
+    REQUIRE(model->GetScope() == AssetScope::Scene);
+    REQUIRE(texture->GetScope() == AssetScope::Scene);
+
+    // Unloading retained assets leaves reclaimed assets loaded.
+    cache.UnloadAssets(AssetScope::Retained);
+    REQUIRE(cache.GetAsset("MODEL.TXT") == model);
+    REQUIRE(cache.GetAsset("TEXTURE.TXT") == texture);
+
+    cache.UnloadAssets(AssetScope::Global);
+}
+
+TEST_CASE("Unloading retained scope unloads assets that weren't requested again")
+{
+    AssetCache<TextAsset> cache("RetainTest");
+
+    TextAsset* used = new TextAsset("USED.TXT", AssetScope::Scene);
+    TextAsset* unused = new TextAsset("UNUSED.TXT", AssetScope::Scene);
+    TextAsset* global = new TextAsset("GLOBAL.TXT", AssetScope::Global);
+    cache.SetAsset(used->GetName(), used);
+    cache.SetAsset(unused->GetName(), unused);
+    cache.SetAsset(global->GetName(), global);
+
+    // Only scene assets are retained.
+    cache.ChangeScope(AssetScope::Scene, AssetScope::Retained);
+    REQUIRE(global->GetScope() == AssetScope::Global);
+
+    // Reclaiming an asset without dependencies only changes that asset.
+    used->Reclaim(AssetScope::Scene);
+    REQUIRE(unused->GetScope() == AssetScope::Retained);
+
+    // Unloading retained scope gets rid of whatever wasn't reclaimed.
+    cache.UnloadAssets(AssetScope::Retained);
+    REQUIRE(cache.GetAsset("USED.TXT") == used);
+    REQUIRE(cache.GetAsset("UNUSED.TXT") == nullptr);
+    REQUIRE(cache.GetAsset("GLOBAL.TXT") == global);
+
+    cache.UnloadAssets(AssetScope::Global);
+}
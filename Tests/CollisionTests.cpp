@@ -4,9 +4,93 @@
 // Tests for collision/intersection logic between geometric primitives.
 //
 #include "catch.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "AABBTree.h"
+#include "CollisionMesh.h"
 #include "Collisions.h"
+#include "Ray.h"
 #include "Sphere.h"
 #include "Triangle.h"
+#include "TriangleBatch.h"
+#include "TriangleBVH.h"
+
+namespace
+{
+    // A bumpy grid of triangles in the XZ plane, so rays from above hit different triangles at different heights.
+    void MakeGrid(int size, float heightScale, std::vector<float>& positions, std::vector<unsigned short>& indexes)
+    {
+        positions.clear();
+        indexes.clear();
+        for(int z = 0; z <= size; ++z)
+        {
+            for(int x = 0; x <= size; ++x)
+            {
+                positions.push_back(static_cast<float>(x));
+                positions.push_back(heightScale * static_cast<float>((x * 7 + z * 13) % 5));
+                positions.push_back(static_cast<float>(z));
+            }
+        }
+        for(int z = 0; z < size; ++z)
+        {
+            for(int x = 0; x < size; ++x)
+            {
+                unsigned short i0 = static_cast<unsigned short>(z * (size + 1) + x);
+                unsigned short i1 = static_cast<unsigned short>(i0 + 1);
+                unsigned short i2 = static_cast<unsigned short>(i0 + size + 1);
+                unsigned short i3 = static_cast<unsigned short>(i2 + 1);
+                indexes.insert(indexes.end(), { i0, i2, i1, i1, i2, i3 });
+            }
+        }
+    }
+
+    // Random triangles around the origin, and random rays pointing roughly at them.
+    void MakeRandomTriangles(std::mt19937& random, int count, std::vector<Triangle>& triangles)
+    {
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+        for(int i = 0; i < count; ++i)
+        {
+            Vector3 p0(position(random), position(random), position(random));
+            Vector3 p1 = p0 + Vector3(offset(random), offset(random), offset(random));
+            Vector3 p2 = p0 + Vector3(offset(random), offset(random), offset(random));
+            triangles.emplace_back(p0, p1, p2);
+        }
+    }
+
+    Ray MakeRandomRay(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        Vector3 origin(position(random), position(random), -30.0f);
+        Vector3 target(position(random), position(random), 0.0f);
+        return Ray(origin, Vector3::Normalize(target - origin));
+    }
+
+    float BruteForceRaycast(const Ray& ray, const std::vector<float>& positions, const std::vector<unsigned short>& indexes)
+    {
+        float closestT = FLT_MAX;
+        for(size_t i = 0; i < indexes.size(); i += 3)
+        {
+            Vector3 p[3];
+            for(int j = 0; j < 3; ++j)
+            {
+                p[j] = Vector3(positions[indexes[i + j] * 3], positions[indexes[i + j] * 3 + 1], positions[indexes[i + j] * 3 + 2]);
+            }
+            float t = FLT_MAX;
+            if(Intersect::TestRayTriangle(ray, p[0], p[1], p[2], t) && t < closestT)
+            {
+                closestT = t;
+            }
+        }
+        return closestT;
+    }
+}
 
 TEST_CASE("Sphere intersect triangle works")
 {
@@ -26,3 +110,323 @@ TEST_CASE("Sphere intersect triangle works")
     Sphere s2(Vector3::Zero + intersect, 10.0f);
     REQUIRE(!Intersect::TestSphereTriangle(s2, t, intersect));
 }
+
+TEST_CASE("TriangleBVH raycast matches brute force, including after refit")
+{
+    std::vector<float> positions;
+    std::vector<unsigned short> indexes;
+    MakeGrid(16, 1.0f, positions, indexes);
+
+    TriangleBVH bvh;
+    bvh.Build(positions.data(), indexes.data(), static_cast<uint32_t>(indexes.size() / 3));
+    REQUIRE(bvh.IsBuilt());
+
+    auto checkRays = [&]() {
+        for(int i = 0; i < 64; ++i)
+        {
+            // Slanted rays from above, plus a few that miss the grid entirely.
+            Vector3 origin(-4.0f + i * 0.4f, 20.0f, -2.0f + (i % 9) * 2.3f);
+            Vector3 direction = Vector3::Normalize(Vector3(0.3f, -1.0f, 0.2f));
+            Ray ray(origin, direction);
+
+            float expectedT = BruteForceRaycast(ray, positions, indexes);
+            float t = FLT_MAX;
+            uint32_t triangleIndex = 0;
+            float u = 0.0f;
+            float v = 0.0f;
+            bool hit = bvh.Raycast(ray, t, triangleIndex, u, v);
+            REQUIRE(hit == (expectedT < FLT_MAX));
+            if(hit)
+            {
+                REQUIRE(t == Approx(expectedT));
+            }
+        }
+    };
+    checkRays();
+
+    // Move the vertices (as vertex animation would), refit, and check again.
+    std::vector<unsigned short> unusedIndexes;
+    MakeGrid(16, 2.5f, positions, unusedIndexes);
+    for(size_t i = 0; i < positions.size(); i += 3)
+    {
+        positions[i] += 0.5f;
+    }
+    bvh.Refit(positions.data(), indexes.data());
+    checkRays();
+}
+
+TEST_CASE("AABBTree raycast finds boxes along the ray")
+{
+    // A row of unit boxes along the x-axis, and a few off to the side.
+    AABBTree tree;
+    int proxies[10];
+    for(int i = 0; i < 10; ++i)
+    {
+        Vector3 center(i * 20.0f, (i % 3 == 0) ? 0.0f : 50.0f, 0.0f);
+        proxies[i] = tree.Insert(AABB::FromCenterAndSize(center, Vector3::One), reinterpret_cast<void*>(static_cast<intptr_t>(i + 1)));
+    }
+
+    // Tree should be balanced.
+    REQUIRE(tree.GetHeight() <= 5);
+
+    // A ray down the x-axis should only find the boxes on the axis.
+    Ray ray(Vector3(-10.0f, 0.0f, 0.0f), Vector3::UnitX);
+    std::vector<intptr_t> found;
+    tree.Raycast(ray, FLT_MAX, [&](int proxyId) {
+        found.push_back(reinterpret_cast<intptr_t>(tree.GetUserData(proxyId)));
+        return FLT_MAX;
+    });
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == std::vector<intptr_t>({ 1, 4, 7, 10 }));
+
+    // The closest box is found first, so returning a shorter max t from the callback skips the rest.
+    found.clear();
+    tree.Raycast(ray, FLT_MAX, [&](int proxyId) {
+        found.push_back(reinterpret_cast<intptr_t>(tree.GetUserData(proxyId)));
+        return 10.0f;
+    });
+    REQUIRE(found == std::vector<intptr_t>({ 1 }));
+
+    // Small moves stay within the fat AABB; big moves update the tree.
+    REQUIRE(!tree.Move(proxies[1], AABB::FromCenterAndSize(Vector3(20.5f, 50.0f, 0.0f), Vector3::One)));
+    REQUIRE(tree.Move(proxies[1], AABB::FromCenterAndSize(Vector3(30.0f, 0.0f, 0.0f), Vector3::One)));
+    tree.Remove(proxies[3]);
+    found.clear();
+    tree.Raycast(ray, FLT_MAX, [&](int proxyId) {
+        found.push_back(reinterpret_cast<intptr_t>(tree.GetUserData(proxyId)));
+        return FLT_MAX;
+    });
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == std::vector<intptr_t>({ 1, 2, 7, 10 }));
+}
+
+TEST_CASE("AABB overlap test checks all three axes")
+{
+    AABB a(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f));
+    REQUIRE(Intersect::TestAABBAABB(a, AABB(Vector3(0.5f, 0.5f, 0.5f), Vector3(2.0f, 2.0f, 2.0f))));
+    REQUIRE(!Intersect::TestAABBAABB(a, AABB(Vector3(0.5f, 0.5f, 2.0f), Vector3(2.0f, 2.0f, 3.0f))));
+    REQUIRE(!Intersect::TestAABBAABB(a, AABB(Vector3(0.5f, 0.5f, -3.0f), Vector3(2.0f, 2.0f, -2.0f))));
+}
+
+TEST_CASE("CollisionMesh sphere sweep matches brute force")
+{
+    std::vector<float> positions;
+    std::vector<unsigned short> indexes;
+    MakeGrid(32, 0.5f, positions, indexes);
+
+    std::vector<Triangle> triangles;
+    CollisionMesh collisionMesh;
+    for(size_t i = 0; i < indexes.size(); i += 3)
+    {
+        Vector3 p[3];
+        for(int j = 0; j < 3; ++j)
+        {
+            p[j] = Vector3(positions[indexes[i + j] * 3], positions[indexes[i + j] * 3 + 1], positions[indexes[i + j] * 3 + 2]);
+        }
+        triangles.emplace_back(p[0], p[1], p[2]);
+        collisionMesh.AddTriangle(p[0], p[1], p[2]);
+    }
+    collisionMesh.Build();
+    REQUIRE(collisionMesh.GetTriangleCount() == triangles.size());
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(0.0f, 32.0f);
+    std::uniform_real_distribution<float> height(-1.0f, 4.0f);
+    std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+    int hitCount = 0;
+    for(int i = 0; i < 500; ++i)
+    {
+        Sphere sphere(Vector3(position(random), height(random), position(random)), 1.0f);
+        Vector3 velocity(offset(random), offset(random), offset(random));
+
+        // Same logic the camera used before it had a collision mesh: check every triangle.
+        bool expectedCollided = false;
+        float expectedT = 1.0f;
+        Vector3 expectedNormal;
+        for(const Triangle& triangle : triangles)
+        {
+            float t = 0.0f;
+            Vector3 normal;
+            if(Collide::SphereTriangle(sphere, triangle, velocity, t, normal))
+            {
+                Vector3 intersectPoint;
+                if(t < 0.0f && !Intersect::TestSphereTriangle(sphere, triangle, intersectPoint)) { continue; }
+                if(t < expectedT)
+                {
+                    expectedCollided = true;
+                    expectedT = t;
+                    expectedNormal = normal;
+                }
+            }
+        }
+
+        float t = 0.0f;
+        Vector3 normal;
+        Triangle triangle;
+        bool collided = collisionMesh.SweepSphere(sphere, velocity, 1.0f, t, normal, triangle);
+        REQUIRE(collided == expectedCollided);
+        if(collided)
+        {
+            REQUIRE(t == expectedT);
+            REQUIRE(normal == expectedNormal);
+            ++hitCount;
+        }
+    }
+
+    // Make sure the test actually exercised some collisions.
+    REQUIRE(hitCount > 0);
+}
+
+TEST_CASE("TestRayTriangleBlock matches TestRayTriangle")
+{
+    std::mt19937 random(1234);
+    std::vector<Triangle> triangles;
+    MakeRandomTriangles(random, 256, triangles);
+
+    // Include an empty (degenerate) lane, like the unused lanes at the end of a batch.
+    TriangleBlock emptyBlock;
+    emptyBlock.SetTriangle(0, triangles[0].p0, triangles[0].p1, triangles[0].p2);
+
+    int hitCount = 0;
+    for(int i = 0; i < 200; ++i)
+    {
+        Ray ray = MakeRandomRay(random);
+        for(size_t j = 0; j < triangles.size(); j += TriangleBlock::kWidth)
+        {
+            TriangleBlock block;
+            for(int lane = 0; lane < TriangleBlock::kWidth; ++lane)
+            {
+                block.SetTriangle(lane, triangles[j + lane].p0, triangles[j + lane].p1, triangles[j + lane].p2);
+            }
+
+            for(int frontFacesOnly = 0; frontFacesOnly < 2; ++frontFacesOnly)
+            {
+                float t[TriangleBlock::kWidth];
+                float u[TriangleBlock::kWidth];
+                float v[TriangleBlock::kWidth];
+                int hitMask = Intersect::TestRayTriangleBlock(ray, block, frontFacesOnly != 0, t, u, v);
+                for(int lane = 0; lane < TriangleBlock::kWidth; ++lane)
+                {
+                    const Triangle& triangle = triangles[j + lane];
+                    float expectedT = 0.0f;
+                    float expectedU = 0.0f;
+                    float expectedV = 0.0f;
+                    bool expectedHit = Intersect::TestRayTriangle(ray, triangle.p0, triangle.p1, triangle.p2, expectedT, expectedU, expectedV);
+                    if(frontFacesOnly)
+                    {
+                        expectedHit = expectedHit && Vector3::Dot(ray.direction, triangle.GetNormal()) < 0.0f;
+                    }
+
+                    bool hit = (hitMask & (1 << lane)) != 0;
+                    REQUIRE(hit == expectedHit);
+                    if(hit)
+                    {
+                        ++hitCount;
+                        REQUIRE(t[lane] == Approx(expectedT));
+                        REQUIRE(u[lane] == Approx(expectedU).margin(1.0e-5f));
+                        REQUIRE(v[lane] == Approx(expectedV).margin(1.0e-5f));
+                    }
+                }
+            }
+        }
+
+        // The empty lanes never hit anything.
+        float t[TriangleBlock::kWidth];
+        float u[TriangleBlock::kWidth];
+        float v[TriangleBlock::kWidth];
+        REQUIRE((Intersect::TestRayTriangleBlock(ray, emptyBlock, false, t, u, v) & ~1) == 0);
+    }
+
+    // Make sure the test is actually testing some hits!
+    REQUIRE(hitCount > 100);
+}
+
+TEST_CASE("TriangleBatch raycast finds the nearest triangle")
+{
+    std::mt19937 random(5678);
+    std::vector<Triangle> triangles;
+    MakeRandomTriangles(random, 101, triangles);
+
+    // An odd count, so the last block is only partly filled.
+    TriangleBatch batch;
+    for(size_t i = 0; i < triangles.size(); ++i)
+    {
+        batch.Add(triangles[i].p0, triangles[i].p1, triangles[i].p2, static_cast<uint32_t>(i));
+    }
+    REQUIRE(batch.GetBlockCount() == 26);
+
+    for(int i = 0; i < 200; ++i)
+    {
+        Ray ray = MakeRandomRay(random);
+        float expectedT = FLT_MAX;
+        uint32_t expectedId = 0;
+        for(size_t j = 0; j < triangles.size(); ++j)
+        {
+            float t = FLT_MAX;
+            if(Intersect::TestRayTriangle(ray, triangles[j], t) && t < expectedT)
+            {
+                expectedT = t;
+                expectedId = static_cast<uint32_t>(j);
+            }
+        }
+
+        TriangleBatchHit hit;
+        REQUIRE(batch.Raycast(ray, hit) == (expectedT < FLT_MAX));
+        if(expectedT < FLT_MAX)
+        {
+            REQUIRE(hit.t == Approx(expectedT));
+            REQUIRE(hit.id == expectedId);
+        }
+    }
+}
+
+TEST_CASE("Ray/triangle throughput", "[.benchmark]")
+{
+    // Hidden by default - run with "tests [.benchmark]" to see numbers.
+    std::mt19937 random(42);
+    std::vector<Triangle> triangles;
+    MakeRandomTriangles(random, 4096, triangles);
+    TriangleBatch batch;
+    for(size_t i = 0; i < triangles.size(); ++i)
+    {
+        batch.Add(triangles[i].p0, triangles[i].p1, triangles[i].p2, static_cast<uint32_t>(i));
+    }
+    std::vector<Ray> rays;
+    for(int i = 0; i < 1000; ++i)
+    {
+        rays.push_back(MakeRandomRay(random));
+    }
+    double testCount = static_cast<double>(triangles.size()) * rays.size();
+
+    // Scalar: one triangle at a time.
+    float scalarSum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for(const Ray& ray : rays)
+    {
+        float closestT = FLT_MAX;
+        for(const Triangle& triangle : triangles)
+        {
+            float t = FLT_MAX;
+            if(Intersect::TestRayTriangle(ray, triangle, t) && t < closestT)
+            {
+                closestT = t;
+            }
+        }
+        scalarSum += closestT < FLT_MAX ? closestT : 0.0f;
+    }
+    std::chrono::duration<double> scalarElapsed = std::chrono::steady_clock::now() - start;
+
+    // Batched: a block at a time.
+    float batchSum = 0.0f;
+    start = std::chrono::steady_clock::now();
+    for(const Ray& ray : rays)
+    {
+        TriangleBatchHit hit;
+        batchSum += batch.Raycast(ray, hit) ? hit.t : 0.0f;
+    }
+    std::chrono::duration<double> batchElapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(batchSum == Approx(scalarSum));
+    printf("Ray/triangle scalar: %.1f M tests/sec\n", testCount / scalarElapsed.count() / 1000000.0);
+    printf("Ray/triangle batch:  %.1f M tests/sec\n", testCount / batchElapsed.count() / 1000000.0);
+}
@@ -5,9 +5,18 @@
 //
 #include "catch.hh"
 
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "FlatMap.h"
+#include "MpscQueue.h"
 #include "Queue.h"
 #include "ResizableQueue.h"
+#include "SpscQueue.h"
 #include "Stack.h"
+#include "Symbol.h"
 
 // Helper object to store in containers.
 // A bit more interesting to test than built-in types.
@@ -185,4 +194,290 @@ TEST_CASE("Queue (resizable) works")
 TEST_CASE("Stack (fixed size) works")
 {
     Stack<TestObject, 10> stack;
-}
\ No newline at end of file
+}
+
+TEST_CASE("SpscQueue works")
+{
+    // Test initial state.
+    SpscQueue<int, 4> queue;
+    REQUIRE(queue.Size() == 0);
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.Capacity() == 4);
+    REQUIRE(queue.PeekReadable() == nullptr);
+
+    // Fill the queue. Once full, no more writable slots are available.
+    for(int i = 0; i < 4; ++i)
+    {
+        int* slot = queue.PeekWritable();
+        REQUIRE(slot != nullptr);
+        *slot = i;
+        queue.Push();
+    }
+    REQUIRE(queue.Size() == 4);
+    REQUIRE(queue.Full());
+    REQUIRE(queue.PeekWritable() == nullptr);
+
+    // Pop a couple, then push a couple more so the indexes wrap around.
+    for(int i = 0; i < 2; ++i)
+    {
+        REQUIRE(*queue.PeekReadable() == i);
+        queue.Pop();
+    }
+    for(int i = 4; i < 6; ++i)
+    {
+        *queue.PeekWritable() = i;
+        queue.Push();
+    }
+
+    // Elements should come out in the order they went in.
+    for(int i = 2; i < 6; ++i)
+    {
+        int* element = queue.PeekReadable();
+        REQUIRE(element != nullptr);
+        REQUIRE(*element == i);
+        queue.Pop();
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.PeekReadable() == nullptr);
+}
+
+namespace
+{
+    // Pushes "count" increasing values from one thread and pops them on another.
+    // Returns true if the consumer saw every value exactly once, in order.
+    template<uint32_t TCapacity>
+    bool RunSpscProducerConsumer(uint32_t count)
+    {
+        SpscQueue<uint32_t, TCapacity> queue;
+        std::thread producer([&queue, count]() {
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                uint32_t* slot = nullptr;
+                while((slot = queue.PeekWritable()) == nullptr)
+                {
+                    std::this_thread::yield();
+                }
+                *slot = i;
+                queue.Push();
+            }
+        });
+
+        bool inOrder = true;
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t* element = nullptr;
+            while((element = queue.PeekReadable()) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+            inOrder &= (*element == i);
+            queue.Pop();
+        }
+        producer.join();
+        return inOrder && queue.Empty();
+    }
+}
+
+TEST_CASE("SpscQueue works across threads")
+{
+    // A small capacity forces lots of full/empty transitions and wraparound.
+    REQUIRE(RunSpscProducerConsumer<4>(200000));
+    REQUIRE(RunSpscProducerConsumer<1024>(200000));
+}
+
+TEST_CASE("SpscQueue throughput", "[.benchmark]")
+{
+    // Hidden by default - run with "tests [.benchmark]" to see numbers.
+    const uint32_t kCount = 10000000;
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(RunSpscProducerConsumer<1024>(kCount));
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("SpscQueue: %u elements in %.3f sec (%.1f M/sec)\n", kCount, elapsed.count(), kCount / elapsed.count() / 1000000.0);
+}
+
+TEST_CASE("MpscQueue works")
+{
+    // Test initial state.
+    MpscQueue<int, 4> queue;
+    REQUIRE(queue.Size() == 0);
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.Capacity() == 4);
+    REQUIRE(queue.PeekReadable() == nullptr);
+
+    // Fill the queue. Once full, pushes fail.
+    for(int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.TryPush(i));
+    }
+    REQUIRE(queue.Size() == 4);
+    int extra = 100;
+    REQUIRE(!queue.TryPush(extra));
+
+    // Pop a couple, then push a couple more so the indexes wrap around.
+    for(int i = 0; i < 2; ++i)
+    {
+        REQUIRE(*queue.PeekReadable() == i);
+        queue.Pop();
+    }
+    for(int i = 4; i < 6; ++i)
+    {
+        REQUIRE(queue.TryPush(i));
+    }
+
+    // Elements should come out in the order they went in.
+    for(int i = 2; i < 6; ++i)
+    {
+        int* element = queue.PeekReadable();
+        REQUIRE(element != nullptr);
+        REQUIRE(*element == i);
+        queue.Pop();
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.PeekReadable() == nullptr);
+
+    // Pushing moves the value into the queue.
+    MpscQueue<std::string, 2> stringQueue;
+    std::string value = "a fairly long string that won't fit in the small string buffer";
+    REQUIRE(stringQueue.TryPush(value));
+    REQUIRE(value.empty());
+    REQUIRE(*stringQueue.PeekReadable() == "a fairly long string that won't fit in the small string buffer");
+}
+
+TEST_CASE("MpscQueue works across threads")
+{
+    // Several producers each push increasing values, tagged with the producer index.
+    // The consumer should see every value exactly once, and each producer's values in order.
+    const uint32_t kProducerCount = 4;
+    const uint32_t kCountPerProducer = 50000;
+    MpscQueue<uint32_t, 64> queue;
+
+    std::vector<std::thread> producers;
+    for(uint32_t producerIndex = 0; producerIndex < kProducerCount; ++producerIndex)
+    {
+        producers.emplace_back([&queue, producerIndex, kCountPerProducer]() {
+            for(uint32_t i = 0; i < kCountPerProducer; ++i)
+            {
+                uint32_t value = (producerIndex << 24) | i;
+                while(!queue.TryPush(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> nextValues(kProducerCount, 0);
+    bool inOrder = true;
+    for(uint32_t i = 0; i < kProducerCount * kCountPerProducer; ++i)
+    {
+        uint32_t* element = nullptr;
+        while((element = queue.PeekReadable()) == nullptr)
+        {
+            std::this_thread::yield();
+        }
+        uint32_t producerIndex = *element >> 24;
+        inOrder &= producerIndex < kProducerCount && (*element & 0xFFFFFF) == nextValues[producerIndex];
+        if(producerIndex < kProducerCount)
+        {
+            ++nextValues[producerIndex];
+        }
+        queue.Pop();
+    }
+    for(std::thread& producer : producers)
+    {
+        producer.join();
+    }
+    REQUIRE(inOrder);
+    REQUIRE(queue.Empty());
+}
+
+TEST_CASE("FlatMap works")
+{
+    FlatMap<int, int> map;
+    REQUIRE(map.Empty());
+    REQUIRE(map.Find(1) == nullptr);
+    REQUIRE(!map.Erase(1));
+
+    // Add enough entries to force several rehashes.
+    const int kCount = 1000;
+    for(int i = 0; i < kCount; ++i)
+    {
+        map[i] = i * 10;
+    }
+    REQUIRE(map.Size() == kCount);
+
+    bool allFound = true;
+    for(int i = 0; i < kCount; ++i)
+    {
+        int* value = map.Find(i);
+        allFound &= value != nullptr && *value == i * 10;
+    }
+    REQUIRE(allFound);
+    REQUIRE(!map.Contains(kCount));
+
+    // operator[] on an existing key doesn't add a new entry.
+    map[5] = 55;
+    REQUIRE(map.Size() == kCount);
+    REQUIRE(*map.Find(5) == 55);
+
+    // Erase every other entry. Entries that probed past erased ones must still be found.
+    for(int i = 0; i < kCount; i += 2)
+    {
+        REQUIRE(map.Erase(i));
+    }
+    REQUIRE(map.Size() == kCount / 2);
+
+    bool correctAfterErase = true;
+    for(int i = 0; i < kCount; ++i)
+    {
+        correctAfterErase &= map.Contains(i) == (i % 2 == 1);
+    }
+    REQUIRE(correctAfterErase);
+
+    // Iteration visits each remaining entry once.
+    int iteratedCount = 0;
+    int iteratedSum = 0;
+    for(auto& entry : map)
+    {
+        ++iteratedCount;
+        iteratedSum += entry.first;
+    }
+    REQUIRE(iteratedCount == kCount / 2);
+    REQUIRE(iteratedSum == (kCount / 2) * (kCount / 2));
+
+    map.Clear();
+    REQUIRE(map.Empty());
+    REQUIRE(map.begin() == map.end());
+    REQUIRE(map.Find(1) == nullptr);
+}
+
+TEST_CASE("Symbol works")
+{
+    // Default symbol is the empty name.
+    Symbol empty;
+    REQUIRE(empty.IsEmpty());
+    REQUIRE(empty.GetId() == 0);
+    REQUIRE(empty.GetName().empty());
+    REQUIRE(Symbol("") == empty);
+
+    // Finding a name doesn't intern it.
+    REQUIRE(Symbol::Find("SymbolTestName").IsEmpty());
+
+    // Symbols are case-insensitive, and keep the casing of the first intern.
+    Symbol symbol("SymbolTestName");
+    REQUIRE(!symbol.IsEmpty());
+    REQUIRE(Symbol("SYMBOLTESTNAME") == symbol);
+    REQUIRE(Symbol::Find("symboltestname") == symbol);
+    REQUIRE(symbol.GetName() == "SymbolTestName");
+
+    // Different names give different symbols.
+    Symbol otherSymbol("SymbolTestOtherName");
+    REQUIRE(otherSymbol != symbol);
+
+    // Symbols work as map keys.
+    SymbolMap<int> map;
+    map[symbol] = 1;
+    map[otherSymbol] = 2;
+    REQUIRE(*map.Find(Symbol("symboltestname")) == 1);
+    REQUIRE(*map.Find(Symbol("SYMBOLTESTOTHERNAME")) == 2);
+}
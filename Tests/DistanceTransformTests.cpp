@@ -0,0 +1,76 @@
+//
+// Clark Kromenaker
+//
+// Tests for DistanceTransform.
+//
+#include "catch.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+#include <vector>
+
+#include "DistanceTransform.h"
+
+TEST_CASE("Distance transform matches brute force")
+{
+    std::mt19937 random(11);
+    const uint32_t kWidth = 37;
+    const uint32_t kHeight = 23;
+    for(int density : { 2, 10, 50, 200 })
+    {
+        // Randomly scatter features, with fewer of them as density goes up.
+        std::uniform_int_distribution<int> chance(0, density);
+        std::vector<uint8_t> features(kWidth * kHeight);
+        for(uint8_t& feature : features)
+        {
+            feature = chance(random) == 0 ? 1 : 0;
+        }
+        features[kWidth * kHeight / 2] = 1;
+
+        std::vector<float> distancesSq(kWidth * kHeight);
+        std::vector<uint32_t> nearestIndexes(kWidth * kHeight);
+        DistanceTransform::Compute(features.data(), kWidth, kHeight, distancesSq.data(), nearestIndexes.data());
+
+        for(uint32_t y = 0; y < kHeight; ++y)
+        {
+            for(uint32_t x = 0; x < kWidth; ++x)
+            {
+                // Check against every feature.
+                float bestDistSq = FLT_MAX;
+                for(uint32_t fy = 0; fy < kHeight; ++fy)
+                {
+                    for(uint32_t fx = 0; fx < kWidth; ++fx)
+                    {
+                        if(features[fy * kWidth + fx] == 0) { continue; }
+                        float dx = static_cast<float>(fx) - static_cast<float>(x);
+                        float dy = static_cast<float>(fy) - static_cast<float>(y);
+                        bestDistSq = std::min(bestDistSq, dx * dx + dy * dy);
+                    }
+                }
+
+                // Ties can go either way, but the nearest feature should be a feature, at the nearest distance.
+                uint32_t index = y * kWidth + x;
+                REQUIRE(distancesSq[index] == bestDistSq);
+                uint32_t nearest = nearestIndexes[index];
+                REQUIRE(features[nearest] != 0);
+                float dx = static_cast<float>(nearest % kWidth) - static_cast<float>(x);
+                float dy = static_cast<float>(nearest / kWidth) - static_cast<float>(y);
+                REQUIRE(dx * dx + dy * dy == bestDistSq);
+            }
+        }
+    }
+}
+
+TEST_CASE("Distance transform with no features")
+{
+    std::vector<uint8_t> features(16 * 8, 0);
+    std::vector<float> distancesSq(features.size());
+    std::vector<uint32_t> nearestIndexes(features.size());
+    DistanceTransform::Compute(features.data(), 16, 8, distancesSq.data(), nearestIndexes.data());
+    for(size_t i = 0; i < features.size(); ++i)
+    {
+        REQUIRE(distancesSq[i] > FLT_MAX);
+        REQUIRE(nearestIndexes[i] == DistanceTransform::kNoFeature);
+    }
+}
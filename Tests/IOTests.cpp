@@ -6,10 +6,18 @@
 #include "catch.hh"
 
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
 
 #include "BinaryReader.h"
 #include "BinaryWriter.h"
+#include "CookCache.h"
+#include "IniReader.h"
+#include "SaveChunks.h"
+#include "StringTokenizer.h"
 
 TEST_CASE("Read/Write binary memory works")
 {
@@ -121,4 +129,295 @@ TEST_CASE("Read/Write binary memory works")
 
     reader.Skip(100);
     REQUIRE(reader.GetPosition() == 100);
-}
\ No newline at end of file
+}
+
+TEST_CASE("IniReader tokenizes sections in place")
+{
+    const char* text =
+        "// Comment line\r\n"
+        "[GENERAL]\r\n"
+        "\tcamera = {10, 20, 30}, hidden  // trailing comment\r\n"
+        "/* block\r\n"
+        "   comment */\r\n"
+        "[ACTORS=IsCurrentTime(\"110A\")]\n"
+        "model=GAB\n"
+        "[ACTORS]\n"
+        "model=GRA";
+    IniReader reader(reinterpret_cast<const uint8_t*>(text), static_cast<uint32_t>(strlen(text)));
+    reader.ReadAll();
+
+    // Keys and values are views into the original buffer - nothing is copied.
+    IniSectionView general = reader.GetSectionView("general");
+    REQUIRE(general.name == "GENERAL");
+    REQUIRE(general.lines.size() == 1);
+    REQUIRE(general.lines[0].entries.size() == 2);
+    REQUIRE(general.lines[0].entries[0].key == "camera");
+    REQUIRE(general.lines[0].entries[0].value == "{10, 20, 30}");
+    REQUIRE(general.lines[0].entries[0].GetValueAsVector3() == Vector3(10.0f, 20.0f, 30.0f));
+    REQUIRE(general.lines[0].entries[1].key == "hidden");
+    REQUIRE(general.lines[0].entries[0].key.data() >= text);
+    REQUIRE(general.lines[0].entries[0].key.data() < text + strlen(text));
+
+    // Conditions are split from the section name. Multiple sections can have the same name.
+    std::vector<IniSectionView> actors = reader.GetSectionViews("ACTORS");
+    REQUIRE(actors.size() == 2);
+    REQUIRE(actors[0].condition == "IsCurrentTime(\"110A\")");
+    REQUIRE(actors[0].lines[0].entries[0].value == "GAB");
+    REQUIRE(actors[1].condition.empty());
+    REQUIRE(actors[1].lines[0].entries[0].value == "GRA");
+
+    // Owning copies still work for callers that hold onto the data.
+    IniSection copy = reader.GetSection("GENERAL");
+    REQUIRE(copy.lines[0].entries[0].key == "camera");
+}
+
+TEST_CASE("StringTokenizer splits without copying")
+{
+    std::string line = "ANIM  GAB_IDLE, TRUE (5)";
+    StringTokenizer tokenizer(line, { ' ', ',', '(', ')' });
+    REQUIRE(tokenizer.GetTokenCount() == 4);
+    REQUIRE(tokenizer.GetNext() == "ANIM");
+    REQUIRE(tokenizer.GetNext() == "GAB_IDLE");
+    REQUIRE(tokenizer.GetNext() == "TRUE");
+    std::string_view last = tokenizer.GetNext();
+    REQUIRE(last == "5");
+    REQUIRE(last.data() == line.data() + line.find('5'));
+    REQUIRE(!tokenizer.HasNext());
+}
+
+TEST_CASE("Cook cache round trips through its file")
+{
+    const char* kFilePath = "CookCacheTest.cache";
+    std::remove(kFilePath);
+
+    // Keys depend on the name (case-insensitive) and the contents.
+    const uint8_t source[] = { 1, 2, 3, 4 };
+    uint64_t key = CookCache::MakeKey("Test.shp", source, sizeof(source));
+    REQUIRE(key == CookCache::MakeKey("TEST.SHP", source, sizeof(source)));
+    REQUIRE(key != CookCache::MakeKey("Test.shp", source, sizeof(source) - 1));
+    REQUIRE(key != CookCache::MakeKey("Other.shp", source, sizeof(source)));
+
+    // Nothing is cached until the cache is loaded.
+    const uint8_t cooked[] = { 9, 8, 7 };
+    const uint8_t* data = nullptr;
+    uint32_t length = 0;
+    {
+        CookCache cache;
+        cache.Store(key, cooked, sizeof(cooked));
+        REQUIRE(!cache.Find(key, data, length));
+
+        // Missing file is fine - the cache just starts empty.
+        cache.Load(kFilePath);
+        REQUIRE(cache.IsEnabled());
+        REQUIRE(!cache.Find(key, data, length));
+
+        cache.Store(key, cooked, sizeof(cooked));
+        cache.Store(key + 1, source, sizeof(source));
+        REQUIRE(cache.Find(key, data, length));
+        REQUIRE(length == sizeof(cooked));
+        REQUIRE(cache.Save());
+    }
+
+    // A new cache finds the saved entries.
+    {
+        CookCache cache;
+        cache.Load(kFilePath);
+        REQUIRE(cache.Find(key, data, length));
+        REQUIRE(length == sizeof(cooked));
+        REQUIRE(memcmp(data, cooked, sizeof(cooked)) == 0);
+        REQUIRE(cache.Find(key + 1, data, length));
+        REQUIRE(length == sizeof(source));
+        REQUIRE(!cache.Find(key + 2, data, length));
+    }
+
+    // A file from another format version is ignored.
+    {
+        std::fstream file(kFilePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(8);
+        uint32_t otherVersion = CookCache::kFormatVersion + 1;
+        file.write(reinterpret_cast<const char*>(&otherVersion), sizeof(otherVersion));
+    }
+    {
+        CookCache cache;
+        cache.Load(kFilePath);
+        REQUIRE(!cache.Find(key, data, length));
+    }
+    std::remove(kFilePath);
+}
+
+TEST_CASE("Cook cache stays under its size cap")
+{
+    const char* kFilePath = "CookCacheCapTest.cache";
+    std::remove(kFilePath);
+
+    // Three of these don't fit in the cache.
+    std::vector<uint8_t> cooked(6 * 1024 * 1024, 1);
+    const uint64_t kKeyA = 1;
+    const uint64_t kKeyB = 2;
+    const uint64_t kKeyC = 3;
+    const uint64_t kKeyD = 4;
+    const uint8_t* data = nullptr;
+    uint32_t length = 0;
+    {
+        CookCache cache;
+        cache.Load(kFilePath);
+        cache.Store(kKeyA, cooked.data(), static_cast<uint32_t>(cooked.size()));
+        cache.Store(kKeyB, cooked.data(), static_cast<uint32_t>(cooked.size()));
+        REQUIRE(cache.Save());
+    }
+
+    // Only A is used on this run. When C is added, there's no room left for B, so it's dropped.
+    {
+        CookCache cache;
+        cache.Load(kFilePath);
+        REQUIRE(cache.Find(kKeyA, data, length));
+        cache.Store(kKeyC, cooked.data(), static_cast<uint32_t>(cooked.size()));
+        REQUIRE(cache.Save());
+    }
+
+    // A and C are used on this run, so there's no room to store D.
+    {
+        CookCache cache;
+        cache.Load(kFilePath);
+        REQUIRE(!cache.Find(kKeyB, data, length));
+        REQUIRE(cache.Find(kKeyA, data, length));
+        REQUIRE(cache.Find(kKeyC, data, length));
+        REQUIRE(length == cooked.size());
+
+        cache.Store(kKeyD, cooked.data(), static_cast<uint32_t>(cooked.size()));
+        REQUIRE(!cache.Find(kKeyD, data, length));
+    }
+    std::remove(kFilePath);
+}
+
+namespace
+{
+    // Writes some bytes (standing in for a save header), followed by the chunks.
+    std::string WriteSaveChunks(const std::vector<SaveChunk>& chunks)
+    {
+        std::stringstream stream;
+        BinaryWriter writer(&stream);
+        writer.WriteUInt(0xDEADBEEF);
+        SaveChunks::Write(writer, chunks);
+        return stream.str();
+    }
+
+    void WriteUIntAt(std::string& bytes, size_t position, uint32_t value)
+    {
+        memcpy(&bytes[position], &value, sizeof(value));
+    }
+}
+
+TEST_CASE("Save chunks round trip")
+{
+    // One chunk that compresses well, and one that doesn't (so is stored as-is).
+    std::vector<uint8_t> game(4096, 7);
+    std::vector<uint8_t> header = { 1, 2, 3, 4, 5 };
+    std::vector<SaveChunk> chunks;
+    chunks.push_back(SaveChunks::Create("HEAD", header.data(), static_cast<uint32_t>(header.size()), {}, nullptr));
+    chunks.push_back(SaveChunks::Create("GAME", game.data(), static_cast<uint32_t>(game.size()), {}, nullptr));
+    REQUIRE(!chunks[0].compressed);
+    REQUIRE(chunks[1].compressed);
+    REQUIRE(chunks[1].storedData.size() < game.size());
+
+    std::string bytes = WriteSaveChunks(chunks);
+    BinaryReader reader(bytes.data(), static_cast<uint32_t>(bytes.size()));
+    reader.Skip(4);
+
+    std::vector<SaveChunk> readChunks;
+    REQUIRE(SaveChunks::ReadTableOfContents(reader, readChunks));
+    REQUIRE(readChunks.size() == 2);
+    REQUIRE(readChunks[0].HasId("HEAD"));
+    REQUIRE(readChunks[1].HasId("GAME"));
+
+    // Chunks can be read individually, in any order.
+    std::vector<uint8_t> data;
+    REQUIRE(SaveChunks::ReadChunk(reader, readChunks[1]));
+    REQUIRE(SaveChunks::Decompress(readChunks[1], data));
+    REQUIRE(data == game);
+
+    data.clear();
+    REQUIRE(SaveChunks::ReadChunk(reader, readChunks[0]));
+    REQUIRE(SaveChunks::Decompress(readChunks[0], data));
+    REQUIRE(data == header);
+
+    // Creating a chunk with unchanged data reuses the previous save's stored data. Changed data is compressed again.
+    std::vector<SaveChunk> previousChunks;
+    reader.Seek(4);
+    REQUIRE(SaveChunks::ReadTableOfContents(reader, previousChunks));
+    SaveChunk reused = SaveChunks::Create("GAME", game.data(), static_cast<uint32_t>(game.size()), previousChunks, &reader);
+    REQUIRE(reused.compressed);
+    REQUIRE(reused.storedData == chunks[1].storedData);
+
+    game[100] = 8;
+    SaveChunk changed = SaveChunks::Create("GAME", game.data(), static_cast<uint32_t>(game.size()), previousChunks, &reader);
+    REQUIRE(changed.checksum != chunks[1].checksum);
+    data.clear();
+    REQUIRE(SaveChunks::Decompress(changed, data));
+    REQUIRE(data == game);
+}
+
+TEST_CASE("Save chunks reject truncated or corrupt input")
+{
+    std::vector<uint8_t> game(4096, 7);
+    std::vector<SaveChunk> chunks;
+    chunks.push_back(SaveChunks::Create("GAME", game.data(), static_cast<uint32_t>(game.size()), {}, nullptr));
+    const std::string bytes = WriteSaveChunks(chunks);
+
+    // Table of contents starts after the 4 byte stand-in header. Its single entry starts after the id and count.
+    const size_t kEntryPosition = 4 + 8;
+    auto readTableOfContents = [](const std::string& input, std::vector<SaveChunk>& outChunks) {
+        BinaryReader reader(input.data(), static_cast<uint32_t>(input.size()));
+        reader.Skip(4);
+        return SaveChunks::ReadTableOfContents(reader, outChunks);
+    };
+    std::vector<SaveChunk> readChunks;
+
+    SECTION("Truncated table of contents")
+    {
+        REQUIRE(!readTableOfContents(bytes.substr(0, kEntryPosition + 10), readChunks));
+        REQUIRE(readChunks.empty());
+    }
+    SECTION("Truncated chunk data")
+    {
+        REQUIRE(!readTableOfContents(bytes.substr(0, bytes.size() - 1), readChunks));
+        REQUIRE(readChunks.empty());
+    }
+    SECTION("Huge chunk count")
+    {
+        std::string corrupt = bytes;
+        WriteUIntAt(corrupt, 4 + 4, 0xFFFFFFFF);
+        REQUIRE(!readTableOfContents(corrupt, readChunks));
+        REQUIRE(readChunks.empty());
+    }
+    SECTION("Chunk offset inside table of contents")
+    {
+        std::string corrupt = bytes;
+        WriteUIntAt(corrupt, kEntryPosition + 8, 0);
+        REQUIRE(!readTableOfContents(corrupt, readChunks));
+    }
+    SECTION("Huge stored size")
+    {
+        std::string corrupt = bytes;
+        WriteUIntAt(corrupt, kEntryPosition + 12, 0xFFFFFFF0);
+        REQUIRE(!readTableOfContents(corrupt, readChunks));
+    }
+    SECTION("Huge uncompressed size")
+    {
+        std::string corrupt = bytes;
+        WriteUIntAt(corrupt, kEntryPosition + 16, 0xFFFFFFF0);
+        REQUIRE(!readTableOfContents(corrupt, readChunks));
+    }
+    SECTION("Corrupt chunk data")
+    {
+        std::string corrupt = bytes;
+        corrupt[corrupt.size() - 2] ^= 0xFF;
+        REQUIRE(readTableOfContents(corrupt, readChunks));
+
+        BinaryReader reader(corrupt.data(), static_cast<uint32_t>(corrupt.size()));
+        REQUIRE(SaveChunks::ReadChunk(reader, readChunks[0]));
+        std::vector<uint8_t> data = { 1, 2 };
+        REQUIRE(!SaveChunks::Decompress(readChunks[0], data));
+        REQUIRE(data.size() == 2);
+    }
+}
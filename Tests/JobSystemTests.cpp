@@ -0,0 +1,184 @@
+//
+// Clark Kromenaker
+//
+// Tests for the job system.
+//
+#include "catch.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+
+TEST_CASE("Job system runs jobs and waits on handles")
+{
+    JobSystem::Init(3);
+
+    // Run a bunch of jobs and wait on each one.
+    std::atomic<int> counter(0);
+    std::vector<JobHandle> handles;
+    for(int i = 0; i < 100; ++i)
+    {
+        handles.push_back(JobSystem::Run([&counter]() { counter++; }));
+    }
+    for(JobHandle& handle : handles)
+    {
+        JobSystem::Wait(handle);
+        REQUIRE(JobSystem::IsDone(handle));
+    }
+    REQUIRE(counter == 100);
+
+    // An invalid handle is always done.
+    REQUIRE(JobSystem::IsDone(JobHandle()));
+
+    JobSystem::Shutdown();
+}
+
+TEST_CASE("Job system respects dependencies")
+{
+    JobSystem::Init(3);
+
+    // Chain jobs so each depends on the previous one. They must run in order, even though several workers are available.
+    std::vector<int> order;
+    JobHandle previous;
+    for(int i = 0; i < 50; ++i)
+    {
+        previous = JobSystem::Run([&order, i]() { order.push_back(i); }, previous);
+    }
+    JobSystem::Wait(previous);
+
+    REQUIRE(order.size() == 50);
+    for(int i = 0; i < 50; ++i)
+    {
+        REQUIRE(order[i] == i);
+    }
+
+    // Many jobs can depend on a single job.
+    std::atomic<bool> rootDone(false);
+    std::atomic<int> dependentsSawRoot(0);
+    JobHandle root = JobSystem::Run([&rootDone]() { rootDone = true; });
+    std::vector<JobHandle> dependents;
+    for(int i = 0; i < 20; ++i)
+    {
+        dependents.push_back(JobSystem::Run([&rootDone, &dependentsSawRoot]() {
+            if(rootDone) { dependentsSawRoot++; }
+        }, root));
+    }
+    for(JobHandle& handle : dependents)
+    {
+        JobSystem::Wait(handle);
+    }
+    REQUIRE(dependentsSawRoot == 20);
+
+    JobSystem::Shutdown();
+}
+
+TEST_CASE("Job system stores big functions")
+{
+    JobSystem::Init(1);
+
+    // This lambda is too big to store inline, so it takes the heap fallback path.
+    int values[64] = { 0 };
+    values[63] = 42;
+    int result = 0;
+    JobHandle handle = JobSystem::Run([values, &result]() { result = values[63]; });
+    JobSystem::Wait(handle);
+    REQUIRE(result == 42);
+
+    JobSystem::Shutdown();
+}
+
+TEST_CASE("ParallelFor visits every index once")
+{
+    JobSystem::Init(3);
+
+    const uint32_t kCount = 10000;
+    std::vector<std::atomic<int>> visits(kCount);
+    JobSystem::ParallelFor(kCount, 64, [&visits](uint32_t i) {
+        visits[i]++;
+    });
+
+    bool allVisitedOnce = true;
+    for(uint32_t i = 0; i < kCount; ++i)
+    {
+        allVisitedOnce &= (visits[i] == 1);
+    }
+    REQUIRE(allVisitedOnce);
+
+    // Works with uneven batches and a count smaller than the batch size too.
+    std::atomic<int> sum(0);
+    JobSystem::ParallelFor(10, 3, [&sum](uint32_t i) { sum += i; });
+    REQUIRE(sum == 45);
+    sum = 0;
+    JobSystem::ParallelFor(5, 100, [&sum](uint32_t i) { sum += i; });
+    REQUIRE(sum == 10);
+
+    JobSystem::Shutdown();
+}
+
+TEST_CASE("Job system runs jobs scheduled by other threads")
+{
+    JobSystem::Init(2);
+
+    // A thread that isn't part of the job system has no deque of its own, but can still schedule jobs and wait on them.
+    std::atomic<int> counter(0);
+    std::thread outsideThread([&counter]() {
+        std::vector<JobHandle> handles;
+        for(int i = 0; i < 100; ++i)
+        {
+            handles.push_back(JobSystem::Run([&counter]() { counter++; }));
+        }
+        for(JobHandle& handle : handles)
+        {
+            JobSystem::Wait(handle);
+        }
+    });
+    outsideThread.join();
+    REQUIRE(counter == 100);
+
+    // The main thread can also run jobs that were scheduled by another thread.
+    JobHandle handle;
+    std::thread scheduleThread([&handle, &counter]() {
+        handle = JobSystem::Run([&counter]() { counter++; });
+    });
+    scheduleThread.join();
+    JobSystem::Wait(handle);
+    REQUIRE(counter == 101);
+
+    JobSystem::Shutdown();
+}
+
+TEST_CASE("Threads outside the job system only run the jobs they wait on")
+{
+    JobSystem::Init(1);
+
+    // Keep the only worker busy until we say so.
+    std::atomic<bool> release(false);
+    JobHandle blocker = JobSystem::Run([&release]() {
+        while(!release) { std::this_thread::yield(); }
+    });
+
+    // While waiting on one job, this thread runs that job, but not another job queued ahead of it.
+    std::atomic<bool> otherRan(false);
+    std::atomic<bool> waitedRan(false);
+    JobHandle other = JobSystem::Run([&otherRan]() { otherRan = true; });
+    JobHandle waited = JobSystem::Run([&waitedRan]() { waitedRan = true; });
+    JobSystem::Wait(waited);
+    REQUIRE(waitedRan);
+    REQUIRE(!otherRan);
+
+    // ParallelFor still finishes even though the worker is busy; this thread takes every batch.
+    std::atomic<int> sum(0);
+    JobSystem::ParallelFor(100, 10, [&sum](uint32_t i) { sum += i; });
+    REQUIRE(sum == 4950);
+    REQUIRE(!otherRan);
+
+    // Once the worker is free, it runs the other job.
+    release = true;
+    JobSystem::Wait(blocker);
+    JobSystem::Wait(other);
+    REQUIRE(otherRan);
+
+    JobSystem::Shutdown();
+}
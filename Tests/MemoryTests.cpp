@@ -5,11 +5,22 @@
 //
 #include "catch.hh"
 
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
 #include <vector>
 
 #include "PtrMath.h"
+#include "FrameAllocator.h"
 #include "LinearAllocator.h"
+#include "MemoryTracker.h"
+#include "ObjectPool.h"
+#include "PoolAllocator.h"
 #include "FreestyleAllocator.h"
+#include "TLSFAllocator.h"
 
 TEST_CASE("Pointer Add/Subtract/Diff are correct")
 {
@@ -206,6 +217,259 @@ TEST_CASE("Linear allocator works correctly")
     REQUIRE(linearAllocator.GetAllocatedSize() == 900);
 }
 
+TEST_CASE("Frame allocator works correctly")
+{
+    // Start from a clean arena.
+    FrameAllocator::EndFrame();
+    REQUIRE(FrameAllocator::GetStats().allocationCount == 0);
+
+    // Allocations respect alignment.
+    void* alloc1 = FrameAllocator::Allocate(3, 1);
+    void* alloc2 = FrameAllocator::Allocate(16, 16);
+    REQUIRE(alloc1 != nullptr);
+    REQUIRE(alloc2 != nullptr);
+    REQUIRE(PtrMath::Align(alloc2, 16) == alloc2);
+    REQUIRE(FrameAllocator::GetStats().allocationCount == 2);
+
+    // Ending the frame resets the arena, so the same memory is reused.
+    FrameAllocator::EndFrame();
+    REQUIRE(FrameAllocator::GetStats().allocationCount == 0);
+    REQUIRE(FrameAllocator::Allocate(3, 1) == alloc1);
+    FrameAllocator::EndFrame();
+
+    // An allocation that doesn't fit in the arena overflows to the heap.
+    size_t capacity = FrameAllocator::GetStats().capacity;
+    void* bigAlloc = FrameAllocator::Allocate(capacity * 2);
+    REQUIRE(bigAlloc != nullptr);
+    REQUIRE(FrameAllocator::GetStats().overflowCount == 1);
+
+    // After a reset, the arena grows so the allocation fits next time.
+    FrameAllocator::EndFrame();
+    REQUIRE(FrameAllocator::GetStats().capacity > capacity * 2);
+    FrameAllocator::Allocate(capacity * 2);
+    REQUIRE(FrameAllocator::GetStats().overflowCount == 0);
+    FrameAllocator::Shutdown();
+}
+
+TEST_CASE("Frame allocator STL adapter works correctly")
+{
+    FrameAllocator::EndFrame();
+
+    // Containers using frame memory work like normal containers.
+    {
+        std::frame_vector<int> vector;
+        for(int i = 0; i < 1000; ++i)
+        {
+            vector.push_back(i);
+        }
+        REQUIRE(vector.size() == 1000);
+        REQUIRE(vector[999] == 999);
+
+        std::frame_unordered_map<int, int> map;
+        for(int i = 0; i < 100; ++i)
+        {
+            map[i] = i * 2;
+        }
+        REQUIRE(map.size() == 100);
+        REQUIRE(map[50] == 100);
+        REQUIRE(FrameAllocator::GetStats().allocationCount > 0);
+    }
+
+    // Once all containers are destroyed, the arena resets itself.
+    REQUIRE(FrameAllocator::GetStats().allocationCount == 0);
+
+    // Each thread has its own arena.
+    std::frame_vector<int> mainVector(10, 1);
+    size_t otherThreadCount = 0;
+    std::thread thread([&otherThreadCount]() {
+        std::frame_vector<int> vector(100, 2);
+        otherThreadCount = FrameAllocator::GetStats().allocationCount;
+    });
+    thread.join();
+    REQUIRE(otherThreadCount == 1);
+    REQUIRE(FrameAllocator::GetStats().allocationCount == 1);
+}
+
+TEST_CASE("Memory tracker records stats per tag")
+{
+    // Tags are set per-scope.
+    REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::Untagged);
+    {
+        ScopedMemoryTag scopedTag(MemoryTag::Textures);
+        REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::Textures);
+        {
+            ScopedMemoryTag innerScopedTag(MemoryTag::BSP);
+            REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::BSP);
+        }
+        REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::Textures);
+    }
+    REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::Untagged);
+
+    // Live bytes/counts go up and down with allocations.
+    MemoryTracker::EndFrame();
+    MemoryTracker::TagStats start = MemoryTracker::GetTagStats(MemoryTag::Animation);
+    MemoryTracker::OnAllocate(100, MemoryTag::Animation);
+    MemoryTracker::OnAllocate(50, MemoryTag::Animation);
+    MemoryTracker::TagStats stats = MemoryTracker::GetTagStats(MemoryTag::Animation);
+    REQUIRE(stats.liveBytes == start.liveBytes + 150);
+    REQUIRE(stats.liveCount == start.liveCount + 2);
+    REQUIRE(stats.peakBytes >= start.liveBytes + 150);
+
+    // Deallocating lowers live bytes, but the peak remains.
+    MemoryTracker::OnDeallocate(100, MemoryTag::Animation);
+    stats = MemoryTracker::GetTagStats(MemoryTag::Animation);
+    REQUIRE(stats.liveBytes == start.liveBytes + 50);
+    REQUIRE(stats.liveCount == start.liveCount + 1);
+    REQUIRE(stats.peakBytes >= start.liveBytes + 150);
+
+    // Other tags aren't affected.
+    REQUIRE(MemoryTracker::GetTagStats(MemoryTag::Sheep).liveBytes == 0);
+
+    // Ending the frame calculates allocations made during the frame.
+    MemoryTracker::EndFrame();
+    stats = MemoryTracker::GetTagStats(MemoryTag::Animation);
+    REQUIRE(stats.frameAllocCount == 2);
+    REQUIRE(stats.frameAllocBytes == 150);
+
+    // No allocations next frame.
+    MemoryTracker::EndFrame();
+    REQUIRE(MemoryTracker::GetTagStats(MemoryTag::Animation).frameAllocCount == 0);
+
+    // Baseline remembers live bytes at the time it was set.
+    MemoryTracker::SetBaseline();
+    REQUIRE(MemoryTracker::GetTagStats(MemoryTag::Animation).baselineBytes == start.liveBytes + 50);
+    MemoryTracker::OnDeallocate(50, MemoryTag::Animation);
+}
+
+TEST_CASE("Pool allocator works correctly")
+{
+    // Block size is rounded up to keep blocks aligned.
+    PoolAllocator allocator(20, 4);
+    REQUIRE(allocator.GetBlockSize() == 32);
+    REQUIRE(allocator.GetChunkCount() == 0);
+
+    // First allocation creates a chunk. Blocks are allocated in address order.
+    std::vector<void*> allocs;
+    for(int i = 0; i < 4; ++i)
+    {
+        allocs.push_back(allocator.Allocate());
+    }
+    REQUIRE(allocator.GetChunkCount() == 1);
+    REQUIRE(allocator.GetAllocationCount() == 4);
+    REQUIRE(PtrMath::Diff(allocs[1], allocs[0]) == 32);
+    REQUIRE(PtrMath::Align(allocs[0], alignof(std::max_align_t)) == allocs[0]);
+
+    // Chunk is full, so another allocation creates a second chunk.
+    allocs.push_back(allocator.Allocate());
+    REQUIRE(allocator.GetChunkCount() == 2);
+
+    // Freed blocks are reused, most recent first.
+    allocator.Deallocate(allocs[2]);
+    REQUIRE(allocator.GetAllocationCount() == 4);
+    REQUIRE(allocator.Allocate() == allocs[2]);
+
+    // A chunk with allocated blocks is not released...
+    allocator.Deallocate(allocs[4]);
+    allocator.Deallocate(allocs[0]);
+    allocator.ReleaseUnusedChunks();
+    REQUIRE(allocator.GetChunkCount() == 1);
+    REQUIRE(allocator.GetAllocationCount() == 3);
+
+    // ...and the free blocks in it are still usable.
+    REQUIRE(allocator.Allocate() == allocs[0]);
+    REQUIRE(allocator.GetChunkCount() == 1);
+
+    // Once everything is freed, all chunks are released.
+    allocator.Deallocate(allocs[0]);
+    allocator.Deallocate(allocs[1]);
+    allocator.Deallocate(allocs[2]);
+    allocator.Deallocate(allocs[3]);
+    allocator.ReleaseUnusedChunks();
+    REQUIRE(allocator.GetChunkCount() == 0);
+    REQUIRE(allocator.GetAllocationCount() == 0);
+}
+
+TEST_CASE("Object pool works correctly")
+{
+    ObjectPool pool;
+
+    // Similar sizes share a size class, so memory is reused across sizes.
+    void* alloc1 = pool.Allocate(40);
+    pool.Deallocate(alloc1, 40);
+    void* alloc2 = pool.Allocate(48);
+    REQUIRE(alloc2 == alloc1);
+    REQUIRE(pool.GetAllocationCount() == 1);
+
+    // Different size classes get different memory.
+    void* alloc3 = pool.Allocate(100);
+    REQUIRE(alloc3 != alloc2);
+    REQUIRE(pool.GetAllocationCount() == 2);
+
+    // Big allocations fall back on the heap, and aren't counted.
+    void* bigAlloc = pool.Allocate(100000);
+    REQUIRE(bigAlloc != nullptr);
+    REQUIRE(pool.GetAllocationCount() == 2);
+    pool.Deallocate(bigAlloc, 100000);
+
+    pool.Deallocate(alloc2, 48);
+    pool.Deallocate(alloc3, 100);
+    REQUIRE(pool.GetAllocationCount() == 0);
+    pool.ReleaseUnusedMemory();
+
+    // Pool can be used from multiple threads at once.
+    auto churn = [&pool]() {
+        std::vector<void*> allocs;
+        for(int i = 0; i < 1000; ++i)
+        {
+            allocs.push_back(pool.Allocate(16 + (i % 8) * 16));
+        }
+        for(int i = 0; i < 1000; ++i)
+        {
+            pool.Deallocate(allocs[i], 16 + (i % 8) * 16);
+        }
+    };
+    std::thread thread1(churn);
+    std::thread thread2(churn);
+    thread1.join();
+    thread2.join();
+    REQUIRE(pool.GetAllocationCount() == 0);
+}
+
+namespace
+{
+    ObjectPool alignedTestPool;
+
+    struct PooledBase
+    {
+        virtual ~PooledBase() = default;
+        static void* operator new(size_t size) { return alignedTestPool.Allocate(size); }
+        static void* operator new(size_t size, std::align_val_t alignment) { return alignedTestPool.Allocate(size, alignment); }
+        static void operator delete(void* memory, size_t size) { alignedTestPool.Deallocate(memory, size); }
+        static void operator delete(void* memory, size_t size, std::align_val_t alignment) { alignedTestPool.Deallocate(memory, size, alignment); }
+    };
+
+    struct alignas(64) OverAlignedPooled : public PooledBase
+    {
+        float values[16];
+    };
+}
+
+TEST_CASE("Object pool gives over-aligned types aligned memory")
+{
+    // Types with default alignment come from the pool.
+    PooledBase* pooled = new PooledBase();
+    REQUIRE(alignedTestPool.GetAllocationCount() == 1);
+
+    // Over-aligned types get memory with the right alignment (from the heap, rather than the pool).
+    PooledBase* overAligned = new OverAlignedPooled();
+    REQUIRE(reinterpret_cast<uintptr_t>(overAligned) % alignof(OverAlignedPooled) == 0);
+    REQUIRE(alignedTestPool.GetAllocationCount() == 1);
+
+    delete overAligned;
+    delete pooled;
+    REQUIRE(alignedTestPool.GetAllocationCount() == 0);
+}
+
 TEST_CASE("Freestyle allocator basic alloc/dealloc works correctly")
 {
     // The checks in this test assume a 64-bit machine...so ignore on Win32 for now.
@@ -265,3 +529,273 @@ TEST_CASE("Freestyle allocator basic alloc/dealloc works correctly")
     REQUIRE(allocator.GetFreeBlockSize(1) == 0); // there is no second free block
     #endif
 }
+
+TEST_CASE("TLSF allocator basic alloc/dealloc works correctly")
+{
+    // Use 16-byte aligned memory, so sizes below are exact.
+    alignas(16) unsigned char memory[4096];
+    TLSFAllocator allocator(memory, 4096);
+    REQUIRE(allocator.GetAllocationCount() == 0);
+    REQUIRE(allocator.GetAllocatedSize() == 0);
+    REQUIRE(allocator.GetFreeBlockCount() == 1);
+
+    // 16 bytes are reserved at the end of the memory.
+    size_t totalFreeSize = allocator.GetFreeSize();
+    REQUIRE(totalFreeSize == 4080);
+    REQUIRE(allocator.GetLargestFreeBlockSize() == totalFreeSize);
+    REQUIRE(allocator.GetFragmentation() == 0.0f);
+
+    // Allocate 4 blocks of size 128.
+    // Because header is 16 bytes, this actually allocates 144 bytes each time.
+    std::vector<void*> allocs128;
+    for(int i = 0; i < 4; ++i)
+    {
+        allocs128.push_back(allocator.Allocate(128));
+        REQUIRE(allocs128.back() != nullptr);
+    }
+    REQUIRE(allocator.GetAllocationCount() == 4);
+    REQUIRE(allocator.GetAllocatedSize() == 576);
+    REQUIRE(allocator.GetFreeSize() == totalFreeSize - 576);
+    REQUIRE(allocator.GetFreeBlockCount() == 1);
+
+    // Deallocating a block in the middle creates a hole.
+    allocator.Deallocate(allocs128[1]);
+    REQUIRE(allocator.GetAllocationCount() == 3);
+    REQUIRE(allocator.GetAllocatedSize() == 432);
+    REQUIRE(allocator.GetFreeBlockCount() == 2);
+    REQUIRE(allocator.GetFragmentation() > 0.0f);
+
+    // A same-size allocation should reuse the hole.
+    void* reused = allocator.Allocate(128);
+    REQUIRE(reused == allocs128[1]);
+    REQUIRE(allocator.GetFreeBlockCount() == 1);
+
+    // Deallocate blocks 1 and 3: two separate holes.
+    allocator.Deallocate(allocs128[1]);
+    allocator.Deallocate(allocs128[3]);
+    REQUIRE(allocator.GetFreeBlockCount() == 2);
+
+    // Deallocating block 2 bridges the holes, so everything after block 0 merges into one free block.
+    allocator.Deallocate(allocs128[2]);
+    REQUIRE(allocator.GetAllocationCount() == 1);
+    REQUIRE(allocator.GetAllocatedSize() == 144);
+    REQUIRE(allocator.GetFreeBlockCount() == 1);
+    REQUIRE(allocator.GetLargestFreeBlockSize() == totalFreeSize - 144);
+
+    // Deallocating block 0 merges with the next block, putting us back where we started.
+    allocator.Deallocate(allocs128[0]);
+    REQUIRE(allocator.GetAllocationCount() == 0);
+    REQUIRE(allocator.GetAllocatedSize() == 0);
+    REQUIRE(allocator.GetFreeBlockCount() == 1);
+    REQUIRE(allocator.GetFreeSize() == totalFreeSize);
+
+    // Allocations that are too big fail.
+    REQUIRE(allocator.Allocate(4096) == nullptr);
+
+    // Fill up the memory until allocations fail.
+    int fillCount = 0;
+    while(allocator.Allocate(128) != nullptr)
+    {
+        ++fillCount;
+    }
+    REQUIRE(fillCount > 0);
+    REQUIRE(allocator.GetAllocationCount() == fillCount);
+
+    // Reset frees everything.
+    allocator.Reset();
+    REQUIRE(allocator.GetAllocationCount() == 0);
+    REQUIRE(allocator.GetFreeSize() == totalFreeSize);
+}
+
+TEST_CASE("TLSF allocator respects alignment")
+{
+    std::vector<unsigned char> memory(64 * 1024);
+    TLSFAllocator allocator(memory.data(), memory.size());
+
+    std::vector<void*> allocs;
+    const unsigned short alignments[] = { 4, 16, 32, 64, 128, 256 };
+    for(int i = 0; i < 60; ++i)
+    {
+        unsigned short alignment = alignments[i % 6];
+        void* alloc = allocator.Allocate(24 + i * 8, alignment);
+        REQUIRE(alloc != nullptr);
+        REQUIRE(PtrMath::Align(alloc, alignment) == alloc);
+        allocs.push_back(alloc);
+    }
+
+    // Padding split off for alignment goes back to the free lists, so freeing everything gets us one block again.
+    for(void* alloc : allocs)
+    {
+        allocator.Deallocate(alloc);
+    }
+    REQUIRE(allocator.GetAllocationCount() == 0);
+    REQUIRE(allocator.GetFreeBlockCount() == 1);
+}
+
+namespace
+{
+    // Does a bunch of random allocations and deallocations, checking that allocations never overlap.
+    // Returns the number of allocations that succeeded.
+    template<typename Allocator>
+    int AllocatorStressTest(Allocator& allocator, unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<size_t> sizeDist(1, 512);
+        std::uniform_int_distribution<int> actionDist(0, 2);
+
+        struct Alloc
+        {
+            unsigned char* memory;
+            size_t size;
+            unsigned char pattern;
+        };
+        std::vector<Alloc> allocs;
+
+        // Each allocation is filled with a pattern. If the pattern is broken on free, something overwrote it.
+        auto deallocate = [&](size_t index) {
+            Alloc& alloc = allocs[index];
+            bool intact = true;
+            for(size_t i = 0; i < alloc.size; ++i)
+            {
+                intact &= alloc.memory[i] == alloc.pattern;
+            }
+            REQUIRE(intact);
+            allocator.Deallocate(alloc.memory);
+            allocs[index] = allocs.back();
+            allocs.pop_back();
+        };
+
+        int successCount = 0;
+        for(int i = 0; i < 20000; ++i)
+        {
+            // Two-thirds of the time, allocate. Otherwise, deallocate at random.
+            if(actionDist(random) != 0 || allocs.empty())
+            {
+                size_t size = sizeDist(random);
+                unsigned char* memory = static_cast<unsigned char*>(allocator.Allocate(size));
+                if(memory != nullptr)
+                {
+                    unsigned char pattern = static_cast<unsigned char>(i);
+                    memset(memory, pattern, size);
+                    allocs.push_back({ memory, size, pattern });
+                    ++successCount;
+                }
+                else
+                {
+                    // Out of memory - free a bunch of stuff.
+                    while(allocs.size() > 16)
+                    {
+                        deallocate(random() % allocs.size());
+                    }
+                }
+            }
+            else
+            {
+                deallocate(random() % allocs.size());
+            }
+            REQUIRE(allocator.GetAllocationCount() == allocs.size());
+        }
+
+        // Free everything that's left.
+        while(!allocs.empty())
+        {
+            deallocate(allocs.size() - 1);
+        }
+        REQUIRE(allocator.GetAllocationCount() == 0);
+        REQUIRE(allocator.GetAllocatedSize() == 0);
+        return successCount;
+    }
+}
+
+TEST_CASE("TLSF allocator survives random alloc/dealloc")
+{
+    std::vector<unsigned char> memory(32 * 1024);
+    TLSFAllocator allocator(memory.data(), memory.size());
+    size_t totalFreeSize = allocator.GetFreeSize();
+
+    for(unsigned int seed = 1; seed <= 4; ++seed)
+    {
+        REQUIRE(AllocatorStressTest(allocator, seed) > 0);
+
+        // Once everything is freed, all memory should have merged back into one block.
+        REQUIRE(allocator.GetFreeBlockCount() == 1);
+        REQUIRE(allocator.GetFreeSize() == totalFreeSize);
+        REQUIRE(allocator.GetFragmentation() == 0.0f);
+    }
+}
+
+TEST_CASE("Freestyle allocator survives random alloc/dealloc")
+{
+    std::vector<unsigned char> memory(32 * 1024);
+    FreestyleAllocator allocator(memory.data(), memory.size());
+
+    for(unsigned int seed = 1; seed <= 4; ++seed)
+    {
+        REQUIRE(AllocatorStressTest(allocator, seed) > 0);
+
+        // Once everything is freed, all memory should have merged back into one block.
+        REQUIRE(allocator.GetFreeBlockSize(0) == memory.size());
+        REQUIRE(allocator.GetFreeBlockSize(1) == 0);
+    }
+}
+
+namespace
+{
+    // Random sizes and a few hundred live allocations at once - roughly what a general-purpose heap sees.
+    template<typename AllocateFunc, typename DeallocateFunc>
+    double AllocatorBenchmark(AllocateFunc allocate, DeallocateFunc deallocate, int operationCount)
+    {
+        std::mt19937 random(1234);
+        std::uniform_int_distribution<size_t> sizeDist(16, 512);
+        std::vector<void*> allocs(512, nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < operationCount; ++i)
+        {
+            // Pick a random slot: free what's there, or allocate into it.
+            void*& alloc = allocs[random() % allocs.size()];
+            if(alloc != nullptr)
+            {
+                deallocate(alloc);
+                alloc = nullptr;
+            }
+            else
+            {
+                alloc = allocate(sizeDist(random));
+            }
+        }
+        for(void*& alloc : allocs)
+        {
+            if(alloc != nullptr)
+            {
+                deallocate(alloc);
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+TEST_CASE("Allocator throughput", "[.benchmark]")
+{
+    // Hidden by default - run with "tests [.benchmark]" to see numbers.
+    const int kOperationCount = 2000000;
+    std::vector<unsigned char> memory(1024 * 1024);
+
+    TLSFAllocator tlsf(memory.data(), memory.size());
+    double tlsfTime = AllocatorBenchmark([&](size_t size) { return tlsf.Allocate(size); },
+                                         [&](void* alloc) { tlsf.Deallocate(alloc); }, kOperationCount);
+    REQUIRE(tlsf.GetAllocationCount() == 0);
+
+    FreestyleAllocator freestyle(memory.data(), memory.size());
+    double freestyleTime = AllocatorBenchmark([&](size_t size) { return freestyle.Allocate(size); },
+                                              [&](void* alloc) { freestyle.Deallocate(alloc); }, kOperationCount);
+    REQUIRE(freestyle.GetAllocationCount() == 0);
+
+    double mallocTime = AllocatorBenchmark([](size_t size) { return malloc(size); },
+                                           [](void* alloc) { free(alloc); }, kOperationCount);
+
+    printf("TLSFAllocator: %d ops in %.3f sec (%.1f M/sec)\n", kOperationCount, tlsfTime, kOperationCount / tlsfTime / 1000000.0);
+    printf("FreestyleAllocator: %d ops in %.3f sec (%.1f M/sec)\n", kOperationCount, freestyleTime, kOperationCount / freestyleTime / 1000000.0);
+    printf("malloc: %d ops in %.3f sec (%.1f M/sec)\n", kOperationCount, mallocTime, kOperationCount / mallocTime / 1000000.0);
+}
@@ -0,0 +1,63 @@
+//
+// Clark Kromenaker
+//
+// Tests for scene prediction helpers.
+//
+#include "catch.hh"
+#include "ScenePrediction.h"
+
+using Locations = std::vector<std::pair<std::string, std::string>>;
+
+TEST_CASE("FindSetLocationCalls finds SetLocation calls")
+{
+    Locations locations;
+    ScenePrediction::FindSetLocationCalls("{ SetLocation(\"LBY\"); Wait(); setlocation ( \"r25\" ); }", locations);
+    REQUIRE(locations.size() == 2);
+    REQUIRE(locations[0].first == "LBY");
+    REQUIRE(locations[0].second.empty());
+    REQUIRE(locations[1].first == "r25");
+    REQUIRE(locations[1].second.empty());
+}
+
+TEST_CASE("FindSetLocationCalls finds SetLocationTime calls")
+{
+    Locations locations;
+    ScenePrediction::FindSetLocationCalls("{ SetLocationTime(\"LBY\", \"110A\"); SetLocationTime(\"DIN\",\"202P\"); }", locations);
+    REQUIRE(locations.size() == 2);
+    REQUIRE(locations[0].first == "LBY");
+    REQUIRE(locations[0].second == "110A");
+    REQUIRE(locations[1].first == "DIN");
+    REQUIRE(locations[1].second == "202P");
+}
+
+TEST_CASE("FindSetLocationCalls skips non-literal arguments")
+{
+    Locations locations;
+
+    // A non-literal location can't be predicted, even if a later call's string literal comes next.
+    ScenePrediction::FindSetLocationCalls("{ SetLocation(sLocation); SetLocation(\"R33\"); }", locations);
+    REQUIRE(locations.size() == 1);
+    REQUIRE(locations[0].first == "R33");
+
+    // A non-literal timeblock leaves the timeblock empty, but the location is still predicted.
+    locations.clear();
+    ScenePrediction::FindSetLocationCalls("{ SetLocationTime(\"LBY\", sTime); Call(\"110A\"); }", locations);
+    REQUIRE(locations.size() == 1);
+    REQUIRE(locations[0].first == "LBY");
+    REQUIRE(locations[0].second.empty());
+
+    locations.clear();
+    ScenePrediction::FindSetLocationCalls("{ SetLocationTime(sLocation, \"110A\"); }", locations);
+    REQUIRE(locations.empty());
+}
+
+TEST_CASE("FindSetLocationCalls ignores invalid locations")
+{
+    // Location codes are always three characters.
+    Locations locations;
+    ScenePrediction::FindSetLocationCalls("{ SetLocation(\"LOBBY\"); SetLocation(\"\"); SetLocation(", locations);
+    REQUIRE(locations.empty());
+
+    ScenePrediction::FindSetLocationCalls("{ PrintString(\"no calls here\"); }", locations);
+    REQUIRE(locations.empty());
+}
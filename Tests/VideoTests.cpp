@@ -0,0 +1,124 @@
+//
+// Clark Kromenaker
+//
+// Tests for video playback helpers.
+//
+#include "catch.hh"
+
+#include <thread>
+
+#include "PacketQueue.h"
+
+namespace
+{
+    int EnqueueDataPacket(PacketQueue& queue, int64_t pts, int64_t duration)
+    {
+        AVPacket avPacket;
+        av_init_packet(&avPacket);
+        av_new_packet(&avPacket, 16);
+        avPacket.pts = pts;
+        avPacket.duration = duration;
+        avPacket.stream_index = 0;
+        return queue.Enqueue(&avPacket);
+    }
+}
+
+TEST_CASE("PacketQueue tracks serials, flushes, and clears")
+{
+    PacketQueue queue;
+    REQUIRE(queue.Init() == 0);
+
+    // Starting the queue enqueues a flush packet, which starts a new serial.
+    queue.Start();
+    REQUIRE(queue.serial == 1);
+    REQUIRE(queue.GetPacketCount() == 1);
+
+    AVPacket avPacket;
+    int serial = 0;
+    REQUIRE(queue.Dequeue(false, &avPacket, &serial) == 1);
+    REQUIRE(PacketQueue::IsFlushPacket(&avPacket));
+    REQUIRE(serial == 1);
+    REQUIRE(queue.GetPacketCount() == 0);
+    REQUIRE(queue.GetByteSize() == 0);
+
+    // Data packets are counted, and have the current serial.
+    REQUIRE(EnqueueDataPacket(queue, 0, 10) == 0);
+    REQUIRE(EnqueueDataPacket(queue, 10, 20) == 0);
+    REQUIRE(queue.GetPacketCount() == 2);
+    REQUIRE(queue.GetDuration() == 30);
+    REQUIRE(queue.GetByteSize() > 32);
+
+    // A flush (e.g. from a seek) bumps the serial for packets after it. Packets before it keep the old serial.
+    REQUIRE(queue.EnqueueFlush() == 0);
+    REQUIRE(EnqueueDataPacket(queue, 100, 5) == 0);
+    REQUIRE(queue.serial == 2);
+    REQUIRE(queue.GetPacketCount() == 4);
+
+    REQUIRE(queue.Dequeue(false, &avPacket, &serial) == 1);
+    REQUIRE(avPacket.pts == 0);
+    REQUIRE(serial == 1);
+    av_packet_unref(&avPacket);
+    REQUIRE(queue.GetPacketCount() == 3);
+    REQUIRE(queue.GetDuration() == 25);
+
+    // Clearing immediately drops everything enqueued so far from the size/duration/count, even before the consumer discards it.
+    queue.Clear();
+    REQUIRE(queue.GetPacketCount() == 0);
+    REQUIRE(queue.GetByteSize() == 0);
+    REQUIRE(queue.GetDuration() == 0);
+
+    // Packets enqueued after a clear are kept. The cleared ones are discarded when the consumer next dequeues.
+    REQUIRE(EnqueueDataPacket(queue, 200, 7) == 0);
+    REQUIRE(queue.GetPacketCount() == 1);
+    REQUIRE(queue.GetDuration() == 7);
+    REQUIRE(queue.Dequeue(false, &avPacket, &serial) == 1);
+    REQUIRE(avPacket.pts == 200);
+    REQUIRE(serial == 2);
+    av_packet_unref(&avPacket);
+    REQUIRE(queue.GetPacketCount() == 0);
+    REQUIRE(queue.Dequeue(false, &avPacket, &serial) == 0);
+
+    // Once aborted, dequeueing fails, and so does enqueueing.
+    queue.Abort();
+    REQUIRE(queue.Aborted());
+    REQUIRE(queue.Dequeue(true, &avPacket, &serial) < 0);
+    REQUIRE(EnqueueDataPacket(queue, 300, 1) < 0);
+    queue.Destroy();
+}
+
+TEST_CASE("PacketQueue passes packets between threads in order")
+{
+    PacketQueue queue;
+    REQUIRE(queue.Init() == 0);
+    queue.Start();
+
+    // More packets than fit in the queue at once, so the producer has to wait on the consumer at times.
+    const int kPacketCount = 5000;
+    std::thread producer([&queue]() {
+        for(int i = 0; i < kPacketCount; ++i)
+        {
+            EnqueueDataPacket(queue, i, 1);
+        }
+    });
+
+    bool inOrder = true;
+    int64_t expectedPts = 0;
+    while(expectedPts < kPacketCount)
+    {
+        AVPacket avPacket;
+        int serial = 0;
+        if(queue.Dequeue(true, &avPacket, &serial) < 0) { break; }
+        if(PacketQueue::IsFlushPacket(&avPacket)) { continue; }
+
+        inOrder &= (avPacket.pts == expectedPts && serial == 1);
+        ++expectedPts;
+        av_packet_unref(&avPacket);
+    }
+    producer.join();
+    REQUIRE(inOrder);
+    REQUIRE(expectedPts == kPacketCount);
+    REQUIRE(queue.GetPacketCount() == 0);
+
+    queue.Abort();
+    queue.Destroy();
+}